@@ -27,8 +27,9 @@ if     ( "${CMAKE_SYSTEM_NAME}" STREQUAL "Windows"  )
 else   ( "${CMAKE_SYSTEM_NAME}" STREQUAL "Windows"  )
 	target_link_libraries   ( ${PROJECT_NAME} z                                           )
 	target_link_libraries   ( ${PROJECT_NAME} ${CMAKE_SOURCE_DIR}/extern/soft-2.0/libsoft1.a )
-	target_link_libraries   ( ${PROJECT_NAME} fftw3                                       )
+	target_link_libraries   ( ${PROJECT_NAME} fftw3_threads fftw3                         )
 	target_link_libraries   ( ${PROJECT_NAME} lapack blas                                 )
+	target_link_libraries   ( ${PROJECT_NAME} ${CMAKE_THREAD_LIBS_INIT}                   )
 endif  ( "${CMAKE_SYSTEM_NAME}" STREQUAL "Windows"  )
 
 
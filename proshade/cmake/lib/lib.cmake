@@ -27,8 +27,9 @@ if     ( "${CMAKE_SYSTEM_NAME}" STREQUAL "Windows"  )
 else   ( "${CMAKE_SYSTEM_NAME}" STREQUAL "Windows"  )
 	target_link_libraries   ( ${PROJECT_NAME}_LIB z                                       )
 	target_link_libraries   ( ${PROJECT_NAME}_LIB ${CMAKE_SOURCE_DIR}/extern/soft-2.0/libsoft1.a )
-	target_link_libraries   ( ${PROJECT_NAME}_LIB fftw3                                   )
+	target_link_libraries   ( ${PROJECT_NAME}_LIB fftw3_threads fftw3                     )
 	target_link_libraries   ( ${PROJECT_NAME}_LIB lapack blas                             )
+	target_link_libraries   ( ${PROJECT_NAME}_LIB ${CMAKE_THREAD_LIBS_INIT}               )
 endif  ( "${CMAKE_SYSTEM_NAME}" STREQUAL "Windows"  )
 
 
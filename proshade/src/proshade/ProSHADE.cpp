@@ -45,6 +45,8 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( )
     this->removeWaters                                = true;
     this->firstModelOnly                              = true;
     this->removeNegativeDensity                       = true;
+    this->mapMemoryBudget                             = 0;
+    this->cropMapOnRead                               = false;
     
     //================================================ Settings regarding the resolution of calculations
     this->requestedResolution                         = -1.0;
@@ -121,6 +123,9 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( )
     this->computeEnergyLevelsDesc                     = true;
     this->computeTraceSigmaDesc                       = true;
     this->computeRotationFuncDesc                     = true;
+    this->rotFunDescCoarseToFine                      = false;
+    this->computeAllDistances                         = false;
+    this->maxInFlightStructures                       = 0;
     this->enLevMatrixPowerWeight                      = 1.0;
     
     //================================================ Settings regarding peak searching
@@ -158,6 +163,20 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( )
     this->verbose                                     = 1;
     this->messageShift                                = 0;
     
+    //================================================ Settings regarding parallel computation
+    this->noThreads                                   = 1;
+    
+    //================================================ Settings regarding FFTW planning
+    this->fftwPlanningRigour                          = 0;
+    this->fftwWisdomFile                              = "";
+    
+    //================================================ Settings regarding the inverse SO(3) Fourier transform
+    this->invSOFTBackend                              = 0;
+    
+    //================================================ Register as a user of the FFTW plans and Wigner d tables caches
+    ProSHADE_internal_fftw::acquirePlanCache          ( );
+    ProSHADE_internal_distances::acquireInvSOFTWignerTables ( );
+    
     //================================================ Done
     
 }
@@ -183,6 +202,8 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( ProSHADE_settings*
     this->removeWaters                                = settings->removeWaters;
     this->firstModelOnly                              = settings->firstModelOnly;
     this->removeNegativeDensity                       = settings->removeNegativeDensity;
+    this->mapMemoryBudget                             = settings->mapMemoryBudget;
+    this->cropMapOnRead                               = settings->cropMapOnRead;
     
     //================================================ Settings regarding the resolution of calculations
     this->requestedResolution                         = settings->requestedResolution;
@@ -260,6 +281,9 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( ProSHADE_settings*
     this->computeEnergyLevelsDesc                     = settings->computeEnergyLevelsDesc;
     this->computeTraceSigmaDesc                       = settings->computeTraceSigmaDesc;
     this->computeRotationFuncDesc                     = settings->computeRotationFuncDesc;
+    this->rotFunDescCoarseToFine                      = settings->rotFunDescCoarseToFine;
+    this->computeAllDistances                         = settings->computeAllDistances;
+    this->maxInFlightStructures                       = settings->maxInFlightStructures;
     this->enLevMatrixPowerWeight                      = settings->enLevMatrixPowerWeight;
     
     //================================================ Settings regarding peak searching
@@ -298,6 +322,20 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( ProSHADE_settings*
     //================================================ Settings regarding verbosity of the program
     this->verbose                                     = settings->verbose;
     this->messageShift                                = settings->messageShift;
+    
+    //================================================ Settings regarding parallel computation
+    this->noThreads                                   = settings->noThreads;
+    
+    //================================================ Settings regarding FFTW planning
+    this->fftwPlanningRigour                          = settings->fftwPlanningRigour;
+    this->fftwWisdomFile                              = settings->fftwWisdomFile;
+    
+    //================================================ Settings regarding the inverse SO(3) Fourier transform
+    this->invSOFTBackend                              = settings->invSOFTBackend;
+    
+    //================================================ Register as a user of the FFTW plans and Wigner d tables caches
+    ProSHADE_internal_fftw::acquirePlanCache          ( );
+    ProSHADE_internal_distances::acquireInvSOFTWignerTables ( );
 }
 
 /*! \brief Contructor for the ProSHADE_settings class for particular task.
@@ -322,6 +360,8 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( ProSHADE_Task taskT
     this->removeWaters                                = true;
     this->firstModelOnly                              = true;
     this->removeNegativeDensity                       = true;
+    this->mapMemoryBudget                             = 0;
+    this->cropMapOnRead                               = false;
     
     //================================================ Settings regarding the resolution of calculations
     this->requestedResolution                         = -1.0;
@@ -397,6 +437,9 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( ProSHADE_Task taskT
     this->computeEnergyLevelsDesc                     = true;
     this->computeTraceSigmaDesc                       = true;
     this->computeRotationFuncDesc                     = true;
+    this->rotFunDescCoarseToFine                      = false;
+    this->computeAllDistances                         = false;
+    this->maxInFlightStructures                       = 0;
     this->enLevMatrixPowerWeight                      = 1.0;
     
     //================================================ Settings regarding peak searching
@@ -434,6 +477,16 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( ProSHADE_Task taskT
     this->verbose                                     = 1;
     this->messageShift                                = 0;
     
+    //================================================ Settings regarding parallel computation
+    this->noThreads                                   = 1;
+    
+    //================================================ Settings regarding FFTW planning
+    this->fftwPlanningRigour                          = 0;
+    this->fftwWisdomFile                              = "";
+    
+    //================================================ Settings regarding the inverse SO(3) Fourier transform
+    this->invSOFTBackend                              = 0;
+    
     //================================================ Task specific settings
     switch ( this->task )
     {
@@ -480,6 +533,10 @@ __declspec(dllexport) ProSHADE_settings::ProSHADE_settings ( ProSHADE_Task taskT
             break;
     }
     
+    //================================================ Register as a user of the FFTW plans and Wigner d tables caches
+    ProSHADE_internal_fftw::acquirePlanCache          ( );
+    ProSHADE_internal_distances::acquireInvSOFTWignerTables ( );
+    
     //================================================ Done
     
 }
@@ -497,6 +554,10 @@ __declspec(dllexport) ProSHADE_settings::~ProSHADE_settings ( void )
     //================================================ Release boundaries variable
     delete[] this->forceBounds;
     
+    //================================================ Release the FFTW plans and Wigner d tables caches (cleared when no settings object is left)
+    ProSHADE_internal_fftw::releasePlanCache          ( );
+    ProSHADE_internal_distances::releaseInvSOFTWignerTables ( );
+    
     //================================================ Done
     
 }
@@ -1280,6 +1341,50 @@ void                       ProSHADE_settings::setRotationFunctionComputation  (
     
 }
 
+/*! \brief Sets whether the rotation function descriptor should be computed by the coarse-to-fine peak search.
+ 
+    If set, the rotation function is computed only at a quarter of the comparison bandwidth and its highest peaks are then
+    refined at the full bandwidth by directly evaluating the rotation function, thus avoiding the full bandwidth rotation
+    function map.
+ 
+    \param[in] coarseVal The requested value for the coarse-to-fine rotation function descriptor switch.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setRotationFunctionCoarseToFine ( bool coarseVal )
+#else
+void                       ProSHADE_settings::setRotationFunctionCoarseToFine ( bool coarseVal )
+#endif
+{
+    //================================================ Set the value
+    this->rotFunDescCoarseToFine                      = coarseVal;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Sets whether the distances should be computed between all pairs of structures.
+ 
+    This function sets the boolean variable deciding whether the distances task should compute the full matrix of distances
+    between all pairs of input structures (with each structure being processed only once), or whether only the distances from
+    the first structure to all other structures should be computed.
+ 
+    \param[in] allDist The requested value for the all-vs-all distances computation switch.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setAllVsAllDistances ( bool allDist )
+#else
+void                       ProSHADE_settings::setAllVsAllDistances ( bool allDist )
+#endif
+{
+    //================================================ Set the value
+    this->computeAllDistances                         = allDist;
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief Sets the number of neighbour values that have to be smaller for an index to be considered a peak.
  
     This function sets the number of neighbouring points (in all three dimensions and both positive and negative direction) that
@@ -1662,6 +1767,157 @@ void                       ProSHADE_settings::setNegativeDensity ( bool nDens )
     
 }
 
+/*! \brief Sets the maximum size of the internal map read from a map file.
+ 
+    This function sets the memory budget for the internal map representation. If a map file would give a larger internal
+    map (after cropping, if enabled by setCropMapOnRead()), the map is not read and an error is raised. The budget only
+    applies to the map as read from uncompressed mode 2 map files; the later processing copies are not limited.
+ 
+    \param[in] memBudget The maximum internal map size in MB; 0 means no limit.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setMapMemoryBudget ( proshade_unsign memBudget )
+#else
+void                       ProSHADE_settings::setMapMemoryBudget ( proshade_unsign memBudget )
+#endif
+{
+    //================================================ Set the value
+    this->mapMemoryBudget                             = memBudget;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Sets whether maps should be cropped to their density box while being read.
+ 
+    If set, only the box containing the map density (the map averaged over small cells and thresholded by the masking threshold,
+    see setMaskIQR()) is read from uncompressed mode 2 map files, so that maps with large noisy or empty padding can be processed
+    without ever holding the full map in memory. Note that this changes the map box and origin, and therefore all the results
+    computed from the map. Maps read by gemmi (compressed, other modes or byte orders) are never cropped.
+ 
+    \param[in] cropOnRead Should the maps be cropped to their density box when read?
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setCropMapOnRead ( bool cropOnRead )
+#else
+void                       ProSHADE_settings::setCropMapOnRead ( bool cropOnRead )
+#endif
+{
+    //================================================ Set the value
+    this->cropMapOnRead                               = cropOnRead;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Sets the maximum number of structures processed concurrently by the parallel distances computation.
+ 
+    This function sets the upper limit on the number of structures which are read in and processed (and therefore held in
+    memory) at the same time by the parallel distances computation, thus allowing the memory requirements to be bounded
+    independently of the number of threads used.
+ 
+    \param[in] maxInFl The maximum number of in-flight structures; 0 means the same as the number of threads.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setMaxInFlightStructures ( proshade_unsign maxInFl )
+#else
+void                       ProSHADE_settings::setMaxInFlightStructures ( proshade_unsign maxInFl )
+#endif
+{
+    //================================================ Set the value
+    this->maxInFlightStructures                       = maxInFl;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Sets the number of threads to be used by the parallelised computations.
+ 
+    \param[in] noThr The requested number of threads; 0 means all available hardware threads.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setNumberOfThreads ( proshade_unsign noThr )
+#else
+void                       ProSHADE_settings::setNumberOfThreads ( proshade_unsign noThr )
+#endif
+{
+    //================================================ Set the value
+    this->noThreads                                   = noThr;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Sets the rigour with which the FFTW plans are created.
+ 
+    Higher rigour makes the planning slower, but may result in faster transforms. As the plans are cached and the planning
+    results can be saved in the wisdom file (see setFFTWWisdomFile()), the higher rigour is worth it for repeated runs on
+    the same box sizes. Note that FFTW planning is process-wide: the value is applied when ProSHADE_run starts and then holds
+    for all settings objects in use, until another run with a different value is started.
+ 
+    \param[in] rigour The planning rigour; 0 for FFTW_ESTIMATE, 1 for FFTW_MEASURE and 2 for FFTW_PATIENT.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setFFTWPlanningRigour ( proshade_unsign rigour )
+#else
+void                       ProSHADE_settings::setFFTWPlanningRigour ( proshade_unsign rigour )
+#endif
+{
+    //================================================ Set the value
+    this->fftwPlanningRigour                          = rigour;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Sets the file to and from which the FFTW wisdom is saved and loaded.
+ 
+    As with the planning rigour (see setFFTWPlanningRigour()), the wisdom file is process-wide and the one set for the most
+    recently started ProSHADE_run is used by all settings objects.
+ 
+    \param[in] wisdomFile The path to the wisdom file; an empty string means no wisdom file is used.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setFFTWWisdomFile ( std::string wisdomFile )
+#else
+void                       ProSHADE_settings::setFFTWWisdomFile ( std::string wisdomFile )
+#endif
+{
+    //================================================ Set the value
+    this->fftwWisdomFile                              = wisdomFile;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Sets which implementation of the inverse SO(3) Fourier transform is to be used.
+ 
+    The parallel implementation distributes the Wigner d synthesis over the threads (see setNumberOfThreads()) and re-uses
+    the Wigner d tables between transforms of the same bandwidth. It is not available on Windows, where the naive transform
+    is used instead.
+ 
+    \param[in] backend The inverse SO(3) transform implementation; 0 for the SOFT library naive transform (default), 1 for the parallel transform.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+void __declspec(dllexport) ProSHADE_settings::setInverseSOFTBackend ( proshade_unsign backend )
+#else
+void                       ProSHADE_settings::setInverseSOFTBackend ( proshade_unsign backend )
+#endif
+{
+    //================================================ Set the value
+    this->invSOFTBackend                              = backend;
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief This function determines the bandwidth for the spherical harmonics computation.
  
     This function is here to automstically determine the bandwidth to which the spherical harmonics computations should be done.
@@ -1910,6 +2166,9 @@ __declspec(dllexport) ProSHADE_run::ProSHADE_run ( ProSHADE_settings* settings )
     //================================================ Try to run ProSHADE
     try
     {
+        //============================================ Set the FFTW planning options and load the wisdom, if available
+        ProSHADE_internal_fftw::setPlanningOptions    ( settings->fftwPlanningRigour, settings->fftwWisdomFile, settings->verbose, settings->messageShift );
+        
         //============================================ Depending on task, switch to correct function to call
         switch ( settings->task )
         {
@@ -1922,7 +2181,8 @@ __declspec(dllexport) ProSHADE_run::ProSHADE_run ( ProSHADE_settings* settings )
                 break;
                 
             case Distances:
-                ProSHADE_internal_tasks::DistancesComputationTask ( settings, &this->enLevs, &this->trSigm, &this->rotFun );
+                if ( settings->computeAllDistances ) { ProSHADE_internal_tasks::AllDistancesComputationTask ( settings, &this->enLevs, &this->trSigm, &this->rotFun, &this->enLevsMatrix, &this->trSigmMatrix, &this->rotFunMatrix ); }
+                else                                 { ProSHADE_internal_tasks::DistancesComputationTask ( settings, &this->enLevs, &this->trSigm, &this->rotFun ); }
                 break;
                 
             case OverlayMap:
@@ -1933,6 +2193,9 @@ __declspec(dllexport) ProSHADE_run::ProSHADE_run ( ProSHADE_settings* settings )
                 ProSHADE_internal_tasks::MapManipulationTask ( settings, &this->originalBounds, &this->reboxedBounds, &this->manipulatedMaps );
                 break;
         }
+        
+        //============================================ Save the FFTW wisdom accumulated by this run
+        ProSHADE_internal_fftw::saveWisdom            ( settings->verbose, settings->messageShift );
     }
     
     //================================================ If this is ProSHADE exception, give all available info and terminate gracefully :-)
@@ -2007,6 +2270,9 @@ __declspec(dllexport) ProSHADE_run::~ProSHADE_run ( )
     this->enLevs.clear                                ( );
     this->trSigm.clear                                ( );
     this->rotFun.clear                                ( );
+    this->enLevsMatrix.clear                          ( );
+    this->trSigmMatrix.clear                          ( );
+    this->rotFunMatrix.clear                          ( );
     
     //================================================ Delete symmetry axes memory
     if ( this->RecomSymAxes.size() > 0 )
@@ -2159,6 +2425,13 @@ void                       ProSHADE_settings::getCommandLineParams ( int argc, c
         { "noEnL",           no_argument,        nullptr, 'l' },
         { "noTrS",           no_argument,        nullptr, 'm' },
         { "noFRF",           no_argument,        nullptr, 'n' },
+        { "FRFCoarse",       no_argument,        nullptr, 'V' },
+        { "allVsAll",        no_argument,        nullptr, 'L' },
+        { "maxInFlight",     required_argument,  nullptr, 'N' },
+        { "threads",         required_argument,  nullptr, 'T' },
+        { "fftwRigour",      required_argument,  nullptr, 'Q' },
+        { "fftwWisdom",      required_argument,  nullptr, 'W' },
+        { "invSOFT",         required_argument,  nullptr, 'U' },
         { "EnLWeight",       required_argument,  nullptr, '_' },
         { "peakNeigh",       required_argument,  nullptr, '=' },
         { "peakThres",       required_argument,  nullptr, '+' },
@@ -2177,12 +2450,14 @@ void                       ProSHADE_settings::getCommandLineParams ( int argc, c
         { "maxRadius",       required_argument,  nullptr, 'J' },
         { "fourierWeights",  required_argument,  nullptr, 'z' },
         { "keepNegDens",     no_argument,        nullptr, 'F' },
+        { "mapMemBudget",    required_argument,  nullptr, 'X' },
+        { "cropOnRead",      no_argument,        nullptr, 'Y' },
         { "coordExtraSpace", required_argument,  nullptr, 'H' },
         { nullptr,           0,                  nullptr,  0  }
     };
     
     //================================================ Short options string
-    const char* const shortopts                       = "AaB:b:C:cDd:E:e:Ff:G:g:H:hIi:J:jK:klmMno:Opqr:Rs:St:uvwxy:z:!:@#$%^:&:*:(:):-_:=:+:[:]:{:}:;:";
+    const char* const shortopts                       = "AaB:b:C:cDd:E:e:Ff:G:g:H:hIi:J:jK:kLlmMN:no:OpQ:qr:Rs:ST:t:U:uVvW:wX:xYy:z:!:@#$%^:&:*:(:):-_:=:+:[:]:{:}:;:";
     
     //================================================ Parsing the options
     while ( true )
@@ -2504,6 +2779,55 @@ void                       ProSHADE_settings::getCommandLineParams ( int argc, c
                  continue;
              }
                  
+             //======================================= Set the coarse-to-fine rotation function descriptor computation to true
+             case 'V':
+             {
+                 this->setRotationFunctionCoarseToFine ( true );
+                 continue;
+             }
+                 
+             //======================================= Set all-vs-all distances computation to true
+             case 'L':
+             {
+                 this->setAllVsAllDistances           ( true );
+                 continue;
+             }
+                 
+             //======================================= Save the argument as the maximum number of in-flight structures
+             case 'N':
+             {
+                 this->setMaxInFlightStructures       ( static_cast< proshade_unsign > ( atoi ( optarg ) ) );
+                 continue;
+             }
+                 
+             //======================================= Save the argument as the number of threads
+             case 'T':
+             {
+                 this->setNumberOfThreads             ( static_cast< proshade_unsign > ( atoi ( optarg ) ) );
+                 continue;
+             }
+                 
+             //======================================= Save the argument as the FFTW planning rigour
+             case 'Q':
+             {
+                 this->setFFTWPlanningRigour          ( static_cast< proshade_unsign > ( atoi ( optarg ) ) );
+                 continue;
+             }
+                 
+             //======================================= Save the argument as the FFTW wisdom file
+             case 'W':
+             {
+                 this->setFFTWWisdomFile              ( std::string ( optarg ) );
+                 continue;
+             }
+                 
+             //======================================= Save the argument as the inverse SO(3) transform implementation
+             case 'U':
+             {
+                 this->setInverseSOFTBackend          ( static_cast< proshade_unsign > ( atoi ( optarg ) ) );
+                 continue;
+             }
+                 
              //======================================= Save the argument as the energy levels descriptor weight value
              case '_':
              {
@@ -2676,6 +3000,20 @@ void                       ProSHADE_settings::getCommandLineParams ( int argc, c
                  continue;
              }
                  
+             //======================================= Save the argument as the map memory budget
+             case 'X':
+             {
+                 this->setMapMemoryBudget             ( static_cast< proshade_unsign > ( atoi ( optarg ) ) );
+                 continue;
+             }
+                 
+             //======================================= Should the maps be cropped to their density box when read?
+             case 'Y':
+             {
+                 this->setCropMapOnRead               ( true );
+                 continue;
+             }
+                 
              //======================================= Unknown option
              case '?':
              {
@@ -2751,6 +3089,14 @@ void                       ProSHADE_settings::printSettings ( )
     if ( this->removeNegativeDensity ) { strstr << "TRUE"; } else { strstr << "FALSE"; }
     printf ( "Remove neg. dens.   : %37s\n", strstr.str().c_str() );
     
+    strstr.str(std::string());
+    strstr << this->mapMemoryBudget;
+    printf ( "Map memory budget   : %37s\n", strstr.str().c_str() );
+    
+    strstr.str(std::string());
+    if ( this->cropMapOnRead ) { strstr << "TRUE"; } else { strstr << "FALSE"; }
+    printf ( "Crop map on read    : %37s\n", strstr.str().c_str() );
+    
     //== Settings regarding the resolution of calculations
     strstr.str(std::string());
     strstr << this->requestedResolution;
@@ -2932,6 +3278,18 @@ void                       ProSHADE_settings::printSettings ( )
     if ( this->computeRotationFuncDesc ) { strstr << "TRUE"; } else { strstr << "FALSE"; }
     printf ( "Full RF desc        : %37s\n", strstr.str().c_str() );
     
+    strstr.str(std::string());
+    if ( this->rotFunDescCoarseToFine ) { strstr << "TRUE"; } else { strstr << "FALSE"; }
+    printf ( "Coarse-to-fine RF   : %37s\n", strstr.str().c_str() );
+    
+    strstr.str(std::string());
+    if ( this->computeAllDistances ) { strstr << "TRUE"; } else { strstr << "FALSE"; }
+    printf ( "All-vs-all dists    : %37s\n", strstr.str().c_str() );
+    
+    strstr.str(std::string());
+    strstr << this->maxInFlightStructures;
+    printf ( "Max in-flight strs  : %37s\n", strstr.str().c_str() );
+    
     //== Settings regarding peak searching
     strstr.str(std::string());
     strstr << this->peakNeighbours;
@@ -3001,6 +3359,25 @@ void                       ProSHADE_settings::printSettings ( )
     strstr << this->verbose;
     printf ( "Verbosity           : %37s\n", strstr.str().c_str() );
     
+    //== Settings regarding parallel computation
+    strstr.str(std::string());
+    strstr << this->noThreads;
+    printf ( "Threads             : %37s\n", strstr.str().c_str() );
+    
+    //== Settings regarding FFTW planning
+    strstr.str(std::string());
+    strstr << this->fftwPlanningRigour;
+    printf ( "FFTW planning rigour: %37s\n", strstr.str().c_str() );
+    
+    strstr.str(std::string());
+    strstr << this->fftwWisdomFile;
+    printf ( "FFTW wisdom file    : %37s\n", strstr.str().c_str() );
+    
+    //== Settings regarding the inverse SO(3) Fourier transform
+    strstr.str(std::string());
+    strstr << this->invSOFTBackend;
+    printf ( "Inverse SOFT backend: %37s\n", strstr.str().c_str() );
+    
     //================================================ Done
     return ;
     
@@ -3048,6 +3425,57 @@ std::vector< proshade_double >                       ProSHADE_run::getRotationFu
     return                                            ( this->rotFun );
 }
 
+/*! \brief This function returns the energy levels distances matrix between all pairs of structures.
+ 
+    This matrix is only filled in when the all-vs-all distances computation was requested (see setAllVsAllDistances()), otherwise
+    an empty vector is returned.
+ 
+    \param[out] enLevsMatrix Vector of vectors of doubles of the distances, indexed by the structure input order.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+std::vector< std::vector< proshade_double > > __declspec(dllexport) ProSHADE_run::getEnergyLevelsMatrix ( )
+#else
+std::vector< std::vector< proshade_double > >                       ProSHADE_run::getEnergyLevelsMatrix ( )
+#endif
+{
+    //================================================ Return the value
+    return                                            ( this->enLevsMatrix );
+}
+
+/*! \brief This function returns the trace sigma distances matrix between all pairs of structures.
+ 
+    This matrix is only filled in when the all-vs-all distances computation was requested (see setAllVsAllDistances()), otherwise
+    an empty vector is returned.
+ 
+    \param[out] trSigmMatrix Vector of vectors of doubles of the distances, indexed by the structure input order.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+std::vector< std::vector< proshade_double > > __declspec(dllexport) ProSHADE_run::getTraceSigmaMatrix ( )
+#else
+std::vector< std::vector< proshade_double > >                       ProSHADE_run::getTraceSigmaMatrix ( )
+#endif
+{
+    //================================================ Return the value
+    return                                            ( this->trSigmMatrix );
+}
+
+/*! \brief This function returns the full rotation function distances matrix between all pairs of structures.
+ 
+    This matrix is only filled in when the all-vs-all distances computation was requested (see setAllVsAllDistances()), otherwise
+    an empty vector is returned.
+ 
+    \param[out] rotFunMatrix Vector of vectors of doubles of the distances, indexed by the structure input order.
+ */
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+std::vector< std::vector< proshade_double > > __declspec(dllexport) ProSHADE_run::getRotationFunctionMatrix ( )
+#else
+std::vector< std::vector< proshade_double > >                       ProSHADE_run::getRotationFunctionMatrix ( )
+#endif
+{
+    //================================================ Return the value
+    return                                            ( this->rotFunMatrix );
+}
+
 /*! \brief This function returns the number of structures used.
 
     \param[in] noStructures Number of structures supplied to the settings object.
@@ -46,6 +46,9 @@ private:
     std::vector < proshade_double > enLevs;           //!< Vector holding energy levels distances from the first to all other supplied structures.
     std::vector < proshade_double > trSigm;           //!< Vector holding trace sigma distances from the first to all other supplied structures.
     std::vector < proshade_double > rotFun;           //!< Vector holding full rotation function distances from the first to all other supplied structures.
+    std::vector < std::vector < proshade_double > > enLevsMatrix; //!< Matrix holding energy levels distances between all pairs of supplied structures (all-vs-all mode only).
+    std::vector < std::vector < proshade_double > > trSigmMatrix; //!< Matrix holding trace sigma distances between all pairs of supplied structures (all-vs-all mode only).
+    std::vector < std::vector < proshade_double > > rotFunMatrix; //!< Matrix holding full rotation function distances between all pairs of supplied structures (all-vs-all mode only).
     
     //================================================ Variables regarding re-boxing task
     std::vector < proshade_signed* > originalBounds;  //!< Original boundaries of the map.
@@ -95,10 +98,16 @@ public:
     std::vector< proshade_double > __declspec(dllexport) getEnergyLevelsVector ( void );
     std::vector< proshade_double > __declspec(dllexport) getTraceSigmaVector ( void );
     std::vector< proshade_double > __declspec(dllexport) getRotationFunctionVector  ( void );
+    std::vector< std::vector< proshade_double > > __declspec(dllexport) getEnergyLevelsMatrix ( void );
+    std::vector< std::vector< proshade_double > > __declspec(dllexport) getTraceSigmaMatrix ( void );
+    std::vector< std::vector< proshade_double > > __declspec(dllexport) getRotationFunctionMatrix ( void );
 #else
     std::vector< proshade_double > getEnergyLevelsVector ( void );
     std::vector< proshade_double > getTraceSigmaVector ( void );
     std::vector< proshade_double > getRotationFunctionVector  ( void );
+    std::vector< std::vector< proshade_double > > getEnergyLevelsMatrix ( void );
+    std::vector< std::vector< proshade_double > > getTraceSigmaMatrix ( void );
+    std::vector< std::vector< proshade_double > > getRotationFunctionMatrix ( void );
 #endif
 
     //================================================ Symmetry results accessor functions
@@ -165,22 +165,35 @@ ProSHADE_internal_data::ProSHADE_data::ProSHADE_data ( )
     this->noSpheres                                   = 0;
     this->spheres                                     = nullptr;
     this->sphericalHarmonics                          = nullptr;
+    this->sphericalHarmonicsArena                     = nullptr;
+    this->sphericalHarmonicsArenaSize                 = 0;
     this->rotSphericalHarmonics                       = nullptr;
+    this->shWorkspaces                                = nullptr;
     this->maxShellBand                                = 0;
     
     // ... Variables regarding shape distance computations
-    this->rrpMatrices                                 = nullptr;
+    this->rrpArena                                    = nullptr;
     this->eMatrices                                   = nullptr;
+    this->eMatricesArena                              = nullptr;
     this->so3Coeffs                                   = nullptr;
     this->so3CoeffsInverse                            = nullptr;
     this->wignerMatrices                              = nullptr;
     this->integrationWeight                           = 0.0;
+    this->comparisonIntegrationWeight                 = 0.0;
     this->maxEMatDim                                  = 0;
     this->translationMap                              = nullptr;
     
+    // ... Map processing
+    this->processingMapArena                          = nullptr;
+    this->processingCoeffsArena                       = nullptr;
+    this->processingMapArenaSize                      = 0;
+    this->processingCoeffsArenaSize                   = 0;
+    this->noMapPasses                                 = 0;
+    
     // ... Symmetry detectino
     this->recommendedSymmetryFold                     = 1;
     this->recommendedSymmetryType                     = 'C';
+    this->rotFunSphereGeometry                        = nullptr;
     
     // ... Control variables
     this->isEmpty                                     = true;
@@ -289,18 +302,33 @@ ProSHADE_internal_data::ProSHADE_data::ProSHADE_data ( std::string strName, doub
     this->noSpheres                                   = 0;
     this->spheres                                     = nullptr;
     this->sphericalHarmonics                          = nullptr;
+    this->sphericalHarmonicsArena                     = nullptr;
+    this->sphericalHarmonicsArenaSize                 = 0;
     this->rotSphericalHarmonics                       = nullptr;
+    this->shWorkspaces                                = nullptr;
     this->maxShellBand                                = 0;
     
     // ... Variables regarding shape distance computations
-    this->rrpMatrices                                 = nullptr;
+    this->rrpArena                                    = nullptr;
     this->eMatrices                                   = nullptr;
+    this->eMatricesArena                              = nullptr;
     this->so3Coeffs                                   = nullptr;
     this->so3CoeffsInverse                            = nullptr;
     this->wignerMatrices                              = nullptr;
     this->integrationWeight                           = 0.0;
+    this->comparisonIntegrationWeight                 = 0.0;
     this->maxEMatDim                                  = 0;
     this->translationMap                              = nullptr;
+    
+    // ... Map processing
+    this->processingMapArena                          = nullptr;
+    this->processingCoeffsArena                       = nullptr;
+    this->processingMapArenaSize                      = 0;
+    this->processingCoeffsArenaSize                   = 0;
+    this->noMapPasses                                 = 0;
+    
+    // ... Symmetry detection
+    this->rotFunSphereGeometry                        = nullptr;
         
     // ... Control variables
     this->isEmpty                                     = false;
@@ -374,19 +402,21 @@ ProSHADE_internal_data::ProSHADE_data::~ProSHADE_data ( )
         delete[] this->spheres;
     }
     
-    //================================================ Release the spherical harmonics
+    //================================================ Release the spherical harmonics (all shells are in a single block)
     if ( this->sphericalHarmonics != nullptr )
     {
-        for ( proshade_unsign iter = 0; iter < this->noSpheres; iter++ )
-        {
-            if ( this->sphericalHarmonics[iter] != nullptr )
-            {
-                delete[] this->sphericalHarmonics[iter];
-                this->sphericalHarmonics[iter]        = nullptr;
-            }
-        }
         delete[] this->sphericalHarmonics;
     }
+    if ( this->sphericalHarmonicsArena != nullptr )
+    {
+        fftw_free                                     ( this->sphericalHarmonicsArena );
+    }
+    
+    //================================================ Release the spherical harmonics workspaces
+    if ( this->shWorkspaces != nullptr )
+    {
+        delete this->shWorkspaces;
+    }
     
     //================================================ Release the rotated spherical harmonics
     if ( this->rotSphericalHarmonics != nullptr )
@@ -403,50 +433,21 @@ ProSHADE_internal_data::ProSHADE_data::~ProSHADE_data ( )
     }
     
     //================================================ Release the RRP matrices (pre-computation for the energy levels descriptor)
-    if ( this->rrpMatrices != nullptr )
+    if ( this->rrpArena != nullptr )
     {
-        for ( proshade_unsign bwIt = 0; bwIt < this->maxShellBand; bwIt++ )
-        {
-            if ( this->rrpMatrices[bwIt] != nullptr )
-            {
-                for ( proshade_unsign shIt = 0; shIt < this->noSpheres; shIt++ )
-                {
-                    if ( this->rrpMatrices[bwIt][shIt] != nullptr )
-                    {
-                        delete[] this->rrpMatrices[bwIt][shIt];
-                        this->rrpMatrices[bwIt][shIt]  = nullptr;
-                    }
-                }
-                
-                delete[] this->rrpMatrices[bwIt];
-            }
-        }
-        
-        delete[] this->rrpMatrices;
+        fftw_free                                     ( this->rrpArena );
     }
     
     //================================================ Release the E matrices
     if ( this->eMatrices != nullptr )
     {
-        for ( proshade_unsign bandIter = 0; bandIter < this->getEMatDim ( ); bandIter++ )
-        {
-            if ( this->eMatrices[bandIter] != nullptr )
-            {
-                for ( proshade_unsign band2Iter = 0; band2Iter < static_cast<proshade_unsign> ( ( bandIter * 2 ) + 1 ); band2Iter++ )
-                {
-                    if ( this->eMatrices[bandIter][band2Iter] != nullptr )
-                    {
-                        delete[] this->eMatrices[bandIter][band2Iter];
-                        this->eMatrices[bandIter][band2Iter] = nullptr;
-                    }
-                }
-                
-                delete[] this->eMatrices[bandIter];
-            }
-        }
-        
+        delete[] this->eMatrices[0];
         delete[] this->eMatrices;
     }
+    if ( this->eMatricesArena != nullptr )
+    {
+        fftw_free                                     ( this->eMatricesArena );
+    }
     
     //================================================ Release SOFT and inverse SOFT coefficients
     if ( this->so3Coeffs != nullptr )
@@ -484,6 +485,9 @@ ProSHADE_internal_data::ProSHADE_data::~ProSHADE_data ( )
         fftw_free                                     ( this->translationMap );
     }
     
+    //================================================ Release the map processing scratch blocks
+    this->releaseProcessingArenas                     ( );
+    
     //================================================ Release the angle-axis space rotation function
     if ( this->sphereMappedRotFun.size() > 0 )
     {
@@ -492,6 +496,10 @@ ProSHADE_internal_data::ProSHADE_data::~ProSHADE_data ( )
             delete this->sphereMappedRotFun.at(spIt);
         }
     }
+    if ( this->rotFunSphereGeometry != nullptr )
+    {
+        delete this->rotFunSphereGeometry;
+    }
     
     //================================================ Release symmetry result holders
     for ( size_t vIt = 0; vIt < this->cyclicSymmetries.size();          vIt++ ) { if ( this->cyclicSymmetries.at(vIt)               != nullptr ) { delete[] this->cyclicSymmetries.at(vIt);          } }
@@ -634,15 +642,36 @@ void ProSHADE_internal_data::ProSHADE_data::readInStructure ( gemmi::Structure*
  */
 void ProSHADE_internal_data::ProSHADE_data::readInMAP ( ProSHADE_settings* settings, proshade_double* maskArr, proshade_unsign maskXDim, proshade_unsign maskYDim, proshade_unsign maskZDim, proshade_double* weightsArr, proshade_unsign weigXDim, proshade_unsign weigYDim, proshade_unsign weigZDim )
 {
-    //================================================ Open the file
-    gemmi::Ccp4<float> map;
-    map.read_ccp4                                     ( gemmi::MaybeGzipped ( this->fileName.c_str() ) );
-    
-    //================================================ Convert to XYZ and create complete map, if need be
-    map.setup                                         ( 0.0f, gemmi::MapSetup::ReorderOnly );
-    
-    //================================================ Read in the rest of the map file header
-    ProSHADE_internal_io::readInMapHeader             ( &map,
+    //================================================ Read uncompressed floating point maps directly from the memory mapped file
+    bool mapRead                                      = ProSHADE_internal_io::readInMapMemoryMapped ( this->fileName, this->internalMap,
+                                                                                                      &this->xDimIndices,  &this->yDimIndices,  &this->zDimIndices,
+                                                                                                      &this->xDimSize,     &this->yDimSize,     &this->zDimSize,
+                                                                                                      &this->aAngle,       &this->bAngle,       &this->cAngle,
+                                                                                                      &this->xFrom,        &this->yFrom,        &this->zFrom,
+                                                                                                      &this->xAxisOrigin,  &this->yAxisOrigin,  &this->zAxisOrigin,
+                                                                                                      &this->xAxisOrder,   &this->yAxisOrder,   &this->zAxisOrder,
+                                                                                                      &this->xGridIndices, &this->yGridIndices, &this->zGridIndices,
+                                                                                                      settings->noThreads, static_cast< size_t > ( settings->mapMemoryBudget ) * 1024 * 1024,
+                                                                                                      settings->cropMapOnRead, settings->maskingThresholdIQRs, settings->verbose, settings->messageShift );
+    
+    //================================================ Otherwise, use gemmi
+    if ( !mapRead )
+    {
+        //============================================ The gemmi reader holds the whole map, so neither the memory budget nor the cropping can be applied
+        if ( ( settings->mapMemoryBudget > 0 ) || settings->cropMapOnRead )
+        {
+            ProSHADE_internal_messages::printWarningMessage ( settings->verbose, "!!! ProSHADE WARNING !!! The map file cannot be memory mapped (it is compressed, not in mode 2, not in the native byte order or memory mapping is not available), the map memory budget and the cropping on read will not be applied.", "WM00081" );
+        }
+        
+        //============================================ Open the file
+        gemmi::Ccp4<float> map;
+        map.read_ccp4                                 ( gemmi::MaybeGzipped ( this->fileName.c_str() ) );
+        
+        //============================================ Convert to XYZ and create complete map, if need be
+        map.setup                                     ( 0.0f, gemmi::MapSetup::ReorderOnly );
+        
+        //============================================ Read in the rest of the map file header
+        ProSHADE_internal_io::readInMapHeader         ( &map,
                                                         &this->xDimIndices,  &this->yDimIndices,  &this->zDimIndices,
                                                         &this->xDimSize,     &this->yDimSize,     &this->zDimSize,
                                                         &this->aAngle,       &this->bAngle,       &this->cAngle,
@@ -650,9 +679,10 @@ void ProSHADE_internal_data::ProSHADE_data::readInMAP ( ProSHADE_settings* setti
                                                         &this->xAxisOrigin,  &this->yAxisOrigin,  &this->zAxisOrigin,
                                                         &this->xAxisOrder,   &this->yAxisOrder,   &this->zAxisOrder,
                                                         &this->xGridIndices, &this->yGridIndices, &this->zGridIndices );
-    
-    //================================================ Save the map density to ProSHADE variable
-    ProSHADE_internal_io::readInMapData               ( &map, this->internalMap, this->xDimIndices, this->yDimIndices, this->zDimIndices, this->xAxisOrder, this->yAxisOrder, this->zAxisOrder );
+        
+        //============================================ Save the map density to ProSHADE variable
+        ProSHADE_internal_io::readInMapData           ( &map, this->internalMap, this->xDimIndices, this->yDimIndices, this->zDimIndices, this->xAxisOrder, this->yAxisOrder, this->zAxisOrder );
+    }
         
     //================================================ If mask is supplied and the correct task is used
     ProSHADE_internal_io::applyMask                   ( this->internalMap, settings->appliedMaskFileName, this->xDimIndices, this->yDimIndices, this->zDimIndices, settings->verbose, settings->messageShift, &settings->calcBounds,
@@ -1096,8 +1126,10 @@ void ProSHADE_internal_data::ProSHADE_data::writeMask ( std::string fName, prosh
     know which position you want, for example, symmetry to be computed over.
  
     \param[in] settings A pointer to settings class containing all the information required for processing of the map.
+    \param[in] addRotationCentreShift Should the shift of the shiftToRotationCentre() function be done as part of this shift? If so, the shiftToRotationCentre()
+    function should then be called with moveMap set to false, so that only its book-keeping is done.
  */
-void ProSHADE_internal_data::ProSHADE_data::shiftToBoxCentre ( ProSHADE_settings* settings )
+void ProSHADE_internal_data::ProSHADE_data::shiftToBoxCentre ( ProSHADE_settings* settings, bool addRotationCentreShift )
 {
     //================================================ Report function start
     std::stringstream ss;
@@ -1135,7 +1167,16 @@ void ProSHADE_internal_data::ProSHADE_data::shiftToBoxCentre ( ProSHADE_settings
         ProSHADE_internal_messages::printWarningMessage ( settings->verbose, "!!! ProSHADE WARNING !!! Requested box centre to be co-ordinate position outside of co-ordinates range. Please re-view the requested box centre position.", "WM00068" );
     }
     
+    //================================================ If required, add the rotation centre shift, so that both translations are done by a single Fourier transform pair
+    if ( addRotationCentreShift )
+    {
+        xShift                                       -= settings->centrePosition.at(0);
+        yShift                                       -= settings->centrePosition.at(1);
+        zShift                                       -= settings->centrePosition.at(2);
+    }
+    
     //================================================ Do the shift
+    fftw_complex* coeffsScratch                       = this->getProcessingCoeffsArena ( static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * ( ( static_cast< size_t > ( this->zDimIndices ) / 2 ) + 1 ) );
     ProSHADE_internal_mapManip::moveMapByFourier      ( this->internalMap,
                                                         static_cast< proshade_single > ( xShift ),
                                                         static_cast< proshade_single > ( yShift ),
@@ -1143,7 +1184,8 @@ void ProSHADE_internal_data::ProSHADE_data::shiftToBoxCentre ( ProSHADE_settings
                                                         this->xDimSize, this->yDimSize, this->zDimSize,
                                                         static_cast< proshade_signed > ( this->xDimIndices ),
                                                         static_cast< proshade_signed > ( this->yDimIndices ),
-                                                        static_cast< proshade_signed > ( this->zDimIndices ) );
+                                                        static_cast< proshade_signed > ( this->zDimIndices ), coeffsScratch );
+    this->noMapPasses                                += 2;
     
     //================================================ Report function completion
     std::stringstream ss2;
@@ -1161,8 +1203,9 @@ void ProSHADE_internal_data::ProSHADE_data::shiftToBoxCentre ( ProSHADE_settings
     map and proceeds to shift the map so that these two positions would be the same.
  
     \param[in] settings A pointer to settings class containing all the information required for processing of the map.
+    \param[in] moveMap Should the map be moved? If false, only the shift is recorded, as the map has already been moved (see shiftToBoxCentre()).
  */
-void ProSHADE_internal_data::ProSHADE_data::shiftToRotationCentre ( ProSHADE_settings* settings )
+void ProSHADE_internal_data::ProSHADE_data::shiftToRotationCentre ( ProSHADE_settings* settings, bool moveMap )
 {
     //================================================ Report function start
     std::stringstream ss;
@@ -1170,14 +1213,19 @@ void ProSHADE_internal_data::ProSHADE_data::shiftToRotationCentre ( ProSHADE_set
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 1, ss.str(), settings->messageShift );
     
     //================================================ Do the shift
-    ProSHADE_internal_mapManip::moveMapByFourier      ( this->internalMap,
+    if ( moveMap )
+    {
+        fftw_complex* coeffsScratch                   = this->getProcessingCoeffsArena ( static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * ( ( static_cast< size_t > ( this->zDimIndices ) / 2 ) + 1 ) );
+        ProSHADE_internal_mapManip::moveMapByFourier  ( this->internalMap,
                                                         static_cast< proshade_single > ( -settings->centrePosition.at(0) ),
                                                         static_cast< proshade_single > ( -settings->centrePosition.at(1) ),
                                                         static_cast< proshade_single > ( -settings->centrePosition.at(2) ),
                                                         this->xDimSize, this->yDimSize, this->zDimSize,
                                                         static_cast< proshade_signed > ( this->xDimIndices ),
                                                         static_cast< proshade_signed > ( this->yDimIndices ),
-                                                        static_cast< proshade_signed > ( this->zDimIndices ) );
+                                                        static_cast< proshade_signed > ( this->zDimIndices ), coeffsScratch );
+        this->noMapPasses                            += 2;
+    }
     
     //================================================ Save the shift
     this->mapCOMProcessChangeX                       += settings->centrePosition.at(0);
@@ -1205,7 +1253,8 @@ void ProSHADE_internal_data::ProSHADE_data::shiftToRotationCentre ( ProSHADE_set
  
     This function switches all index values along the three axes from 0 ... max to max ... 0. This should not
     normally be done, but in the case where the wrong hand has been used in the map re-construction process, this
-    may be helpful.
+    may be helpful. As the map is stored with the z axis being the fastest, inverting all three axes is the same as
+    reversing the order of the map array, which is done in place.
  
     \param[in] settings A pointer to settings class containing all the information required for reading in the map.
  */
@@ -1214,38 +1263,10 @@ void ProSHADE_internal_data::ProSHADE_data::invertMirrorMap ( ProSHADE_settings*
     //================================================ Report function start
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 1, "Map inversion.", settings->messageShift );
     
-    //================================================ Initialise variables
-    proshade_signed arrayPos, invPos;
-    
-    //================================================ Create helper map
-    proshade_double* hlpMap                           = new proshade_double [this->xDimIndices * this->yDimIndices * this->zDimIndices];
-    ProSHADE_internal_misc::checkMemoryAllocation     ( hlpMap, __FILE__, __LINE__, __func__ );
-    
-    //================================================ Save map values to the helper map
-    for ( proshade_unsign iter = 0; iter < ( this->xDimIndices * this->yDimIndices * this->zDimIndices ); iter++ )
-    {
-        hlpMap[iter]                                  = this->internalMap[iter];
-    }
-    
-    //================================================ Invert the values
-    for ( proshade_signed xIt = 0; xIt < static_cast<proshade_signed> ( this->xDimIndices ); xIt++ )
-    {
-        for ( proshade_signed yIt = 0; yIt < static_cast<proshade_signed> ( this->yDimIndices ); yIt++ )
-        {
-            for ( proshade_signed zIt = 0; zIt < static_cast<proshade_signed> ( this->zDimIndices ); zIt++ )
-            {
-                //==================================== Var init
-                arrayPos                              = zIt + static_cast< proshade_signed > ( this->zDimIndices ) * ( yIt + static_cast< proshade_signed > ( this->yDimIndices ) * xIt );
-                invPos                                = ( static_cast< proshade_signed > ( this->zDimIndices - 1 ) - zIt ) + static_cast< proshade_signed > ( this->zDimIndices ) * ( ( static_cast< proshade_signed > ( this->yDimIndices - 1 ) - yIt ) + static_cast< proshade_signed > ( this->yDimIndices ) * ( static_cast< proshade_signed > ( this->xDimIndices - 1 ) - xIt ) );
-                
-                //==================================== And save
-                this->internalMap[invPos]             = hlpMap[arrayPos];
-            }
-        }
-    }
-    
-    //================================================ Release memory
-    delete[] hlpMap;
+    //================================================ Invert the values (position x, y, z moves to position ( xDim - 1 - x ), ( yDim - 1 - y ), ( zDim - 1 - z ), i.e. array position i moves to ( size - 1 - i ))
+    size_t mapSize                                    = static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * static_cast< size_t > ( this->zDimIndices );
+    std::reverse                                      ( this->internalMap, this->internalMap + mapSize );
+    this->noMapPasses                                += 1;
     
     //================================================ Report function completion
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Map inversion completed.", settings->messageShift );
@@ -1268,33 +1289,66 @@ void ProSHADE_internal_data::ProSHADE_data::normaliseMap ( ProSHADE_settings* se
     //================================================ Report function start
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 1, "Map normalisation.", settings->messageShift );
     
-    //================================================ Initialise vector of map values
-    std::vector<proshade_double> mapVals              ( this->xDimIndices * this->yDimIndices * this->zDimIndices, 0.0 );
+    //================================================ Get mean and sd
+    size_t mapSize                                    = static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * static_cast< size_t > ( this->zDimIndices );
+    proshade_double* meanSD                           = new proshade_double[2];
+    ProSHADE_internal_misc::checkMemoryAllocation     ( meanSD, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_maths::arrayMeanAndSD           ( this->internalMap, mapSize, meanSD );
     
-    //================================================ Get all map values
-    for ( proshade_unsign iter = 0; iter < ( this->xDimIndices * this->yDimIndices * this->zDimIndices ); iter++ )
+    //================================================ Normalise the values
+    for ( size_t iter = 0; iter < mapSize; iter++ )
     {
-        mapVals.at(iter)                              = this->internalMap[iter];
+        this->internalMap[iter]                       = ( this->internalMap[iter] - meanSD[0] ) / meanSD[1];
     }
+    this->noMapPasses                                += 2;
+    
+    //================================================ Release memory
+    delete[] meanSD;
+    
+    //================================================ Report function completion
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Map normalisation completed.", settings->messageShift );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Function for inverting the map to its mirror image and normalising it in a single pass.
+ 
+    This function gives the same result as calling the invertMirrorMap() and normaliseMap() functions one after the other (up to
+    the order of summation of the map values), but as the inversion only re-orders the map values and therefore does not change
+    their mean and standard deviation, the statistics are computed first and each pair of values swapped by the inversion is
+    then normalised as it is swapped.
+ 
+    \param[in] settings A pointer to settings class containing all the information required for reading in the map.
+ */
+void ProSHADE_internal_data::ProSHADE_data::invertAndNormaliseMap ( ProSHADE_settings* settings )
+{
+    //================================================ Report function start
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 1, "Map inversion and normalisation.", settings->messageShift );
     
     //================================================ Get mean and sd
+    size_t mapSize                                    = static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * static_cast< size_t > ( this->zDimIndices );
     proshade_double* meanSD                           = new proshade_double[2];
-    ProSHADE_internal_maths::vectorMeanAndSD          ( &mapVals, meanSD );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( meanSD, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_maths::arrayMeanAndSD           ( this->internalMap, mapSize, meanSD );
     
-    //================================================ Normalise the values
-    for ( proshade_unsign iter = 0; iter < ( this->xDimIndices * this->yDimIndices * this->zDimIndices ); iter++ )
+    //================================================ Swap and normalise the values (array position i moves to ( size - 1 - i ))
+    proshade_double hlpVal;
+    for ( size_t iter = 0; iter < ( mapSize / 2 ); iter++ )
     {
-        this->internalMap[iter]                       = ( this->internalMap[iter] - meanSD[0] ) / meanSD[1];
+        hlpVal                                        = this->internalMap[iter];
+        this->internalMap[iter]                       = ( this->internalMap[mapSize - 1 - iter] - meanSD[0] ) / meanSD[1];
+        this->internalMap[mapSize - 1 - iter]         = ( hlpVal - meanSD[0] ) / meanSD[1];
     }
-    
-    //================================================ Clear the vector
-    mapVals.clear                                     ( );
+    if ( ( mapSize % 2 ) == 1 ) { this->internalMap[mapSize / 2] = ( this->internalMap[mapSize / 2] - meanSD[0] ) / meanSD[1]; }
+    this->noMapPasses                                += 2;
     
     //================================================ Release memory
     delete[] meanSD;
     
     //================================================ Report function completion
-    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Map normalisation completed.", settings->messageShift );
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Map inversion and normalisation completed.", settings->messageShift );
     
     //================================================ Done
     return ;
@@ -1315,23 +1369,22 @@ void ProSHADE_internal_data::ProSHADE_data::maskMap ( ProSHADE_settings* setting
     //================================================ Report function start
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 1, "Computing mask.", settings->messageShift );
     
-    //================================================ Initialise the blurred map
-    proshade_double* blurredMap                       = new proshade_double[this->xDimIndices * this->yDimIndices * this->zDimIndices];
-    ProSHADE_internal_misc::checkMemoryAllocation ( blurredMap, __FILE__, __LINE__, __func__ );
+    //================================================ Get the blurred map and Fourier coefficients scratch memory
+    size_t mapSize                                    = static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * static_cast< size_t > ( this->zDimIndices );
+    proshade_double* blurredMap                       = this->getProcessingMapArena ( mapSize );
+    fftw_complex* coeffsScratch                       = this->getProcessingCoeffsArena ( static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * ( ( static_cast< size_t > ( this->zDimIndices ) / 2 ) + 1 ) );
     
     //================================================ Compute blurred map
     ProSHADE_internal_mapManip::blurSharpenMap        ( this->internalMap, blurredMap, this->xDimIndices, this->yDimIndices, this->zDimIndices,
-                                                        this->xDimSize, this->yDimSize, this->zDimSize, settings->blurFactor );
+                                                        this->xDimSize, this->yDimSize, this->zDimSize, settings->blurFactor, coeffsScratch );
+    this->noMapPasses                                += 1;
     
     //================================================ Compute mask from blurred map and save it into the original map
-    ProSHADE_internal_mapManip::getMaskFromBlurr      ( blurredMap, this->internalMap, this->xDimIndices, this->yDimIndices, this->zDimIndices, settings->maskingThresholdIQRs );
+    ProSHADE_internal_mapManip::getMaskFromBlurr      ( blurredMap, this->internalMap, this->xDimIndices, this->yDimIndices, this->zDimIndices, settings->maskingThresholdIQRs, settings->noThreads, &this->noMapPasses );
     
     //================================================ Print the mask if need be
     if ( settings->saveMask ) {  if ( settings->maskFileName == "" ) { this->writeMask ( "proshade_mask.map", blurredMap ); } else { std::stringstream ss; ss << settings->maskFileName << "_" << this->inputOrder << ".map"; this->writeMask ( ss.str(), blurredMap ); } }
     
-    //================================================ Release memory
-    delete[] blurredMap;
-    
     //================================================ Report function completion
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Mask computed.", settings->messageShift );
     
@@ -1503,7 +1556,7 @@ void ProSHADE_internal_data::ProSHADE_data::reSampleMap ( ProSHADE_settings* set
     {
         ProSHADE_internal_mapManip::reSampleMapToResolutionTrilinear ( this->internalMap, settings->requestedResolution * settings->resolutionOversampling,
                                                                        this->xDimIndices, this->yDimIndices, this->zDimIndices,
-                                                                       this->xDimSize, this->yDimSize, this->zDimSize, changeVals );
+                                                                       this->xDimSize, this->yDimSize, this->zDimSize, changeVals, settings->noThreads );
 
     }
     
@@ -1555,8 +1608,10 @@ void ProSHADE_internal_data::ProSHADE_data::reSampleMap ( ProSHADE_settings* set
     messy.
  
     \param[in] settings A pointer to settings class containing all the information required for map manipulation.
+    \param[in] moveMap Should the map be moved? If false, only the shift is recorded - this is useful when the phases are to be removed next, as
+    the resulting Patterson map does not depend on the map position.
  */
-void ProSHADE_internal_data::ProSHADE_data::centreMapOnCOM ( ProSHADE_settings* settings )
+void ProSHADE_internal_data::ProSHADE_data::centreMapOnCOM ( ProSHADE_settings* settings, bool moveMap )
 {
     //================================================ Sanity check
     if ( !( ( std::isinf ( settings->centrePosition.at(0) ) ) || ( std::isinf ( settings->centrePosition.at(1) ) ) || ( std::isinf ( settings->centrePosition.at(2) ) ) ) )
@@ -1578,6 +1633,7 @@ void ProSHADE_internal_data::ProSHADE_data::centreMapOnCOM ( ProSHADE_settings*
     ProSHADE_internal_mapManip::findMAPCOMValues      ( this->internalMap, &xCOM, &yCOM, &zCOM,
                                                         this->xDimSize, this->yDimSize, this->zDimSize, this->xFrom,
                                                         this->xTo, this->yFrom, this->yTo, this->zFrom, this->zTo, settings->removeNegativeDensity );
+    this->noMapPasses                                += 1;
     
     //================================================ Find the sampling rates
     proshade_single xSampRate                         = static_cast< proshade_single > ( this->xDimSize ) / static_cast< proshade_single > ( this->xTo - this->xFrom + 1 );
@@ -1599,14 +1655,19 @@ void ProSHADE_internal_data::ProSHADE_data::centreMapOnCOM ( ProSHADE_settings*
     proshade_double zDist                             = ( ( static_cast<proshade_double> ( this->zDimIndices ) / 2.0 ) - zCOM ) * static_cast<proshade_double> ( this->zDimSize ) / static_cast<proshade_double> ( this->zDimIndices );
     
     //================================================ Move the map within the box
-    ProSHADE_internal_mapManip::moveMapByFourier      ( this->internalMap,
+    if ( moveMap )
+    {
+        fftw_complex* coeffsScratch                   = this->getProcessingCoeffsArena ( static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * ( ( static_cast< size_t > ( this->zDimIndices ) / 2 ) + 1 ) );
+        ProSHADE_internal_mapManip::moveMapByFourier  ( this->internalMap,
                                                         static_cast< proshade_single > ( xDist ),
                                                         static_cast< proshade_single > ( yDist ),
                                                         static_cast< proshade_single > ( zDist ),
                                                         this->xDimSize, this->yDimSize, this->zDimSize,
                                                         static_cast< proshade_signed > ( this->xDimIndices ),
                                                         static_cast< proshade_signed > ( this->yDimIndices ),
-                                                        static_cast< proshade_signed > ( this->zDimIndices ) );
+                                                        static_cast< proshade_signed > ( this->zDimIndices ), coeffsScratch );
+        this->noMapPasses                            += 2;
+    }
     
     //================================================ Note the change due to centering
     this->mapCOMProcessChangeX                       -= xDist;
@@ -1670,51 +1731,37 @@ void ProSHADE_internal_data::ProSHADE_data::addExtraSpace ( ProSHADE_settings* s
     proshade_double* newMap                           = new proshade_double[this->xDimIndices * this->yDimIndices * this->zDimIndices];
     ProSHADE_internal_misc::checkMemoryAllocation     ( newMap, __FILE__, __LINE__, __func__ );
     
-    //================================================ Set new map to zeroes
-    for ( proshade_unsign iter = 0; iter < ( this->xDimIndices * this->yDimIndices * this->zDimIndices ); iter++ )
-    {
-        newMap[iter]                                  = 0.0;
-    }
-    
-    //================================================ Update the map
+    //================================================ Fill the new map in a single pass (the extra space is set to zero, the rest is copied from the old map)
     proshade_unsign newMapIndex, oldMapIndex;
-    for ( proshade_unsign xIt = 0; xIt < (this->xDimIndices - xAddIndices); xIt++ )
+    for ( proshade_unsign xIt = 0; xIt < this->xDimIndices; xIt++ )
     {
-        //============================================ Check if point is applicable
-        if ( xIt < xAddIndices ) { continue; }
-        
-        for ( proshade_unsign yIt = 0; yIt < (this->yDimIndices - yAddIndices); yIt++ )
+        for ( proshade_unsign yIt = 0; yIt < this->yDimIndices; yIt++ )
         {
-            //======================================== Check if point is applicable
-            if ( yIt < yAddIndices ) { continue; }
-            
-            for ( proshade_unsign zIt = 0; zIt < (this->zDimIndices - zAddIndices); zIt++ )
+            for ( proshade_unsign zIt = 0; zIt < this->zDimIndices; zIt++ )
             {
-                //==================================== Check if point is applicable
-                if ( zIt < zAddIndices ) { continue; }
-                
                 //==================================== Var init
                 newMapIndex                           = zIt + this->zDimIndices * ( yIt + this->yDimIndices * xIt );
-                oldMapIndex                           = (zIt - zAddIndices) + (this->zDimIndices - ( 2 * zAddIndices ) ) * ( (yIt - yAddIndices) + (this->yDimIndices - ( 2 * yAddIndices ) ) * (xIt - xAddIndices) );
                 
+                //==================================== Check if point is in the extra space
+                if ( ( xIt < xAddIndices ) || ( xIt >= ( this->xDimIndices - xAddIndices ) ) ||
+                     ( yIt < yAddIndices ) || ( yIt >= ( this->yDimIndices - yAddIndices ) ) ||
+                     ( zIt < zAddIndices ) || ( zIt >= ( this->zDimIndices - zAddIndices ) ) )
+                {
+                    newMap[newMapIndex]               = 0.0;
+                    continue;
+                }
+                
+                //==================================== Copy
+                oldMapIndex                           = (zIt - zAddIndices) + (this->zDimIndices - ( 2 * zAddIndices ) ) * ( (yIt - yAddIndices) + (this->yDimIndices - ( 2 * yAddIndices ) ) * (xIt - xAddIndices) );
                 newMap[newMapIndex]                   = this->internalMap[oldMapIndex];
             }
         }
     }
+    this->noMapPasses                                += 1;
     
-    //================================================ Copy new to old
+    //================================================ Replace the old map by the new one
     delete[] this->internalMap;
-    
-    this->internalMap                                 = new proshade_double[this->xDimIndices * this->yDimIndices * this->zDimIndices];
-    ProSHADE_internal_misc::checkMemoryAllocation     ( this->internalMap, __FILE__, __LINE__, __func__ );
-    
-    for ( proshade_unsign iter = 0; iter < ( this->xDimIndices * this->yDimIndices * this->zDimIndices ); iter++ )
-    {
-        this->internalMap[iter]                       = newMap[iter];
-    }
-    
-    //================================================ Release memory
-    delete[] newMap;
+    this->internalMap                                 = newMap;
     
     //================================================ Report function completion
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Extra space added.", settings->messageShift );
@@ -1731,6 +1778,13 @@ void ProSHADE_internal_data::ProSHADE_data::addExtraSpace ( ProSHADE_settings* s
     are ultimately driven by the settings. This function also shifts the map so that its centre of box is at the desired
     position.
  
+    The stages to be run are planned from the settings first, so that stages which can share a pass over the map are
+    merged: the box centre and rotation centre translations are done by a single Fourier transform pair, map inversion
+    is done while normalising and the COM centering translation is only recorded (and not applied) when the phases are
+    to be removed, as the Patterson map does not depend on the map position. All Fourier space stages share the same
+    scratch memory, which is released at the end. The number of full map passes done is then reported and can be
+    obtained by the getNoMapPasses() function.
+ 
     This function also does some internal value saving and auto-determination of any parameters that the user did not
     supply. This, however, means, that this function MUST be called for every structure that is to be processed by
     ProSHADE. This is of importance to people whe want to use only a perticular functions.
@@ -1741,28 +1795,37 @@ void ProSHADE_internal_data::ProSHADE_data::addExtraSpace ( ProSHADE_settings* s
  */
 void ProSHADE_internal_data::ProSHADE_data::processInternalMap ( ProSHADE_settings* settings )
 {
-    //================================================ Move given point to box centre
-    if ( !( ( std::isinf ( settings->boxCentre.at(0) ) ) || ( std::isinf ( settings->boxCentre.at(1) ) ) || ( std::isinf ( settings->boxCentre.at(2) ) ) ) ) { this->shiftToBoxCentre ( settings ); }
+    //================================================ Plan the stages
+    bool shiftBoxCentre                               = !( ( std::isinf ( settings->boxCentre.at(0) ) ) || ( std::isinf ( settings->boxCentre.at(1) ) ) || ( std::isinf ( settings->boxCentre.at(2) ) ) );
+    bool shiftRotationCentre                          = !( ( std::isinf ( settings->centrePosition.at(0) ) ) || ( std::isinf ( settings->centrePosition.at(1) ) ) || ( std::isinf ( settings->centrePosition.at(2) ) ) );
+    bool fuseInvertNormalise                          = settings->invertMap && settings->normaliseMap;
+    this->noMapPasses                                 = 0;
+    
+    //================================================ Move given point to box centre (together with the rotation centre shift, if required)
+    if ( shiftBoxCentre ) { this->shiftToBoxCentre ( settings, shiftRotationCentre ); }
     else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Map left at original position.", settings->messageShift ); }
     
     //================================================ Shift map to centre of rotation if so required
-    if ( !( ( std::isinf ( settings->centrePosition.at(0) ) ) || ( std::isinf ( settings->centrePosition.at(1) ) ) || ( std::isinf ( settings->centrePosition.at(2) ) ) ) ) { this->shiftToRotationCentre ( settings ); }
+    if ( shiftRotationCentre ) { this->shiftToRotationCentre ( settings, !shiftBoxCentre ); }
     else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Map rotation centre not shifted.", settings->messageShift ); }
     
+    //================================================ Invert and normalise map in a single pass
+    if ( fuseInvertNormalise ) { this->invertAndNormaliseMap ( settings ); }
+    
     //================================================ Invert map
-    if ( settings->invertMap ) { this->invertMirrorMap ( settings ); }
-    else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Map inversion (mirror image) not requested.", settings->messageShift ); }
+    if ( settings->invertMap && !fuseInvertNormalise ) { this->invertMirrorMap ( settings ); }
+    else if ( !settings->invertMap ) { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Map inversion (mirror image) not requested.", settings->messageShift ); }
     
     //================================================ Normalise map
-    if ( settings->normaliseMap ) { this->normaliseMap ( settings ); }
-    else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Map normalisation not requested.", settings->messageShift ); }
+    if ( settings->normaliseMap && !fuseInvertNormalise ) { this->normaliseMap ( settings ); }
+    else if ( !settings->normaliseMap ) { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Map normalisation not requested.", settings->messageShift ); }
 
     //================================================ Compute mask
     if ( settings->maskMap ) { this->maskMap ( settings ); }
     else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Masking not requested.", settings->messageShift ); }
     
-    //================================================ Centre map
-    if ( settings->moveToCOM ) { this->centreMapOnCOM ( settings ); }
+    //================================================ Centre map (only recording the shift if the phase is to be removed)
+    if ( settings->moveToCOM ) { this->centreMapOnCOM ( settings, settings->usePhase ); }
     else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Map centering not requested.", settings->messageShift ); }
     
     //================================================ Remove phase, if required
@@ -1773,6 +1836,14 @@ void ProSHADE_internal_data::ProSHADE_data::processInternalMap ( ProSHADE_settin
     if ( settings->addExtraSpace != 0.0f ) { this->addExtraSpace ( settings ); }
     else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Extra space not requested.", settings->messageShift ); }
     
+    //================================================ Release the processing scratch memory
+    this->releaseProcessingArenas                     ( );
+    
+    //================================================ Report the number of map passes
+    std::stringstream hlpSS;
+    hlpSS << "Map processing required " << this->noMapPasses << " full map passes.";
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, hlpSS.str(), settings->messageShift );
+    
     //================================================ Set settings values which were left on AUTO by user and will not be set later
     settings->setVariablesLeftOnAuto                  ( );
 
@@ -1781,6 +1852,73 @@ void ProSHADE_internal_data::ProSHADE_data::processInternalMap ( ProSHADE_settin
     
 }
 
+/*! \brief This function returns the map sized processing scratch block, allocating or enlarging it if need be.
+ 
+    The block is shared by all map processing stages, so its content is not preserved between the stages. It is released by the
+    releaseProcessingArenas() function.
+ 
+    \param[in] noVals The number of values the block needs to hold.
+    \param[out] processingMapArena Pointer to the scratch block.
+ */
+proshade_double* ProSHADE_internal_data::ProSHADE_data::getProcessingMapArena ( size_t noVals )
+{
+    //================================================ Enlarge if need be
+    if ( this->processingMapArenaSize < noVals )
+    {
+        if ( this->processingMapArena != nullptr ) { fftw_free ( this->processingMapArena ); }
+        this->processingMapArena                      = reinterpret_cast< proshade_double* > ( fftw_malloc ( sizeof ( proshade_double ) * noVals ) );
+        ProSHADE_internal_misc::checkMemoryAllocation ( this->processingMapArena, __FILE__, __LINE__, __func__ );
+        this->processingMapArenaSize                  = noVals;
+    }
+    
+    //================================================ Done
+    return                                            ( this->processingMapArena );
+    
+}
+
+/*! \brief This function returns the Fourier coefficients processing scratch block, allocating or enlarging it if need be.
+ 
+    The block is shared by all Fourier space map processing stages, so its content is not preserved between the stages. It is released
+    by the releaseProcessingArenas() function.
+ 
+    \param[in] noCoeffs The number of complex coefficients the block needs to hold.
+    \param[out] processingCoeffsArena Pointer to the scratch block.
+ */
+fftw_complex* ProSHADE_internal_data::ProSHADE_data::getProcessingCoeffsArena ( size_t noCoeffs )
+{
+    //================================================ Enlarge if need be
+    if ( this->processingCoeffsArenaSize < noCoeffs )
+    {
+        if ( this->processingCoeffsArena != nullptr ) { fftw_free ( this->processingCoeffsArena ); }
+        this->processingCoeffsArena                   = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * noCoeffs ) );
+        ProSHADE_internal_misc::checkMemoryAllocation ( this->processingCoeffsArena, __FILE__, __LINE__, __func__ );
+        this->processingCoeffsArenaSize               = noCoeffs;
+    }
+    
+    //================================================ Done
+    return                                            ( this->processingCoeffsArena );
+    
+}
+
+/*! \brief This function releases the map processing scratch blocks.
+ */
+void ProSHADE_internal_data::ProSHADE_data::releaseProcessingArenas ( void )
+{
+    //================================================ Release the blocks
+    if ( this->processingMapArena != nullptr )    { fftw_free ( this->processingMapArena ); }
+    if ( this->processingCoeffsArena != nullptr ) { fftw_free ( this->processingCoeffsArena ); }
+    
+    //================================================ Reset
+    this->processingMapArena                          = nullptr;
+    this->processingCoeffsArena                       = nullptr;
+    this->processingMapArenaSize                      = 0;
+    this->processingCoeffsArenaSize                   = 0;
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief This function determines the sphere positions (radii) for sphere mapping.
 
     This function determines the radii of the concentric spheres (as measured from the centre of the map). This is
@@ -1847,7 +1985,8 @@ void ProSHADE_internal_data::ProSHADE_data::getSpherePositions ( ProSHADE_settin
     these were determined by the user.
  
     Finally, the function creates a new instance of the ProSHADE_sphere class for each of the already determined sphere
-    positions. Note: The constructor of ProSHADE_sphere is where the mapping then happens.
+    positions, distributing the spheres over the number of threads given by the settings. Note: The constructor of ProSHADE_sphere
+    is where the mapping then happens.
  
     \param[in] settings A pointer to settings class containing all the information required for map manipulation.
  */
@@ -1865,18 +2004,29 @@ void ProSHADE_internal_data::ProSHADE_data::mapToSpheres ( ProSHADE_settings* se
     this->getSpherePositions                          ( settings );
     ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 2, "Sphere positions obtained.", settings->messageShift );
     
-    //================================================ Create sphere objects and map the density
+    //================================================ Create sphere objects and map the density (the shells are independent, so they can be mapped in parallel)
     this->spheres                                     = new ProSHADE_internal_spheres::ProSHADE_sphere* [ this->noSpheres ];
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( this->spherePos.size() ); iter++ )
+    ProSHADE_internal_misc::checkMemoryAllocation     ( this->spheres, __FILE__, __LINE__, __func__ );
+    for ( proshade_unsign iter = 0; iter < this->noSpheres; iter++ ) { this->spheres[iter] = nullptr; }
+    
+    ProSHADE_internal_misc::parallelFor               ( static_cast<proshade_unsign> ( this->spherePos.size() ), settings->noThreads, [&] ( proshade_unsign iter, proshade_unsign )
     {
         std::stringstream ss;
         ss << "Now mapping sphere " << iter << " .";
         ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 4, ss.str(), settings->messageShift );
         
+        //============================================ The maximum bands are collected after all shells are mapped, so that the shells do not write into shared variables
+        proshade_unsign locMaxShellBand = 0, locMaxCompBand = 0;
         this->spheres[iter]                           = new ProSHADE_internal_spheres::ProSHADE_sphere ( this->xDimIndices, this->yDimIndices, this->zDimIndices,
                                                                                                          this->xDimSize, this->yDimSize, this->zDimSize, iter,
                                                                                                         &this->spherePos, settings->progressiveSphereMapping, settings->maxBandwidth,
-                                                                                                         this->internalMap, &this->maxShellBand, &this->maxEMatDim );
+                                                                                                         this->internalMap, &locMaxShellBand, &locMaxCompBand );
+    } );
+    
+    //================================================ Save the maximum shell band
+    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( this->spherePos.size() ); iter++ )
+    {
+        if ( this->maxShellBand < this->spheres[iter]->getLocalBandwidth() ) { this->maxShellBand = this->spheres[iter]->getLocalBandwidth(); this->maxEMatDim = this->spheres[iter]->getLocalBandwidth(); }
     }
     
     //================================================ Report completion
@@ -1890,8 +2040,7 @@ void ProSHADE_internal_data::ProSHADE_data::mapToSpheres ( ProSHADE_settings* se
 /*! \brief This function computes the spherical harmonics decomposition for the whole structure.
  
     This function is called to compute the spherical harmonics decomposition of the mapped data on every available
-    sphere. This is done sphere-wise and there is some sub-optimal memory management stemming from different shells
-    having different resolutions.
+    sphere. This is done sphere-wise, with the spheres being distributed over the number of threads given by the settings.
  
     \param[in] settings A pointer to settings class containing all the information required for map manipulation.
  */
@@ -1900,18 +2049,45 @@ void ProSHADE_internal_data::ProSHADE_data::computeSphericalHarmonics ( ProSHADE
     //================================================ Report progress
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 1, "Starting spherical harmonics decomposition.", settings->messageShift );
     
-    //================================================ Initialise memory
+    //================================================ Initialise memory (a single block for all shells, re-used if the structure is decomposed again with the same shells)
+    size_t noSHValues                                 = 0;
+    for ( proshade_unsign iter = 0; iter < this->noSpheres; iter++ ) { noSHValues += static_cast< size_t > ( this->spheres[iter]->getLocalAngRes() ) * static_cast< size_t > ( this->spheres[iter]->getLocalAngRes() ); }
+    if ( ( this->sphericalHarmonicsArena == nullptr ) || ( this->sphericalHarmonicsArenaSize != noSHValues ) )
+    {
+        if ( this->sphericalHarmonicsArena != nullptr ) { fftw_free ( this->sphericalHarmonicsArena ); }
+        this->sphericalHarmonicsArena                 = reinterpret_cast< proshade_complex* > ( fftw_malloc ( sizeof ( proshade_complex ) * std::max ( noSHValues, static_cast< size_t > ( 1 ) ) ) );
+        ProSHADE_internal_misc::checkMemoryAllocation ( this->sphericalHarmonicsArena, __FILE__, __LINE__, __func__ );
+        this->sphericalHarmonicsArenaSize             = noSHValues;
+    }
+    if ( this->sphericalHarmonics != nullptr ) { delete[] this->sphericalHarmonics; }
     this->sphericalHarmonics                          = new proshade_complex* [this->noSpheres];
     ProSHADE_internal_misc::checkMemoryAllocation     ( this->sphericalHarmonics, __FILE__, __LINE__, __func__ );
-    for ( proshade_unsign iter = 0; iter < this->noSpheres; iter++ )
+    
+    //================================================ Invalidate the RRP matrices cache (it was computed from the previous decomposition)
+    if ( this->rrpArena != nullptr )
     {
-        this->sphericalHarmonics[iter]                = new proshade_complex [( this->spheres[iter]->getLocalAngRes() ) * ( this->spheres[iter]->getLocalAngRes() )];
-        ProSHADE_internal_misc::checkMemoryAllocation ( this->sphericalHarmonics[iter], __FILE__, __LINE__, __func__ );
-        for ( size_t it = 0; it < ( ( this->spheres[iter]->getLocalAngRes() ) * ( this->spheres[iter]->getLocalAngRes() ) ); it++ ) { this->sphericalHarmonics[iter][it][0] = 0.0; this->sphericalHarmonics[iter][it][1] = 0.0; }
+        fftw_free                                     ( this->rrpArena );
+        this->rrpArena                                = nullptr;
     }
+    for ( size_t it = 0; it < noSHValues; it++ ) { this->sphericalHarmonicsArena[it][0] = 0.0; this->sphericalHarmonicsArena[it][1] = 0.0; }
     
-    //================================================ Compute the spherical harmonics
+    noSHValues                                        = 0;
     for ( proshade_unsign iter = 0; iter < this->noSpheres; iter++ )
+    {
+        this->sphericalHarmonics[iter]                = this->sphericalHarmonicsArena + noSHValues;
+        noSHValues                                   += static_cast< size_t > ( this->spheres[iter]->getLocalAngRes() ) * static_cast< size_t > ( this->spheres[iter]->getLocalAngRes() );
+    }
+    
+    //================================================ Prepare the workspaces pool (kept with the structure, so that repeated decompositions re-use the tables)
+    if ( this->shWorkspaces == nullptr )
+    {
+        this->shWorkspaces                            = new ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspacePool ( );
+        ProSHADE_internal_misc::checkMemoryAllocation ( this->shWorkspaces, __FILE__, __LINE__, __func__ );
+    }
+    this->shWorkspaces->reserveWorkers                ( ProSHADE_internal_misc::getNumberOfThreads ( settings->noThreads, this->noSpheres ) );
+    
+    //================================================ Compute the spherical harmonics (each worker uses its own workspaces)
+    ProSHADE_internal_misc::parallelFor               ( this->noSpheres, settings->noThreads, [&] ( proshade_unsign iter, proshade_unsign workerIt )
     {
         //============================================ Report progress
         std::stringstream ss;
@@ -1919,8 +2095,9 @@ void ProSHADE_internal_data::ProSHADE_data::computeSphericalHarmonics ( ProSHADE
         ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 4, ss.str(), settings->messageShift );
         
         //============================================ Compute
-        ProSHADE_internal_sphericalHarmonics::computeSphericalHarmonics ( this->spheres[iter]->getLocalBandwidth(), this->spheres[iter]->getMappedData(), this->sphericalHarmonics[iter] );
-    }
+        ProSHADE_internal_sphericalHarmonics::computeSphericalHarmonics ( this->spheres[iter]->getLocalBandwidth(), this->spheres[iter]->getMappedData(), this->sphericalHarmonics[iter],
+                                                                          this->shWorkspaces->getWorkspace ( this->spheres[iter]->getLocalBandwidth(), workerIt ) );
+    } );
     
     //================================================ Report completion
     ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 2, "Spherical harmonics decomposition complete.", settings->messageShift );
@@ -1981,14 +2158,13 @@ void ProSHADE_internal_data::ProSHADE_data::detectSymmetryFromAngleAxisSpace ( P
         this->cyclicSymmetries                        = this->findRequestedCSymmetryFromAngleAxis ( settings, settings->requestedSymmetryFold, &symThres );
         
         //============================================ Compute FSC for all possible axes
+        std::vector< proshade_double* > fscAxes;
         for ( size_t cIt = 0; cIt < this->cyclicSymmetries.size(); cIt++ )
         {
             const FloatingPoint< proshade_double > lhs ( this->cyclicSymmetries.at(cIt)[5] ), rhs ( -999.9 );
-            if ( ( this->cyclicSymmetries.at(cIt)[5] > settings->peakThresholdMin ) || ( lhs.AlmostEquals ( rhs ) ) )
-            {
-                this->computeFSC                      ( settings, &this->cyclicSymmetries, cIt, cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim );
-            }
+            if ( ( this->cyclicSymmetries.at(cIt)[5] > settings->peakThresholdMin ) || ( lhs.AlmostEquals ( rhs ) ) ) { fscAxes.push_back ( this->cyclicSymmetries.at(cIt) ); }
         }
+        this->computeFSCBatch                         ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
         
         //============================================ Sort by FSC
         std::sort                                     ( this->cyclicSymmetries.begin(), this->cyclicSymmetries.end(), sortProSHADESymmetryByFSC );
@@ -2091,7 +2267,7 @@ void ProSHADE_internal_data::ProSHADE_data::detectSymmetryFromAngleAxisSpace ( P
     {
         //============================================ Run only the D symmetry detection and search for requested fold
         this->getDihedralSymmetriesList               ( settings, &this->cyclicSymmetries );
-        this->saveRequestedSymmetryD                  ( settings, cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim );
+        this->saveRequestedSymmetryD                  ( settings, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
     }
     
     if ( settings->requestedSymmetryType == "T" )
@@ -2105,8 +2281,13 @@ void ProSHADE_internal_data::ProSHADE_data::detectSymmetryFromAngleAxisSpace ( P
             proshade_double fscVal                    = 0.0;
             proshade_double fscValAvg                 = 0.0;
 
+            //======================================== Compute the FSCs of axes with high enough peak height
+            std::vector< proshade_double* > fscAxes;
+            for ( size_t tIt = 0; tIt < this->tetrahedralSymmetries.size(); tIt++ ) { if ( this->tetrahedralSymmetries.at(tIt)[5] > settings->peakThresholdMin ) { fscAxes.push_back ( this->tetrahedralSymmetries.at(tIt) ); } }
+            this->computeFSCBatch                     ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
+            
             //======================================== Check if axes have high enough FSC and peak height
-            for ( size_t tIt = 0; tIt < this->tetrahedralSymmetries.size(); tIt++ ) { if ( this->tetrahedralSymmetries.at(tIt)[5] > settings->peakThresholdMin ) { fscVal = this->computeFSC ( settings, &this->tetrahedralSymmetries.at(tIt)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); fscValAvg += fscVal; } }
+            for ( size_t tIt = 0; tIt < this->tetrahedralSymmetries.size(); tIt++ ) { if ( this->tetrahedralSymmetries.at(tIt)[5] > settings->peakThresholdMin ) { fscVal = this->tetrahedralSymmetries.at(tIt)[6]; fscValAvg += fscVal; } }
             fscValAvg                                /= 7.0;
 
             //======================================== If the average is over the threshold, save it
@@ -2131,8 +2312,13 @@ void ProSHADE_internal_data::ProSHADE_data::detectSymmetryFromAngleAxisSpace ( P
             proshade_double fscVal                    = 0.0;
             proshade_double fscValAvg                 = 0.0;
 
+            //======================================== Compute the FSCs of axes with high enough peak height
+            std::vector< proshade_double* > fscAxes;
+            for ( size_t oIt = 0; oIt < this->octahedralSymmetries.size(); oIt++ ) { if ( this->octahedralSymmetries.at(oIt)[5] > settings->peakThresholdMin ) { fscAxes.push_back ( this->octahedralSymmetries.at(oIt) ); } }
+            this->computeFSCBatch                     ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
+            
             //======================================== Find the average FSC
-            for ( size_t oIt = 0; oIt < this->octahedralSymmetries.size(); oIt++ ) { if ( this->octahedralSymmetries.at(oIt)[5] > settings->peakThresholdMin ) { fscVal = this->computeFSC ( settings, &this->octahedralSymmetries.at(oIt)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); fscValAvg += fscVal; } }
+            for ( size_t oIt = 0; oIt < this->octahedralSymmetries.size(); oIt++ ) { if ( this->octahedralSymmetries.at(oIt)[5] > settings->peakThresholdMin ) { fscVal = this->octahedralSymmetries.at(oIt)[6]; fscValAvg += fscVal; } }
             fscValAvg                                /= 13.0;
 
             //======================================== If the average FSC is over the threshold, save it.
@@ -2157,8 +2343,13 @@ void ProSHADE_internal_data::ProSHADE_data::detectSymmetryFromAngleAxisSpace ( P
             proshade_double fscVal                    = 0.0;
             proshade_double fscValAvg                 = 0.0;
 
+            //======================================== Compute the FSCs of axes with high enough peak height
+            std::vector< proshade_double* > fscAxes;
+            for ( size_t iIt = 0; iIt < this->icosahedralSymmetries.size(); iIt++ ) { if ( this->icosahedralSymmetries.at(iIt)[5] > settings->peakThresholdMin ) { fscAxes.push_back ( this->icosahedralSymmetries.at(iIt) ); } }
+            this->computeFSCBatch                     ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
+            
             //======================================== Compute FSC average over all detected axes
-            for ( size_t iIt = 0; iIt < this->icosahedralSymmetries.size(); iIt++ ) { if ( this->icosahedralSymmetries.at(iIt)[5] > settings->peakThresholdMin ) { fscVal = this->computeFSC ( settings, &this->icosahedralSymmetries.at(iIt)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); fscValAvg += fscVal; } }
+            for ( size_t iIt = 0; iIt < this->icosahedralSymmetries.size(); iIt++ ) { if ( this->icosahedralSymmetries.at(iIt)[5] > settings->peakThresholdMin ) { fscVal = this->icosahedralSymmetries.at(iIt)[6]; fscValAvg += fscVal; } }
             fscValAvg                                /= 31.0;
 
             //======================================== If the axes averaged FSC is over the threshold, save it
@@ -2188,8 +2379,8 @@ void ProSHADE_internal_data::ProSHADE_data::detectSymmetryFromAngleAxisSpace ( P
  
     This function does all the heavy lifting of the FSC computation that can be done with only the knowledge of the array dimensions. It
     starts by assigning each array index into a bin and then it proceeds to cut the array of bins to contain all reflections up to the resolution,
-    but not more. Next, it computes the Fourier transform of the static map and cuts it to the same dimensions as the bin array to save
-    space and computation time.
+    but not more. Next, it computes the Fourier transform of the static map (as the real to complex half-spectrum, which is then expanded using
+    Friedel's law) and cuts it to the same dimensions as the bin array to save space and computation time.
  
     \param[in] cutIndices This is where the bin indexing array 'cut to the resolution' will be saved into.
     \param[in] fCoeffsCut This is where the Fourier coefficients array cut to the resolution will be saved into.
@@ -2225,12 +2416,14 @@ void ProSHADE_internal_data::ProSHADE_data::prepareFSCFourierMemory ( proshade_s
     bindata                                           = new proshade_double*[*noBins];
     binCounts                                         = new proshade_signed [*noBins];
     fscByBin                                          = new proshade_double [*noBins];
-    fftw_complex* mapData                             = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * this->xDimIndices * this->yDimIndices * this->zDimIndices ) );
+    proshade_double* mapData                          = reinterpret_cast< proshade_double* > ( fftw_malloc ( sizeof ( proshade_double ) * this->xDimIndices * this->yDimIndices * this->zDimIndices ) );
+    fftw_complex* halfCoeffs                          = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * this->xDimIndices * this->yDimIndices * ( ( this->zDimIndices / 2 ) + 1 ) ) );
     fftw_complex* fCoeffs                             = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * this->xDimIndices * this->yDimIndices * this->zDimIndices ) );
     fCoeffsCut                                        = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * static_cast< proshade_unsign > ( (*cutXDim) * (*cutYDim) * (*cutZDim) ) ) );
     
     //================================================ Check memory allocation
     ProSHADE_internal_misc::checkMemoryAllocation     ( mapData,       __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( halfCoeffs,    __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( fCoeffs,       __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( fCoeffsCut,    __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( bindata,       __FILE__, __LINE__, __func__ );
@@ -2247,16 +2440,28 @@ void ProSHADE_internal_data::ProSHADE_data::prepareFSCFourierMemory ( proshade_s
     //================================================ Zeroes
     for ( size_t binIt = 0; binIt < static_cast< size_t > ( *noBins ); binIt++ ) { for ( size_t it = 0; it < 12; it++ ) { bindata[binIt][it] = 0.0; } }
     for ( size_t binIt = 0; binIt < static_cast< size_t > ( *noBins ); binIt++ ) { binCounts[binIt] = 0; fscByBin[binIt] = 0.0; }
-    for ( size_t mapIt = 0; mapIt < static_cast< size_t > ( this->xDimIndices * this->yDimIndices * this->zDimIndices ); mapIt++ ) { mapData[mapIt][0] = 0.0; mapData[mapIt][1] = 0.0; fCoeffs[mapIt][0] = 0.0; fCoeffs[mapIt][1] = 0.0; }
     for ( size_t mapIt = 0; mapIt < static_cast< size_t > ( (*cutXDim) * (*cutYDim) * (*cutZDim) ); mapIt++ ) { fCoeffsCut[mapIt][0] = 0.0; fCoeffsCut[mapIt][1] = 0.0; }
     
-    //================================================ Prepare memory for Fourier transform
-    fftw_plan planForwardFourier                      = fftw_plan_dft_3d ( static_cast< int > ( this->xDimIndices ), static_cast< int > ( this->yDimIndices ), static_cast< int > ( this->zDimIndices ), mapData, fCoeffs, FFTW_FORWARD,  FFTW_ESTIMATE );
+    //================================================ Get the real to complex Fourier transform plan from the plans cache
+    fftw_plan planForwardFourier                      = ProSHADE_internal_fftw::getR2C3DPlan ( static_cast< int > ( this->xDimIndices ), static_cast< int > ( this->yDimIndices ), static_cast< int > ( this->zDimIndices ), mapData, halfCoeffs );
+    
+    //================================================ Copy the map with the centre moved to the origin (this is what the negative first order change does to the map)
+    for ( size_t xIt = 0; xIt < static_cast< size_t > ( this->xDimIndices ); xIt++ )
+    {
+        for ( size_t yIt = 0; yIt < static_cast< size_t > ( this->yDimIndices ); yIt++ )
+        {
+            for ( size_t zIt = 0; zIt < static_cast< size_t > ( this->zDimIndices ); zIt++ )
+            {
+                size_t shiftPos                       = ( ( zIt + ( this->zDimIndices / 2 ) ) % this->zDimIndices ) + this->zDimIndices * ( ( ( yIt + ( this->yDimIndices / 2 ) ) % this->yDimIndices ) +
+                                                          this->yDimIndices * ( ( xIt + ( this->xDimIndices / 2 ) ) % this->xDimIndices ) );
+                mapData[shiftPos]                     = this->internalMap[zIt + this->zDimIndices * ( yIt + this->yDimIndices * xIt )];
+            }
+        }
+    }
     
-    //================================================ Compute Fourier transform of the original map
-    for ( size_t iter = 0; iter < static_cast< size_t > ( this->xDimIndices * this->yDimIndices * this->zDimIndices ); iter++ ) { mapData[iter][0] = this->internalMap[iter]; mapData[iter][1] = 0.0; }
-    ProSHADE_internal_mapManip::changeFourierOrder    ( mapData, static_cast< proshade_signed > ( this->xDimIndices ), static_cast< proshade_signed > ( this->yDimIndices ), static_cast< proshade_signed > ( this->zDimIndices ), true );
-    fftw_execute                                      ( planForwardFourier );
+    //================================================ Compute the half-spectrum and expand it using Friedel's law
+    fftw_execute_dft_r2c                              ( planForwardFourier, mapData, halfCoeffs );
+    ProSHADE_internal_maths::expandHalfSpectrum       ( halfCoeffs, fCoeffs, static_cast< proshade_signed > ( this->xDimIndices ), static_cast< proshade_signed > ( this->yDimIndices ), static_cast< proshade_signed > ( this->zDimIndices ) );
     ProSHADE_internal_mapManip::changeFourierOrder    ( fCoeffs, static_cast< proshade_signed > ( this->xDimIndices ), static_cast< proshade_signed > ( this->yDimIndices ), static_cast< proshade_signed > ( this->zDimIndices ), true );
     
     //================================================ Cut Fourier coeffs
@@ -2276,9 +2481,9 @@ void ProSHADE_internal_data::ProSHADE_data::prepareFSCFourierMemory ( proshade_s
         }
     }
     
-    //================================================ Release internal memory
-    fftw_destroy_plan                                 ( planForwardFourier );
+    //================================================ Release internal memory (the plan is owned by the plans cache)
     fftw_free                                         ( mapData );
+    fftw_free                                         ( halfCoeffs );
     fftw_free                                         ( fCoeffs );
     
     //================================================ Done
@@ -2330,7 +2535,7 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::computeFSC ( ProSHADE_set
     ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 4, ss2.str(), settings->messageShift );
 
     //================================================ Initialise local variables
-    fftw_complex *rotCoeffs;
+    proshade_double rotMat[9];
     proshade_double averageFSC                        = 0.0;
     
     //================================================ If no rotation number is given, use all rotations and average
@@ -2338,14 +2543,12 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::computeFSC ( ProSHADE_set
     {
         for ( proshade_unsign rotIndex = 1; rotIndex < static_cast< proshade_unsign > ( CSym->at(symIndex)[0] ); rotIndex++ )
         {
-            //======================================== Get rotated Fourier coefficients
-            this->rotateFourierCoeffs                 ( CSym->at(symIndex)[1], CSym->at(symIndex)[2], CSym->at(symIndex)[3], ( ( 2.0 * M_PI ) / CSym->at(symIndex)[0] ) * static_cast< proshade_double > ( rotIndex ), fCoeffsCut, rotCoeffs, xDim, yDim, zDim );
-            
-            //======================================== Compute FSC and sum it
-            averageFSC                               += ProSHADE_internal_maths::computeFSC ( fCoeffsCut, rotCoeffs, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin );
+            //======================================== Get the rotation matrix (transposed, as the Fourier coefficients rotation requires)
+            ProSHADE_internal_maths::getRotationMatrixFromAngleAxis ( rotMat, CSym->at(symIndex)[3], CSym->at(symIndex)[2], CSym->at(symIndex)[1], ( ( 2.0 * M_PI ) / CSym->at(symIndex)[0] ) * static_cast< proshade_double > ( rotIndex ) );
+            ProSHADE_internal_maths::transpose3x3MatrixInPlace ( rotMat );
             
-            //======================================== Release memory
-            fftw_free                                 ( rotCoeffs );
+            //======================================== Compute FSC and sum it without computing the rotated coefficients
+            averageFSC                               += ProSHADE_internal_maths::computeRotatedFSC ( fCoeffsCut, rotMat, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin, settings->noThreads );
         }
         
         //============================================ Average the summed FSCs
@@ -2353,14 +2556,12 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::computeFSC ( ProSHADE_set
     }
     else
     {
-        //============================================ Get rotated Fourier coefficients
-        this->rotateFourierCoeffs                     (  CSym->at(symIndex)[1], CSym->at(symIndex)[2], CSym->at(symIndex)[3], ( ( 2.0 * M_PI ) / CSym->at(symIndex)[0] ) * static_cast< proshade_double > ( rotNumber ), fCoeffsCut, rotCoeffs, xDim, yDim, zDim );
-        
-        //============================================ Compute FSC
-        averageFSC                                    = ProSHADE_internal_maths::computeFSC ( fCoeffsCut, rotCoeffs, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin );
+        //============================================ Get the rotation matrix (transposed, as the Fourier coefficients rotation requires)
+        ProSHADE_internal_maths::getRotationMatrixFromAngleAxis ( rotMat, CSym->at(symIndex)[3], CSym->at(symIndex)[2], CSym->at(symIndex)[1], ( ( 2.0 * M_PI ) / CSym->at(symIndex)[0] ) * static_cast< proshade_double > ( rotNumber ) );
+        ProSHADE_internal_maths::transpose3x3MatrixInPlace ( rotMat );
         
-        //============================================ Release memory
-        fftw_free                                     ( rotCoeffs );
+        //============================================ Compute FSC without computing the rotated coefficients
+        averageFSC                                    = ProSHADE_internal_maths::computeRotatedFSC ( fCoeffsCut, rotMat, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin, settings->noThreads );
     }
 
     //================================================ Save result to the axis
@@ -2419,7 +2620,7 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::computeFSC ( ProSHADE_set
     ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 4, ss2.str(), settings->messageShift );
     
     //================================================ Initialise local variables
-    fftw_complex *rotCoeffs;
+    proshade_double rotMat[9];
     proshade_double averageFSC                        = 0.0;
     
     //================================================ If no rotation number is given, use all rotations and average
@@ -2427,14 +2628,12 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::computeFSC ( ProSHADE_set
     {
         for ( proshade_unsign rotIndex = 1; rotIndex < static_cast< proshade_unsign > ( sym[0] ); rotIndex++ )
         {
-            //======================================== Get rotated Fourier coefficients
-            this->rotateFourierCoeffs                 (  sym[1], sym[2], sym[3], ( ( 2.0 * M_PI ) / sym[0] ) * static_cast< proshade_double > ( rotIndex ), fCoeffsCut, rotCoeffs, xDim, yDim, zDim );
-            
-            //======================================== Compute FSC and sum it
-            averageFSC                               += ProSHADE_internal_maths::computeFSC ( fCoeffsCut, rotCoeffs, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin );
+            //======================================== Get the rotation matrix (transposed, as the Fourier coefficients rotation requires)
+            ProSHADE_internal_maths::getRotationMatrixFromAngleAxis ( rotMat, sym[3], sym[2], sym[1], ( ( 2.0 * M_PI ) / sym[0] ) * static_cast< proshade_double > ( rotIndex ) );
+            ProSHADE_internal_maths::transpose3x3MatrixInPlace ( rotMat );
             
-            //======================================== Release memory
-            fftw_free                                 ( rotCoeffs );
+            //======================================== Compute FSC and sum it without computing the rotated coefficients
+            averageFSC                               += ProSHADE_internal_maths::computeRotatedFSC ( fCoeffsCut, rotMat, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin, settings->noThreads );
         }
         
         //============================================ Average the summed FSCs
@@ -2442,14 +2641,12 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::computeFSC ( ProSHADE_set
     }
     else
     {
-        //============================================ Get rotated Fourier coefficients
-        this->rotateFourierCoeffs                     (  sym[1], sym[2], sym[3], ( ( 2.0 * M_PI ) / sym[0] ) * static_cast< proshade_double > ( rotNumber ), fCoeffsCut, rotCoeffs, xDim, yDim, zDim );
+        //============================================ Get the rotation matrix (transposed, as the Fourier coefficients rotation requires)
+        ProSHADE_internal_maths::getRotationMatrixFromAngleAxis ( rotMat, sym[3], sym[2], sym[1], ( ( 2.0 * M_PI ) / sym[0] ) * static_cast< proshade_double > ( rotNumber ) );
+        ProSHADE_internal_maths::transpose3x3MatrixInPlace ( rotMat );
         
-        //============================================ Compute FSC
-        averageFSC                                    = ProSHADE_internal_maths::computeFSC ( fCoeffsCut, rotCoeffs, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin );
-        
-        //============================================ Release memory
-        fftw_free                                     ( rotCoeffs );
+        //============================================ Compute FSC without computing the rotated coefficients
+        averageFSC                                    = ProSHADE_internal_maths::computeRotatedFSC ( fCoeffsCut, rotMat, xDim, yDim, zDim, noBins, cutIndices, bindata, binCounts, fscByBin, settings->noThreads );
     }
 
     //================================================ Save result to the axis
@@ -2472,6 +2669,58 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::computeFSC ( ProSHADE_set
     
 }
 
+/*! \brief This function computes FSC for a list of symmetry axes concurrently.
+ 
+    This function takes a list of symmetry axes and computes the FSC for all of them, which do not have their FSC already computed (i.e. have the
+    value at index 6 larger than -2.0). The axes are processed in parallel, with each worker having its own bin sums workspace, while the
+    cut Fourier coefficients and the bin indexing are shared as they are only read. The results are saved to index 6 of each axis as the
+    computeFSC() function does. If only a single axis needs to be processed, the FSC computation itself is parallelised instead.
+ 
+    \param[in] settings A pointer to settings class containing all the information required for map symmetry detection.
+    \param[in] syms A vector of pointers to double arrays, each array being a single Cyclic symmetry entry in the ProSHADE format.
+    \param[in] cutIndices Map of each coefficient index to its correct bin cut to resolution.
+    \param[in] fCoeffsCut The original map Fourier coefficients cut to resolution.
+    \param[in] noBins Number of bins to be used (only up to the cut-off resolution).
+    \param[in] xDim The number of indices along the x-axis of the of the array to be rotated.
+    \param[in] yDim The number of indices along the y-axis of the of the array to be rotated.
+    \param[in] zDim The number of indices along the z-axis of the of the array to be rotated.
+    \param[in] rotNumber Which rotation should be used to compare against the original position? Defaults to first (1).
+ */
+void ProSHADE_internal_data::ProSHADE_data::computeFSCBatch ( ProSHADE_settings* settings, std::vector< proshade_double* >* syms, proshade_signed*& cutIndices, fftw_complex*& fCoeffsCut, proshade_signed noBins, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_unsign rotNumber )
+{
+    //================================================ Find axes which still need the FSC computed (each only once, as the same axis may be listed repeatedly)
+    std::vector< proshade_double* > pending;
+    for ( size_t symIt = 0; symIt < syms->size(); symIt++ )
+    {
+        if ( syms->at(symIt)[6] > -2.0 ) { continue; }
+        if ( std::find ( pending.begin(), pending.end(), syms->at(symIt) ) != pending.end() ) { continue; }
+        pending.push_back                             ( syms->at(symIt) );
+    }
+    if ( pending.size() == 0 ) { return ; }
+    
+    //================================================ Allocate the workspace for each worker
+    proshade_unsign noWorkers                         = ProSHADE_internal_misc::getNumberOfThreads ( settings->noThreads, static_cast< proshade_unsign > ( pending.size() ) );
+    size_t noBinsS                                    = static_cast< size_t > ( noBins );
+    std::vector< std::vector< proshade_double > > workerBinStore ( noWorkers, std::vector< proshade_double > ( noBinsS * 12, 0.0 ) );
+    std::vector< std::vector< proshade_double* > > workerBinData ( noWorkers, std::vector< proshade_double* > ( noBinsS, nullptr ) );
+    std::vector< std::vector< proshade_signed > > workerBinCounts ( noWorkers, std::vector< proshade_signed > ( noBinsS, 0 ) );
+    std::vector< std::vector< proshade_double > > workerFSCByBin ( noWorkers, std::vector< proshade_double > ( noBinsS, 0.0 ) );
+    for ( size_t wIt = 0; wIt < static_cast< size_t > ( noWorkers ); wIt++ ) { for ( size_t binIt = 0; binIt < noBinsS; binIt++ ) { workerBinData.at(wIt).at(binIt) = &workerBinStore.at(wIt).at(binIt * 12); } }
+    
+    //================================================ Compute the FSCs
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( pending.size() ), settings->noThreads, [&] ( proshade_unsign symIt, proshade_unsign workerIt )
+    {
+        proshade_double** bindata                     = workerBinData.at(workerIt).data();
+        proshade_signed* binCounts                    = workerBinCounts.at(workerIt).data();
+        proshade_double* fscByBin                     = workerFSCByBin.at(workerIt).data();
+        this->computeFSC                              ( settings, pending.at(symIt), cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, xDim, yDim, zDim, rotNumber );
+    } );
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief This function takes all the detected symmetry results and decides on which are to be recommended for this structure.
  
     This function is the brains of symmetry detection in the sense that it decides which symmetry group ProSHADE recommends as being
@@ -2562,7 +2811,8 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
         proshade_unsign lowFSC                        = 0;
         
         //============================================ Find FSCs and their average
-        for ( size_t iIt = 0; iIt < this->icosahedralSymmetries.size(); iIt++ ) { if ( !std::isinf ( this->icosahedralSymmetries.at(iIt)[6] ) ) { fscVal = this->icosahedralSymmetries.at(iIt)[6]; } else { fscVal = this->computeFSC ( settings, &this->icosahedralSymmetries.at(iIt)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); } fscValAvg += fscVal; if ( fscVal < threshold ) { lowFSC++; } }
+        this->computeFSCBatch                         ( settings, &this->icosahedralSymmetries, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
+        for ( size_t iIt = 0; iIt < this->icosahedralSymmetries.size(); iIt++ ) { fscVal = this->icosahedralSymmetries.at(iIt)[6]; fscValAvg += fscVal; if ( fscVal < threshold ) { lowFSC++; } }
         fscValAvg                                    /= 31.0;
         IFSCAverage                                   = fscValAvg;
         if ( ( IFSCAverage < threshold ) || ( lowFSC > 10 ) ) { IFSCAverage = 0.0; }
@@ -2577,7 +2827,8 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
         proshade_unsign lowFSC                        = 0;
         
         //============================================ Find FSCs and their average
-        for ( size_t oIt = 0; oIt < this->octahedralSymmetries.size(); oIt++ ) { if ( !std::isinf ( this->octahedralSymmetries.at(oIt)[6] ) ) { fscVal = this->octahedralSymmetries.at(oIt)[6]; } else { fscVal = this->computeFSC ( settings, &this->octahedralSymmetries.at(oIt)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); } fscValAvg += fscVal; if ( fscVal < threshold ) { lowFSC++; } }
+        this->computeFSCBatch                         ( settings, &this->octahedralSymmetries, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
+        for ( size_t oIt = 0; oIt < this->octahedralSymmetries.size(); oIt++ ) { fscVal = this->octahedralSymmetries.at(oIt)[6]; fscValAvg += fscVal; if ( fscVal < threshold ) { lowFSC++; } }
         fscValAvg                                    /= 13.0;
         OFSCAverage                                   = fscValAvg;
         if ( ( OFSCAverage < threshold ) || ( lowFSC > 5 ) ) { OFSCAverage = 0.0; }
@@ -2592,7 +2843,8 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
         proshade_unsign lowFSC                        = 0;
         
         //============================================ Find FSCs and their average
-        for ( size_t tIt = 0; tIt < this->tetrahedralSymmetries.size(); tIt++ )  { if ( !std::isinf ( this->tetrahedralSymmetries.at(tIt)[6] ) ) { fscVal = this->tetrahedralSymmetries.at(tIt)[6]; } else { fscVal = this->computeFSC ( settings, &this->tetrahedralSymmetries.at(tIt)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); } fscValAvg += fscVal; if ( fscVal < threshold ) { lowFSC++; } }
+        this->computeFSCBatch                         ( settings, &this->tetrahedralSymmetries, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
+        for ( size_t tIt = 0; tIt < this->tetrahedralSymmetries.size(); tIt++ )  { fscVal = this->tetrahedralSymmetries.at(tIt)[6]; fscValAvg += fscVal; if ( fscVal < threshold ) { lowFSC++; } }
         fscValAvg                                    /= 7.0;
         TFSCAverage                                   = fscValAvg;
         if ( ( TFSCAverage < threshold ) || ( lowFSC > 2 ) ) { TFSCAverage = 0.0; }
@@ -2666,6 +2918,7 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
         proshade_double bestValPeak                   = -std::numeric_limits < proshade_double >::infinity();
         
         //============================================ Find FSCs
+        std::vector< proshade_double* > fscAxes;
         for ( size_t dIt = 0; dIt < this->dihedralSymmetries.size(); dIt++ )
         {
             //======================================== Check the peak heights
@@ -2673,10 +2926,11 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
             if ( ( this->dihedralSymmetries.at(dIt).at(0)[5] < bestHistPeakStart ) && !( lhs999a.AlmostEquals( rhs999 ) ) ) { continue; }
             if ( ( this->dihedralSymmetries.at(dIt).at(1)[5] < bestHistPeakStart ) && !( lhs999b.AlmostEquals( rhs999 ) ) ) { continue; }
             
-            //======================================== Find FSCs
-            if ( std::isinf ( this->dihedralSymmetries.at(dIt).at(0)[6] ) ) { this->computeFSC ( settings, &this->dihedralSymmetries.at(dIt).at(0)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); }
-            if ( std::isinf ( this->dihedralSymmetries.at(dIt).at(1)[6] ) ) { this->computeFSC ( settings, &this->dihedralSymmetries.at(dIt).at(1)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); }
+            //======================================== Collect axes for FSC computation
+            fscAxes.push_back                         ( this->dihedralSymmetries.at(dIt).at(0) );
+            fscAxes.push_back                         ( this->dihedralSymmetries.at(dIt).at(1) );
         }
+        this->computeFSCBatch                         ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
         
         //============================================ Prepare vector to get the smoothened threshold for D's only
         std::vector< proshade_double* > smootheningHlp;
@@ -2771,6 +3025,7 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
         proshade_unsign bestFold                      = 0;
         
         //============================================ Find FSCs for C syms
+        std::vector< proshade_double* > fscAxes;
         for ( size_t cIt = 0; cIt < this->cyclicSymmetries.size(); cIt++ )
         {
             //======================================== Do not consider more than top 20, takes time and is unlikely to produce anything...
@@ -2779,9 +3034,10 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
             //======================================== Check the peak height
             if ( this->cyclicSymmetries.at(cIt)[5] < bestHistPeakStart ) { continue; }
             
-            //======================================== Compute FSC
-            if ( std::isinf ( this->cyclicSymmetries.at(cIt)[6] ) ) { this->computeFSC ( settings, &this->cyclicSymmetries.at(cIt)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, cutXDim, cutYDim, cutZDim ); }
+            //======================================== Collect axes for FSC computation
+            fscAxes.push_back                         ( this->cyclicSymmetries.at(cIt) );
         }
+        this->computeFSCBatch                         ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, cutXDim, cutYDim, cutZDim );
         
         //============================================ Find FSC top group threshold
         proshade_double bestHistFSCStart              = ProSHADE_internal_maths::findTopGroupSmooth ( &this->cyclicSymmetries, 6, step, sigma, windowSize );
@@ -2846,20 +3102,19 @@ void ProSHADE_internal_data::ProSHADE_data::determineRecommendedSymmetry ( ProSH
     \param[in] cutIndices Map of each coefficient index to its correct bin cut to resolution.
     \param[in] fCoeffsCut The original map Fourier coefficients cut to resolution.
     \param[in] noBins Number of bins to be used (only up to the cut-off resolution).
-    \param[in] bindata Pre-allocated array of dimensions noBins x 12 serving as workspace for the bin summation and FSC computation. This array is modified by the function in case the caller would be interested in these results.
-    \param[in] binCounts Pre-allocated array of dimension noBins serving to store the bin sizes for FSC computation. This array is modified by the function in case the caller would be interested in these results.
-    \param[in] fscByBin This array will hold FSC values for each bin. This is useful in further computations, but could be internal for FSC only computation.
     \param[in] xDim The number of indices along the x-axis of the of the array to be rotated.
     \param[in] yDim The number of indices along the y-axis of the of the array to be rotated.
     \param[in] zDim The number of indices along the z-axis of the of the array to be rotated.
  */
-void ProSHADE_internal_data::ProSHADE_data::saveRequestedSymmetryD ( ProSHADE_settings* settings, proshade_signed*& cutIndices, fftw_complex*& fCoeffsCut, proshade_signed noBins, proshade_double**& bindata, proshade_signed*& binCounts, proshade_double*& fscByBin, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim )
+void ProSHADE_internal_data::ProSHADE_data::saveRequestedSymmetryD ( ProSHADE_settings* settings, proshade_signed*& cutIndices, fftw_complex*& fCoeffsCut, proshade_signed noBins, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim )
 {
     //================================================ Initialise variables
     proshade_unsign bestIndex                         = 0;
     proshade_double highestSym                        = 0.0;
+    std::vector< proshade_unsign > correctFold;
+    std::vector< proshade_double* > fscAxes;
     
-    //================================================ Search for best fold
+    //================================================ Find axes with the correct fold
     for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( this->dihedralSymmetries.size() ); iter++ )
     {
         //============================================ Check if it is tbe correct fold
@@ -2871,11 +3126,18 @@ void ProSHADE_internal_data::ProSHADE_data::saveRequestedSymmetryD ( ProSHADE_se
         if ( ( this->dihedralSymmetries.at(iter).at(0)[5] < settings->peakThresholdMin ) && !( lhs999a.AlmostEquals( rhs999 ) ) ) { continue; }
         if ( ( this->dihedralSymmetries.at(iter).at(1)[5] < settings->peakThresholdMin ) && !( lhs999b.AlmostEquals( rhs999 ) ) ) { continue; }
         
-        //============================================ If correct, compute FSC
-        this->computeFSC                              ( settings, &this->dihedralSymmetries.at(iter).at(0)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, xDim, yDim, zDim );
-        this->computeFSC                              ( settings, &this->dihedralSymmetries.at(iter).at(1)[0], cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, xDim, yDim, zDim );
-        
+        //============================================ If correct, collect the axes for FSC computation
+        ProSHADE_internal_misc::addToUnsignVector     ( &correctFold, iter );
+        fscAxes.push_back                             ( this->dihedralSymmetries.at(iter).at(0) );
+        fscAxes.push_back                             ( this->dihedralSymmetries.at(iter).at(1) );
+    }
+    this->computeFSCBatch                             ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, xDim, yDim, zDim );
+    
+    //================================================ Search for best fold
+    for ( size_t corIt = 0; corIt < correctFold.size(); corIt++ )
+    {
         //============================================ If best, store it
+        proshade_unsign iter                          = correctFold.at(corIt);
         if ( ( this->dihedralSymmetries.at(iter).at(0)[6] + this->dihedralSymmetries.at(iter).at(1)[6] ) > highestSym )
         {
             highestSym                                = ( this->dihedralSymmetries.at(iter).at(0)[6] + this->dihedralSymmetries.at(iter).at(1)[6] );
@@ -3761,7 +4023,50 @@ proshade_unsign ProSHADE_internal_data::ProSHADE_data::getMaxBand ( )
 proshade_double ProSHADE_internal_data::ProSHADE_data::getRRPValue ( proshade_unsign band, proshade_unsign sh1, proshade_unsign sh2 )
 {
     //================================================ Return the value
-    return                                            ( this->rrpMatrices[band][sh1][sh2] );
+    return                                            ( this->rrpArena[this->getRRPArenaIndex ( band, sh1, sh2 )] );
+}
+
+/*! \brief This function returns the position of the given RRP matrix value in the packed RRP matrices block.
+ 
+    The RRP matrices are symmetric, so only their upper triangles are stored; each band holds noSpheres * ( noSpheres + 1 ) / 2
+    values packed row by row. The shell indices may be given in any order.
+ 
+    \param[in] band The band of the RRP matrix.
+    \param[in] sh1 The first shell index.
+    \param[in] sh2 The second shell index.
+    \param[out] X The index of the value in the rrpArena array.
+ */
+size_t ProSHADE_internal_data::ProSHADE_data::getRRPArenaIndex ( proshade_unsign band, proshade_unsign sh1, proshade_unsign sh2 )
+{
+    //================================================ Use the upper triangle
+    if ( sh1 > sh2 ) { std::swap ( sh1, sh2 ); }
+    
+    //================================================ Initialise local variables
+    size_t noShells                                   = static_cast< size_t > ( this->noSpheres );
+    size_t row                                        = static_cast< size_t > ( sh1 );
+    
+    //================================================ Band offset, then row offset, then column within the row
+    return                                            ( ( static_cast< size_t > ( band ) * ( ( noShells * ( noShells + 1 ) ) / 2 ) ) + ( ( row * ( ( 2 * noShells ) - row + 1 ) ) / 2 ) + ( sh2 - sh1 ) );
+}
+
+/*! \brief This function returns the position of the given E matrix value in the contiguous E matrices block.
+ 
+    The E matrix for band l has ( 2l + 1 )^2 values, so that the E matrix of band l starts after l ( 2l - 1 ) ( 2l + 1 ) / 3 values
+    of all the lower bands.
+ 
+    \param[in] band The band of the E matrix.
+    \param[in] order1 The first order index.
+    \param[in] order2 The second order index.
+    \param[out] X The index of the value in the eMatricesArena array.
+ */
+size_t ProSHADE_internal_data::ProSHADE_data::getEMatrixArenaIndex ( proshade_unsign band, proshade_unsign order1, proshade_unsign order2 )
+{
+    //================================================ Initialise local variables
+    size_t bandSz                                     = static_cast< size_t > ( band );
+    size_t noOrders                                   = ( bandSz * 2 ) + 1;
+    
+    //================================================ Offset of the band, then order1, then order2
+    return                                            ( ( bandSz * ( ( 2 * bandSz ) + 1 ) * ( bandSz > 0 ? ( 2 * bandSz ) - 1 : 0 ) ) / 3 + ( order1 * noOrders ) + order2 );
 }
 
 /*! \brief This function checks if particular shell has a  particular band.
@@ -3799,35 +4104,24 @@ void ProSHADE_internal_data::ProSHADE_data::removePhaseInormation ( ProSHADE_set
     //================================================ Report function start
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 1, "Removing phase from the map.", settings->messageShift );
     
-    //================================================ Copy map for processing
-    fftw_complex* mapCoeffs                           = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * this->xDimIndices * this->yDimIndices * this->zDimIndices ) );
-    fftw_complex* pattersonMap                        = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * this->xDimIndices * this->yDimIndices * this->zDimIndices ) );
-    
-    //================================================ Check memory allocation
-    ProSHADE_internal_misc::checkMemoryAllocation     ( mapCoeffs, __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( pattersonMap, __FILE__, __LINE__, __func__ );
+    //================================================ Get the processing scratch memory (the real to complex transform only needs the non-redundant half of the coefficients)
+    fftw_complex* mapCoeffs                           = this->getProcessingCoeffsArena ( static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * ( ( static_cast< size_t > ( this->zDimIndices ) / 2 ) + 1 ) );
+    proshade_double* pattersonMap                     = this->getProcessingMapArena ( static_cast< size_t > ( this->xDimIndices ) * static_cast< size_t > ( this->yDimIndices ) * static_cast< size_t > ( this->zDimIndices ) );
     
-    //================================================ Copy data to map
-    for ( proshade_unsign iter = 0; iter < (this->xDimIndices * this->yDimIndices * this->zDimIndices); iter++ )
-    {
-        pattersonMap[iter][0]                         = this->internalMap[iter];
-        pattersonMap[iter][1]                         = 0.0;
-    }
+    //================================================ Get FFTW plans from the plans cache
+    fftw_plan forward                                 = ProSHADE_internal_fftw::getR2C3DPlan ( static_cast< int > ( this->xDimIndices ), static_cast< int > ( this->yDimIndices ), static_cast< int > ( this->zDimIndices ),
+                                                                                               this->internalMap, mapCoeffs );
+    fftw_plan inverse                                 = ProSHADE_internal_fftw::getC2R3DPlan ( static_cast< int > ( this->xDimIndices ), static_cast< int > ( this->yDimIndices ), static_cast< int > ( this->zDimIndices ),
+                                                                                               mapCoeffs, pattersonMap );
     
-    //================================================ Prepare FFTW plans
-    fftw_plan forward                                 = fftw_plan_dft_3d ( static_cast< int > ( this->xDimIndices ), static_cast< int > ( this->yDimIndices ), static_cast< int > ( this->zDimIndices ),
-                                                                           pattersonMap, mapCoeffs, FFTW_FORWARD,  FFTW_ESTIMATE );
-    fftw_plan inverse                                 = fftw_plan_dft_3d ( static_cast< int > ( this->xDimIndices ), static_cast< int > ( this->yDimIndices ), static_cast< int > ( this->zDimIndices ),
-                                                                           mapCoeffs, pattersonMap, FFTW_BACKWARD, FFTW_ESTIMATE );
-    
-    //================================================ Run forward Fourier
-    fftw_execute                                      ( forward );
+    //================================================ Run forward Fourier (directly from the map, as the out-of-place real to complex transform does not change its input)
+    fftw_execute_dft_r2c                              ( forward, this->internalMap, mapCoeffs );
     
     //================================================ Remove the phase
     ProSHADE_internal_mapManip::removeMapPhase        ( mapCoeffs, this->xDimIndices, this->yDimIndices, this->zDimIndices );
     
     //================================================ Run inverse Fourier
-    fftw_execute                                      ( inverse );
+    fftw_execute_dft_c2r                              ( inverse, mapCoeffs, pattersonMap );
     
     //================================================ Save the results
     proshade_signed mapIt, patIt, patX, patY, patZ;
@@ -3847,18 +4141,11 @@ void ProSHADE_internal_data::ProSHADE_data::removePhaseInormation ( ProSHADE_set
                 patIt                                 = patZ + static_cast< proshade_signed > ( this->zDimIndices ) * ( patY + static_cast< proshade_signed > ( this->yDimIndices ) * patX );
                 
                 //==================================== Copy
-                this->internalMap[mapIt]              = pattersonMap[patIt][0];
+                this->internalMap[mapIt]              = pattersonMap[patIt];
             }
         }
     }
-    
-    //================================================ Release memory
-    fftw_free                                         ( mapCoeffs );
-    fftw_free                                         ( pattersonMap );
-    
-    //================================================ Delete FFTW plans
-    fftw_destroy_plan                                 ( forward );
-    fftw_destroy_plan                                 ( inverse );
+    this->noMapPasses                                += 2;
     
     //================================================ Change settings to reflect Patterson map
     if ( !settings->usePhase )
@@ -3933,6 +4220,17 @@ proshade_double ProSHADE_internal_data::ProSHADE_data::getIntegrationWeight  ( v
     
 }
 
+/*! \brief This function allows access to the integration weight of the other structure in the comparison stored in this object.
+ 
+    \param[out] X The integration weight of the other compared structure or 0.0 if not yet computed.
+ */
+proshade_double ProSHADE_internal_data::ProSHADE_data::getComparisonIntegrationWeight  ( void )
+{
+    //================================================ Done
+    return                                            ( this->comparisonIntegrationWeight );
+    
+}
+
 /*! \brief This function allows access to the bandwidth of a particular shell.
  
     \param[in] shell The index of the shell for which the bandwidth is required.
@@ -3980,8 +4278,8 @@ proshade_complex** ProSHADE_internal_data::ProSHADE_data::getEMatrixByBand ( pro
 void ProSHADE_internal_data::ProSHADE_data::getEMatrixValue ( proshade_unsign band, proshade_unsign order1, proshade_unsign order2, proshade_double* valueReal, proshade_double* valueImag )
 {
     //================================================ Set pointer
-   *valueReal                                         = this->eMatrices[band][order1][order2][0];
-   *valueImag                                         = this->eMatrices[band][order1][order2][1];
+   *valueReal                                         = this->eMatricesArena[this->getEMatrixArenaIndex ( band, order1, order2 )][0];
+   *valueImag                                         = this->eMatricesArena[this->getEMatrixArenaIndex ( band, order1, order2 )][1];
     
     //================================================ Done
     return ;
@@ -3999,6 +4297,27 @@ proshade_complex* ProSHADE_internal_data::ProSHADE_data::getInvSO3Coeffs ( )
     
 }
 
+/*! \brief This function allows access to the angle-axis sphere sampling positions cache, creating it on the first call.
+ 
+    This function must not be called from multiple threads at the same time before the cache exists; the returned cache itself can then be
+    used concurrently.
+ 
+    \param[out] X The internal angle-axis sphere sampling positions cache.
+ */
+ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry* ProSHADE_internal_data::ProSHADE_data::getRotFunSphereGeometry ( )
+{
+    //================================================ Create the cache, if need be
+    if ( this->rotFunSphereGeometry == nullptr )
+    {
+        this->rotFunSphereGeometry                    = new ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry ( );
+        ProSHADE_internal_misc::checkMemoryAllocation ( this->rotFunSphereGeometry, __FILE__, __LINE__, __func__ );
+    }
+    
+    //================================================ Done
+    return                                            ( this->rotFunSphereGeometry );
+    
+}
+
 /*! \brief This function allows access to the SO(3) coefficients array.
  
     \param[out] X The internal SO(3) coefficients array variable.
@@ -4235,6 +4554,17 @@ std::vector< proshade_double > ProSHADE_internal_data::ProSHADE_data::getMapCOMP
     
 }
 
+/*! \brief This function allows access to the number of full map passes done by the map processing stages.
+
+    \param[out] noMapPasses The number of full map passes (elementwise sweeps or forward and inverse Fourier transform pairs) done by the last processInternalMap() call.
+*/
+proshade_unsign ProSHADE_internal_data::ProSHADE_data::getNoMapPasses ( void )
+{
+    //================================================ Return the requested value
+    return                                            ( this->noMapPasses );
+    
+}
+
 /*! \brief This function allows access to the list of detected cyclic axes.
 
     \param[out] cyclicSymmetries Vector of the cyclic axes detected in the structure.
@@ -4329,6 +4659,34 @@ void ProSHADE_internal_data::ProSHADE_data::setIntegrationWeightCumul ( proshade
     
 }
 
+/*! \brief This function allows setting the integration weight of the other structure in the comparison stored in this object.
+ 
+    \param[in] intW The integration weight to be set for the other compared structure.
+ */
+void ProSHADE_internal_data::ProSHADE_data::setComparisonIntegrationWeight ( proshade_double intW )
+{
+    //================================================ Mutate
+    this->comparisonIntegrationWeight                 = intW;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function allows setting the cumulative integration weight of the other structure in the comparison stored in this object.
+ 
+    \param[in] intW The integration weight to be added to the current value for the other compared structure.
+ */
+void ProSHADE_internal_data::ProSHADE_data::setComparisonIntegrationWeightCumul ( proshade_double intW )
+{
+    //================================================ Mutate
+    this->comparisonIntegrationWeight                += intW;
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief This function allows setting the E matrix value.
  
     \param[in] band The band indice of the E matrix to which the value should be assigned.
@@ -4339,8 +4697,8 @@ void ProSHADE_internal_data::ProSHADE_data::setIntegrationWeightCumul ( proshade
 void ProSHADE_internal_data::ProSHADE_data::setEMatrixValue ( int band, int order1, int order2, proshade_complex val )
 {
     //================================================ Mutate
-    this->eMatrices[band][order1][order2][0]          = val[0];
-    this->eMatrices[band][order1][order2][1]          = val[1];
+    this->eMatricesArena[this->getEMatrixArenaIndex ( static_cast< proshade_unsign > ( band ), static_cast< proshade_unsign > ( order1 ), static_cast< proshade_unsign > ( order2 ) )][0] = val[0];
+    this->eMatricesArena[this->getEMatrixArenaIndex ( static_cast< proshade_unsign > ( band ), static_cast< proshade_unsign > ( order1 ), static_cast< proshade_unsign > ( order2 ) )][1] = val[1];
     
     //================================================ Done
     return ;
@@ -4357,8 +4715,8 @@ void ProSHADE_internal_data::ProSHADE_data::setEMatrixValue ( int band, int orde
 void ProSHADE_internal_data::ProSHADE_data::normaliseEMatrixValue ( proshade_unsign band, proshade_unsign order1, proshade_unsign order2, proshade_double normF )
 {
     //================================================ Mutate
-    this->eMatrices[band][order1][order2][0]         /= normF;
-    this->eMatrices[band][order1][order2][1]         /= normF;
+    this->eMatricesArena[this->getEMatrixArenaIndex ( band, order1, order2 )][0] /= normF;
+    this->eMatricesArena[this->getEMatrixArenaIndex ( band, order1, order2 )][1] /= normF;
     
     //================================================ Done
     return ;
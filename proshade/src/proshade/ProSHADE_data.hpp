@@ -55,6 +55,13 @@ namespace ProSHADE_internal_data
         //============================================ Variables regarding map
         proshade_double* internalMap;                 //!< The internal map data representation, which may be amended as the run progresses.
         
+        //============================================ Variables regarding map processing
+        proshade_double* processingMapArena;          //!< Map sized scratch block re-used by the map processing stages (e.g. the blurred map for masking), released once processing is done.
+        fftw_complex* processingCoeffsArena;          //!< Half-spectrum Fourier coefficients scratch block re-used by the Fourier space map processing stages, released once processing is done.
+        size_t processingMapArenaSize;                //!< The number of values the processingMapArena can currently hold.
+        size_t processingCoeffsArenaSize;             //!< The number of coefficients the processingCoeffsArena can currently hold.
+        proshade_unsign noMapPasses;                  //!< The number of full map passes (elementwise sweeps or forward and inverse Fourier transform pairs) done by the map processing stages so far.
+        
         //============================================ Variables regarding map information
         proshade_single xDimSize;                     //!< This is the size of the map cell x dimension in Angstroms.
         proshade_single yDimSize;                     //!< This is the size of the map cell y dimension in Angstroms.
@@ -119,14 +126,19 @@ namespace ProSHADE_internal_data
         proshade_unsign noSpheres;                    //!< The number of spheres with map projected onto them.
         ProSHADE_internal_spheres::ProSHADE_sphere** spheres; //!< The set of concentric spheres to which the intermal density map has been projected.
         proshade_complex** sphericalHarmonics;        //!< A set of spherical harmonics values arrays for each sphere.
+        proshade_complex* sphericalHarmonicsArena;    //!< The single contiguous block holding the spherical harmonics values of all spheres; the sphericalHarmonics pointers point into this block.
+        size_t sphericalHarmonicsArenaSize;           //!< The number of values the sphericalHarmonicsArena holds.
         proshade_complex** rotSphericalHarmonics;     //!< A set of rotated spherical harmonics values arrays for each sphere, used only if map rotation is required.
+        ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspacePool* shWorkspaces; //!< The spherical harmonics workspaces of the workers decomposing the spheres; released with the structure.
         proshade_unsign maxShellBand;                 //!< The maximum band for any shell of the object.
         proshade_unsign maxEMatDim;                   //!< The band (l) value for E matrix (i.e. the smallest of the two bands).
         
         //============================================ Variables regarding shape distance computations
-        proshade_double*** rrpMatrices;               //!< The energy levels descriptor shell correlation tables.
-        proshade_complex*** eMatrices;                //!< The trace sigma and full rotation function c*conj(c) integral tables.
+        proshade_double* rrpArena;                    //!< The energy levels descriptor shell correlation tables; only the upper triangle of each band's symmetric matrix is stored, packed band after band.
+        proshade_complex*** eMatrices;                //!< The trace sigma and full rotation function c*conj(c) integral tables; the row pointers are a single block starting at eMatrices[0] and point into the eMatricesArena.
+        proshade_complex* eMatricesArena;             //!< The single contiguous block holding all the E matrices values, indexed by band, order1 and order2.
         proshade_double integrationWeight;            //!< The Pearson's c.c. type weighting for the integration.
+        proshade_double comparisonIntegrationWeight;  //!< The Pearson's c.c. type weighting for the integration of the other structure in the comparison whose E matrices are stored in this object.
         proshade_complex* so3Coeffs;                  //!< The coefficients obtained by SO(3) Fourier Transform (SOFT), in this case derived from the E matrices.
         proshade_complex* so3CoeffsInverse;           //!< The inverse coefficients obtained by inverse SO(3) Fourier Transform (SOFT) - i.e. rotation function.
         proshade_complex*** wignerMatrices;           //!< These matrices are computed for a particular rotation to be done in spherical harmonics
@@ -134,6 +146,7 @@ namespace ProSHADE_internal_data
         
         //============================================ Variables regarding symmetry detection
         std::vector<ProSHADE_internal_spheres::ProSHADE_rotFun_sphere*> sphereMappedRotFun;
+        ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry* rotFunSphereGeometry; //!< The angle-axis sphere sampling positions shared by the spheres of this structure; released with the structure.
         
         //============================================ Control variables
         bool isEmpty;                                 //!< This variable stated whether the class contains any information.
@@ -159,6 +172,12 @@ namespace ProSHADE_internal_data
         void readInPDB                                ( ProSHADE_settings* settings );
         void readInGemmi                              ( gemmi::Structure* gemmiStruct, ProSHADE_settings* settings );
         void allocateRRPMemory                        ( );
+        size_t getRRPArenaIndex                       ( proshade_unsign band, proshade_unsign sh1, proshade_unsign sh2 );
+        size_t getEMatrixArenaIndex                   ( proshade_unsign band, proshade_unsign order1, proshade_unsign order2 );
+        proshade_double* getProcessingMapArena        ( size_t noVals );
+        fftw_complex* getProcessingCoeffsArena        ( size_t noCoeffs );
+        void releaseProcessingArenas                  ( void );
+        void invertAndNormaliseMap                    ( ProSHADE_settings* settings );
         
     public:
         //============================================ Constructors / Destructors
@@ -190,11 +209,11 @@ namespace ProSHADE_internal_data
         void getReBoxBoundaries                       ( ProSHADE_settings* settings, proshade_signed*& ret );
         void createNewMapFromBounds                   ( ProSHADE_settings* settings, ProSHADE_data*& newStr, proshade_signed* newBounds );
         void reSampleMap                              ( ProSHADE_settings* settings );
-        void centreMapOnCOM                           ( ProSHADE_settings* settings );
+        void centreMapOnCOM                           ( ProSHADE_settings* settings, bool moveMap = true );
         void addExtraSpace                            ( ProSHADE_settings* settings );
         void removePhaseInormation                    ( ProSHADE_settings* settings );
-        void shiftToBoxCentre                         ( ProSHADE_settings* settings );
-        void shiftToRotationCentre                    ( ProSHADE_settings* settings );
+        void shiftToBoxCentre                         ( ProSHADE_settings* settings, bool addRotationCentreShift = false );
+        void shiftToRotationCentre                    ( ProSHADE_settings* settings, bool moveMap = true );
         void processInternalMap                       ( ProSHADE_settings* settings );
         
         //============================================ Data sphere mapping functions
@@ -206,6 +225,7 @@ namespace ProSHADE_internal_data
         bool shellBandExists                          ( proshade_unsign shell, proshade_unsign bandVal );
         void computeRRPMatrices                       ( ProSHADE_settings* settings );
         void allocateEMatrices                        ( proshade_unsign  band, proshade_single oversamplingRatio );
+        void releaseEMatricesMemory                   ( void );
         void allocateSO3CoeffsSpace                   ( proshade_unsign band );
         void allocateWignerMatricesSpace              ( );
         
@@ -251,10 +271,12 @@ namespace ProSHADE_internal_data
         proshade_double computeFSC                    ( ProSHADE_settings* settings, proshade_double* sym, proshade_signed*& cutIndices, fftw_complex*& fCoeffsCut, proshade_signed noBins,
                                                         proshade_double**& bindata, proshade_signed*& binCounts, proshade_double*& fscByBin,
                                                         proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_unsign rotNumber = 1 );
+        void computeFSCBatch                          ( ProSHADE_settings* settings, std::vector< proshade_double* >* syms, proshade_signed*& cutIndices, fftw_complex*& fCoeffsCut,
+                                                        proshade_signed noBins, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_unsign rotNumber = 1 );
         void determineRecommendedSymmetry             ( ProSHADE_settings* settings, proshade_double threshold, proshade_signed*& cutIndices, fftw_complex*& fCoeffsCut, proshade_signed noBins, proshade_double**& bindata,
                                                         proshade_signed*& binCounts, proshade_double*& fscByBin, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim );
         void saveRequestedSymmetryD                   ( ProSHADE_settings* settings, proshade_signed*& cutIndices, fftw_complex*& fCoeffsCut, proshade_signed noBins,
-                                                        proshade_double**& bindata, proshade_signed*& binCounts, proshade_double*& fscByBin, proshade_signed cutXDim, proshade_signed cutYDim, proshade_signed cutZDim );
+                                                        proshade_signed cutXDim, proshade_signed cutYDim, proshade_signed cutZDim );
         std::vector<std::vector< proshade_double > > getAllGroupElements ( std::vector< proshade_unsign > axesList, std::string groupType = "", proshade_double matrixTolerance = 0.05 );
         std::vector<std::vector< proshade_double > > getAllGroupElements ( std::vector < std::vector< proshade_double > >* allCs, std::vector< proshade_unsign > axesList, std::string groupType = "", proshade_double matrixTolerance = 0.05 );
         void reportSymmetryResults                    ( ProSHADE_settings* settings );
@@ -297,11 +319,13 @@ namespace ProSHADE_internal_data
         proshade_double getRRPValue                   ( proshade_unsign band, proshade_unsign sh1, proshade_unsign sh2 );
         proshade_double getAnySphereRadius            ( proshade_unsign shell );
         proshade_double getIntegrationWeight          ( void );
+        proshade_double getComparisonIntegrationWeight ( void );
         proshade_unsign getShellBandwidth             ( proshade_unsign shell );
         proshade_single getSpherePosValue             ( proshade_unsign shell );
         proshade_complex** getEMatrixByBand           ( proshade_unsign band );
         void getEMatrixValue                          ( proshade_unsign band, proshade_unsign order1, proshade_unsign order2, proshade_double* valueReal, proshade_double* valueImag );
         proshade_complex* getInvSO3Coeffs             ( void );
+        ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry* getRotFunSphereGeometry ( void );
         proshade_complex* getSO3Coeffs                ( void );
         proshade_unsign getEMatDim                    ( void );
         void getWignerMatrixValue                     ( proshade_unsign band, proshade_unsign order1, proshade_unsign order2, proshade_double* valueReal, proshade_double* valueImag );
@@ -323,6 +347,7 @@ namespace ProSHADE_internal_data
         proshade_double*& getInternalMap              ( void );
         proshade_complex* getTranslationFnPointer     ( void );
         std::vector< proshade_double > getMapCOMProcessChange ( void );
+        proshade_unsign getNoMapPasses                ( void );
         std::vector< proshade_double* >* getCyclicAxes ( void );
         std::vector< proshade_double* >  getCyclicAxesCopy ( void );
         std::vector< std::vector< proshade_double* > >* getDihedralAxes ( void );
@@ -331,6 +356,8 @@ namespace ProSHADE_internal_data
         //============================================ Mutator functions
         void setIntegrationWeight                     ( proshade_double intW );
         void setIntegrationWeightCumul                ( proshade_double intW );
+        void setComparisonIntegrationWeight           ( proshade_double intW );
+        void setComparisonIntegrationWeightCumul      ( proshade_double intW );
         void setEMatrixValue                          ( int band, int order1, int order2, proshade_complex val );
         void normaliseEMatrixValue                    ( proshade_unsign band, proshade_unsign order1, proshade_unsign order2, proshade_double normF );
         void setSO3CoeffValue                         ( proshade_unsign position, proshade_complex val );
@@ -26,99 +26,103 @@
 /*! \brief This function allocates the required memory for the RRP matrices.
  
     This function belongs to the ProSHADE_data class and its role is to allocate the require memory
-    for the RRP matrices, given the already determined bandwidths and shell count.
+    for the RRP matrices, given the already determined bandwidths and shell count. As the RRP matrices
+    are symmetric, only the upper triangle of each band's matrix is held, all bands in a single contiguous
+    block (see getRRPArenaIndex()).
  */
 void ProSHADE_internal_data::ProSHADE_data::allocateRRPMemory ( )
 {
+    //================================================ Initialise local variables
+    size_t noValues                                   = static_cast< size_t > ( this->maxShellBand ) * ( ( static_cast< size_t > ( this->noSpheres ) * ( static_cast< size_t > ( this->noSpheres ) + 1 ) ) / 2 );
+    
     //================================================ Allocate the required memory
-    this->rrpMatrices                                 = new proshade_double** [this->maxShellBand];
-    ProSHADE_internal_misc::checkMemoryAllocation     ( this->rrpMatrices, __FILE__, __LINE__, __func__ );
+    this->rrpArena                                    = reinterpret_cast< proshade_double* > ( fftw_malloc ( sizeof ( proshade_double ) * std::max ( noValues, static_cast< size_t > ( 1 ) ) ) );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( this->rrpArena, __FILE__, __LINE__, __func__ );
     
-    for ( proshade_unsign bwIt = 0; bwIt < this->maxShellBand; bwIt++ )
-    {
-        //============================================ For rach sphere
-        this->rrpMatrices[bwIt]                       = new proshade_double*  [this->noSpheres];
-        ProSHADE_internal_misc::checkMemoryAllocation ( this->rrpMatrices[bwIt], __FILE__, __LINE__, __func__ );
-        
-        for ( proshade_unsign shIt = 0; shIt < this->noSpheres; shIt++ )
-        {
-            this->rrpMatrices[bwIt][shIt]             = new double [this->noSpheres];
-            ProSHADE_internal_misc::checkMemoryAllocation ( this->rrpMatrices[bwIt][shIt], __FILE__, __LINE__, __func__ );
-        }
-    }
+    //================================================ Set memory to zero (shell pairs without the band keep zero)
+    for ( size_t valIt = 0; valIt < noValues; valIt++ ) { this->rrpArena[valIt] = 0.0; }
 }
 
 /*! \brief This function pre-computes the RRP matrices for a data object.
  
     This function belongs to the ProSHADE_data class and its role is to set the objects internal
     variables properly and provide all the required calculations, so that the object will in the
-    end have all the RRP matrices computed and be ready for the energy levels calculation.
+    end have all the RRP matrices computed and be ready for the energy levels calculation. As the RRP matrices
+    depend only on the calling object, they are computed only once and re-used by any subsequent calls (e.g.
+    when the same structure is compared against multiple other structures); the cached matrices are released whenever
+    the spherical harmonics of the structure are computed again.
+ 
+    For each band, the band coefficients of all shells which have this band are gathered into contiguous vectors
+    (real and imaginary parts interleaved), so that the real parts of all the c1 * conj ( c2 ) order sums are simply
+    the dot products of these vectors. These are then computed at once as a symmetric rank-k product and
+    only the upper triangle is saved.
  
     \param[in] settings A pointer to settings class containing all the information required for the task.
  */
 void ProSHADE_internal_data::ProSHADE_data::computeRRPMatrices ( ProSHADE_settings* settings )
 {
+    //================================================ Already computed?
+    if ( this->rrpArena != nullptr ) { return ; }
+    
     //================================================ Report progress
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Computing RRP matrices for structure " + this->fileName, settings->messageShift );
     
     //================================================ Allocate the memory
     this->allocateRRPMemory                           ( );
     
+    //================================================ Allocate the workspace (large enough for the highest band)
+    size_t maxVecLength                               = static_cast< size_t > ( 2 * ( ( 2 * std::max ( this->maxShellBand, static_cast< proshade_unsign > ( 1 ) ) ) - 1 ) );
+    proshade_double* bandCoeffs                       = new proshade_double [std::max ( static_cast< size_t > ( this->noSpheres ), static_cast< size_t > ( 1 ) ) * maxVecLength];
+    proshade_double* gramMatrix                       = new proshade_double [std::max ( static_cast< size_t > ( this->noSpheres ) * this->noSpheres, static_cast< size_t > ( 1 ) )];
+    proshade_unsign* bandShells                       = new proshade_unsign [std::max ( this->noSpheres, static_cast< proshade_unsign > ( 1 ) )];
+    ProSHADE_internal_misc::checkMemoryAllocation     ( bandCoeffs, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( gramMatrix, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( bandShells, __FILE__, __LINE__, __func__ );
+    
     //================================================ Start computation: For each band (l)
-    proshade_double descValR                          = 0.0;
-    proshade_unsign arrPos1, arrPos2;
+    proshade_unsign noBandShells, arrPos;
     for ( proshade_unsign band = 0; band < this->maxShellBand; band++ )
     {
-        //============================================ For each unique shell couple
-        for ( proshade_unsign shell1 = 0; shell1 < this->noSpheres; shell1++ )
+        //============================================ Gather the band coefficients of all shells which have this band
+        int vecLength                                 = static_cast< int > ( 2 * ( ( 2 * band ) + 1 ) );
+        noBandShells                                  = 0;
+        for ( proshade_unsign shell = 0; shell < this->noSpheres; shell++ )
         {
-            //======================================== Does the band exist for this shell1?
-            if ( !ProSHADE_internal_distances::isBandWithinShell ( band, shell1, this->spheres ) )
+            //======================================== Does the band exist for this shell?
+            if ( !ProSHADE_internal_distances::isBandWithinShell ( band, shell, this->spheres ) ) { continue; }
+            
+            //======================================== Copy the orders (m) into a contiguous vector
+            proshade_double* shellVec                 = bandCoeffs + ( static_cast< size_t > ( noBandShells ) * static_cast< size_t > ( vecLength ) );
+            for ( proshade_unsign order = 0; order < static_cast< proshade_unsign >  ( ( 2 * band ) + 1 ); order++ )
             {
-                for ( proshade_unsign shell2 = 0; shell2 < this->noSpheres; shell2++ )
-                {
-                    this->rrpMatrices[band][shell1][shell2] = 0.0;
-                    this->rrpMatrices[band][shell2][shell1] = 0.0;
-                }
-                continue;
+                arrPos                                = static_cast< proshade_unsign > ( seanindex ( static_cast< int > ( order ) - static_cast<int > ( band ),
+                                                                                                   static_cast< int > ( band ), static_cast< int > ( this->spheres[shell]->getLocalBandwidth() ) ) );
+                shellVec[( 2 * order ) + 0]           = this->sphericalHarmonics[shell][arrPos][0];
+                shellVec[( 2 * order ) + 1]           = this->sphericalHarmonics[shell][arrPos][1];
             }
             
-            for ( proshade_unsign shell2 = 0; shell2 < this->noSpheres; shell2++ )
+            bandShells[noBandShells]                  = shell;
+            noBandShells                             += 1;
+        }
+        
+        //============================================ Compute all shell pairs at once
+        ProSHADE_internal_maths::realGramMatrixUpper  ( static_cast< int > ( noBandShells ), vecLength, bandCoeffs, gramMatrix );
+        
+        //============================================ Save the upper triangle
+        for ( proshade_unsign col = 0; col < noBandShells; col++ )
+        {
+            for ( proshade_unsign row = 0; row <= col; row++ )
             {
-                //==================================== Compute each values only once
-                if ( shell1 > shell2 ) { continue; }
-                
-                //==================================== Check if band exists for this shell2?
-                if ( !ProSHADE_internal_distances::isBandWithinShell ( band, shell2, this->spheres ) )
-                {
-                    this->rrpMatrices[band][shell1][shell2] = 0.0;
-                    this->rrpMatrices[band][shell2][shell1] = 0.0;
-                    continue;
-                }
-
-                //==================================== Initialise
-                descValR                              = 0.0;
-
-                //==================================== Sum over order (m)
-                for ( proshade_unsign order = 0; order < static_cast< proshade_unsign >  ( ( 2 * band ) + 1 ); order++ )
-                {
-                    arrPos1                           = static_cast< proshade_unsign > ( seanindex ( static_cast< int > ( order ) - static_cast<int > ( band ),
-                                                                                                   static_cast< int > ( band ), static_cast< int > ( this->spheres[shell1]->getLocalBandwidth() ) ) );
-                    arrPos2                           = static_cast< proshade_unsign > ( seanindex ( static_cast< int > ( order ) - static_cast< int > ( band ),
-                                                                                                   static_cast< int > ( band ), static_cast< int > ( this->spheres[shell2]->getLocalBandwidth() ) ) );
-                    descValR                         += ProSHADE_internal_maths::complexMultiplicationConjugRealOnly ( &this->sphericalHarmonics[shell1][arrPos1][0],
-                                                                                                                       &this->sphericalHarmonics[shell1][arrPos1][1],
-                                                                                                                       &this->sphericalHarmonics[shell2][arrPos2][0],
-                                                                                                                       &this->sphericalHarmonics[shell2][arrPos2][1]  );
-                }
-
-                //==================================== Save the matrices
-                this->rrpMatrices[band][shell1][shell2] = descValR;
-                this->rrpMatrices[band][shell2][shell1] = descValR;
+                this->rrpArena[this->getRRPArenaIndex ( band, bandShells[row], bandShells[col] )] = gramMatrix[row + ( static_cast< size_t > ( col ) * noBandShells )];
             }
         }
     }
     
+    //================================================ Release the workspace
+    delete[] bandCoeffs;
+    delete[] gramMatrix;
+    delete[] bandShells;
+    
     //================================================ Report progress
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, "RRP matrices successfully computed.", settings->messageShift );
     
@@ -268,47 +272,90 @@ void ProSHADE_internal_distances::computeRRPPearsonCoefficients ( ProSHADE_inter
  
     This function belongs to the ProSHADE_data class and its role is to allocate the require memory
     for the E matrices required by both, the Trace Sigma and Full Rotational descriptors, as well as
-    symmetry and rotation tasks.
+    symmetry and rotation tasks. Any previously allocated E matrices (and the Wigner D matrices, which share
+    their dimensions) are released first, so that the same object can be compared repeatedly.
  
     \param[in] band The minimal band of the comparison for which E matrices are computed.
     \param[in] oversamplingRatio How much was the resolution oversampled?
  */
 void ProSHADE_internal_data::ProSHADE_data::allocateEMatrices ( proshade_unsign band, proshade_single oversamplingRatio )
 {
+    //================================================ Release any previous comparison results
+    this->releaseEMatricesMemory                      ( );
+    
     //================================================ Compute oversampled band
     proshade_unsign oversampleEMatricesBy             = static_cast< proshade_unsign > ( static_cast< proshade_single > ( band ) * ( 1.0f - oversamplingRatio ) );
     
     //================================================ Save the maximum band to the object
     this->maxEMatDim                                  = band + oversampleEMatricesBy;
     
-    //================================================ Allocate the required memory
-    this->eMatrices                                   = new proshade_complex** [this->maxEMatDim];
-    ProSHADE_internal_misc::checkMemoryAllocation ( this->eMatrices, __FILE__, __LINE__, __func__ );
-    
+    //================================================ Allocate the required memory (a single block, band after band)
+    size_t noRows                                     = static_cast< size_t > ( this->maxEMatDim ) * static_cast< size_t > ( this->maxEMatDim );
+    size_t noValues                                   = this->getEMatrixArenaIndex ( this->maxEMatDim, 0, 0 );
+    this->eMatricesArena                              = reinterpret_cast< proshade_complex* > ( fftw_malloc ( sizeof ( proshade_complex ) * std::max ( noValues, static_cast< size_t > ( 1 ) ) ) );
+    this->eMatrices                                   = new proshade_complex** [std::max ( this->maxEMatDim, static_cast< proshade_unsign > ( 1 ) )];
+    proshade_complex** eMatRows                       = new proshade_complex*  [std::max ( noRows, static_cast< size_t > ( 1 ) )];
+    ProSHADE_internal_misc::checkMemoryAllocation     ( this->eMatricesArena, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( this->eMatrices, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( eMatRows, __FILE__, __LINE__, __func__ );
+    
+    //================================================ Point the tables into the block (band l has ( 2l + 1 ) rows, so its rows start at l^2)
+    this->eMatrices[0]                                = eMatRows;
     for ( proshade_unsign bandIter = 0; bandIter < this->maxEMatDim; bandIter++ )
     {
-        //============================================ Allocate the data structure
-        this->eMatrices[bandIter]                     = new proshade_complex*  [static_cast<proshade_unsign> ( ( bandIter * 2 ) + 1 )];
-        ProSHADE_internal_misc::checkMemoryAllocation ( this->eMatrices[bandIter], __FILE__, __LINE__, __func__ );
-        
+        this->eMatrices[bandIter]                     = eMatRows + ( static_cast< size_t > ( bandIter ) * bandIter );
         for ( proshade_unsign band2Iter = 0; band2Iter < static_cast<proshade_unsign> ( ( bandIter * 2 ) + 1 ); band2Iter++ )
         {
-            this->eMatrices[bandIter][band2Iter]      = new proshade_complex [static_cast<proshade_unsign> ( ( bandIter * 2 ) + 1 )];
-            ProSHADE_internal_misc::checkMemoryAllocation ( this->eMatrices[bandIter][band2Iter], __FILE__, __LINE__, __func__ );
+            this->eMatrices[bandIter][band2Iter]      = this->eMatricesArena + this->getEMatrixArenaIndex ( bandIter, band2Iter, 0 );
         }
     }
     
     //================================================ Set memory to zero
-    for ( proshade_unsign bandIter = 0; bandIter < this->maxEMatDim; bandIter++ )
+    for ( size_t valIt = 0; valIt < noValues; valIt++ )
     {
-        for ( proshade_unsign band2Iter = 0; band2Iter < static_cast<proshade_unsign> ( ( bandIter * 2 ) + 1 ); band2Iter++ )
+        this->eMatricesArena[valIt][0]                = 0.0;
+        this->eMatricesArena[valIt][1]                = 0.0;
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function releases the E matrices and Wigner D matrices memory.
+ 
+    This function belongs to the ProSHADE_data class and its role is to release the memory of the E matrices
+    and the Wigner D matrices (if allocated), as both are dimensioned by the current E matrices bandwidth. It
+    is called before the E matrices are re-allocated for a new comparison.
+ */
+void ProSHADE_internal_data::ProSHADE_data::releaseEMatricesMemory ( )
+{
+    //================================================ Release the E matrices
+    if ( this->eMatrices != nullptr )
+    {
+        delete[] this->eMatrices[0];
+        delete[] this->eMatrices;
+        this->eMatrices                               = nullptr;
+    }
+    if ( this->eMatricesArena != nullptr )
+    {
+        fftw_free                                     ( this->eMatricesArena );
+        this->eMatricesArena                          = nullptr;
+    }
+    
+    //================================================ Release the Wigner D matrices
+    if ( this->wignerMatrices != nullptr )
+    {
+        for ( proshade_unsign bandIter = 0; bandIter < this->maxEMatDim; bandIter++ )
         {
-            for ( proshade_unsign band3Iter = 0; band3Iter < static_cast<proshade_unsign> ( ( bandIter * 2 ) + 1 ); band3Iter++ )
+            for ( proshade_unsign order1Iter = 0; order1Iter < static_cast<proshade_unsign> ( ( bandIter * 2 ) + 1 ); order1Iter++ )
             {
-                this->eMatrices[bandIter][band2Iter][band3Iter][0] = 0.0;
-                this->eMatrices[bandIter][band2Iter][band3Iter][1] = 0.0;
+                delete[] this->wignerMatrices[bandIter][order1Iter];
             }
+            delete[] this->wignerMatrices[bandIter];
         }
+        delete[] this->wignerMatrices;
+        this->wignerMatrices                          = nullptr;
     }
     
     //================================================ Done
@@ -320,27 +367,40 @@ void ProSHADE_internal_data::ProSHADE_data::allocateEMatrices ( proshade_unsign
  
     \param[in] minSpheres The minima of the number of spheres available in the compared objects.
     \param[in] intOrder The integration order for the computation.
+    \param[in] maxBand The maximum band for which the E matrices will be computed.
     \param[in] obj1Vals Array to hold the shell values for the first object integgration.
     \param[in] obj2Vals Array to hold the shell values for the second object integgration.
     \param[in] GLabscissas An array to hold the pre-computed anscissas for the Gauss-Legendre integration.
     \param[in] glWeights An array to hold the pre-computed weights for the Gauss-Legendre integration.
-    \param[in] radiiVals A complex array to hold the results of combining spherical harmonics coefficients of the two objects for each shell.
+    \param[in] shellWeights An array to hold the Gauss-Legendre integration weight of each shell.
+    \param[in] obj1Coeffs A complex array to hold the weighted spherical harmonics coefficients of the first object for all orders and shells of a single band.
+    \param[in] obj2Coeffs A complex array to hold the spherical harmonics coefficients of the second object for all orders and shells of a single band.
+    \param[in] eMatBand A complex array to hold the E matrix of a single band.
  */
-void ProSHADE_internal_distances::allocateTrSigmaWorkspace ( proshade_unsign minSpheres, proshade_unsign intOrder, proshade_double*& obj1Vals, proshade_double*& obj2Vals, proshade_double*& GLabscissas, proshade_double*& GLweights, proshade_complex*& radiiVals )
+void ProSHADE_internal_distances::allocateTrSigmaWorkspace ( proshade_unsign minSpheres, proshade_unsign intOrder, proshade_unsign maxBand, proshade_double*& obj1Vals, proshade_double*& obj2Vals, proshade_double*& GLabscissas, proshade_double*& GLweights, proshade_double*& shellWeights, std::complex<proshade_double>*& obj1Coeffs, std::complex<proshade_double>*& obj2Coeffs, std::complex<proshade_double>*& eMatBand )
 {
+    //================================================ Initialise local variables
+    proshade_unsign maxOrders                         = ( maxBand * 2 ) + 1;
+    
     //================================================ Allocate the memory
     obj1Vals                                          = new proshade_double [minSpheres];
     obj2Vals                                          = new proshade_double [minSpheres];
-    radiiVals                                         = new proshade_complex[minSpheres];
     GLabscissas                                       = new proshade_double [intOrder];
     GLweights                                         = new proshade_double [intOrder];
+    shellWeights                                      = new proshade_double [minSpheres];
+    obj1Coeffs                                        = new std::complex<proshade_double> [minSpheres * maxOrders];
+    obj2Coeffs                                        = new std::complex<proshade_double> [minSpheres * maxOrders];
+    eMatBand                                          = new std::complex<proshade_double> [maxOrders * maxOrders];
     
     //================================================ Check the memory allocation
     ProSHADE_internal_misc::checkMemoryAllocation     ( obj1Vals, __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( obj2Vals, __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( radiiVals, __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( GLabscissas, __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( GLweights, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( shellWeights, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( obj1Coeffs, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( obj2Coeffs, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( eMatBand, __FILE__, __LINE__, __func__ );
     
     //================================================ Done
     return ;
@@ -375,68 +435,79 @@ void ProSHADE_internal_distances::computeSphericalHarmonicsMagnitude ( ProSHADE_
     
 }
 
-/*! \brief This function computes the E matrix un-weighted values for a given band and order and saves these into the obj2 parameter.
+/*! \brief This function computes the E matrix un-weighted values for all orders of a given band and saves these into the obj2 parameter.
+ 
+    For a given band, the E matrix is the radial Gauss-Legendre integral of the outer product of the first object spherical harmonics
+    coefficients with the complex conjugate of the second object coefficients. As the integration is a linear combination of the shell
+    values, this function firstly gathers the coefficients of all orders and usable shells into two contiguous column-major matrices
+    (orders x shells), scales the first one by the r^2 and integration weight of each shell and then obtains the whole E matrix for the
+    band as a single complex matrix product.
  
     \param[in] obj1 The ProSHADE_data object for which the comparison is done in regards to.
     \param[in] obj2 The ProSHADE_data object for which the comparison is done in regards from - the E matrices will be saved into this object.
-    \param[in] band The bandwidth of the SH value for which this should be done.
-    \param[in] order The order of the SH value for which this should be done.
-    \param[in] radiiVals Already allocated array of proshade_complex to which integrated values will be saved. It must have size equal to minimum of spheres in the two compared objects.
+    \param[in] bandIter The bandwidth of the SH value for which this should be done.
     \param[in] integOrder The Gauss-Legendre integration order to be used.
     \param[in] abscissas The pre-computed abscissas for the Gauss-Legendre integration.
     \param[in] weights The pre-computed weights for the Gauss-Legendre integration.
     \param[in] integRange The range in angstroms between the smalleds and largest shell which are integrated over (might not be 0 to max for progressive shell sampling).
     \param[in] sphereDist The distance between any two spheres.
+    \param[in] shellWeights Already allocated array to which the integration weights of the shells will be saved. It must have size equal to minimum of spheres in the two compared objects.
+    \param[in] obj1Coeffs Already allocated array for the first object coefficients. It must have size equal to minimum of spheres in the two compared objects times ( 2 * band + 1 ).
+    \param[in] obj2Coeffs Already allocated array for the second object coefficients. It must have size equal to minimum of spheres in the two compared objects times ( 2 * band + 1 ).
+    \param[in] eMatBand Already allocated array for the E matrix of this band. It must have size of at least ( 2 * band + 1 )^2.
  */
-void ProSHADE_internal_distances::computeEMatricesForLM ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2, int bandIter, int orderIter, proshade_complex* radiiVals, int integOrder, proshade_double* abscissas, proshade_double* weights, proshade_double integRange, proshade_double sphereDist )
+void ProSHADE_internal_distances::computeEMatricesForBand ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2, int bandIter, int integOrder, proshade_double* abscissas, proshade_double* weights, proshade_double integRange, proshade_double sphereDist, proshade_double* shellWeights, std::complex<proshade_double>* obj1Coeffs, std::complex<proshade_double>* obj2Coeffs, std::complex<proshade_double>* eMatBand )
 {
     //================================================ Initialise local variables
-    proshade_unsign objCombValsIter                   = 0;
-    proshade_double hlpReal, hlpImag, rSquared;
+    int noOrders                                      = ( bandIter * 2 ) + 1;
+    int noShells                                      = 0;
+    int arrPos, locBand;
+    proshade_double rSquared;
     proshade_complex arrVal;
-    int o1ArrPos, o2ArrPos, locBand;
-    proshade_unsign integOrderU                       = static_cast< proshade_unsign > ( integOrder );
     
-    //================================================ For each combination of m and m' for E matrices
-    for ( int order2Iter = 0; order2Iter < ( ( bandIter * 2 ) + 1 ); order2Iter++ )
+    //================================================ Gather the coefficients of all orders for all shells having the band
+    for ( proshade_unsign radiusIter = 0; radiusIter < std::min( obj1->getMaxSpheres(), obj2->getMaxSpheres() ); radiusIter++ )
     {
-        //============================================ Reset loop
-        objCombValsIter                               = 0;
+        //============================================ Get only values where the shell has the band
+        if ( std::min ( obj1->getShellBandwidth ( radiusIter ), obj2->getShellBandwidth ( radiusIter ) ) <= static_cast< proshade_unsign > ( bandIter ) ) { continue; }
         
-        //============================================ Find the c*conj(c) values for different radii
-        for ( proshade_unsign radiusIter = 0; radiusIter < std::min( obj1->getMaxSpheres(), obj2->getMaxSpheres() ); radiusIter++ )
-        {
-            //======================================== Get only values where the shell has the band
-            if ( std::min ( obj1->getShellBandwidth ( radiusIter ), obj2->getShellBandwidth ( radiusIter ) ) <= static_cast< proshade_unsign > ( bandIter ) ) { continue; }
-            
-            //======================================== Pre-compute values
-            rSquared                                  = pow ( ( static_cast<proshade_double> ( obj1->getAnySphereRadius( radiusIter ) ) ), 2.0 );
-            
-            //======================================== Multiply coeffs
-            locBand                                   = static_cast< int > ( obj1->spheres[radiusIter]->getLocalBandwidth() );
-            o1ArrPos                                  = seanindex ( orderIter - bandIter, bandIter, locBand );
-            o2ArrPos                                  = seanindex ( order2Iter - bandIter, bandIter, locBand );
-            
-            ProSHADE_internal_maths::complexMultiplicationConjug ( &obj1->sphericalHarmonics[radiusIter][o1ArrPos][0],
-                                                                   &obj1->sphericalHarmonics[radiusIter][o1ArrPos][1],
-                                                                   &obj2->sphericalHarmonics[radiusIter][o2ArrPos][0],
-                                                                   &obj2->sphericalHarmonics[radiusIter][o2ArrPos][1],
-                                                                   &hlpReal, &hlpImag );
-  
-            //======================================== Apply r^2 integral weight
-            radiiVals[objCombValsIter][0]             = hlpReal * rSquared;
-            radiiVals[objCombValsIter][1]             = hlpImag * rSquared;
+        //============================================ Pre-compute values
+        rSquared                                      = pow ( ( static_cast<proshade_double> ( obj1->getAnySphereRadius( radiusIter ) ) ), 2.0 );
+        locBand                                       = static_cast< int > ( obj1->spheres[radiusIter]->getLocalBandwidth() );
+        shellWeights[noShells]                        = rSquared;
         
-            objCombValsIter                          += 1;
+        //============================================ Copy coefficients into the shell column
+        for ( int orderIter = 0; orderIter < noOrders; orderIter++ )
+        {
+            arrPos                                    = seanindex ( orderIter - bandIter, bandIter, locBand );
+            obj1Coeffs[orderIter + ( noShells * noOrders )] = std::complex<proshade_double> ( obj1->sphericalHarmonics[radiusIter][arrPos][0], obj1->sphericalHarmonics[radiusIter][arrPos][1] );
+            obj2Coeffs[orderIter + ( noShells * noOrders )] = std::complex<proshade_double> ( obj2->sphericalHarmonics[radiusIter][arrPos][0], obj2->sphericalHarmonics[radiusIter][arrPos][1] );
         }
         
-        //============================================ Integrate over all radii using n-point Gauss-Legendre integration
-        ProSHADE_internal_maths::gaussLegendreIntegration ( radiiVals, objCombValsIter, integOrderU, abscissas, weights, integRange, sphereDist, &hlpReal, &hlpImag );
-  
-        //============================================ Save the result into E matrices
-        arrVal[0]                                     = hlpReal;
-        arrVal[1]                                     = hlpImag;
-        obj2->setEMatrixValue                         ( bandIter, orderIter, order2Iter, arrVal );
+        noShells                                     += 1;
+    }
+    
+    //================================================ Apply the r^2 and the Gauss-Legendre integration weights to the first object coefficients
+    std::vector< proshade_double > integWeights       ( static_cast< size_t > ( noShells ) + 1, 0.0 );
+    ProSHADE_internal_maths::getGaussLegendreShellWeights ( static_cast< proshade_unsign > ( noShells ), static_cast< proshade_unsign > ( integOrder ), abscissas, weights, integRange, sphereDist, &integWeights[0] );
+    for ( int shellIter = 0; shellIter < noShells; shellIter++ )
+    {
+        shellWeights[shellIter]                      *= integWeights[static_cast< size_t > ( shellIter )];
+        for ( int orderIter = 0; orderIter < noOrders; orderIter++ ) { obj1Coeffs[orderIter + ( shellIter * noOrders )] *= shellWeights[shellIter]; }
+    }
+    
+    //================================================ Compute the E matrix for all m and m' at once as obj1 * obj2^H
+    ProSHADE_internal_maths::complexMatrixMultiplyConjugTranspose ( noOrders, noOrders, noShells, obj1Coeffs, obj2Coeffs, eMatBand );
+    
+    //================================================ Save the result into E matrices
+    for ( int orderIter = 0; orderIter < noOrders; orderIter++ )
+    {
+        for ( int order2Iter = 0; order2Iter < noOrders; order2Iter++ )
+        {
+            arrVal[0]                                 = eMatBand[orderIter + ( order2Iter * noOrders )].real ( );
+            arrVal[1]                                 = eMatBand[orderIter + ( order2Iter * noOrders )].imag ( );
+            obj2->setEMatrixValue                     ( bandIter, orderIter, order2Iter, arrVal );
+        }
     }
     
     //================================================ Done
@@ -444,7 +515,10 @@ void ProSHADE_internal_distances::computeEMatricesForLM ( ProSHADE_internal_data
     
 }
 
-/*! \brief This function computes the E matrix weight values for a given band and order and saves these into the appropriate objects.
+/*! \brief This function computes the E matrix weight values for a given band and order and saves these into the second object.
+ 
+    Both weights are saved into the second object (the one holding the E matrices), so that the first object is only read from and
+    can be compared against multiple other objects at the same time.
  
     \param[in] obj1 The ProSHADE_data object for which the comparison is done in regards to.
     \param[in] obj2 The ProSHADE_data object for which the comparison is done in regards from - the E matrices will be saved into this object.
@@ -489,7 +563,7 @@ proshade_double ProSHADE_internal_distances::computeWeightsForEMatricesForLM ( P
     proshade_single minSphereRad                      = obj1->getSpherePosValue ( minSphere ) - ( sphereDist * 0.5f );
     proshade_single maxSphereRad                      = obj1->getSpherePosValue ( maxSphere ) + ( sphereDist * 0.5f );
             
-    obj1->setIntegrationWeightCumul                   ( ProSHADE_internal_maths::gaussLegendreIntegrationReal ( obj1Vals, obj1ValsIter, integOrderU, abscissas, weights, static_cast< proshade_double > ( maxSphereRad - minSphereRad ), static_cast< proshade_double > ( sphereDist ) ) );
+    obj2->setComparisonIntegrationWeightCumul         ( ProSHADE_internal_maths::gaussLegendreIntegrationReal ( obj1Vals, obj1ValsIter, integOrderU, abscissas, weights, static_cast< proshade_double > ( maxSphereRad - minSphereRad ), static_cast< proshade_double > ( sphereDist ) ) );
     obj2->setIntegrationWeightCumul                   ( ProSHADE_internal_maths::gaussLegendreIntegrationReal ( obj2Vals, obj2ValsIter, integOrderU, abscissas, weights, static_cast< proshade_double > ( maxSphereRad - minSphereRad ), static_cast< proshade_double > ( sphereDist ) ) );
     
     //================================================ Done
@@ -503,23 +577,32 @@ proshade_double ProSHADE_internal_distances::computeWeightsForEMatricesForLM ( P
     \param[in] obj2Vals Array to hold the shell values for the second object integgration.
     \param[in] GLabscissas An array to hold the pre-computed anscissas for the Gauss-Legendre integration.
     \param[in] glWeights An array to hold the pre-computed weights for the Gauss-Legendre integration.
-    \param[in] radiiVals A complex array to hold the results of combining spherical harmonics coefficients of the two objects for each shell.
+    \param[in] shellWeights An array to hold the Gauss-Legendre integration weight of each shell.
+    \param[in] obj1Coeffs A complex array to hold the weighted spherical harmonics coefficients of the first object for all orders and shells of a single band.
+    \param[in] obj2Coeffs A complex array to hold the spherical harmonics coefficients of the second object for all orders and shells of a single band.
+    \param[in] eMatBand A complex array to hold the E matrix of a single band.
  */
-void ProSHADE_internal_distances::releaseTrSigmaWorkspace ( proshade_double*& obj1Vals, proshade_double*& obj2Vals, proshade_double*& GLabscissas, proshade_double*& GLweights, proshade_complex*& radiiVals )
+void ProSHADE_internal_distances::releaseTrSigmaWorkspace ( proshade_double*& obj1Vals, proshade_double*& obj2Vals, proshade_double*& GLabscissas, proshade_double*& GLweights, proshade_double*& shellWeights, std::complex<proshade_double>*& obj1Coeffs, std::complex<proshade_double>*& obj2Coeffs, std::complex<proshade_double>*& eMatBand )
 {
     //================================================ Release memory
     delete[] obj1Vals;
     delete[] obj2Vals;
-    delete[] radiiVals;
     delete[] GLabscissas;
     delete[] GLweights;
+    delete[] shellWeights;
+    delete[] obj1Coeffs;
+    delete[] obj2Coeffs;
+    delete[] eMatBand;
     
     //================================================ Set to NULL
     obj1Vals                                          = nullptr;
     obj2Vals                                          = nullptr;
-    radiiVals                                         = nullptr;
     GLabscissas                                       = nullptr;
     GLweights                                         = nullptr;
+    shellWeights                                      = nullptr;
+    obj1Coeffs                                        = nullptr;
+    obj2Coeffs                                        = nullptr;
+    eMatBand                                          = nullptr;
     
     //================================================ Done
     return ;
@@ -545,13 +628,17 @@ void ProSHADE_internal_distances::computeEMatrices    ( ProSHADE_internal_data::
     //================================================ Allocatre memory for E matrices in the second object (first may be compared to more structures and therefore its data would be written over)
     obj2->allocateEMatrices                           ( std::min ( obj1->getMaxBand(), obj2->getMaxBand() ), settings->resolutionOversampling );
     
+    //================================================ Empty the cumulative weights back to 0.0
+    obj2->setIntegrationWeight                        ( 0.0 );
+    obj2->setComparisonIntegrationWeight              ( 0.0 );
+    
     //================================================ Initialise local variables
-    proshade_double *obj1Vals, *obj2Vals, *GLAbscissas, *GLWeights;
-    proshade_complex* radiiVals;
-    proshade_double integRange;
+    proshade_double *obj1Vals, *obj2Vals, *GLAbscissas, *GLWeights, *shellWeights;
+    std::complex<proshade_double> *obj1Coeffs, *obj2Coeffs, *eMatBand;
+    proshade_double integRange                        = 0.0;
     
     //================================================ Allocate workspace memory
-    allocateTrSigmaWorkspace                          ( std::min( obj1->getMaxSpheres(), obj2->getMaxSpheres() ), settings->integOrder, obj1Vals, obj2Vals, GLAbscissas, GLWeights,  radiiVals);
+    allocateTrSigmaWorkspace                          ( std::min( obj1->getMaxSpheres(), obj2->getMaxSpheres() ), settings->integOrder, std::min ( obj1->getMaxBand(), obj2->getMaxBand() ), obj1Vals, obj2Vals, GLAbscissas, GLWeights, shellWeights, obj1Coeffs, obj2Coeffs, eMatBand );
     
     //================================================ For each band (l), compute the E matrix integrals
     for ( int bandIter = 0; bandIter < static_cast< int > ( std::min ( obj1->getMaxBand(), obj2->getMaxBand() ) ); bandIter++ )
@@ -561,16 +648,15 @@ void ProSHADE_internal_distances::computeEMatrices    ( ProSHADE_internal_data::
         if ( settings->noIntegrationSpeedup )         { localIntegOrder = static_cast< int > ( settings->integOrder ); }
         ProSHADE_internal_maths::getLegendreAbscAndWeights ( static_cast< proshade_unsign > ( localIntegOrder ), GLAbscissas, GLWeights, settings->integApproxSteps );
         
-        //============================================ For each order (m)
+        //============================================ For each order (m), get weights for the required band(l) and order (m)
         for ( int orderIter = 0; orderIter < ( ( bandIter * 2 ) + 1 ); orderIter++ )
         {
-            //======================================== Get weights for the required band(l) and order (m)
             integRange                                = computeWeightsForEMatricesForLM ( obj1, obj2, bandIter, orderIter, obj1Vals, obj2Vals, localIntegOrder, GLAbscissas, GLWeights, settings->maxSphereDists );
-
-            //======================================== Compute E matrices value for given band (l) and order(m)
-            computeEMatricesForLM                     ( obj1, obj2, bandIter, orderIter, radiiVals, localIntegOrder, GLAbscissas, GLWeights, integRange, static_cast< proshade_double > ( settings->maxSphereDists ) );
         }
         
+        //============================================ Compute E matrices values for given band (l) and all orders (m and m')
+        computeEMatricesForBand                       ( obj1, obj2, bandIter, localIntegOrder, GLAbscissas, GLWeights, integRange, static_cast< proshade_double > ( settings->maxSphereDists ), shellWeights, obj1Coeffs, obj2Coeffs, eMatBand );
+        
         //============================================ Report progress
         if ( settings->verbose > 3 )
         {
@@ -581,7 +667,7 @@ void ProSHADE_internal_distances::computeEMatrices    ( ProSHADE_internal_data::
     }
     
     //================================================ Release the workspace memory
-    releaseTrSigmaWorkspace                           ( obj1Vals, obj2Vals, GLAbscissas, GLWeights, radiiVals );
+    releaseTrSigmaWorkspace                           ( obj1Vals, obj2Vals, GLAbscissas, GLWeights, shellWeights, obj1Coeffs, obj2Coeffs, eMatBand );
     
     //================================================ Report progress
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, "E matrices computed.", settings->messageShift );
@@ -606,11 +692,8 @@ void ProSHADE_internal_distances::normaliseEMatrices ( ProSHADE_internal_data::P
     //================================================ Report progress
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, "Starting E matrices normalisation.", settings->messageShift );
     
-    //================================================ Normalise by the Pearson's c.c. like formula
-    proshade_double eMatNormFactor                    = std::sqrt ( obj1->getIntegrationWeight() * obj2->getIntegrationWeight() );
-    
-    //================================================ If this is self-correlation (i.e. obj1 == obj2), then divide normalisation factor by 2 as the weight was applied cumulatively!
-    if ( obj1->inputOrder == obj2->inputOrder )       { eMatNormFactor /= 2.0; }
+    //================================================ Normalise by the Pearson's c.c. like formula (both weights are held by the object with the E matrices)
+    proshade_double eMatNormFactor                    = std::sqrt ( obj2->getComparisonIntegrationWeight() * obj2->getIntegrationWeight() );
     
     for ( proshade_unsign bandIter = 0; bandIter < std::min ( obj1->getMaxBand(), obj2->getMaxBand() ); bandIter++ )
     {
@@ -659,10 +742,6 @@ proshade_double ProSHADE_internal_distances::computeTraceSigmaDescriptor ( ProSH
         throw ProSHADE_exception ( "Attempted computing trace sigma descriptors when it was\n                    : not required.", "ED00018", __FILE__, __LINE__, __func__, "Attempted to pre-compute the E matrices, when the user\n                    : has specifically stated that these should not be computed.\n                    : Unless you manipulated the code, this error should never\n                    : occur; if you see this, I made a large blunder. Please let\n                    : me know!" );
     }
     
-    //================================================ Empty the cumulative weights back to 0.0 for each structure
-    obj1->setIntegrationWeight                        ( 0.0 );
-    obj1->setIntegrationWeight                        ( 0.0 );
-
     //================================================ Compute un-weighted E matrices and their weights
     computeEMatrices                                  ( obj1, obj2, settings );
     
@@ -706,6 +785,10 @@ proshade_double ProSHADE_internal_distances::computeTraceSigmaDescriptor ( ProSH
  */
 void ProSHADE_internal_data::ProSHADE_data::allocateSO3CoeffsSpace ( proshade_unsign band )
 {
+    //================================================ Release any previous coefficients
+    if ( this->so3Coeffs        != nullptr ) { fftw_free ( this->so3Coeffs );        this->so3Coeffs        = nullptr; }
+    if ( this->so3CoeffsInverse != nullptr ) { fftw_free ( this->so3CoeffsInverse ); this->so3CoeffsInverse = nullptr; }
+    
     //================================================ Allocate the memory
     this->so3Coeffs                                   = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * static_cast<proshade_unsign>( ( 4 * pow( static_cast<proshade_double> ( band ), 3.0 ) - static_cast<proshade_double> ( band ) ) / 3.0 ) ) );
     this->so3CoeffsInverse                            = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * static_cast<proshade_unsign>( pow( static_cast<proshade_double> ( band ) * 2.0, 3.0 ) ) ) );
@@ -737,14 +820,36 @@ void ProSHADE_internal_distances::generateSO3CoeffsFromEMatrices ( ProSHADE_inte
     //================================================ Allocate memory for the coefficients
     obj2->allocateSO3CoeffsSpace                      ( obj2->getEMatDim ( ) );
     
+    //================================================ Convert
+    fillSO3CoeffsFromEMatrices                        ( obj2, obj2->getEMatDim ( ), obj2->getSO3Coeffs ( ) );
+    
+    //================================================ Report progress
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, "SO(3) coefficients obtained.", settings->messageShift );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function converts the E matrices of the bands lower than the given bandwidth to SO(3) coefficients.
+ 
+    This function converts the E matrix values into the SO(3) transform coefficients of the given bandwidth by applying
+    the Wigner normalisation factor and changing the sign as required by SOFT library. The bandwidth may be lower than the
+    E matrices bandwidth, in which case only the low bands are used (e.g. for a coarse rotation function).
+ 
+    \param[in] obj2 The ProSHADE_data object holding the E matrices.
+    \param[in] band The bandwidth of the SO(3) coefficients, must not be larger than the E matrices bandwidth.
+    \param[in] coeffs The array of ( 4 * band^3 - band ) / 3 values to which the coefficients will be saved.
+ */
+void ProSHADE_internal_distances::fillSO3CoeffsFromEMatrices ( ProSHADE_internal_data::ProSHADE_data* obj2, proshade_unsign band, proshade_complex* coeffs )
+{
     //================================================ Initialise local variables
     proshade_double wigNorm, hlpValReal, hlpValImag;
     proshade_double signValue                         = 1.0;
     proshade_unsign indexO;
-    proshade_complex hlpVal;
     
     //================================================ For each band (l)
-    for ( proshade_signed bandIter = 0; bandIter < static_cast<proshade_signed> ( obj2->getEMatDim ( ) ); bandIter++ )
+    for ( proshade_signed bandIter = 0; bandIter < static_cast<proshade_signed> ( band ); bandIter++ )
     {
         //============================================ Get wigner normalisation factor
         wigNorm                                       = 2.0 * M_PI * sqrt ( 2.0 / (2.0 * static_cast< proshade_double > ( bandIter ) + 1.0 ) );
@@ -760,13 +865,12 @@ void ProSHADE_internal_distances::generateSO3CoeffsFromEMatrices ( ProSHADE_inte
             for ( proshade_signed order2Iter = 0; order2Iter < ( ( bandIter * 2 ) + 1 ); order2Iter++ )
             {
                 //==================================== Find output index
-                indexO                                = static_cast< proshade_unsign > ( so3CoefLoc ( static_cast< int > ( orderIter - bandIter ), static_cast< int > ( order2Iter - bandIter ), static_cast< int > ( bandIter ), static_cast< int > ( obj2->getEMatDim ( ) ) ) );
+                indexO                                = static_cast< proshade_unsign > ( so3CoefLoc ( static_cast< int > ( orderIter - bandIter ), static_cast< int > ( order2Iter - bandIter ), static_cast< int > ( bandIter ), static_cast< int > ( band ) ) );
                 
                 //==================================== Compute and save the SO(3) coefficients
                 obj2->getEMatrixValue                 ( static_cast< proshade_unsign > ( bandIter ), static_cast< proshade_unsign > ( orderIter ), static_cast< proshade_unsign > ( order2Iter ), &hlpValReal, &hlpValImag );
-                hlpVal[0]                             = hlpValReal * wigNorm * signValue;
-                hlpVal[1]                             = hlpValImag * wigNorm * signValue;
-                obj2->setSO3CoeffValue                ( indexO, hlpVal );
+                coeffs[indexO][0]                     = hlpValReal * wigNorm * signValue;
+                coeffs[indexO][1]                     = hlpValImag * wigNorm * signValue;
                 
                 //==================================== Switch the sign value
                 signValue                            *= -1.0;
@@ -774,9 +878,6 @@ void ProSHADE_internal_distances::generateSO3CoeffsFromEMatrices ( ProSHADE_inte
         }
     }
     
-    //================================================ Report progress
-    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, "SO(3) coefficients obtained.", settings->messageShift );
-    
     //================================================ Done
     return ;
     
@@ -808,6 +909,10 @@ void ProSHADE_internal_distances::allocateInvSOFTWorkspaces ( proshade_complex*&
 
 /*! \brief This function prepares the FFTW plan for the inverse SO(3) transform.
  
+    As the plan is executed by SOFT2.0 on the arrays supplied at planning time, it cannot be taken from the plans cache. It is,
+    however, planned with the same planner flags as the cached plans, so that any wisdom accumulated (or loaded) for this
+    transform shape is re-used.
+ 
     \param[in] inverseSO3 The FFTW_PLAN pointer where the result will be saved.
     \param[in] band The bandwidth of the computations.
     \param[in] work1 The workspace to be used for the computation.
@@ -847,7 +952,7 @@ void ProSHADE_internal_distances::prepareInvSOFTPlan ( fftw_plan* inverseSO3, in
                                                                              ostride,
                                                                              odist,
                                                                              FFTW_FORWARD,
-                                                                             FFTW_ESTIMATE );
+                                                                             ProSHADE_internal_fftw::getPlannerFlags ( ) );
             
     //================================================ Done
     return ;
@@ -871,37 +976,34 @@ void ProSHADE_internal_distances::releaseInvSOFTMemory ( proshade_complex*& work
     return ;
 }
 
-/*! \brief This function computes the inverse SO(3) transform.
+/*! \brief This function computes the inverse SO(3) transform using the SOFT library naive implementation.
  
     This function firstly allocates all the required workspaces for the inverse SO(3) Fourier Transform, then it
     prepares the FFTW plans for performing the FFTW inverse Fourier transform in the SO(3) space using FFTW and
-    finally it subjects the SO(3) coeffficients available at this point to the computation. The results are saved
-    into the second object, memory is released and function terminates.
+    finally it subjects the SO(3) coeffficients to the SOFT library computation on a single thread.
  
-    \param[in] obj1 The first ProSHADE_data object against which comparison is done.
-    \param[in] obj2 The second ProSHADE_data object which is compared to the first.
+    \param[in] band The bandwidth of the transform.
+    \param[in] coeffs The SO(3) coefficients to be inverted.
+    \param[in] invCoeffs The array of ( 2 * band )^3 values to which the inverse transform results will be saved.
     \param[in] settings A pointer to settings class containing all the information required for the task.
  */
-void ProSHADE_internal_distances::computeInverseSOFTTransform ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings )
+void ProSHADE_internal_distances::computeInverseSOFTNaive ( proshade_unsign band, proshade_complex* coeffs, proshade_complex* invCoeffs, ProSHADE_settings* )
 {
-    //================================================ Report progress
-    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Computing inverse SO(3) Fourier transform.", settings->messageShift );
-    
     //================================================ Initialise local variables
     proshade_complex *workspace1, *workspace2;
     proshade_double *workspace3;
     fftw_plan inverseSO3;
     
     //================================================ Allocate memory for the workspaces
-    allocateInvSOFTWorkspaces                         ( workspace1, workspace2, workspace3, obj2->getEMatDim ( ) );
+    allocateInvSOFTWorkspaces                         ( workspace1, workspace2, workspace3, band );
     
     //================================================ Prepare the FFTW plan
-    prepareInvSOFTPlan                                ( &inverseSO3, static_cast< int > ( obj2->getEMatDim ( ) ), workspace1, obj2->getInvSO3Coeffs ( ) );
+    prepareInvSOFTPlan                                ( &inverseSO3, static_cast< int > ( band ), workspace1, invCoeffs );
     
     //================================================ Compute the transform
-    Inverse_SO3_Naive_fftw                            ( static_cast< int > ( obj2->getEMatDim ( ) ),
-                                                        obj2->getSO3Coeffs ( ),
-                                                        obj2->getInvSO3Coeffs ( ),
+    Inverse_SO3_Naive_fftw                            ( static_cast< int > ( band ),
+                                                        coeffs,
+                                                        invCoeffs,
                                                         workspace1,
                                                         workspace2,
                                                         workspace3,
@@ -912,16 +1014,515 @@ void ProSHADE_internal_distances::computeInverseSOFTTransform ( ProSHADE_interna
     releaseInvSOFTMemory                              ( workspace1, workspace2, workspace3 );
     fftw_destroy_plan                                 ( inverseSO3 );
     
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function lists the (m1, m2) order pairs for which the Wigner d functions are needed by the inverse SO(3) transform.
+ 
+    Following the SOFT library, the Wigner d functions computed for the order pair (m1, m2) are re-used for all the order
+    pairs related by symmetry, i.e. the list contains the pairs (m, m) for 0 <= m < band, the pairs (m, 0) for 0 < m < band
+    and the pairs (m1, m2) for 0 < m1 < m2 < band. For each pair, the offset of its Wigner d table (having
+    ( band - max ( m1, m2 ) ) * 2 * band values) in a single block holding all the tables is also given.
+ 
+    \param[in] band The bandwidth of the transform.
+    \param[in] orderPairs Vector to which the order pairs will be saved.
+    \param[in] wignerOffsets Vector to which the table offsets will be saved; it has one more element holding the total size.
+ */
+void ProSHADE_internal_distances::getInvSOFTOrderPairs ( int band, std::vector< std::pair< int, int > >* orderPairs, std::vector< size_t >* wignerOffsets )
+{
+    //================================================ Initialise local variables
+    size_t noSamples                                  = static_cast< size_t > ( 2 * band );
+    orderPairs->clear                                 ( );
+    wignerOffsets->clear                              ( );
+    
+    //================================================ List the pairs
+    for ( int m1 = 0; m1 < band; m1++ )               { orderPairs->emplace_back ( m1, m1 ); }
+    for ( int m1 = 1; m1 < band; m1++ )               { orderPairs->emplace_back ( m1, 0  ); }
+    for ( int m1 = 1; m1 < band; m1++ )               { for ( int m2 = m1 + 1; m2 < band; m2++ ) { orderPairs->emplace_back ( m1, m2 ); } }
+    
+    //================================================ Find the table offsets
+    size_t offset                                     = 0;
+    for ( size_t prIt = 0; prIt < orderPairs->size(); prIt++ )
+    {
+        wignerOffsets->emplace_back                   ( offset );
+        offset                                       += static_cast< size_t > ( band - std::max ( orderPairs->at(prIt).first, orderPairs->at(prIt).second ) ) * noSamples;
+    }
+    wignerOffsets->emplace_back                       ( offset );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+//==================================================== Local variables
+namespace ProSHADE_internal_distances
+{
+    static std::mutex invSOFTWignerMutex;             //!< Mutex guarding the Wigner d tables cache.
+    static std::map< int, std::vector< proshade_double > > invSOFTWignerTables; //!< The Wigner d tables for the inverse SO(3) transform keyed by the bandwidth.
+    static size_t invSOFTWignerCachedValues           = 0; //!< The number of values held by all the cached tables.
+    static const size_t invSOFTWignerMaxValues        = static_cast< size_t > ( 1 ) << 24; //!< The maximum number of values (128MB) to be held by all the cached tables.
+    static proshade_unsign invSOFTWignerUsers         = 0; //!< The number of settings objects currently in existence; the tables are released when the last one is destroyed.
+}
+
+/*! \brief This function registers a new user of the Wigner d tables cache.
+ 
+    Each ProSHADE_settings object registers itself when created and releases itself (see releaseInvSOFTWignerTables()) when destroyed,
+    so that the cached tables live only as long as there is any settings object which could be used to compute with them.
+ */
+void ProSHADE_internal_distances::acquireInvSOFTWignerTables ( void )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( invSOFTWignerMutex );
+    
+    //================================================ Register the user
+    invSOFTWignerUsers                               += 1;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function releases a user of the Wigner d tables cache, freeing all the cached tables when it was the last one.
+ */
+void ProSHADE_internal_distances::releaseInvSOFTWignerTables ( void )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( invSOFTWignerMutex );
+    
+    //================================================ Release the user
+    if ( invSOFTWignerUsers > 0 ) { invSOFTWignerUsers -= 1; }
+    
+    //================================================ Free the tables if nobody can use them any more
+    if ( invSOFTWignerUsers == 0 )
+    {
+        std::map< int, std::vector< proshade_double > >().swap ( invSOFTWignerTables );
+        invSOFTWignerCachedValues                     = 0;
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function returns the Wigner d tables for all the order pairs of the inverse SO(3) transform of a given bandwidth.
+ 
+    The tables are computed (in parallel) the first time a bandwidth is requested and re-used by all the subsequent transforms of the
+    same bandwidth, until the last settings object is destroyed (see releaseInvSOFTWignerTables()). If holding the tables would exceed
+    the cache size limit, nullptr is returned and the caller needs to compute the tables itself.
+ 
+    \param[in] band The bandwidth of the transform.
+    \param[in] settings A pointer to settings class containing all the information required for the task.
+    \param[out] X Pointer to the tables laid out as given by getInvSOFTOrderPairs(), or nullptr if these are not cached.
+ */
+const proshade_double* ProSHADE_internal_distances::getInvSOFTWignerTables ( int band, ProSHADE_settings* settings )
+{
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+    //================================================ The SOFT Wigner d functions are not exported by the Windows library
+    return                                            ( nullptr );
+#else
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( invSOFTWignerMutex );
+    
+    //================================================ Return cached tables if available
+    std::map< int, std::vector< proshade_double > >::iterator found = invSOFTWignerTables.find ( band );
+    if ( found != invSOFTWignerTables.end() ) { return ( found->second.data() ); }
+    
+    //================================================ Check the size
+    std::vector< std::pair< int, int > > orderPairs;
+    std::vector< size_t > wignerOffsets;
+    getInvSOFTOrderPairs                              ( band, &orderPairs, &wignerOffsets );
+    if ( ( invSOFTWignerCachedValues + wignerOffsets.back() ) > invSOFTWignerMaxValues ) { return ( nullptr ); }
+    
+    //================================================ Compute the evaluation points
+    int noSamples                                     = 2 * band;
+    std::vector< proshade_double > evalPts            ( static_cast< size_t > ( 4 * noSamples ) );
+    SinEvalPts                                        ( noSamples, &evalPts[0] );
+    CosEvalPts                                        ( noSamples, &evalPts[static_cast< size_t > ( noSamples )] );
+    SinEvalPts2                                       ( noSamples, &evalPts[static_cast< size_t > ( 2 * noSamples )] );
+    CosEvalPts2                                       ( noSamples, &evalPts[static_cast< size_t > ( 3 * noSamples )] );
+    
+    //================================================ Compute the tables
+    std::vector< proshade_double >& tables            = invSOFTWignerTables[band];
+    tables.resize                                     ( std::max ( wignerOffsets.back(), static_cast< size_t > ( 1 ) ) );
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( orderPairs.size() ), settings->noThreads, [&] ( proshade_unsign prIt, proshade_unsign )
+    {
+        std::vector< proshade_double > scratch        ( static_cast< size_t > ( 6 * noSamples ) );
+        genWigTrans_L2                                ( orderPairs.at(prIt).first, orderPairs.at(prIt).second, band,
+                                                       &evalPts[0], &evalPts[static_cast< size_t > ( noSamples )], &evalPts[static_cast< size_t > ( 2 * noSamples )], &evalPts[static_cast< size_t > ( 3 * noSamples )],
+                                                       &tables[wignerOffsets.at(prIt)], &scratch[0] );
+    } );
+    invSOFTWignerCachedValues                        += wignerOffsets.back();
+    
+    //================================================ Done
+    return                                            ( tables.data() );
+#endif
+}
+
+/*! \brief This function synthesises the inverse Wigner transforms of all the order pairs sharing the Wigner d functions of order pair (m1, m2).
+ 
+    This function does the work of one step of the SOFT library Inverse_SO3_Naive_fftw() order loops for complex data, i.e.
+    it computes the inverse Wigner transforms of the order pairs (m1, m2) and all the pairs related to it by symmetry, using
+    the Wigner d functions computed for (m1, m2). As the different order pairs write to different parts of the output array,
+    the function can be run for different (m1, m2) pairs in parallel.
+ 
+    \param[in] m1 The first order, with 0 <= m1 < band.
+    \param[in] m2 The second order, which must be either m1, 0, or larger than m1.
+    \param[in] band The bandwidth of the transform.
+    \param[in] coeffs The SO(3) coefficients to be inverted.
+    \param[in] data The ( 2 * band )^3 array to which the results for these orders will be written.
+    \param[in] wignersTrans The Wigner d functions for the order pair (m1, m2) as computed by genWigTrans_L2().
+    \param[in] workspace The scratch array of 2 * band values required by the SOFT synthesis; each concurrent call needs its own.
+ */
+void ProSHADE_internal_distances::synthesiseInvSOFTOrders ( int m1, int m2, int band, fftw_complex* coeffs, fftw_complex* data, proshade_double* wignersTrans, fftw_complex* workspace )
+{
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+    //================================================ The SOFT Wigner synthesis functions are not exported by the Windows library
+    throw ProSHADE_exception ( "The parallel inverse SO(3) transform is not available.", "ED00080", __FILE__, __LINE__, __func__, "The parallel inverse SOFT transform is not available on\n                    : Windows, as the SOFT library does not export the Wigner\n                    : synthesis functions there. The SOFT library naive\n                    : transform is used instead; this error should never occur.\n                    : If you see this, please let me know!" );
+#else
+    //================================================ Synthesis of a single order pair; variant 0 is the plain synthesis, while 1 and 2 apply the X and Y sign fudges
+    auto synthesise = [&] ( int variant, int locM1, int locM2, int callM1, int callM2 )
+    {
+        fftw_complex* coeffsPtr                       = coeffs + coefLoc_so3 ( locM1, locM2, band );
+        fftw_complex* dataPtr                         = data   + sampLoc_so3 ( locM1, locM2, band );
+        if      ( variant == 0 ) { wigNaiveSynthesis_fftw  ( callM1, callM2, band, coeffsPtr, wignersTrans, dataPtr, workspace ); }
+        else if ( variant == 1 ) { wigNaiveSynthesis_fftwX ( callM1, callM2, band, coeffsPtr, wignersTrans, dataPtr, workspace ); }
+        else                     { wigNaiveSynthesis_fftwY ( callM1, callM2, band, coeffsPtr, wignersTrans, dataPtr, workspace ); }
+    };
+    
+    //================================================ The (0, 0) pair
+    if ( ( m1 == 0 ) && ( m2 == 0 ) )
+    {
+        synthesise                                    ( 0,  0,   0,   0,   0  );
+    }
+    //================================================ The (m, m) pairs
+    else if ( m1 == m2 )
+    {
+        synthesise                                    ( 0,  m1,  m1,  m1,  m1 );
+        synthesise                                    ( 0, -m1, -m1, -m1, -m1 );
+        synthesise                                    ( 2, -m1,  m1, -m1,  m1 );
+        synthesise                                    ( 2,  m1, -m1,  m1, -m1 );
+    }
+    //================================================ The (m, 0) pairs
+    else if ( m2 == 0 )
+    {
+        synthesise                                    ( 0,  m1,  0,   m1,  0  );
+        synthesise                                    ( 1, -m1,  0,  -m1,  0  );
+        synthesise                                    ( 1,  0,   m1,  0,   m1 );
+        synthesise                                    ( 0,  0,  -m1,  0,  -m1 );
+    }
+    //================================================ The (m1, m2) pairs with m1 < m2
+    else
+    {
+        synthesise                                    ( 0,  m1,  m2,  m1,  m2 );
+        synthesise                                    ( 1, -m1, -m2, -m1, -m2 );
+        synthesise                                    ( 2,  m1, -m2,  m1, -m2 );
+        synthesise                                    ( 2, -m1,  m2, -m1,  m2 );
+        synthesise                                    ( 1,  m2,  m1,  m2,  m1 );
+        synthesise                                    ( 0, -m2, -m1, -m2, -m1 );
+        synthesise                                    ( 2,  m2, -m1,  m1, -m2 );
+        synthesise                                    ( 2, -m2,  m1, -m1,  m2 );
+    }
+    
+    //================================================ Done
+    return ;
+#endif
+}
+
+/*! \brief This function computes the inverse SO(3) transform in parallel.
+ 
+    This function gives the same results as the SOFT library Inverse_SO3_Naive_fftw() function (see computeInverseSOFTNaive()), but
+    the inverse Wigner transforms of the independent order pairs are distributed over the threads, the Wigner d tables are re-used
+    between the transforms of the same bandwidth (see getInvSOFTWignerTables()) and the final Fourier transforms are done by the
+    threaded FFTW using a cached plan.
+ 
+    \param[in] band The bandwidth of the transform.
+    \param[in] coeffs The SO(3) coefficients to be inverted.
+    \param[in] invCoeffs The array of ( 2 * band )^3 values to which the inverse transform results will be saved.
+    \param[in] settings A pointer to settings class containing all the information required for the task.
+ */
+void ProSHADE_internal_distances::computeInverseSOFTParallel ( proshade_unsign band, proshade_complex* coeffs, proshade_complex* invCoeffs, ProSHADE_settings* settings )
+{
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+    //================================================ The SOFT Wigner synthesis functions are not exported by the Windows library, use the naive transform
+    computeInverseSOFTNaive                           ( band, coeffs, invCoeffs, settings );
+#else
+    //================================================ Initialise local variables
+    int bw                                            = static_cast< int > ( band );
+    int noSamples                                     = 2 * bw;
+    size_t noSamplesSz                                = static_cast< size_t > ( noSamples );
+    size_t noValues                                   = noSamplesSz * noSamplesSz * noSamplesSz;
+    std::vector< std::pair< int, int > > orderPairs;
+    std::vector< size_t > wignerOffsets;
+    getInvSOFTOrderPairs                              ( bw, &orderPairs, &wignerOffsets );
+    proshade_unsign noTasks                           = static_cast< proshade_unsign > ( orderPairs.size() );
+    
+    //================================================ Get the cached Wigner d tables, or prepare for computing them on the fly
+    const proshade_double* cachedWigners              = getInvSOFTWignerTables ( bw, settings );
+    std::vector< proshade_double > evalPts;
+    std::vector< std::vector< proshade_double > > workerWigners;
+    proshade_unsign noWorkers                         = ProSHADE_internal_misc::getNumberOfThreads ( settings->noThreads, noTasks );
+    if ( cachedWigners == nullptr )
+    {
+        evalPts.resize                                ( 4 * noSamplesSz );
+        SinEvalPts                                    ( noSamples, &evalPts[0] );
+        CosEvalPts                                    ( noSamples, &evalPts[noSamplesSz] );
+        SinEvalPts2                                   ( noSamples, &evalPts[2 * noSamplesSz] );
+        CosEvalPts2                                   ( noSamples, &evalPts[3 * noSamplesSz] );
+        workerWigners.resize                          ( noWorkers, std::vector< proshade_double > ( ( static_cast< size_t > ( bw ) + 6 ) * noSamplesSz ) );
+    }
+    
+    //================================================ Allocate the SOFT synthesis scratch space for each worker
+    fftw_complex* synthWorkspace                      = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * noSamplesSz * static_cast< size_t > ( noWorkers ) ) );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( synthWorkspace, __FILE__, __LINE__, __func__ );
+    
+    //================================================ Inverse Wigner transforms of all order pairs
+    ProSHADE_internal_misc::parallelFor               ( noTasks, settings->noThreads, [&] ( proshade_unsign prIt, proshade_unsign workerIt )
+    {
+        int m1                                        = orderPairs.at(prIt).first;
+        int m2                                        = orderPairs.at(prIt).second;
+        proshade_double* wigners                      = nullptr;
+        if ( cachedWigners != nullptr )
+        {
+            wigners                                   = const_cast< proshade_double* > ( cachedWigners + wignerOffsets.at(prIt) );
+        }
+        else
+        {
+            wigners                                   = &workerWigners.at(workerIt)[0];
+            genWigTrans_L2                            ( m1, m2, bw, &evalPts[0], &evalPts[noSamplesSz], &evalPts[2 * noSamplesSz], &evalPts[3 * noSamplesSz],
+                                                        wigners, wigners + ( static_cast< size_t > ( bw ) * noSamplesSz ) );
+        }
+        synthesiseInvSOFTOrders                       ( m1, m2, bw, coeffs, invCoeffs, wigners, synthWorkspace + ( static_cast< size_t > ( workerIt ) * noSamplesSz ) );
+    } );
+    fftw_free                                         ( synthWorkspace );
+    
+    //================================================ Set the zeroes required by the Fourier transform (as done by SOFT)
+    fftw_complex* dataPtr                             = invCoeffs + ( noSamplesSz * static_cast< size_t > ( bw ) );
+    for ( int m1 = 0; m1 < bw; m1++ )
+    {
+        memset                                        ( dataPtr, 0, sizeof ( fftw_complex ) * noSamplesSz );
+        dataPtr                                      += ( 2 * noSamplesSz ) * static_cast< size_t > ( bw );
+    }
+    dataPtr                                           = invCoeffs + ( static_cast< size_t > ( bw ) * noSamplesSz * noSamplesSz );
+    memset                                            ( dataPtr, 0, sizeof ( fftw_complex ) * noSamplesSz * noSamplesSz );
+    dataPtr                                          += ( noSamplesSz * noSamplesSz ) + ( noSamplesSz * static_cast< size_t > ( bw ) );
+    for ( int m1 = 1; m1 < bw; m1++ )
+    {
+        memset                                        ( dataPtr, 0, sizeof ( fftw_complex ) * noSamplesSz );
+        dataPtr                                      += ( 2 * noSamplesSz ) * static_cast< size_t > ( bw );
+    }
+    
+    //================================================ Get the workspace and the cached Fourier transform plan (threaded, unless already within a parallel loop)
+    fftw_complex* workspace                           = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * noValues ) );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( workspace, __FILE__, __LINE__, __func__ );
+    int fftThreads                                    = 1;
+    if ( !ProSHADE_internal_misc::isInsideParallelLoop ( ) ) { fftThreads = static_cast< int > ( ProSHADE_internal_misc::getNumberOfThreads ( settings->noThreads, static_cast< proshade_unsign > ( noSamples * noSamples ) ) ); }
+    fftw_plan fftPlan                                 = ProSHADE_internal_fftw::getBatchedDFT1DPlan ( noSamples, noSamples * noSamples, workspace, invCoeffs, FFTW_FORWARD, fftThreads );
+    
+    //================================================ Transpose, Fourier transform, transpose and Fourier transform again
+    transpose_cx                                      ( invCoeffs, workspace, noSamples, noSamples * noSamples );
+    fftw_execute_dft                                  ( fftPlan, workspace, invCoeffs );
+    transpose_cx                                      ( invCoeffs, workspace, noSamples, noSamples * noSamples );
+    fftw_execute_dft                                  ( fftPlan, workspace, invCoeffs );
+    
+    //================================================ Normalise
+    proshade_double normFactor                        = ( 1.0 / static_cast< proshade_double > ( noSamples ) ) * ( static_cast< proshade_double > ( bw ) / M_PI );
+    for ( size_t iter = 0; iter < noValues; iter++ )
+    {
+        invCoeffs[iter][0]                           *= normFactor;
+        invCoeffs[iter][1]                           *= normFactor;
+    }
+    
+    //================================================ Release memory
+    fftw_free                                         ( workspace );
+#endif
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function returns the inverse SO(3) transform implementation selected by the settings.
+ 
+    \param[in] settings A pointer to settings class containing all the information required for the task.
+    \param[out] X The function computing the inverse SO(3) transform.
+ */
+ProSHADE_internal_distances::inverseSOFTBackend ProSHADE_internal_distances::getInverseSOFTBackend ( ProSHADE_settings* settings )
+{
+    //================================================ Select the backend
+    switch ( settings->invSOFTBackend )
+    {
+        case 0:
+            return                                    ( &computeInverseSOFTNaive );
+            
+        case 1:
+            return                                    ( &computeInverseSOFTParallel );
+            
+        default:
+            throw ProSHADE_exception ( "Unknown inverse SO(3) Fourier transform backend requested.", "ED00078", __FILE__, __LINE__, __func__, "The inverse SOFT backend setting (-U or --invSOFT) has a\n                    : value for which there is no implementation. Please use\n                    : 0 for the SOFT library naive transform or 1 for the\n                    : parallel transform." );
+    }
+}
+
+/*! \brief This function computes the inverse SO(3) transform.
+ 
+    This function subjects the SO(3) coeffficients available at this point to the inverse SO(3) Fourier Transform using the
+    implementation selected by the settings (see getInverseSOFTBackend()). The results are saved into the second object.
+ 
+    \param[in] obj2 The ProSHADE_data object holding the SO(3) coefficients, to which the results will be saved.
+    \param[in] settings A pointer to settings class containing all the information required for the task.
+ */
+void ProSHADE_internal_distances::computeInverseSOFTTransform ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings )
+{
     //================================================ Report progress
-    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, "Inverse SO(3) Fourier transform computed.", settings->messageShift );
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Computing inverse SO(3) Fourier transform.", settings->messageShift );
     
+    //================================================ Compute the transform
+    inverseSOFTBackend invSOFT                        = getInverseSOFTBackend ( settings );
+    invSOFT                                           ( obj2->getEMatDim ( ), obj2->getSO3Coeffs ( ), obj2->getInvSO3Coeffs ( ), settings );
     
+    //================================================ Report progress
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, "Inverse SO(3) Fourier transform computed.", settings->messageShift );
     
     //================================================ Done
     return ;
     
 }
 
+/*! \brief This function evaluates the rotation function directly at the given rotation.
+ 
+    This function computes the Wigner D matrices for the given Euler angles and sums the traces of their products with the
+    E matrices over all bands, i.e. it computes the value of the full bandwidth rotation function at this rotation without
+    computing the rest of the rotation function map. Upon return, the obj2 Wigner matrices hold the values for this rotation.
+ 
+    \param[in] obj2 The ProSHADE_data object holding the E matrices.
+    \param[in] settings A pointer to settings class containing all the information required for the task.
+    \param[in] eulA The Euler ZYZ convention alpha angle value.
+    \param[in] eulB The Euler ZYZ convention beta angle value.
+    \param[in] eulG The Euler ZYZ convention gamma angle value.
+    \param[out] ret The rotation function value at the given rotation.
+ */
+proshade_double ProSHADE_internal_distances::evaluateRotationFunctionAt ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings, proshade_double eulA, proshade_double eulB, proshade_double eulG )
+{
+    //================================================ Initialise local variables
+    proshade_double ret                               = 0.0;
+    proshade_double EMatR, EMatI, WigDR, WigDI;
+    
+    //================================================ Compute the Wigner D matrices for the Euler angles
+    ProSHADE_internal_wigner::computeWignerMatricesForRotation ( settings, obj2, eulA, eulB, eulG );
+    
+    //================================================ Sum the traces of D_{l} * E_{l}
+    for ( proshade_unsign bandIter = 0; bandIter < obj2->getEMatDim(); bandIter++ )
+    {
+        for ( proshade_unsign order1 = 0; order1 < ( ( bandIter * 2 ) + 1 ); order1++ )
+        {
+            for ( proshade_unsign order2 = 0; order2 < ( ( bandIter * 2 ) + 1 ); order2++ )
+            {
+                obj2->getEMatrixValue                 ( bandIter, order1, order2, &EMatR, &EMatI );
+                obj2->getWignerMatrixValue            ( bandIter, order2, order1, &WigDR, &WigDI );
+                ret                                  += ProSHADE_internal_maths::complexMultiplicationRealOnly ( &WigDR, &WigDI, &EMatR, &EMatI );
+            }
+        }
+    }
+    
+    //================================================ Done
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function finds the rotation function maximum by the coarse-to-fine search.
+ 
+    This function computes the rotation function only at a quarter of the E matrices bandwidth (using the low band E matrices),
+    finds its highest peaks and then refines each of these by a pattern search over the Euler angles, where the full bandwidth
+    rotation function is evaluated directly (see evaluateRotationFunctionAt()). The search step starts at the coarse map sampling
+    and is halved whenever no neighbour improves, until it is below half of the full bandwidth sampling. Upon return, the obj2
+    Wigner matrices hold the values for the best rotation.
+ 
+    \param[in] obj2 The ProSHADE_data object holding the E matrices.
+    \param[in] settings A pointer to settings class containing all the information required for the task.
+    \param[in] eulA Pointer to where the Euler alpha angle of the best rotation will be saved.
+    \param[in] eulB Pointer to where the Euler beta angle of the best rotation will be saved.
+    \param[in] eulG Pointer to where the Euler gamma angle of the best rotation will be saved.
+    \param[out] ret The full bandwidth rotation function value at the best rotation.
+ */
+proshade_double ProSHADE_internal_distances::findRotationFunctionPeakCoarseToFine ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings, proshade_double* eulA, proshade_double* eulB, proshade_double* eulG )
+{
+    //================================================ Report progress
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Searching for the rotation function peak coarse-to-fine.", settings->messageShift );
+    
+    //================================================ Initialise local variables
+    const proshade_unsign noCandidates                = 4;
+    proshade_unsign fullBand                          = obj2->getEMatDim ( );
+    proshade_unsign coarseBand                        = std::min ( fullBand, std::max ( fullBand / 4, static_cast< proshade_unsign > ( 8 ) ) );
+    size_t noCoeffs                                   = static_cast< size_t > ( totalCoeffs_so3 ( static_cast< int > ( coarseBand ) ) );
+    size_t noMapValues                                = static_cast< size_t > ( 8 ) * coarseBand * coarseBand * coarseBand;
+    
+    //================================================ Compute the coarse rotation function from the low band E matrices
+    proshade_complex* coarseCoeffs                    = reinterpret_cast< proshade_complex* > ( fftw_malloc ( sizeof ( proshade_complex ) * noCoeffs ) );
+    proshade_complex* coarseMap                       = reinterpret_cast< proshade_complex* > ( fftw_malloc ( sizeof ( proshade_complex ) * noMapValues ) );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( coarseCoeffs, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( coarseMap,    __FILE__, __LINE__, __func__ );
+    fillSO3CoeffsFromEMatrices                        ( obj2, coarseBand, coarseCoeffs );
+    getInverseSOFTBackend ( settings )                ( coarseBand, coarseCoeffs, coarseMap, settings );
+    
+    //================================================ Find the coarse peaks, highest first
+    std::vector< ProSHADE_internal_peakSearch::ProSHADE_rotationPeak > allPeaks = ProSHADE_internal_peakSearch::getAllPeaksNaive ( coarseMap, coarseBand * 2, static_cast< proshade_signed > ( settings->peakNeighbours ), settings->noIQRsFromMedianNaivePeak, settings->noThreads );
+    std::sort                                         ( allPeaks.begin(), allPeaks.end(), [] ( const ProSHADE_internal_peakSearch::ProSHADE_rotationPeak& a, const ProSHADE_internal_peakSearch::ProSHADE_rotationPeak& b ) { return ( a.height > b.height ); } );
+    fftw_free                                         ( coarseCoeffs );
+    fftw_free                                         ( coarseMap );
+    
+    //================================================ No peaks, use the identity as the original search does
+    std::vector< std::vector< proshade_double > > candidates;
+    for ( size_t pkIt = 0; pkIt < std::min ( allPeaks.size(), static_cast< size_t > ( noCandidates ) ); pkIt++ ) { candidates.emplace_back ( std::vector< proshade_double > { allPeaks.at(pkIt).eulA, allPeaks.at(pkIt).eulB, allPeaks.at(pkIt).eulG } ); }
+    if ( candidates.size() == 0 ) { candidates.emplace_back ( std::vector< proshade_double > { 0.0, 0.0, 0.0 } ); }
+    
+    //================================================ Refine each candidate at full bandwidth
+    proshade_double bestValue                         = -std::numeric_limits< proshade_double >::infinity ( );
+    proshade_double finalStep                         = M_PI / ( 4.0 * static_cast< proshade_double > ( fullBand ) );
+    for ( size_t cdIt = 0; cdIt < candidates.size(); cdIt++ )
+    {
+        //============================================ Start from the candidate
+        proshade_double pos[3]                        = { candidates.at(cdIt)[0], candidates.at(cdIt)[1], candidates.at(cdIt)[2] };
+        proshade_double posValue                      = evaluateRotationFunctionAt ( obj2, settings, pos[0], pos[1], pos[2] );
+        proshade_double step                          = M_PI / static_cast< proshade_double > ( coarseBand );
+        
+        //============================================ Pattern search: move to the best improving neighbour, or halve the step
+        while ( step > finalStep )
+        {
+            proshade_double bestNeighValue            = posValue;
+            proshade_double bestNeigh[3]              = { pos[0], pos[1], pos[2] };
+            for ( int angIt = 0; angIt < 3; angIt++ )
+            {
+                for ( int sgnIt = -1; sgnIt <= 1; sgnIt += 2 )
+                {
+                    proshade_double neigh[3]          = { pos[0], pos[1], pos[2] };
+                    neigh[angIt]                     += static_cast< proshade_double > ( sgnIt ) * ( angIt == 1 ? step / 2.0 : step );
+                    proshade_double neighValue        = evaluateRotationFunctionAt ( obj2, settings, neigh[0], neigh[1], neigh[2] );
+                    if ( neighValue > bestNeighValue ) { bestNeighValue = neighValue; bestNeigh[0] = neigh[0]; bestNeigh[1] = neigh[1]; bestNeigh[2] = neigh[2]; }
+                }
+            }
+            
+            if ( bestNeighValue > posValue ) { posValue = bestNeighValue; pos[0] = bestNeigh[0]; pos[1] = bestNeigh[1]; pos[2] = bestNeigh[2]; }
+            else                             { step /= 2.0; }
+        }
+        
+        //============================================ Keep the best candidate
+        if ( posValue > bestValue ) { bestValue = posValue; *eulA = pos[0]; *eulB = pos[1]; *eulG = pos[2]; }
+    }
+    
+    //================================================ Leave the Wigner matrices at the best rotation
+    bestValue                                         = evaluateRotationFunctionAt ( obj2, settings, *eulA, *eulB, *eulG );
+    
+    //================================================ Report progress
+    std::stringstream hlpSS;
+    hlpSS << "Optimal Euler angles are " << *eulA << " ; " << *eulB << " ; " << *eulG << " with rotation function value " << bestValue;
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, hlpSS.str(), settings->messageShift );
+    
+    //================================================ Done
+    return                                            ( bestValue );
+    
+}
+
 /*! \brief This function computes the rotation function descriptor value between two objects.
  
     This function starts by sanity checks and computation and normalisation of the E matrices used for the trace sigma
@@ -943,7 +1544,7 @@ proshade_double ProSHADE_internal_distances::computeRotationFunctionDescriptor (
     
     //================================================ Initialise return variable
     proshade_double ret                               = 0.0;
-    proshade_double eulA, eulB, eulG, EMatR, EMatI, WigDR, WigDI;
+    proshade_double eulA, eulB, eulG;
     
     //================================================ Sanity check
     if ( !settings->computeRotationFuncDesc )
@@ -958,35 +1559,26 @@ proshade_double ProSHADE_internal_distances::computeRotationFunctionDescriptor (
         normaliseEMatrices                            ( obj1, obj2, settings );
     }
     
-    //================================================ Generate SO(3) coefficients
-    generateSO3CoeffsFromEMatrices                    ( obj2, settings );
-    
-    //================================================ Compute the inverse SO(3) Fourier Transform (SOFT) on the newly computed coefficients
-    computeInverseSOFTTransform                       ( obj2, settings );
-    
-    //================================================ Get inverse SO(3) map top peak Euler angle values
-    ProSHADE_internal_peakSearch::getBestPeakEulerAngsNaive ( obj2->getInvSO3Coeffs (),
-                                                              obj2->getEMatDim ( ) * 2,
-                                                             &eulA, &eulB, &eulG, settings );
-
-    //================================================ Compute the Wigner D matrices for the Euler angles
-    ProSHADE_internal_wigner::computeWignerMatricesForRotation ( settings, obj2, eulA, eulB, eulG );
-
-    //================================================ Compute the distance
-    for ( proshade_unsign bandIter = 0; bandIter < obj2->getEMatDim(); bandIter++ )
+    //================================================ Coarse-to-fine search evaluates the descriptor directly at the best rotation
+    if ( settings->rotFunDescCoarseToFine )
     {
-        //============================================ For each order1
-        for ( proshade_unsign order1 = 0; order1 < ( ( bandIter * 2 ) + 1 ); order1++ )
-        {
-            //======================================== For each order2
-            for ( proshade_unsign order2 = 0; order2 < ( ( bandIter * 2 ) + 1 ); order2++ )
-            {
-                //==================================== Multiply D_{l} * E_{l} and get sum over l of traces (i.e. just sum all together)
-                obj2->getEMatrixValue                 ( bandIter, order1, order2, &EMatR, &EMatI );
-                obj2->getWignerMatrixValue            ( bandIter, order2, order1, &WigDR, &WigDI );
-                ret                                  += ProSHADE_internal_maths::complexMultiplicationRealOnly ( &WigDR, &WigDI, &EMatR, &EMatI );
-            }
-        }
+        ret                                           = findRotationFunctionPeakCoarseToFine ( obj2, settings, &eulA, &eulB, &eulG );
+    }
+    else
+    {
+        //============================================ Generate SO(3) coefficients
+        generateSO3CoeffsFromEMatrices                ( obj2, settings );
+        
+        //============================================ Compute the inverse SO(3) Fourier Transform (SOFT) on the newly computed coefficients
+        computeInverseSOFTTransform                   ( obj2, settings );
+        
+        //============================================ Get inverse SO(3) map top peak Euler angle values
+        ProSHADE_internal_peakSearch::getBestPeakEulerAngsNaive ( obj2->getInvSO3Coeffs (),
+                                                                  obj2->getEMatDim ( ) * 2,
+                                                                 &eulA, &eulB, &eulG, settings );
+        
+        //============================================ Compute the distance (sum over l of traces of D_{l} * E_{l})
+        ret                                           = evaluateRotationFunctionAt ( obj2, settings, eulA, eulB, eulG );
     }
     
     //================================================ Report completion
@@ -38,6 +38,9 @@
  */
 namespace ProSHADE_internal_distances
 {
+    //================================================ The inverse SO(3) Fourier transform implementations signature
+    typedef void ( *inverseSOFTBackend )              ( proshade_unsign band, proshade_complex* coeffs, proshade_complex* invCoeffs, ProSHADE_settings* settings );
+    
     proshade_double computeEnergyLevelsDescriptor     ( ProSHADE_internal_data::ProSHADE_data* obj1,
                                                         ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings );
     bool isBandWithinShell                            ( proshade_unsign bandInQuestion, proshade_unsign shellInQuestion,
@@ -45,18 +48,23 @@ namespace ProSHADE_internal_distances
     void computeRRPPearsonCoefficients                ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
                                                         ProSHADE_settings* settings, proshade_unsign minCommonBands,
                                                         proshade_unsign minCommonShells, std::vector<proshade_double>* bandDists );
-    void allocateTrSigmaWorkspace                     ( proshade_unsign minSpheres, proshade_unsign intOrder, proshade_double*& obj1Vals, proshade_double*& obj2Vals,
-                                                        proshade_double*& GLabscissas, proshade_double*& glWeights, proshade_complex*& radiiVals );
+    void allocateTrSigmaWorkspace                     ( proshade_unsign minSpheres, proshade_unsign intOrder, proshade_unsign maxBand, proshade_double*& obj1Vals,
+                                                        proshade_double*& obj2Vals, proshade_double*& GLabscissas, proshade_double*& glWeights,
+                                                        proshade_double*& shellWeights, std::complex<proshade_double>*& obj1Coeffs,
+                                                        std::complex<proshade_double>*& obj2Coeffs, std::complex<proshade_double>*& eMatBand );
     void computeSphericalHarmonicsMagnitude           ( ProSHADE_internal_data::ProSHADE_data* obj, int band, int order,
                                                         proshade_unsign radius, proshade_double* result );
-    void computeEMatricesForLM                        ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
-                                                        int bandIter, int orderIter, proshade_complex* radiiVals, int integOrder,
-                                                        proshade_double* abscissas, proshade_double* weights, proshade_double integRange, proshade_double sphereDist );
+    void computeEMatricesForBand                      ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
+                                                        int bandIter, int integOrder, proshade_double* abscissas, proshade_double* weights,
+                                                        proshade_double integRange, proshade_double sphereDist, proshade_double* shellWeights,
+                                                        std::complex<proshade_double>* obj1Coeffs, std::complex<proshade_double>* obj2Coeffs,
+                                                        std::complex<proshade_double>* eMatBand );
     proshade_double computeWeightsForEMatricesForLM   ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
                                                         int bandIter, int orderIter, proshade_double* obj1Vals, proshade_double* obj2Vals,
                                                         int integOrder, proshade_double* abscissas, proshade_double* weights, proshade_single sphereDist );
     void releaseTrSigmaWorkspace                      ( proshade_double*& obj1Vals, proshade_double*& obj2Vals, proshade_double*& GLabscissas,
-                                                        proshade_double*& glWeights, proshade_complex*& radiiVals );
+                                                        proshade_double*& glWeights, proshade_double*& shellWeights, std::complex<proshade_double>*& obj1Coeffs,
+                                                        std::complex<proshade_double>*& obj2Coeffs, std::complex<proshade_double>*& eMatBand );
     void computeEMatrices                             ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
                                                         ProSHADE_settings* settings );
     void normaliseEMatrices                           ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
@@ -64,10 +72,24 @@ namespace ProSHADE_internal_distances
     proshade_double computeTraceSigmaDescriptor       ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
                                                         ProSHADE_settings* settings );
     void generateSO3CoeffsFromEMatrices               ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings );
+    void fillSO3CoeffsFromEMatrices                   ( ProSHADE_internal_data::ProSHADE_data* obj2, proshade_unsign band, proshade_complex* coeffs );
     void allocateInvSOFTWorkspaces                    ( proshade_complex*& work1, proshade_complex*& work2, proshade_double*& work3, proshade_unsign band );
     void prepareInvSOFTPlan                           ( fftw_plan* inverseSO3, int band, fftw_complex* work1, proshade_complex* invCoeffs );
     void releaseInvSOFTMemory                         ( proshade_complex*& work1, proshade_complex*& work2, proshade_double*& work3 );
+    void computeInverseSOFTNaive                      ( proshade_unsign band, proshade_complex* coeffs, proshade_complex* invCoeffs, ProSHADE_settings* settings );
+    void getInvSOFTOrderPairs                         ( int band, std::vector< std::pair< int, int > >* orderPairs, std::vector< size_t >* wignerOffsets );
+    void acquireInvSOFTWignerTables                   ( void );
+    void releaseInvSOFTWignerTables                   ( void );
+    const proshade_double* getInvSOFTWignerTables     ( int band, ProSHADE_settings* settings );
+    void synthesiseInvSOFTOrders                      ( int m1, int m2, int band, fftw_complex* coeffs, fftw_complex* data, proshade_double* wignersTrans,
+                                                        fftw_complex* workspace );
+    void computeInverseSOFTParallel                   ( proshade_unsign band, proshade_complex* coeffs, proshade_complex* invCoeffs, ProSHADE_settings* settings );
+    inverseSOFTBackend getInverseSOFTBackend          ( ProSHADE_settings* settings );
     void computeInverseSOFTTransform                  ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings );
+    proshade_double evaluateRotationFunctionAt        ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings, proshade_double eulA,
+                                                        proshade_double eulB, proshade_double eulG );
+    proshade_double findRotationFunctionPeakCoarseToFine ( ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings, proshade_double* eulA,
+                                                        proshade_double* eulB, proshade_double* eulG );
     proshade_double computeRotationFunctionDescriptor ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2,
                                                         ProSHADE_settings* settings );
 }
@@ -0,0 +1,586 @@
+/*! \file ProSHADE_fftw.cpp
+    \brief This source file contains the FFTW plans cache.
+ 
+    The functions defined in here keep a process-wide cache of FFTW plans keyed by the transform shape and the alignment of
+    the arrays, so that repeated transforms of the same shape (e.g. all shells of the same bandwidth, or all maps of the same
+    box size) do not need to be planned again. They also allow the planning rigour to be increased and the FFTW wisdom to be
+    loaded from and saved to a file, so that the more expensive planning is only done once across multiple runs.
+ 
+    Copyright by Michal Tykac and individual contributors. All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+    1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    3) Neither the name of Michal Tykac nor the names of this code's contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+    This software is provided by the copyright holder and contributors "as is" and any express or implied warranties, including, but not limitted to, the implied warranties of merchantibility and fitness for a particular purpose are disclaimed. In no event shall the copyright owner or the contributors be liable for any direct, indirect, incidental, special, exemplary, or consequential damages (including, but not limitted to, procurement of substitute goods or services, loss of use, data or profits, or business interuption) however caused and on any theory of liability, whether in contract, strict liability or tort (including negligence or otherwise) arising in any way out of the use of this software, even if advised of the possibility of such damage.
+ 
+    \author    Michal Tykac
+    \author    Garib N. Murshudov
+    \version   0.7.6.7
+    \date      JUL 2022
+ */
+
+//==================================================== ProSHADE
+#include "ProSHADE_fftw.hpp"
+
+//==================================================== Local variables
+namespace ProSHADE_internal_fftw
+{
+    static std::mutex planCacheMutex;                 //!< Mutex guarding the plans cache as well as all FFTW planner calls made through it.
+    static std::map< std::string, fftw_plan > planCache; //!< The cached plans keyed by the transform description.
+    static unsigned int plannerFlags                  = FFTW_ESTIMATE; //!< The FFTW planner flags to be used for new plans; shared by all settings objects.
+    static std::string wisdomFileName                 = ""; //!< The file to and from which the FFTW wisdom is saved and loaded; shared by all settings objects.
+    static std::string wisdomLoadedFrom               = ""; //!< The file from which the wisdom was already loaded, so that it is not loaded repeatedly.
+    static bool threadsInitialised                    = false; //!< Was the threaded FFTW initialised (and did it succeed)?
+    static bool threadsInitAttempted                  = false; //!< Was the threaded FFTW initialisation already attempted?
+    static proshade_unsign planCacheUsers             = 0; //!< The number of settings objects currently in existence; the cache is cleared when the last one is destroyed.
+    
+    void initialiseThreads                            ( void );
+    bool plannerUsesArrays                            ( void );
+    double* allocateScratch                           ( size_t len, size_t offset, int alignment, double*& block );
+}
+
+/*! \brief This function initialises the threaded FFTW, if this was not yet attempted.
+ 
+    FFTW requires fftw_init_threads() to be called before any other FFTW function, so this function is called by acquirePlanCache()
+    (i.e. whenever a settings object is created) and setPlanningOptions(), before any plan can be made. This function must be
+    called with the cache lock held.
+ */
+void ProSHADE_internal_fftw::initialiseThreads ( void )
+{
+    //================================================ Initialise only once
+    if ( threadsInitAttempted ) { return ; }
+    
+    //================================================ Initialise
+    threadsInitialised                                = ( fftw_init_threads ( ) != 0 );
+    threadsInitAttempted                              = true;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function sets the FFTW planning rigour and the wisdom file, loading the wisdom if available.
+ 
+    Note that the planning rigour and the wisdom file are process-wide, as are the cached plans and the accumulated wisdom. If
+    several settings objects with different FFTW options are in use at the same time, the last call of this function (i.e. the
+    last ProSHADE_run started) decides the options used for all the plans made from then on.
+ 
+    \param[in] rigour The planning rigour, 0 for FFTW_ESTIMATE, 1 for FFTW_MEASURE and 2 for FFTW_PATIENT.
+    \param[in] wisdomFile The path to the file to and from which the wisdom is to be saved and loaded; empty string means no wisdom file.
+    \param[in] verbose How loud the run should be?
+    \param[in] messageShift Are we in a subprocess, so that the log should be shifted for this function call? If so, by how much?
+ */
+void ProSHADE_internal_fftw::setPlanningOptions ( proshade_unsign rigour, std::string wisdomFile, proshade_signed verbose, proshade_signed messageShift )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Make sure the threaded FFTW is initialised before the wisdom is imported
+    initialiseThreads                                 ( );
+    
+    //================================================ Set the planner flags
+    if      ( rigour == 0 ) { plannerFlags = FFTW_ESTIMATE; }
+    else if ( rigour == 1 ) { plannerFlags = FFTW_MEASURE;  }
+    else                    { plannerFlags = FFTW_PATIENT;  }
+    
+    //================================================ Load the wisdom, if supplied and not loaded already
+    wisdomFileName                                    = wisdomFile;
+    if ( ( wisdomFileName != "" ) && ( wisdomFileName != wisdomLoadedFrom ) )
+    {
+        std::ifstream wisdomTest                      ( wisdomFileName.c_str() );
+        if ( wisdomTest.good ( ) )
+        {
+            wisdomTest.close                          ( );
+            if ( fftw_import_wisdom_from_filename ( wisdomFileName.c_str() ) == 0 )
+            {
+                ProSHADE_internal_messages::printWarningMessage ( verbose, "!!! ProSHADE WARNING !!! Failed to load the FFTW wisdom from file " + wisdomFileName + ". The wisdom will be re-computed.", "W000076" );
+            }
+            else
+            {
+                ProSHADE_internal_messages::printProgressMessage ( verbose, 2, "FFTW wisdom loaded from " + wisdomFileName, messageShift );
+            }
+        }
+        wisdomLoadedFrom                              = wisdomFileName;
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function returns the FFTW planner flags currently in use.
+ 
+    This is useful for the plans which cannot be cached (e.g. because they are executed by a dependency on the arrays supplied
+    at the planning time), but should still be planned with the same rigour, thus benefitting from the accumulated wisdom.
+ 
+    \param[out] X The FFTW planner flags.
+ */
+unsigned int ProSHADE_internal_fftw::getPlannerFlags ( void )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Done
+    return                                            ( plannerFlags );
+    
+}
+
+/*! \brief This function saves the accumulated FFTW wisdom into the wisdom file, if one was set.
+ 
+    \param[in] verbose How loud the run should be?
+    \param[in] messageShift Are we in a subprocess, so that the log should be shifted for this function call? If so, by how much?
+ */
+void ProSHADE_internal_fftw::saveWisdom ( proshade_signed verbose, proshade_signed messageShift )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Nothing to do without a file
+    if ( wisdomFileName == "" ) { return ; }
+    
+    //================================================ Save
+    if ( fftw_export_wisdom_to_filename ( wisdomFileName.c_str() ) == 0 )
+    {
+        ProSHADE_internal_messages::printWarningMessage ( verbose, "!!! ProSHADE WARNING !!! Failed to save the FFTW wisdom to file " + wisdomFileName + ".", "W000077" );
+    }
+    else
+    {
+        ProSHADE_internal_messages::printProgressMessage ( verbose, 2, "FFTW wisdom saved to " + wisdomFileName, messageShift );
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function destroys all the cached plans.
+ 
+    Note that any plan previously obtained from the cache becomes invalid after this call.
+ */
+void ProSHADE_internal_fftw::clearPlanCache ( void )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Destroy all plans
+    for ( std::map< std::string, fftw_plan >::iterator it = planCache.begin(); it != planCache.end(); ++it ) { fftw_destroy_plan ( it->second ); }
+    planCache.clear                                   ( );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function registers a new user of the plans cache.
+ 
+    Each ProSHADE_settings object registers itself when created and releases itself (see releasePlanCache()) when destroyed,
+    so that the cached plans live only as long as there is any settings object which could be used to compute with them.
+ */
+void ProSHADE_internal_fftw::acquirePlanCache ( void )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Initialise the threaded FFTW before any plan is made
+    initialiseThreads                                 ( );
+    
+    //================================================ Register the user
+    planCacheUsers                                   += 1;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function releases a user of the plans cache, destroying all the cached plans when it was the last one.
+ */
+void ProSHADE_internal_fftw::releasePlanCache ( void )
+{
+    //================================================ Release the user
+    bool lastUser                                     = false;
+    {
+        std::lock_guard< std::mutex > lock            ( planCacheMutex );
+        if ( planCacheUsers > 0 ) { planCacheUsers -= 1; }
+        lastUser                                      = ( planCacheUsers == 0 );
+    }
+    
+    //================================================ Clear the cache if nobody can use it any more
+    if ( lastUser ) { clearPlanCache ( ); }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function checks whether planning with the current planner flags would write into the supplied arrays.
+ 
+    The FFTW_ESTIMATE and FFTW_WISDOM_ONLY planning never touches the arrays, so the plans can be created directly on the caller's
+    arrays. Any other planning rigour measures actual transforms, so scratch arrays need to be used instead. This function must
+    be called with the cache lock held.
+ 
+    \param[out] X Bool value true if the planner would overwrite the supplied arrays.
+ */
+bool ProSHADE_internal_fftw::plannerUsesArrays ( void )
+{
+    //================================================ Done
+    return                                            ( ( plannerFlags & ( FFTW_ESTIMATE | FFTW_WISDOM_ONLY ) ) == 0 );
+    
+}
+
+/*! \brief This function allocates a scratch array for planning with the same alignment as the supplied array would have.
+ 
+    \param[in] len The number of doubles the scratch array needs to hold after the returned pointer.
+    \param[in] offset The number of doubles the scratch array needs to hold before the returned pointer.
+    \param[in] alignment The FFTW alignment (as given by fftw_alignment_of()) the returned pointer needs to have.
+    \param[in] block Pointer reference where the allocated block (to be released by fftw_free) will be saved.
+    \param[out] X Pointer to the position within the block with the required alignment.
+ */
+double* ProSHADE_internal_fftw::allocateScratch ( size_t len, size_t offset, int alignment, double*& block )
+{
+    //================================================ Allocate with space for re-aligning
+    block                                             = reinterpret_cast< double* > ( fftw_malloc ( sizeof ( double ) * ( len + offset + 16 ) ) );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( block, __FILE__, __LINE__, __func__ );
+    
+    //================================================ Find the position with the same alignment
+    double* ret                                       = block + offset;
+    for ( size_t iter = 0; iter < 16; iter++ )
+    {
+        if ( fftw_alignment_of ( ret ) == alignment ) { break; }
+        ret                                          += 1;
+    }
+    
+    //================================================ Done
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function returns a cached plan for the 3D complex to complex Fourier transform.
+ 
+    \param[in] xDim The size of the x dimension.
+    \param[in] yDim The size of the y dimension.
+    \param[in] zDim The size of the z dimension.
+    \param[in] in The input array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[in] out The output array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[in] sign The transform direction, FFTW_FORWARD or FFTW_BACKWARD.
+    \param[out] X The cached plan, to be executed by fftw_execute_dft().
+ */
+fftw_plan ProSHADE_internal_fftw::getDFT3DPlan ( int xDim, int yDim, int zDim, fftw_complex* in, fftw_complex* out, int sign )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Initialise local variables
+    int inAlign                                       = fftw_alignment_of ( reinterpret_cast< double* > ( in ) );
+    int outAlign                                      = fftw_alignment_of ( reinterpret_cast< double* > ( out ) );
+    bool inPlace                                      = ( in == out );
+    std::stringstream hlpSS;
+    hlpSS << "dft3d_" << xDim << "_" << yDim << "_" << zDim << "_" << sign << "_" << inAlign << "_" << outAlign << "_" << inPlace << "_" << plannerFlags;
+    
+    //================================================ Return cached plan if available
+    std::map< std::string, fftw_plan >::iterator found = planCache.find ( hlpSS.str() );
+    if ( found != planCache.end() ) { return ( found->second ); }
+    
+    //================================================ Plan on the supplied arrays, unless the planner would overwrite them
+    double *inBlock = nullptr, *outBlock = nullptr;
+    double* scrIn                                     = reinterpret_cast< double* > ( in );
+    double* scrOut                                    = reinterpret_cast< double* > ( out );
+    if ( plannerUsesArrays ( ) )
+    {
+        size_t len                                    = 2 * static_cast< size_t > ( xDim ) * static_cast< size_t > ( yDim ) * static_cast< size_t > ( zDim );
+        scrIn                                         = allocateScratch ( len, 0, inAlign, inBlock );
+        scrOut                                        = scrIn;
+        if ( !inPlace ) { scrOut = allocateScratch ( len, 0, outAlign, outBlock ); }
+    }
+    
+    fftw_plan ret                                     = fftw_plan_dft_3d ( xDim, yDim, zDim, reinterpret_cast< fftw_complex* > ( scrIn ), reinterpret_cast< fftw_complex* > ( scrOut ), sign, plannerFlags );
+    
+    //================================================ Release scratch
+    if ( inBlock  != nullptr ) { fftw_free ( inBlock  ); }
+    if ( outBlock != nullptr ) { fftw_free ( outBlock ); }
+    
+    //================================================ Save and return
+    planCache[hlpSS.str()]                            = ret;
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function returns a cached plan for the 3D real to complex Fourier transform.
+ 
+    The output holds only the non-redundant half of the Hermitian symmetric Fourier coefficients, i.e. it has the dimensions
+    xDim x yDim x ( zDim / 2 + 1 ) with the z-axis being the fastest changing index.
+ 
+    \param[in] xDim The size of the x dimension.
+    \param[in] yDim The size of the y dimension.
+    \param[in] zDim The size of the z dimension.
+    \param[in] in The real input array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[in] out The half-spectrum output array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[out] X The cached plan, to be executed by fftw_execute_dft_r2c().
+ */
+fftw_plan ProSHADE_internal_fftw::getR2C3DPlan ( int xDim, int yDim, int zDim, double* in, fftw_complex* out )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Initialise local variables
+    int inAlign                                       = fftw_alignment_of ( in );
+    int outAlign                                      = fftw_alignment_of ( reinterpret_cast< double* > ( out ) );
+    bool inPlace                                      = ( in == reinterpret_cast< double* > ( out ) );
+    std::stringstream hlpSS;
+    hlpSS << "r2c3d_" << xDim << "_" << yDim << "_" << zDim << "_" << inAlign << "_" << outAlign << "_" << inPlace << "_" << plannerFlags;
+    
+    //================================================ Return cached plan if available
+    std::map< std::string, fftw_plan >::iterator found = planCache.find ( hlpSS.str() );
+    if ( found != planCache.end() ) { return ( found->second ); }
+    
+    //================================================ Plan on the supplied arrays, unless the planner would overwrite them (the scratch holds the half-spectrum, which also covers the padded in-place real array)
+    double *inBlock = nullptr, *outBlock = nullptr;
+    double* scrIn                                     = in;
+    double* scrOut                                    = reinterpret_cast< double* > ( out );
+    if ( plannerUsesArrays ( ) )
+    {
+        size_t len                                    = 2 * static_cast< size_t > ( xDim ) * static_cast< size_t > ( yDim ) * static_cast< size_t > ( ( zDim / 2 ) + 1 );
+        scrIn                                         = allocateScratch ( len, 0, inAlign, inBlock );
+        scrOut                                        = scrIn;
+        if ( !inPlace ) { scrOut = allocateScratch ( len, 0, outAlign, outBlock ); }
+    }
+    
+    fftw_plan ret                                     = fftw_plan_dft_r2c_3d ( xDim, yDim, zDim, scrIn, reinterpret_cast< fftw_complex* > ( scrOut ), plannerFlags );
+    
+    //================================================ Release scratch
+    if ( inBlock  != nullptr ) { fftw_free ( inBlock  ); }
+    if ( outBlock != nullptr ) { fftw_free ( outBlock ); }
+    
+    //================================================ Save and return
+    planCache[hlpSS.str()]                            = ret;
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function returns a cached plan for the 3D complex to real Fourier transform.
+ 
+    The input is the non-redundant half of the Hermitian symmetric Fourier coefficients with the dimensions xDim x yDim x ( zDim / 2 + 1 ).
+    Please note that FFTW overwrites the input array of the multi-dimensional complex to real transforms when executing the plan.
+ 
+    \param[in] xDim The size of the x dimension of the real output.
+    \param[in] yDim The size of the y dimension of the real output.
+    \param[in] zDim The size of the z dimension of the real output.
+    \param[in] in The half-spectrum input array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[in] out The real output array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[out] X The cached plan, to be executed by fftw_execute_dft_c2r().
+ */
+fftw_plan ProSHADE_internal_fftw::getC2R3DPlan ( int xDim, int yDim, int zDim, fftw_complex* in, double* out )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Initialise local variables
+    int inAlign                                       = fftw_alignment_of ( reinterpret_cast< double* > ( in ) );
+    int outAlign                                      = fftw_alignment_of ( out );
+    bool inPlace                                      = ( reinterpret_cast< double* > ( in ) == out );
+    std::stringstream hlpSS;
+    hlpSS << "c2r3d_" << xDim << "_" << yDim << "_" << zDim << "_" << inAlign << "_" << outAlign << "_" << inPlace << "_" << plannerFlags;
+    
+    //================================================ Return cached plan if available
+    std::map< std::string, fftw_plan >::iterator found = planCache.find ( hlpSS.str() );
+    if ( found != planCache.end() ) { return ( found->second ); }
+    
+    //================================================ Plan on the supplied arrays, unless the planner would overwrite them
+    double *inBlock = nullptr, *outBlock = nullptr;
+    double* scrIn                                     = reinterpret_cast< double* > ( in );
+    double* scrOut                                    = out;
+    if ( plannerUsesArrays ( ) )
+    {
+        size_t len                                    = 2 * static_cast< size_t > ( xDim ) * static_cast< size_t > ( yDim ) * static_cast< size_t > ( ( zDim / 2 ) + 1 );
+        scrIn                                         = allocateScratch ( len, 0, inAlign, inBlock );
+        scrOut                                        = scrIn;
+        if ( !inPlace ) { scrOut = allocateScratch ( len, 0, outAlign, outBlock ); }
+    }
+    
+    fftw_plan ret                                     = fftw_plan_dft_c2r_3d ( xDim, yDim, zDim, reinterpret_cast< fftw_complex* > ( scrIn ), scrOut, plannerFlags );
+    
+    //================================================ Release scratch
+    if ( inBlock  != nullptr ) { fftw_free ( inBlock  ); }
+    if ( outBlock != nullptr ) { fftw_free ( outBlock ); }
+    
+    //================================================ Save and return
+    planCache[hlpSS.str()]                            = ret;
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function returns a cached plan for a batch of 1D split array complex to complex Fourier transforms.
+ 
+    The plan computes howMany forward transforms of length n. The real and imaginary parts of the input (and of the output) must
+    reside within the same allocated block, as FFTW requires the separation between them to be the same for all executions of
+    the plan.
+ 
+    \param[in] n The length of each transform.
+    \param[in] howMany The number of the transforms.
+    \param[in] inStride The stride between the elements of a single input transform.
+    \param[in] inDist The distance between the starts of the consecutive input transforms.
+    \param[in] outStride The stride between the elements of a single output transform.
+    \param[in] outDist The distance between the starts of the consecutive output transforms.
+    \param[in] ri The input real parts (used only to determine the alignment and layout).
+    \param[in] ii The input imaginary parts (used only to determine the alignment and layout).
+    \param[in] ro The output real parts (used only to determine the alignment and layout).
+    \param[in] io The output imaginary parts (used only to determine the alignment and layout).
+    \param[out] X The cached plan, to be executed by fftw_execute_split_dft().
+ */
+fftw_plan ProSHADE_internal_fftw::getSplitDFTPlan ( int n, int howMany, int inStride, int inDist, int outStride, int outDist, double* ri, double* ii, double* ro, double* io )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Initialise local variables
+    std::ptrdiff_t inSep                              = ii - ri;
+    std::ptrdiff_t outSep                             = io - ro;
+    std::stringstream hlpSS;
+    hlpSS << "split_" << n << "_" << howMany << "_" << inStride << "_" << inDist << "_" << outStride << "_" << outDist << "_" << inSep << "_" << outSep << "_";
+    hlpSS << fftw_alignment_of ( ri ) << "_" << fftw_alignment_of ( ii ) << "_" << fftw_alignment_of ( ro ) << "_" << fftw_alignment_of ( io ) << "_" << ( ri == ro ) << "_" << plannerFlags;
+    
+    //================================================ Return cached plan if available
+    std::map< std::string, fftw_plan >::iterator found = planCache.find ( hlpSS.str() );
+    if ( found != planCache.end() ) { return ( found->second ); }
+    
+    //================================================ Plan on the supplied arrays, unless the planner would overwrite them, in which case scratch arrays with the same layout are used
+    double *inBlock = nullptr, *outBlock = nullptr;
+    double* scrRI                                     = ri;
+    double* scrRO                                     = ro;
+    if ( plannerUsesArrays ( ) )
+    {
+        size_t inLen                                  = static_cast< size_t > ( ( n - 1 ) * inStride  + ( howMany - 1 ) * inDist  + 1 );
+        size_t outLen                                 = static_cast< size_t > ( ( n - 1 ) * outStride + ( howMany - 1 ) * outDist + 1 );
+        size_t inLo                                   = static_cast< size_t > ( std::max ( static_cast< std::ptrdiff_t > ( 0 ), -inSep ) );
+        size_t inHi                                   = static_cast< size_t > ( std::max ( static_cast< std::ptrdiff_t > ( inLen ), inSep + static_cast< std::ptrdiff_t > ( inLen ) ) );
+        size_t outLo                                  = static_cast< size_t > ( std::max ( static_cast< std::ptrdiff_t > ( 0 ), -outSep ) );
+        size_t outHi                                  = static_cast< size_t > ( std::max ( static_cast< std::ptrdiff_t > ( outLen ), outSep + static_cast< std::ptrdiff_t > ( outLen ) ) );
+        scrRI                                         = allocateScratch ( inHi, inLo, fftw_alignment_of ( ri ), inBlock );
+        scrRO                                         = scrRI;
+        if ( ri != ro ) { scrRO = allocateScratch ( outHi, outLo, fftw_alignment_of ( ro ), outBlock ); }
+    }
+    
+    fftw_iodim dims[1], howmany_dims[1];
+    dims[0].n                                         = n;
+    dims[0].is                                        = inStride;
+    dims[0].os                                        = outStride;
+    howmany_dims[0].n                                 = howMany;
+    howmany_dims[0].is                                = inDist;
+    howmany_dims[0].os                                = outDist;
+    
+    fftw_plan ret                                     = fftw_plan_guru_split_dft ( 1, dims, 1, howmany_dims, scrRI, scrRI + inSep, scrRO, scrRO + outSep, plannerFlags );
+    
+    //================================================ Release scratch
+    if ( inBlock  != nullptr ) { fftw_free ( inBlock  ); }
+    if ( outBlock != nullptr ) { fftw_free ( outBlock ); }
+    
+    //================================================ Save and return
+    planCache[hlpSS.str()]                            = ret;
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function returns a cached plan for the 1D real to real transform.
+ 
+    \param[in] n The length of the transform.
+    \param[in] in The input array (used only to determine the alignment and in-place-ness).
+    \param[in] out The output array (used only to determine the alignment and in-place-ness).
+    \param[in] kind The kind of the real to real transform (e.g. FFTW_REDFT10).
+    \param[out] X The cached plan, to be executed by fftw_execute_r2r().
+ */
+fftw_plan ProSHADE_internal_fftw::getR2R1DPlan ( int n, double* in, double* out, fftw_r2r_kind kind )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Initialise local variables
+    bool inPlace                                      = ( in == out );
+    std::stringstream hlpSS;
+    hlpSS << "r2r1d_" << n << "_" << kind << "_" << fftw_alignment_of ( in ) << "_" << fftw_alignment_of ( out ) << "_" << inPlace << "_" << plannerFlags;
+    
+    //================================================ Return cached plan if available
+    std::map< std::string, fftw_plan >::iterator found = planCache.find ( hlpSS.str() );
+    if ( found != planCache.end() ) { return ( found->second ); }
+    
+    //================================================ Plan on the supplied arrays, unless the planner would overwrite them
+    double *inBlock = nullptr, *outBlock = nullptr;
+    double* scrIn                                     = in;
+    double* scrOut                                    = out;
+    if ( plannerUsesArrays ( ) )
+    {
+        scrIn                                         = allocateScratch ( static_cast< size_t > ( n ), 0, fftw_alignment_of ( in ), inBlock );
+        scrOut                                        = scrIn;
+        if ( !inPlace ) { scrOut = allocateScratch ( static_cast< size_t > ( n ), 0, fftw_alignment_of ( out ), outBlock ); }
+    }
+    
+    fftw_plan ret                                     = fftw_plan_r2r_1d ( n, scrIn, scrOut, kind, plannerFlags );
+    
+    //================================================ Release scratch
+    if ( inBlock  != nullptr ) { fftw_free ( inBlock  ); }
+    if ( outBlock != nullptr ) { fftw_free ( outBlock ); }
+    
+    //================================================ Save and return
+    planCache[hlpSS.str()]                            = ret;
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function returns a cached plan for a batch of contiguous 1D complex to complex Fourier transforms.
+ 
+    The plan computes howMany transforms of length n, the i-th transform reading the elements i * n to ( i + 1 ) * n - 1 of the
+    input array and writing the same elements of the output array. If more than one thread is requested, the plan is created
+    by the threaded FFTW (if it was initialised, see initialiseThreads()), so that its execution uses these threads.
+ 
+    \param[in] n The length of each transform.
+    \param[in] howMany The number of the transforms.
+    \param[in] in The input array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[in] out The output array (used only to determine the alignment and in-place-ness, it is not modified).
+    \param[in] sign The transform direction, FFTW_FORWARD or FFTW_BACKWARD.
+    \param[in] noThreads The number of threads the plan should use when executed.
+    \param[out] X The cached plan, to be executed by fftw_execute_dft().
+ */
+fftw_plan ProSHADE_internal_fftw::getBatchedDFT1DPlan ( int n, int howMany, fftw_complex* in, fftw_complex* out, int sign, int noThreads )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( planCacheMutex );
+    
+    //================================================ Initialise local variables
+    int inAlign                                       = fftw_alignment_of ( reinterpret_cast< double* > ( in ) );
+    int outAlign                                      = fftw_alignment_of ( reinterpret_cast< double* > ( out ) );
+    bool inPlace                                      = ( in == out );
+    std::stringstream hlpSS;
+    hlpSS << "batch1d_" << n << "_" << howMany << "_" << sign << "_" << inAlign << "_" << outAlign << "_" << inPlace << "_" << noThreads << "_" << plannerFlags;
+    
+    //================================================ Return cached plan if available
+    std::map< std::string, fftw_plan >::iterator found = planCache.find ( hlpSS.str() );
+    if ( found != planCache.end() ) { return ( found->second ); }
+    
+    //================================================ Plan on the supplied arrays, unless the planner would overwrite them
+    double *inBlock = nullptr, *outBlock = nullptr;
+    double* scrIn                                     = reinterpret_cast< double* > ( in );
+    double* scrOut                                    = reinterpret_cast< double* > ( out );
+    if ( plannerUsesArrays ( ) )
+    {
+        size_t len                                    = 2 * static_cast< size_t > ( n ) * static_cast< size_t > ( howMany );
+        scrIn                                         = allocateScratch ( len, 0, inAlign, inBlock );
+        scrOut                                        = scrIn;
+        if ( !inPlace ) { scrOut = allocateScratch ( len, 0, outAlign, outBlock ); }
+    }
+    
+    if ( threadsInitialised ) { fftw_plan_with_nthreads ( std::max ( noThreads, 1 ) ); }
+    fftw_plan ret                                     = fftw_plan_many_dft ( 1, &n, howMany,
+                                                                             reinterpret_cast< fftw_complex* > ( scrIn ),  nullptr, 1, n,
+                                                                             reinterpret_cast< fftw_complex* > ( scrOut ), nullptr, 1, n,
+                                                                             sign, plannerFlags );
+    if ( threadsInitialised ) { fftw_plan_with_nthreads ( 1 ); }
+    
+    //================================================ Release scratch
+    if ( inBlock  != nullptr ) { fftw_free ( inBlock  ); }
+    if ( outBlock != nullptr ) { fftw_free ( outBlock ); }
+    
+    //================================================ Save and return
+    planCache[hlpSS.str()]                            = ret;
+    return                                            ( ret );
+    
+}
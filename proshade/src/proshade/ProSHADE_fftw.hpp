@@ -0,0 +1,56 @@
+/*! \file ProSHADE_fftw.hpp
+    \brief This header file declares the FFTW plans cache.
+ 
+    The functions declared in here are used by ProSHADE to obtain FFTW plans from a process-wide cache, so that the plans for
+    transforms of the same shape are created only once, as well as to control the planning rigour and the FFTW wisdom file.
+ 
+    Copyright by Michal Tykac and individual contributors. All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+    1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+    2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+    3) Neither the name of Michal Tykac nor the names of this code's contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+    This software is provided by the copyright holder and contributors "as is" and any express or implied warranties, including, but not limitted to, the implied warranties of merchantibility and fitness for a particular purpose are disclaimed. In no event shall the copyright owner or the contributors be liable for any direct, indirect, incidental, special, exemplary, or consequential damages (including, but not limitted to, procurement of substitute goods or services, loss of use, data or profits, or business interuption) however caused and on any theory of liability, whether in contract, strict liability or tort (including negligence or otherwise) arising in any way out of the use of this software, even if advised of the possibility of such damage.
+ 
+    \author    Michal Tykac
+    \author    Garib N. Murshudov
+    \version   0.7.6.7
+    \date      JUL 2022
+ */
+
+//==================================================== ProSHADE
+#include "ProSHADE_misc.hpp"
+
+//==================================================== Overinclusion protection
+#ifndef PROSHADE_FFTW
+#define PROSHADE_FFTW
+
+//==================================================== ProSHADE_internal_fftw Namespace
+/*! \namespace ProSHADE_internal_fftw
+    \brief This namespace contains the FFTW plans cache and the FFTW planning options.
+ 
+    The ProSHADE_internal_fftw namespace contains the functions returning FFTW plans from the process-wide cache. The cached plans
+    are created on the supplied arrays (or on internal scratch arrays when the planning rigour would overwrite them) and are shared
+    between all callers, therefore they must be executed using the FFTW new-array execute functions (fftw_execute_dft,
+    fftw_execute_dft_r2c, fftw_execute_dft_c2r, fftw_execute_split_dft and fftw_execute_r2r) on arrays with the same alignment and in-place-ness as the arrays supplied when the
+    plan was requested. The cached plans are owned by the cache and must not be destroyed by the caller.
+ */
+namespace ProSHADE_internal_fftw
+{
+    void setPlanningOptions                           ( proshade_unsign rigour, std::string wisdomFile, proshade_signed verbose, proshade_signed messageShift );
+    unsigned int getPlannerFlags                      ( void );
+    void saveWisdom                                   ( proshade_signed verbose, proshade_signed messageShift );
+    void clearPlanCache                               ( void );
+    void acquirePlanCache                             ( void );
+    void releasePlanCache                             ( void );
+    
+    fftw_plan getDFT3DPlan                            ( int xDim, int yDim, int zDim, fftw_complex* in, fftw_complex* out, int sign );
+    fftw_plan getR2C3DPlan                            ( int xDim, int yDim, int zDim, double* in, fftw_complex* out );
+    fftw_plan getC2R3DPlan                            ( int xDim, int yDim, int zDim, fftw_complex* in, double* out );
+    fftw_plan getSplitDFTPlan                         ( int n, int howMany, int inStride, int inDist, int outStride, int outDist, double* ri, double* ii, double* ro, double* io );
+    fftw_plan getR2R1DPlan                            ( int n, double* in, double* out, fftw_r2r_kind kind );
+    fftw_plan getBatchedDFT1DPlan                     ( int n, int howMany, fftw_complex* in, fftw_complex* out, int sign, int noThreads );
+}
+
+#endif
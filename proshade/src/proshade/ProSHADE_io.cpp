@@ -22,6 +22,15 @@
 //==================================================== ProSHADE
 #include "ProSHADE_io.hpp"
 
+//==================================================== Memory mapping (POSIX only, other systems use the gemmi reader)
+#if !defined ( _WIN64 ) && !defined ( _WIN32 )
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+#include <cstring>
+
 //==================================================== Forward declarations
 namespace ProSHADE_internal_mapManip
 {
@@ -223,6 +232,262 @@ void ProSHADE_internal_io::readInMapData ( gemmi::Ccp4<float> *gemmiMap, proshad
     
 }
 
+/*! \brief This function reads a floating point (mode 2) MRC/CCP4 map file using memory mapping.
+ 
+    This function maps the map file into the memory, parses the header directly and converts the voxel values into the ProSHADE
+    internal map representation (XYZ axis order with z being the fastest index) in a single pass. The conversion is done in cubic
+    blocks, so that both the reading from the file order and the writing into the internal order stay cache friendly for any axis
+    order. This avoids keeping the gemmi floating point grid in memory alongside the internal map and also avoids any per-voxel
+    grid access overhead.
+ 
+    If cropping is requested, the mapped file is first streamed over to average the map values over small cubic cells. The cells
+    whose average is more than the given number of inter-quartile ranges above the median of all cell averages (the same threshold
+    as used by getMaskFromBlurr()) are taken to hold the map density and only the box containing them (plus one cell margin) is
+    materialised as the internal map, with the header values describing the cropped box. This allows processing maps with large
+    noisy or empty padding, such as composite maps or tomographic sub-volumes, without ever holding the full map in memory, but
+    it changes the map box and origin. If a memory budget is given and the (cropped) map exceeds it, an exception is thrown.
+ 
+    The header values are reported in the same way as readInMapHeader() reports them after the gemmi axis re-ordering, i.e. the
+    dimensions and starting indices are given along the XYZ axes and the axis order is 1, 2, 3. If the file cannot be read by this
+    function (it is compressed, it is not in mode 2, it has a non-native byte order, it is truncated or the system does not support
+    memory mapping), false is returned without any of the outputs being changed and the caller should use the gemmi reader instead.
+ 
+    \param[in] fName The file name of the map file to be read.
+    \param[in] map Pointer reference to a variable to save the map data.
+    \param[in] xDimInds Address to a variable to save the x-axis size in indices.
+    \param[in] yDimInds Address to a variable to save the y-axis size in indices.
+    \param[in] zDimInds Address to a variable to save the z-axis size in indices.
+    \param[in] xDim Address to a variable to save the x dimension size in angstroms.
+    \param[in] yDim Address to a variable to save the y dimension size in angstroms.
+    \param[in] zDim Address to a variable to save the z dimension size in angstroms.
+    \param[in] aAng Address to a variable to save the a angle in degrees.
+    \param[in] bAng Address to a variable to save the b angle in degrees.
+    \param[in] cAng Address to a variable to save the c angle in degrees.
+    \param[in] xFrom Address to a variable to save the starting index along the x-axis.
+    \param[in] yFrom Address to a variable to save the starting index along the y-axis.
+    \param[in] zFrom Address to a variable to save the starting index along the z-axis.
+    \param[in] xAxOrigin Address to a variable to save the map origin positon along the x-axis.
+    \param[in] yAxOrigin Address to a variable to save the map origin positon along the y-axis.
+    \param[in] zAxOrigin Address to a variable to save the map origin positon along the z-axis.
+    \param[in] xAxOrder Address to a variable to save the order of x axis.
+    \param[in] yAxOrder Address to a variable to save the order of y axis.
+    \param[in] zAxOrder Address to a variable to save the order of z axis.
+    \param[in] xGridInds Address to a variable to save the grid indices count along the x-axis.
+    \param[in] yGridInds Address to a variable to save the grid indices count along the y-axis.
+    \param[in] zGridInds Address to a variable to save the grid indices count along the z-axis.
+    \param[in] noThreads The number of threads to be used for the conversion.
+    \param[in] maxMapBytes The maximum size of the internal map in bytes, 0 for no limit.
+    \param[in] cropToDensity Should the map be cropped to the box containing its density?
+    \param[in] noIQRs The number of inter-quartile ranges from the median of the cell averages used as the threshold for cropping.
+    \param[in] verbose How verbose should the run be? Use -1 if you do not want any standard output output.
+    \param[in] messageShift Are we in a subprocess, so that the log should be shifted for this function call? If so, by how much?
+    \param[out] X Bool value true if the map was read and false if the gemmi reader should be used instead.
+ */
+bool ProSHADE_internal_io::readInMapMemoryMapped ( std::string fName, proshade_double*& map, proshade_unsign *xDimInds, proshade_unsign *yDimInds, proshade_unsign *zDimInds, proshade_single *xDim, proshade_single *yDim, proshade_single *zDim, proshade_single *aAng, proshade_single *bAng, proshade_single *cAng, proshade_signed *xFrom, proshade_signed *yFrom, proshade_signed *zFrom, proshade_signed *xAxOrigin, proshade_signed *yAxOrigin, proshade_signed *zAxOrigin, proshade_unsign *xAxOrder, proshade_unsign *yAxOrder, proshade_unsign *zAxOrder, proshade_unsign *xGridInds, proshade_unsign *yGridInds, proshade_unsign *zGridInds, proshade_unsign noThreads, size_t maxMapBytes, bool cropToDensity, proshade_single noIQRs, proshade_signed verbose, proshade_signed messageShift )
+{
+#if defined ( _WIN64 ) || defined ( _WIN32 )
+    //================================================ Memory mapping not supported here, use gemmi
+    (void)fName; (void)map; (void)xDimInds; (void)yDimInds; (void)zDimInds; (void)xDim; (void)yDim; (void)zDim; (void)aAng; (void)bAng; (void)cAng;
+    (void)xFrom; (void)yFrom; (void)zFrom; (void)xAxOrigin; (void)yAxOrigin; (void)zAxOrigin; (void)xAxOrder; (void)yAxOrder; (void)zAxOrder;
+    (void)xGridInds; (void)yGridInds; (void)zGridInds; (void)noThreads; (void)maxMapBytes; (void)cropToDensity; (void)noIQRs; (void)verbose; (void)messageShift;
+    return                                            ( false );
+#else
+    //================================================ Open the file and find its size
+    int fileDesc                                      = open ( fName.c_str(), O_RDONLY );
+    if ( fileDesc < 0 ) { return ( false ); }
+    struct stat fileStat;
+    if ( ( fstat ( fileDesc, &fileStat ) != 0 ) || ( fileStat.st_size < 1024 ) ) { close ( fileDesc ); return ( false ); }
+    size_t fileSize                                   = static_cast< size_t > ( fileStat.st_size );
+    
+    //================================================ Map the file
+    void* mapped                                      = mmap ( nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDesc, 0 );
+    close                                             ( fileDesc );
+    if ( mapped == MAP_FAILED ) { return ( false ); }
+    const unsigned char* fileBytes                    = static_cast< const unsigned char* > ( mapped );
+    
+    //================================================ Parse the header words (header word n is hdrI[n-1] or hdrF[n-1])
+    int32_t hdrI[256];
+    float hdrF[256];
+    std::memcpy                                       ( hdrI, fileBytes, 1024 );
+    std::memcpy                                       ( hdrF, fileBytes, 1024 );
+    
+    //================================================ Check the map is something this reader can deal with (MAP stamp, native byte order, mode 2, axis permutation)
+    const uint16_t endianTest                         = 1;
+    bool littleEndian                                 = ( *reinterpret_cast< const unsigned char* > ( &endianTest ) == 1 );
+    bool readable                                     = ( std::memcmp ( fileBytes + 208, "MAP", 3 ) == 0 );
+    readable                                          = readable && ( littleEndian ? ( fileBytes[212] == 0x44 ) : ( fileBytes[212] == 0x11 ) );
+    readable                                          = readable && ( hdrI[3] == 2 );
+    readable                                          = readable && ( hdrI[0] > 0 ) && ( hdrI[1] > 0 ) && ( hdrI[2] > 0 ) && ( hdrI[23] >= 0 );
+    readable                                          = readable && ( hdrI[16] >= 1 ) && ( hdrI[16] <= 3 ) && ( hdrI[17] >= 1 ) && ( hdrI[17] <= 3 ) && ( hdrI[18] >= 1 ) && ( hdrI[18] <= 3 );
+    readable                                          = readable && ( hdrI[16] != hdrI[17] ) && ( hdrI[16] != hdrI[18] ) && ( hdrI[17] != hdrI[18] );
+    
+    //================================================ Check the file holds all the data
+    size_t fileAx[3]                                  = { static_cast< size_t > ( hdrI[0] ), static_cast< size_t > ( hdrI[1] ), static_cast< size_t > ( hdrI[2] ) };
+    size_t dataOffset                                 = 1024 + static_cast< size_t > ( std::max ( hdrI[23], 0 ) );
+    readable                                          = readable && ( ( dataOffset % sizeof ( float ) ) == 0 ) && ( fileSize >= ( dataOffset + sizeof ( float ) * fileAx[0] * fileAx[1] * fileAx[2] ) );
+    if ( !readable ) { munmap ( mapped, fileSize ); return ( false ); }
+    
+    //================================================ Set local variables
+    const size_t blockSize                            = 32;
+    const float* fileData                             = reinterpret_cast< const float* > ( fileBytes + dataOffset );
+    proshade_unsign noSecBlocks                       = static_cast< proshade_unsign > ( ( fileAx[2] + blockSize - 1 ) / blockSize );
+    size_t cropFrom[3]                                = { 0, 0, 0 };
+    size_t cropTo[3]                                  = { fileAx[0], fileAx[1], fileAx[2] };
+    madvise                                           ( mapped, fileSize, MADV_SEQUENTIAL );
+    
+    //================================================ If requested, stream over the file to find the box containing the map density
+    if ( cropToDensity )
+    {
+        //============================================ Report progress
+        ProSHADE_internal_messages::printProgressMessage ( verbose, 2, "Cropping the map to the map density box.", messageShift );
+        
+        //============================================ Average the map over cubic cells, so that the noise is smoothed out as the blurring does before masking
+        const size_t cellSize                         = 8;
+        size_t cellAx[3]                              = { ( fileAx[0] + cellSize - 1 ) / cellSize, ( fileAx[1] + cellSize - 1 ) / cellSize, ( fileAx[2] + cellSize - 1 ) / cellSize };
+        std::vector< proshade_double > cellMeans      ( cellAx[0] * cellAx[1] * cellAx[2], 0.0 );
+        ProSHADE_internal_misc::parallelFor           ( static_cast< proshade_unsign > ( cellAx[2] ), noThreads, [&] ( proshade_unsign secCell, proshade_unsign )
+        {
+            proshade_double* cellSlab                 = &cellMeans[cellAx[0] * cellAx[1] * static_cast< size_t > ( secCell )];
+            size_t secFrom                            = static_cast< size_t > ( secCell ) * cellSize;
+            size_t secTo                              = std::min ( secFrom + cellSize, fileAx[2] );
+            for ( size_t sec = secFrom; sec < secTo; sec++ )
+            {
+                for ( size_t row = 0; row < fileAx[1]; row++ )
+                {
+                    const float* fileRow              = fileData + fileAx[0] * ( row + fileAx[1] * sec );
+                    proshade_double* cellRow          = cellSlab + cellAx[0] * ( row / cellSize );
+                    for ( size_t col = 0; col < fileAx[0]; col++ ) { cellRow[col / cellSize] += static_cast< proshade_double > ( fileRow[col] ); }
+                }
+            }
+            for ( size_t rowCell = 0; rowCell < cellAx[1]; rowCell++ )
+            {
+                size_t rowCount                       = std::min ( ( rowCell + 1 ) * cellSize, fileAx[1] ) - ( rowCell * cellSize );
+                for ( size_t colCell = 0; colCell < cellAx[0]; colCell++ )
+                {
+                    size_t colCount                   = std::min ( ( colCell + 1 ) * cellSize, fileAx[0] ) - ( colCell * cellSize );
+                    cellSlab[colCell + cellAx[0] * rowCell] /= static_cast< proshade_double > ( colCount * rowCount * ( secTo - secFrom ) );
+                }
+            }
+        } );
+        
+        //============================================ Threshold the cell averages at the given number of IQRs from their median (as is done by getMaskFromBlurr())
+        proshade_double* medianIQR                    = new proshade_double[2];
+        ProSHADE_internal_misc::checkMemoryAllocation ( medianIQR, __FILE__, __LINE__, __func__ );
+        ProSHADE_internal_maths::arrayMedianAndIQRHistogram ( &cellMeans[0], cellMeans.size(), medianIQR, noThreads );
+        proshade_double threshold                     = medianIQR[0] + ( static_cast< proshade_double > ( noIQRs ) * medianIQR[1] );
+        delete[] medianIQR;
+        
+        //============================================ Find the box of cells above the threshold, extended by one cell for the density edges (a map with no such cell is left uncropped)
+        size_t cellBounds[6]                          = { cellAx[0], 0, cellAx[1], 0, cellAx[2], 0 };
+        for ( size_t secCell = 0; secCell < cellAx[2]; secCell++ )
+        {
+            for ( size_t rowCell = 0; rowCell < cellAx[1]; rowCell++ )
+            {
+                for ( size_t colCell = 0; colCell < cellAx[0]; colCell++ )
+                {
+                    if ( cellMeans[colCell + cellAx[0] * ( rowCell + cellAx[1] * secCell )] <= threshold ) { continue; }
+                    cellBounds[0]                     = std::min ( cellBounds[0], colCell ); cellBounds[1] = std::max ( cellBounds[1], colCell + 1 );
+                    cellBounds[2]                     = std::min ( cellBounds[2], rowCell ); cellBounds[3] = std::max ( cellBounds[3], rowCell + 1 );
+                    cellBounds[4]                     = std::min ( cellBounds[4], secCell ); cellBounds[5] = std::max ( cellBounds[5], secCell + 1 );
+                }
+            }
+        }
+        if ( cellBounds[1] > cellBounds[0] )
+        {
+            for ( size_t aIt = 0; aIt < 3; aIt++ )
+            {
+                cropFrom[aIt]                         = ( cellBounds[aIt*2] > 0 ) ? ( ( cellBounds[aIt*2] - 1 ) * cellSize ) : 0;
+                cropTo[aIt]                           = std::min ( ( cellBounds[aIt*2+1] + 1 ) * cellSize, fileAx[aIt] );
+            }
+        }
+    }
+    
+    //================================================ Check the (cropped) map fits the budget
+    if ( ( maxMapBytes > 0 ) && ( ( sizeof ( proshade_double ) * ( cropTo[0] - cropFrom[0] ) * ( cropTo[1] - cropFrom[1] ) * ( cropTo[2] - cropFrom[2] ) ) > maxMapBytes ) )
+    {
+        munmap                                        ( mapped, fileSize );
+        throw ProSHADE_exception ( "The map does not fit into the map memory budget.", "EM00079", __FILE__, __LINE__, __func__, "The map memory budget (--mapMemBudget or -X) is smaller than\n                    : the map read from the map file\n                    : " + fName + ". Please increase the budget or\n                    : set it to 0 for no limit. Alternatively, --cropOnRead (-Y)\n                    : reads only the box containing the map density (this\n                    : changes the map box and origin), which can be made smaller\n                    : by increasing the masking threshold (--maskThreshold)." );
+    }
+    
+    //================================================ Find the XYZ axis of each file axis (columns, rows, sections) and the internal map strides
+    size_t cropAx[3]                                  = { cropTo[0] - cropFrom[0], cropTo[1] - cropFrom[1], cropTo[2] - cropFrom[2] };
+    size_t axXYZ[3]                                   = { static_cast< size_t > ( hdrI[16] - 1 ), static_cast< size_t > ( hdrI[17] - 1 ), static_cast< size_t > ( hdrI[18] - 1 ) };
+    size_t dimXYZ[3], startXYZ[3];
+    for ( size_t iter = 0; iter < 3; iter++ ) { dimXYZ[axXYZ[iter]] = cropAx[iter]; startXYZ[axXYZ[iter]] = iter; }
+    size_t strideXYZ[3]                               = { dimXYZ[1] * dimXYZ[2], dimXYZ[2], 1 };
+    size_t outStride[3]                               = { strideXYZ[axXYZ[0]], strideXYZ[axXYZ[1]], strideXYZ[axXYZ[2]] };
+    
+    //================================================ Allocate the ProSHADE internal map variable memory
+    map                                               = new proshade_double [cropAx[0] * cropAx[1] * cropAx[2]];
+    ProSHADE_internal_misc::checkMemoryAllocation     ( map, __FILE__, __LINE__, __func__ );
+    
+    //================================================ Convert the data in blocks of sections, rows and columns
+    noSecBlocks                                       = static_cast< proshade_unsign > ( ( cropAx[2] + blockSize - 1 ) / blockSize );
+    ProSHADE_internal_misc::parallelFor               ( noSecBlocks, noThreads, [&] ( proshade_unsign secBlock, proshade_unsign )
+    {
+        size_t secFrom                                = static_cast< size_t > ( secBlock ) * blockSize;
+        size_t secTo                                  = std::min ( secFrom + blockSize, cropAx[2] );
+        for ( size_t rowFrom = 0; rowFrom < cropAx[1]; rowFrom += blockSize )
+        {
+            size_t rowTo                              = std::min ( rowFrom + blockSize, cropAx[1] );
+            for ( size_t colFrom = 0; colFrom < cropAx[0]; colFrom += blockSize )
+            {
+                size_t colTo                          = std::min ( colFrom + blockSize, cropAx[0] );
+                for ( size_t sec = secFrom; sec < secTo; sec++ )
+                {
+                    for ( size_t row = rowFrom; row < rowTo; row++ )
+                    {
+                        const float* fileRow          = fileData + cropFrom[0] + fileAx[0] * ( ( row + cropFrom[1] ) + fileAx[1] * ( sec + cropFrom[2] ) );
+                        proshade_double* outRow       = map + ( row * outStride[1] ) + ( sec * outStride[2] );
+                        for ( size_t col = colFrom; col < colTo; col++ ) { outRow[col * outStride[0]] = static_cast< proshade_double > ( fileRow[col] ); }
+                    }
+                }
+            }
+        }
+    } );
+    
+    //================================================ Save the header values in the XYZ axis order
+   *xDimInds                                          = static_cast<proshade_unsign> ( dimXYZ[0] );
+   *yDimInds                                          = static_cast<proshade_unsign> ( dimXYZ[1] );
+   *zDimInds                                          = static_cast<proshade_unsign> ( dimXYZ[2] );
+    
+   *xFrom                                             = static_cast<proshade_signed> ( hdrI[4 + startXYZ[0]] ) + static_cast<proshade_signed> ( cropFrom[startXYZ[0]] );
+   *yFrom                                             = static_cast<proshade_signed> ( hdrI[4 + startXYZ[1]] ) + static_cast<proshade_signed> ( cropFrom[startXYZ[1]] );
+   *zFrom                                             = static_cast<proshade_signed> ( hdrI[4 + startXYZ[2]] ) + static_cast<proshade_signed> ( cropFrom[startXYZ[2]] );
+    
+   *xDim                                              = static_cast<proshade_single> ( hdrF[10] );
+   *yDim                                              = static_cast<proshade_single> ( hdrF[11] );
+   *zDim                                              = static_cast<proshade_single> ( hdrF[12] );
+    
+   *aAng                                              = static_cast<proshade_single> ( hdrF[13] );
+   *bAng                                              = static_cast<proshade_single> ( hdrF[14] );
+   *cAng                                              = static_cast<proshade_single> ( hdrF[15] );
+    
+   *xAxOrigin                                         = static_cast<proshade_signed> ( hdrI[49] ) + (*xFrom);
+   *yAxOrigin                                         = static_cast<proshade_signed> ( hdrI[50] ) + (*yFrom);
+   *zAxOrigin                                         = static_cast<proshade_signed> ( hdrI[51] ) + (*zFrom);
+    
+   *xAxOrder                                          = 1;
+   *yAxOrder                                          = 2;
+   *zAxOrder                                          = 3;
+    
+   *xGridInds                                         = static_cast<proshade_unsign> ( hdrI[7] );
+   *yGridInds                                         = static_cast<proshade_unsign> ( hdrI[8] );
+   *zGridInds                                         = static_cast<proshade_unsign> ( hdrI[9] );
+    
+    //================================================ Deal with sampling being different from cell size
+    if ( *xGridInds != *xDimInds ) { *xDim = *xDim * ( static_cast<proshade_single> ( *xDimInds ) / static_cast<proshade_single> ( *xGridInds ) ); *xGridInds = *xDimInds; }
+    if ( *yGridInds != *yDimInds ) { *yDim = *yDim * ( static_cast<proshade_single> ( *yDimInds ) / static_cast<proshade_single> ( *yGridInds ) ); *yGridInds = *yDimInds; }
+    if ( *zGridInds != *zDimInds ) { *zDim = *zDim * ( static_cast<proshade_single> ( *zDimInds ) / static_cast<proshade_single> ( *zGridInds ) ); *zGridInds = *zDimInds; }
+    
+    //================================================ Release the mapping
+    munmap                                            ( mapped, fileSize );
+    
+    //================================================ Done
+    return                                            ( true );
+#endif
+}
+
 /*! \brief This function converts the gemmi Ccp4 object data to ProSHADE mask representation.
  
     This function firstly allocates the required memory for the ProSHADE mask representation variable according to the grid size. Then, it iterates over the axes in such a way, so that the resulting ProSHADE
@@ -405,8 +670,8 @@ void ProSHADE_internal_io::applyMaskFromArray ( proshade_double*& map, proshade_
         for ( size_t iter = 0; iter < newVolume; iter++ ) { inMap[iter][0] = mask[iter]; inMap[iter][1] = 0.0; }
 
         //============================================ Prepare Fourier transform plans
-        fftw_plan planForwardFourier                  = fftw_plan_dft_3d ( static_cast< int > ( xDimIndsMsk ), static_cast< int > ( yDimIndsMsk ), static_cast< int > ( zDimIndsMsk ), inMap, origCoeffs, FFTW_FORWARD,  FFTW_ESTIMATE );
-        fftw_plan inverseFoourier                     = fftw_plan_dft_3d ( static_cast< int > ( xDimInds ), static_cast< int > ( yDimInds ), static_cast< int > ( zDimInds ), modifCoeffs, outMap, FFTW_BACKWARD, FFTW_ESTIMATE );
+        fftw_plan planForwardFourier                  = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xDimIndsMsk ), static_cast< int > ( yDimIndsMsk ), static_cast< int > ( zDimIndsMsk ), inMap, origCoeffs, FFTW_FORWARD );
+        fftw_plan inverseFoourier                     = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xDimInds ), static_cast< int > ( yDimInds ), static_cast< int > ( zDimInds ), modifCoeffs, outMap, FFTW_BACKWARD );
 
         //============================================ Compute pre and post changes
         proshade_signed xPre, yPre, zPre;
@@ -419,7 +684,7 @@ void ProSHADE_internal_io::applyMaskFromArray ( proshade_double*& map, proshade_
         if ( ( ( static_cast< proshade_signed > ( zDimInds ) - static_cast< proshade_signed > ( zDimIndsMsk ) ) % 2 ) == 1 ) { zPre -= 1; }
 
         //============================================ Run forward Fourier
-        fftw_execute                                  ( planForwardFourier );
+        fftw_execute_dft                              ( planForwardFourier, inMap, origCoeffs );
 
         //============================================ Initialise local variables
         proshade_signed maskMapIndex                  = 0;
@@ -512,7 +777,7 @@ void ProSHADE_internal_io::applyMaskFromArray ( proshade_double*& map, proshade_
         }
 
         //============================================ Run inverse Fourier on the modified coefficients
-        fftw_execute                                  ( inverseFoourier );
+        fftw_execute_dft                              ( inverseFoourier, modifCoeffs, outMap );
 
         //============================================ Delete old mask and allocate memory for the new, re-sampled mask
         maskFinal                                     = new proshade_double [origVolume];
@@ -522,8 +787,6 @@ void ProSHADE_internal_io::applyMaskFromArray ( proshade_double*& map, proshade_
         for ( size_t iter = 0; iter < origVolume; iter++ ) { maskFinal[iter] = outMap[iter][0]; }
 
         //============================================ Release remaining memory
-        fftw_destroy_plan                             ( planForwardFourier );
-        fftw_destroy_plan                             ( inverseFoourier );
         fftw_free                                     ( origCoeffs );
         fftw_free                                     ( modifCoeffs );
         fftw_free                                     ( origCoeffsHKL );
@@ -690,8 +953,8 @@ void ProSHADE_internal_io::applyWeightsFromArray ( proshade_double*& map, prosha
         for ( size_t iter = 0; iter < newVolume; iter++ ) { inMap[iter][0] = weights[iter]; inMap[iter][1] = 0.0; }
         
         //============================================ Prepare Fourier transform plans
-        fftw_plan planForwardFourier                  = fftw_plan_dft_3d ( static_cast< int > ( xDimIndsWgh ), static_cast< int > ( yDimIndsWgh ), static_cast< int > ( zDimIndsWgh ), inMap, origCoeffs, FFTW_FORWARD,  FFTW_ESTIMATE );
-        fftw_plan inverseFoourier                     = fftw_plan_dft_3d ( static_cast< int > ( xDimInds ), static_cast< int > ( yDimInds ), static_cast< int > ( zDimInds ), modifCoeffs, outMap, FFTW_BACKWARD, FFTW_ESTIMATE );
+        fftw_plan planForwardFourier                  = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xDimIndsWgh ), static_cast< int > ( yDimIndsWgh ), static_cast< int > ( zDimIndsWgh ), inMap, origCoeffs, FFTW_FORWARD );
+        fftw_plan inverseFoourier                     = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xDimInds ), static_cast< int > ( yDimInds ), static_cast< int > ( zDimInds ), modifCoeffs, outMap, FFTW_BACKWARD );
 
         //============================================ Compute pre and post changes
         proshade_signed xPre, yPre, zPre;
@@ -704,7 +967,7 @@ void ProSHADE_internal_io::applyWeightsFromArray ( proshade_double*& map, prosha
         if ( ( ( static_cast< proshade_signed > ( zDimInds ) - static_cast< proshade_signed > ( zDimIndsWgh ) ) % 2 ) == 1 ) { zPre -= 1; }
 
         //============================================ Run forward Fourier
-        fftw_execute                                  ( planForwardFourier );
+        fftw_execute_dft                              ( planForwardFourier, inMap, origCoeffs );
 
         //============================================ Initialise local variables
         proshade_signed maskMapIndex                  = 0;
@@ -797,7 +1060,7 @@ void ProSHADE_internal_io::applyWeightsFromArray ( proshade_double*& map, prosha
         }
 
         //============================================ Run inverse Fourier on the modified coefficients
-        fftw_execute                                  ( inverseFoourier );
+        fftw_execute_dft                              ( inverseFoourier, modifCoeffs, outMap );
 
         //============================================ Delete old weights and allocate memory for the new, re-sampled weights
         weightsFinal                                  = new proshade_double [origVolume];
@@ -807,8 +1070,6 @@ void ProSHADE_internal_io::applyWeightsFromArray ( proshade_double*& map, prosha
         for ( size_t iter = 0; iter < origVolume; iter++ ) { weightsFinal[iter] = outMap[iter][0]; }
 
         //============================================ Release remaining memory
-        fftw_destroy_plan                             ( planForwardFourier );
-        fftw_destroy_plan                             ( inverseFoourier );
         fftw_free                                     ( origCoeffs );
         fftw_free                                     ( modifCoeffs );
         fftw_free                                     ( origCoeffsHKL );
@@ -823,36 +1084,13 @@ void ProSHADE_internal_io::applyWeightsFromArray ( proshade_double*& map, prosha
         for ( size_t iter = 0; iter < origVolume; iter++ ) { weightsFinal[iter] = weights[iter]; }
     }
     
-    //================================================ Allocate memory for map Fourier transform
-    fftw_complex* inMap                               = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * origVolume ) );
-    fftw_complex* outMap                              = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * origVolume ) );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( inMap,  __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( outMap, __FILE__, __LINE__, __func__ );
-    fftw_plan planForwardFourier                      = fftw_plan_dft_3d ( static_cast< int > ( xDimInds ), static_cast< int > ( yDimInds ), static_cast< int > ( zDimInds ), inMap, outMap, FFTW_FORWARD,  FFTW_ESTIMATE );
-    fftw_plan inverseFoourier                         = fftw_plan_dft_3d ( static_cast< int > ( xDimInds ), static_cast< int > ( yDimInds ), static_cast< int > ( zDimInds ), outMap, inMap, FFTW_BACKWARD, FFTW_ESTIMATE );
-
-    //================================================ Set data
-    for ( size_t iter = 0; iter < static_cast< size_t > ( origVolume ); iter++ ) { inMap[iter][0] = map[iter]; inMap[iter][1] = 0.0; }
-    
-    //================================================ Convert map to Fourier space
-    fftw_execute                                      ( planForwardFourier );
-    
-    //================================================ Apply the weights to the map in Fourier space
+    //================================================ Apply the weights to the map in Fourier space using the half-spectrum Fourier transforms
     proshade_double normFactor                        = static_cast<proshade_double> ( origVolume );
-    for ( size_t iter = 0; iter < static_cast< size_t > ( origVolume ); iter++ ) { outMap[iter][0] *= weightsFinal[iter] / normFactor; outMap[iter][1] *= weightsFinal[iter] / normFactor; }
-    
-    //================================================ Convert weighted map from Fourier space
-    fftw_execute                                      ( inverseFoourier );
-
-    //================================================ Copy results to map
-    for ( size_t iter = 0; iter < static_cast< size_t > ( xDimInds * yDimInds * zDimInds ); iter++ ) { map[iter] = inMap[iter][0]; }
+    std::function< std::complex< proshade_double > ( size_t ) > weighting = [&] ( size_t arrayPos ) { return ( std::complex< proshade_double > ( weightsFinal[arrayPos] / normFactor, 0.0 ) ); };
+    ProSHADE_internal_maths::applyFourierFilterToRealMap ( map, map, static_cast< proshade_signed > ( xDimInds ), static_cast< proshade_signed > ( yDimInds ), static_cast< proshade_signed > ( zDimInds ), weighting );
     
     //================================================ Release memory
     delete[] weightsFinal;
-    fftw_free                                         ( inMap );
-    fftw_free                                         ( outMap );
-    fftw_destroy_plan                                 ( planForwardFourier );
-    fftw_destroy_plan                                 ( inverseFoourier );
     
     //================================================ Report progress
     ProSHADE_internal_messages::printProgressMessage  ( verbose, 3, "Mask read in and applied successfully.", messageShift );
@@ -804,6 +804,39 @@ void ProSHADE_internal_mapManip::moveMapByIndices ( proshade_single* xMov, prosh
     
 }
 
+/*! \brief This function computes the phase shift multiplier which translates a map when applied to its Fourier coefficient.
+ 
+    \param[in] uIt The x-axis index of the coefficient in the Fourier coefficients array.
+    \param[in] vIt The y-axis index of the coefficient in the Fourier coefficients array.
+    \param[in] wIt The z-axis index of the coefficient in the Fourier coefficients array.
+    \param[in] xMov The NEGATIVE value by how many angstroms should the x axis be moved.
+    \param[in] yMov The NEGATIVE value by how many angstroms should the y axis be moved.
+    \param[in] zMov The NEGATIVE value by how many angstroms should the z axis be moved.
+    \param[in] xAngs How many angstroms are there along the x dimension.
+    \param[in] yAngs How many angstroms are there along the y dimension.
+    \param[in] zAngs How many angstroms are there along the z dimension.
+    \param[in] xDim How many indices are there along the x dimension.
+    \param[in] yDim How many indices are there along the y dimension.
+    \param[in] zDim How many indices are there along the z dimension.
+    \param[out] X The (not normalised) unit complex multiplier for the coefficient.
+ */
+std::complex< proshade_double > ProSHADE_internal_mapManip::getTranslationPhaseShift ( proshade_signed uIt, proshade_signed vIt, proshade_signed wIt, proshade_single xMov, proshade_single yMov, proshade_single zMov, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim )
+{
+    //================================================ Convert 0-max indices to HKL
+    proshade_signed h                                 = ( uIt > ( (xDim+1) / 2 ) ) ? ( uIt - xDim ) : uIt;
+    proshade_signed k                                 = ( vIt > ( (yDim+1) / 2 ) ) ? ( vIt - yDim ) : vIt;
+    proshade_signed l                                 = ( wIt > ( (zDim+1) / 2 ) ) ? ( wIt - zDim ) : wIt;
+    
+    //================================================ Get translation coefficient change
+    proshade_double exponent                          = ( ( ( static_cast <proshade_double> ( h ) / static_cast <proshade_double> ( xAngs ) ) * static_cast< proshade_double > ( -xMov ) ) +
+                                                          ( ( static_cast <proshade_double> ( k ) / static_cast <proshade_double> ( yAngs ) ) * static_cast< proshade_double > ( -yMov ) ) +
+                                                          ( ( static_cast <proshade_double> ( l ) / static_cast <proshade_double> ( zAngs ) ) * static_cast< proshade_double > ( -zMov ) ) ) * 2.0 * M_PI;
+    
+    //================================================ Done
+    return                                            ( std::complex< proshade_double > ( cos ( exponent ), sin ( exponent ) ) );
+    
+}
+
 /*! \brief Function for moving map back to original PDB location by using Fourier transformation.
  
     This function translates the map by changing the phase information of the map Fourier transform and then
@@ -821,69 +854,34 @@ void ProSHADE_internal_mapManip::moveMapByIndices ( proshade_single* xMov, prosh
     \param[in] xDim How many indices are there along the x dimension.
     \param[in] yDim How many indices are there along the y dimension.
     \param[in] zDim How many indices are there along the z dimension.
+    \param[in] coeffsScratch Optional half-spectrum scratch array (see applyFourierFilterToRealMap()) to be re-used instead of allocating a new one.
  */
-void ProSHADE_internal_mapManip::moveMapByFourier ( proshade_double*& map, proshade_single xMov, proshade_single yMov, proshade_single zMov, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim )
+void ProSHADE_internal_mapManip::moveMapByFourier ( proshade_double*& map, proshade_single xMov, proshade_single yMov, proshade_single zMov, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, fftw_complex* coeffsScratch )
 {
     //================================================ Local variables initialisation
-    proshade_unsign arrayPos                          = 0;
-    
-    //================================================ Create Fourier map variable
-    fftw_complex *fCoeffs                             = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * static_cast< proshade_unsign > ( xDim * yDim * zDim ) ) );
-    fftw_complex *translatedMap                       = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * static_cast< proshade_unsign > ( xDim * yDim * zDim ) ) );
-    
-    //================================================ Check memory allocation
-    ProSHADE_internal_misc::checkMemoryAllocation     ( fCoeffs,       __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( translatedMap, __FILE__, __LINE__, __func__ );
-    
-    //================================================ Create plans
-    fftw_plan planForwardFourier                      = fftw_plan_dft_3d ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), translatedMap, fCoeffs, FFTW_FORWARD,  FFTW_ESTIMATE );
-    fftw_plan planBackwardFourier                     = fftw_plan_dft_3d ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), fCoeffs, translatedMap, FFTW_BACKWARD, FFTW_ESTIMATE );
+    proshade_double normFactor                        = static_cast< proshade_double > ( xDim * yDim * zDim );
     
-    //================================================ Copy map to complex format
-    for ( proshade_unsign uIt = 0; uIt < static_cast< proshade_unsign > ( xDim ); uIt++ )
+    //================================================ Remove NaN values from the map
+    for ( size_t iter = 0; iter < static_cast< size_t > ( xDim * yDim * zDim ); iter++ )
     {
-        for ( proshade_unsign vIt = 0; vIt < static_cast< proshade_unsign > ( yDim ); vIt++ )
-        {
-            for ( proshade_unsign wIt = 0; wIt < static_cast< proshade_unsign > ( zDim ); wIt++ )
-            {
-                arrayPos                              = wIt + static_cast< proshade_unsign > ( zDim ) * ( vIt + static_cast< proshade_unsign > ( yDim ) * uIt );
-                
-                const FloatingPoint< proshade_double > lhs ( map[arrayPos] ), rhs ( map[arrayPos] );
-                if ( lhs.AlmostEquals ( rhs ) )       { translatedMap[arrayPos][0] = map[arrayPos]; }
-                else                                  { translatedMap[arrayPos][0] = 0.0; }
-                translatedMap[arrayPos][1]            = 0.0;
-            }
-        }
+        const FloatingPoint< proshade_double > lhs ( map[iter] ), rhs ( map[iter] );
+        if ( !lhs.AlmostEquals ( rhs ) )              { map[iter] = 0.0; }
     }
     
-    //================================================ Compute Forward Fourier
-    fftw_execute                                      ( planForwardFourier );
-    
-    //================================================ Shift the Fourier coefficients
-    proshade_double *weight                           = nullptr;
-    moveMapByFourierInReci                            ( fCoeffs, weight, xMov, yMov, zMov, xAngs, yAngs, zAngs, xDim, yDim, zDim );
-
-    //================================================ Compute inverse Fourier
-    fftw_execute                                      ( planBackwardFourier );
-    
-    //================================================ Copy back to map
-    for ( proshade_unsign uIt = 0; uIt < static_cast< proshade_unsign > ( xDim ); uIt++ )
+    //================================================ Define the translation phase shift for each coefficient
+    std::function< std::complex< proshade_double > ( size_t ) > shift = [&] ( size_t arrayPos )
     {
-        for ( proshade_unsign vIt = 0; vIt < static_cast< proshade_unsign > ( yDim ); vIt++ )
-        {
-            for ( proshade_unsign wIt = 0; wIt < static_cast< proshade_unsign > ( zDim ); wIt++ )
-            {
-                arrayPos                              = wIt + static_cast< proshade_unsign > ( zDim ) * ( vIt + static_cast< proshade_unsign > ( yDim ) * uIt );
-                map[arrayPos]                         = translatedMap[arrayPos][0];
-            }
-        }
-    }
+        //============================================ Find the indices
+        proshade_signed wIt                           = static_cast< proshade_signed > ( arrayPos % static_cast< size_t > ( zDim ) );
+        proshade_signed vIt                           = static_cast< proshade_signed > ( ( arrayPos / static_cast< size_t > ( zDim ) ) % static_cast< size_t > ( yDim ) );
+        proshade_signed uIt                           = static_cast< proshade_signed > ( arrayPos / static_cast< size_t > ( zDim * yDim ) );
+        
+        //============================================ Get the normalised translation coefficient change
+        return                                        ( getTranslationPhaseShift ( uIt, vIt, wIt, xMov, yMov, zMov, xAngs, yAngs, zAngs, xDim, yDim, zDim ) / normFactor );
+    };
     
-    //================================================ Release memory
-    fftw_destroy_plan                                 ( planForwardFourier );
-    fftw_destroy_plan                                 ( planBackwardFourier );
-    fftw_free                                         ( fCoeffs );
-    fftw_free                                         ( translatedMap );
+    //================================================ Shift the map using the half-spectrum Fourier transforms
+    ProSHADE_internal_maths::applyFourierFilterToRealMap ( map, map, xDim, yDim, zDim, shift, coeffsScratch );
     
     //================================================ Done
     return ;
@@ -911,12 +909,10 @@ void ProSHADE_internal_mapManip::moveMapByFourierInReci ( proshade_complex*& coe
 {
     //================================================ Local variables initialisation
     proshade_unsign arrayPos                          = 0;
-    proshade_signed h, k, l;
     proshade_double real                              = 0.0;
     proshade_double imag                              = 0.0;
     proshade_double trCoeffReal, trCoeffImag;
     proshade_double normFactor                        = static_cast< proshade_double > ( xDim * yDim * zDim );
-    proshade_double exponent                          = 0.0;
     proshade_double hlpArrReal;
     proshade_double hlpArrImag;
     
@@ -938,18 +934,11 @@ void ProSHADE_internal_mapManip::moveMapByFourierInReci ( proshade_complex*& coe
                 real                                  = coeffs[arrayPos][0];
                 imag                                  = coeffs[arrayPos][1];
                 
-                //==================================== Convert 0-max indices to HKL
-                if ( uIt > static_cast< proshade_unsign > ( (xDim+1) / 2) ) { h = static_cast < proshade_signed > ( uIt ) - xDim; } else { h = static_cast < proshade_signed > ( uIt ); }
-                if ( vIt > static_cast< proshade_unsign > ( (yDim+1) / 2) ) { k = static_cast < proshade_signed > ( vIt ) - yDim; } else { k = static_cast < proshade_signed > ( vIt ); }
-                if ( wIt > static_cast< proshade_unsign > ( (zDim+1) / 2) ) { l = static_cast < proshade_signed > ( wIt ) - zDim; } else { l = static_cast < proshade_signed > ( wIt ); }
-                
                 //==================================== Get translation coefficient change
-                exponent                              = ( ( ( static_cast <proshade_double> ( h ) / static_cast <proshade_double> ( xAngs ) ) * static_cast< proshade_double > ( -xMov ) ) +
-                                                          ( ( static_cast <proshade_double> ( k ) / static_cast <proshade_double> ( yAngs ) ) * static_cast< proshade_double > ( -yMov ) ) +
-                                                          ( ( static_cast <proshade_double> ( l ) / static_cast <proshade_double> ( zAngs ) ) * static_cast< proshade_double > ( -zMov ) ) ) * 2.0 * M_PI;
-                        
-                trCoeffReal                           = cos ( exponent );
-                trCoeffImag                           = sin ( exponent );
+                std::complex< proshade_double > trCoeff = getTranslationPhaseShift ( static_cast< proshade_signed > ( uIt ), static_cast< proshade_signed > ( vIt ), static_cast< proshade_signed > ( wIt ),
+                                                                                     xMov, yMov, zMov, xAngs, yAngs, zAngs, xDim, yDim, zDim );
+                trCoeffReal                           = trCoeff.real();
+                trCoeffImag                           = trCoeff.imag();
                 ProSHADE_internal_maths::complexMultiplication ( &real, &imag, &trCoeffReal, &trCoeffImag, &hlpArrReal, &hlpArrImag );
                 
                 //==================================== Save the translated coefficient value and apply weights
@@ -982,87 +971,39 @@ void ProSHADE_internal_mapManip::moveMapByFourierInReci ( proshade_complex*& coe
     \param[in] yAngs The size of the y dimension of the map in angstroms.
     \param[in] zAngs The size of the z dimension of the map in angstroms.
     \param[in] blurringFactor The amount of B-factor change that should be applied to the map. (I.e. increasing the map overall B-factors by 20 will be done by supplying 20 as a value for this parameter).
+    \param[in] coeffsScratch Optional half-spectrum scratch array (see applyFourierFilterToRealMap()) to be re-used instead of allocating a new one.
  */
-void ProSHADE_internal_mapManip::blurSharpenMap ( proshade_double*& map, proshade_double*& blurredMap, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single blurringFactor )
+void ProSHADE_internal_mapManip::blurSharpenMap ( proshade_double*& map, proshade_double*& blurredMap, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single blurringFactor, fftw_complex* coeffsScratch )
 {
     //================================================ Set local variables
     proshade_signed xDim                              = static_cast< proshade_signed > ( xDimS );
     proshade_signed yDim                              = static_cast< proshade_signed > ( yDimS );
     proshade_signed zDim                              = static_cast< proshade_signed > ( zDimS );
-    proshade_double real, imag, S, mag, phase;
-    proshade_signed h, k, l;
-    proshade_unsign arrayPos                          = 0;
     proshade_double normFactor                        = static_cast<proshade_double> ( xDim * yDim * zDim );
     
-    //================================================ Copy map for processing
-    fftw_complex* mapCoeffs                           = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * static_cast< proshade_unsign > ( xDim * yDim * zDim ) ) );
-    fftw_complex* mapMask                             = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * static_cast< proshade_unsign > ( xDim * yDim * zDim ) ) );
-    
-    //================================================ Check memory allocation
-    ProSHADE_internal_misc::checkMemoryAllocation     ( mapCoeffs, __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( mapMask,   __FILE__, __LINE__, __func__ );
-    
-    //================================================ Copy data to mask
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> (xDim * yDim * zDim); iter++ )
-    {
-        mapMask[iter][0]                              = map[iter];
-        mapMask[iter][1]                              = 0.0;
-    }
-    
-    //================================================ Prepare FFTW plans
-    fftw_plan forward                                 = fftw_plan_dft_3d ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), mapMask, mapCoeffs, FFTW_FORWARD,  FFTW_ESTIMATE );
-    fftw_plan inverse                                 = fftw_plan_dft_3d ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), mapCoeffs, mapMask, FFTW_BACKWARD, FFTW_ESTIMATE );
-    
-    //================================================ Run forward Fourier
-    fftw_execute                                      ( forward );
-    
-    //================================================ Blur the coeffs
-    for ( proshade_unsign uIt = 0; uIt < static_cast<proshade_unsign> ( xDim ); uIt++ )
+    //================================================ Define the B-factor change for each coefficient
+    std::function< std::complex< proshade_double > ( size_t ) > blur = [&] ( size_t arrayPos )
     {
-        for ( proshade_unsign vIt = 0; vIt < static_cast<proshade_unsign> ( yDim ); vIt++ )
-        {
-            for ( proshade_unsign wIt = 0; wIt < static_cast<proshade_unsign> ( zDim ); wIt++ )
-            {
-                //==================================== Var init
-                arrayPos                              = wIt + static_cast< proshade_unsign > ( zDim ) * ( vIt + static_cast< proshade_unsign > ( yDim ) * uIt );
-                real                                  = mapCoeffs[arrayPos][0];
-                imag                                  = mapCoeffs[arrayPos][1];
-                
-                //==================================== Convert to HKL
-                if ( uIt > static_cast< proshade_unsign > ( (xDim+1) / 2) ) { h = static_cast < proshade_signed > ( uIt ) - xDim; } else { h = static_cast < proshade_signed > ( uIt ); }
-                if ( vIt > static_cast< proshade_unsign > ( (yDim+1) / 2) ) { k = static_cast < proshade_signed > ( vIt ) - yDim; } else { k = static_cast < proshade_signed > ( vIt ); }
-                if ( wIt > static_cast< proshade_unsign > ( (zDim+1) / 2) ) { l = static_cast < proshade_signed > ( wIt ) - zDim; } else { l = static_cast < proshade_signed > ( wIt ); }
-                
-                //====================================Get magnitude and phase with mask parameters
-                S                                     = ( pow( static_cast< proshade_double > ( h ) / static_cast< proshade_double > ( xAngs ), 2.0 ) +
+        //============================================ Find the indices
+        proshade_signed wIt                           = static_cast< proshade_signed > ( arrayPos % zDimS );
+        proshade_signed vIt                           = static_cast< proshade_signed > ( ( arrayPos / zDimS ) % yDimS );
+        proshade_signed uIt                           = static_cast< proshade_signed > ( arrayPos / ( zDimS * yDimS ) );
+        
+        //============================================ Convert to HKL
+        proshade_signed h                             = ( uIt > ( (xDim+1) / 2 ) ) ? ( uIt - xDim ) : uIt;
+        proshade_signed k                             = ( vIt > ( (yDim+1) / 2 ) ) ? ( vIt - yDim ) : vIt;
+        proshade_signed l                             = ( wIt > ( (zDim+1) / 2 ) ) ? ( wIt - zDim ) : wIt;
+        
+        //============================================ Get the magnitude change
+        proshade_double S                             = ( pow( static_cast< proshade_double > ( h ) / static_cast< proshade_double > ( xAngs ), 2.0 ) +
                                                           pow( static_cast< proshade_double > ( k ) / static_cast< proshade_double > ( yAngs ), 2.0 ) +
                                                           pow( static_cast< proshade_double > ( l ) / static_cast< proshade_double > ( zAngs ), 2.0 ) );
-                mag                                   = std::sqrt ( (real*real) + (imag*imag) ) * std::exp ( - ( ( static_cast< proshade_double > ( blurringFactor ) * S ) / 4.0 ) );
-                phase                                 = std::atan2 ( imag, real );
-                
-                //==================================== Save the mask data
-                mapCoeffs[arrayPos][0]                = ( mag * cos(phase) ) / normFactor;
-                mapCoeffs[arrayPos][1]                = ( mag * sin(phase) ) / normFactor;
-            }
-        }
-    }
-    
-    //================================================ Run inverse Fourier
-    fftw_execute                                      ( inverse );
-    
-    //================================================ Save the results
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> (xDim * yDim * zDim); iter++ )
-    {
-        blurredMap[iter]                              = mapMask[iter][0];
-    }
-    
-    //================================================ Release memory
-    fftw_free                                         ( mapMask );
-    fftw_free                                         ( mapCoeffs );
+        
+        return                                        ( std::complex< proshade_double > ( std::exp ( - ( ( static_cast< proshade_double > ( blurringFactor ) * S ) / 4.0 ) ) / normFactor, 0.0 ) );
+    };
     
-    //================================================ Delete FFTW plans
-    fftw_destroy_plan                                 ( forward );
-    fftw_destroy_plan                                 ( inverse );
+    //================================================ Blur the map using the half-spectrum Fourier transforms
+    ProSHADE_internal_maths::applyFourierFilterToRealMap ( map, blurredMap, xDim, yDim, zDim, blur, coeffsScratch );
     
     //================================================ Done
     return ;
@@ -1082,27 +1023,22 @@ void ProSHADE_internal_mapManip::blurSharpenMap ( proshade_double*& map, proshad
     \param[in] yDim The number of indices along the y axis of the map.
     \param[in] zDim The number of indices along the z axis of the map.
     \param[in] noIQRs The number of inter-quartile ranges from the median which should be used to compute the threshold for masking.
+    \param[in] noThreads The number of threads to be used for finding the median and IQR.
+    \param[in] noPasses Optional pointer to a counter, to which the number of passes over the map will be added.
  */
-void ProSHADE_internal_mapManip::getMaskFromBlurr ( proshade_double*& blurMap, proshade_double*& outMap, proshade_unsign xDim, proshade_unsign yDim, proshade_unsign zDim, proshade_single noIQRs )
+void ProSHADE_internal_mapManip::getMaskFromBlurr ( proshade_double*& blurMap, proshade_double*& outMap, proshade_unsign xDim, proshade_unsign yDim, proshade_unsign zDim, proshade_single noIQRs, proshade_unsign noThreads, proshade_unsign* noPasses )
 {
-    //================================================ Initialise vector for map data
-    std::vector<proshade_double> mapVals ( xDim * yDim * zDim, 0.0 );
-    
-    //================================================ Save map values in vector
-    for ( proshade_unsign iter = 0; iter < ( xDim * yDim * zDim ); iter++ )
-    {
-        mapVals.at(iter)                              = blurMap[iter];
-    }
-    
-    //================================================ Find median and IQRs
+    //================================================ Find median and IQRs (directly from the map, without copying or sorting it)
+    size_t mapSize                                    = static_cast< size_t > ( xDim ) * static_cast< size_t > ( yDim ) * static_cast< size_t > ( zDim );
     proshade_double* medAndIQR                        = new proshade_double[2];
-    ProSHADE_internal_maths::vectorMedianAndIQR ( &mapVals, medAndIQR );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( medAndIQR, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_maths::arrayMedianAndIQRHistogram ( blurMap, mapSize, medAndIQR, noThreads, noPasses );
     
     //================================================ Find the threshold
     proshade_double maskThreshold                     = medAndIQR[0] + ( medAndIQR[1] * static_cast<proshade_double> ( noIQRs ) );
     
     //================================================ Apply threshold
-    for ( proshade_unsign iter = 0; iter < ( xDim * yDim * zDim ); iter++ )
+    for ( size_t iter = 0; iter < mapSize; iter++ )
     {
         if ( blurMap[iter] < maskThreshold )
         {
@@ -1110,9 +1046,7 @@ void ProSHADE_internal_mapManip::getMaskFromBlurr ( proshade_double*& blurMap, p
             blurMap[iter]                             = 0.0;
         }
     }
-    
-    //================================================ Release vector values
-    mapVals.clear                                     ( );
+    if ( noPasses != nullptr ) { *noPasses += 1; }
     
     //================================================ Release memory
     delete[] medAndIQR;
@@ -1210,11 +1144,52 @@ void ProSHADE_internal_mapManip::addExtraBoundSpace ( proshade_unsign xDim, pros
     
 }
 
+/*! \brief This function computes the tri-linear interpolation positions and weights along a single map axis.
+ 
+    For each index of the new grid along the axis, this function finds the first old grid interval which contains the new grid position (or keeps the
+    last found interval if the new position is past the end of the old grid) and computes the relative position of the new point within this interval.
+    As the tri-linear interpolation is separable, these tables are all that is needed to interpolate along the given axis.
+ 
+    \param[in] newDim The number of indices along the axis of the new map.
+    \param[in] oldDim The number of indices along the axis of the old map.
+    \param[in] newSample The sampling (in angstroms) of the new map along the axis.
+    \param[in] oldSample The sampling (in angstroms) of the old map along the axis.
+    \param[in] bottoms Pointer to vector to which the lower old map index for each new index will be saved.
+    \param[in] tops Pointer to vector to which the upper old map index for each new index will be saved.
+    \param[in] weights Pointer to vector to which the relative position of each new index between its lower and upper old map indices will be saved.
+ */
+void ProSHADE_internal_mapManip::getTrilinearAxisTable ( proshade_signed newDim, proshade_signed oldDim, proshade_single newSample, proshade_single oldSample, std::vector< proshade_signed >* bottoms, std::vector< proshade_signed >* tops, std::vector< proshade_double >* weights )
+{
+    //================================================ Initialise local variables
+    proshade_signed bottom = 0, top;
+    bottoms->resize                                   ( static_cast< size_t > ( newDim ) );
+    tops->resize                                      ( static_cast< size_t > ( newDim ) );
+    weights->resize                                   ( static_cast< size_t > ( newDim ) );
+    
+    //================================================ For each new index
+    for ( proshade_signed it = 0; it < newDim; it++ )
+    {
+        //============================================ Find the bottom and top positions in the old map
+        for ( proshade_signed o = 0; o < ( oldDim - 1 ); o++ ) { if ( ( ( static_cast< proshade_single > ( it ) * newSample ) >= ( static_cast< proshade_single > ( o ) * oldSample ) ) && ( ( static_cast< proshade_single > ( it ) * newSample ) <= ( ( static_cast< proshade_single > ( o ) + 1 ) * oldSample ) ) ) { bottom = o; break; } }
+        top                                           = bottom + 1;
+        
+        //============================================ Save the positions (the top one clamped for single index axes) and the relative position
+        bottoms->at(static_cast< size_t > ( it ))     = bottom;
+        tops->at(static_cast< size_t > ( it ))        = std::min ( top, oldDim - 1 );
+        weights->at(static_cast< size_t > ( it ))     = ( ( static_cast<proshade_double> ( it ) * static_cast<proshade_double> ( newSample ) ) - ( static_cast<proshade_double> ( bottom ) * static_cast<proshade_double> ( oldSample ) ) ) / ( ( static_cast<proshade_double> ( top ) * static_cast<proshade_double> ( oldSample ) ) - ( static_cast<proshade_double> ( bottom ) * static_cast<proshade_double> ( oldSample ) ) );
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief This function re-samples a map to conform to given resolution using tri-linear interpolation.
  
     This function takes a map and resolution value and it proceeds to create a new map, which has sampling resolution/2 and is
     large enough to contain the original map. It then proceeds to interpolate the new map values from the old map values, re-writing
-    the old map once interpolation is done.
+    the old map once interpolation is done. As the interpolation is separable, the old map positions and weights are computed once
+    for each axis and every new map x-plane is then interpolated along x, y and z in turn by its own task.
  
     \param[in] map A Reference Pointer to the map for which the bounds are to be found.
     \param[in] resolution The required resolution value.
@@ -1224,9 +1199,10 @@ void ProSHADE_internal_mapManip::addExtraBoundSpace ( proshade_unsign xDim, pros
     \param[in] xAngs The size of the x dimension of the map in angstroms.
     \param[in] yAngs The size of the y dimension of the map in angstroms.
     \param[in] zAngs The size of the z dimension of the map in angstroms.
- \param[in] corrs Pointer reference to proshade_single array of 6 values with the following meaning: 0 = xAdd; 1 = yAdd; 2 = zAdd; 3 = newXAng; 4 = newYAng;  5 = newZAng
+    \param[in] corrs Pointer reference to proshade_single array of 6 values with the following meaning: 0 = xAdd; 1 = yAdd; 2 = zAdd; 3 = newXAng; 4 = newYAng;  5 = newZAng
+    \param[in] noThreads The number of threads to be used for the interpolation.
  */
-void ProSHADE_internal_mapManip::reSampleMapToResolutionTrilinear ( proshade_double*& map, proshade_single resolution, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single*& corrs )
+void ProSHADE_internal_mapManip::reSampleMapToResolutionTrilinear ( proshade_double*& map, proshade_single resolution, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single*& corrs, proshade_unsign noThreads )
 {
     //================================================ Sanity check - the resolution needs to be set
     if ( resolution <= 0.0f )
@@ -1252,152 +1228,72 @@ void ProSHADE_internal_mapManip::reSampleMapToResolutionTrilinear ( proshade_dou
     
     //================================================ Create a new map variable
     proshade_double* newMap                           = new proshade_double [newXDim * newYDim * newZDim];
-    
-    //================================================ For each new map point
-    proshade_signed xBottom = 0, xTop, yBottom = 0, yTop, zBottom = 0, zTop, oldMapIndex, newMapIndex;
-    std::vector<proshade_double> c000                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c001                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c010                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c011                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c100                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c101                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c110                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c111                 = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c00                  = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c01                  = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c10                  = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c11                  = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c0                   = std::vector<proshade_double> ( 4, 0.0 );
-    std::vector<proshade_double> c1                   = std::vector<proshade_double> ( 4, 0.0 );
-    proshade_double xRelative, yRelative, zRelative;
-    
-    for ( proshade_signed xIt = 0; xIt < newXDim; xIt++ )
+    ProSHADE_internal_misc::checkMemoryAllocation     ( newMap, __FILE__, __LINE__, __func__ );
+    
+    //================================================ Find the old map positions and interpolation weights along each axis
+    std::vector< proshade_signed > xBottoms, xTops, yBottoms, yTops, zBottoms, zTops;
+    std::vector< proshade_double > xWeights, yWeights, zWeights, zWeightsC;
+    getTrilinearAxisTable                             ( newXDim, xDim, newXSample, oldXSample, &xBottoms, &xTops, &xWeights );
+    getTrilinearAxisTable                             ( newYDim, yDim, newYSample, oldYSample, &yBottoms, &yTops, &yWeights );
+    getTrilinearAxisTable                             ( newZDim, zDim, newZSample, oldZSample, &zBottoms, &zTops, &zWeights );
+    zWeightsC.resize                                  ( zWeights.size() );
+    for ( size_t iter = 0; iter < zWeights.size(); iter++ ) { zWeightsC.at(iter) = 1.0 - zWeights.at(iter); }
+    
+    //================================================ Allocate per worker planes for the x and the x and y interpolated values
+    size_t oldPlaneSize                               = static_cast< size_t > ( yDim * zDim );
+    proshade_unsign noWorkers                         = ProSHADE_internal_misc::getNumberOfThreads ( noThreads, static_cast< proshade_unsign > ( newXDim ) );
+    std::vector< std::vector< proshade_double > > xPlanes ( noWorkers, std::vector< proshade_double > ( oldPlaneSize ) );
+    std::vector< std::vector< proshade_double > > xyPlanes ( noWorkers, std::vector< proshade_double > ( static_cast< size_t > ( newYDim * zDim ) ) );
+    
+    //================================================ Interpolate each new map x-plane along X, then Y and then Z
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( newXDim ), noThreads, [&] ( proshade_unsign xIt, proshade_unsign workerIt )
     {
+        proshade_double* xPlane                       = &xPlanes.at(workerIt)[0];
+        proshade_double* xyPlane                      = &xyPlanes.at(workerIt)[0];
+        
+        //============================================ Interpolate to the new grid along X
+        const proshade_double* bottomPlane            = map + static_cast< size_t > ( xBottoms.at(xIt) ) * oldPlaneSize;
+        const proshade_double* topPlane               = map + static_cast< size_t > ( xTops.at(xIt) ) * oldPlaneSize;
+        proshade_double xRelative                     = xWeights.at(xIt);
+        proshade_double xRelativeC                    = 1.0 - xRelative;
+        for ( size_t iter = 0; iter < oldPlaneSize; iter++ )
+        {
+            xPlane[iter]                              = ( bottomPlane[iter] * xRelativeC ) + ( topPlane[iter] * xRelative );
+        }
+        
+        //============================================ Interpolate to the new grid along Y
         for ( proshade_signed yIt = 0; yIt < newYDim; yIt++ )
         {
+            const proshade_double* bottomRow          = xPlane + yBottoms.at(static_cast< size_t > ( yIt )) * zDim;
+            const proshade_double* topRow             = xPlane + yTops.at(static_cast< size_t > ( yIt )) * zDim;
+            proshade_double* xyRow                    = xyPlane + yIt * zDim;
+            proshade_double yRelative                 = yWeights.at(static_cast< size_t > ( yIt ));
+            proshade_double yRelativeC                = 1.0 - yRelative;
+            for ( proshade_signed zIt = 0; zIt < zDim; zIt++ )
+            {
+                xyRow[zIt]                            = ( bottomRow[zIt] * yRelativeC ) + ( topRow[zIt] * yRelative );
+            }
+        }
+        
+        //============================================ Interpolate to the new grid along Z
+        const proshade_signed* zBottom                = &zBottoms[0];
+        const proshade_signed* zTop                   = &zTops[0];
+        const proshade_double* zRelative              = &zWeights[0];
+        const proshade_double* zRelativeC             = &zWeightsC[0];
+        for ( proshade_signed yIt = 0; yIt < newYDim; yIt++ )
+        {
+            const proshade_double* xyRow              = xyPlane + yIt * zDim;
+            proshade_double* newRow                   = newMap + newZDim * ( yIt + newYDim * static_cast< proshade_signed > ( xIt ) );
             for ( proshade_signed zIt = 0; zIt < newZDim; zIt++ )
             {
-                //==================================== Get this point's index
-                newMapIndex                           = zIt + newZDim * ( yIt + newYDim * xIt );
-                
-                //==================================== Find this points bottom and top positions in the old map (including periodicity)
-                for ( proshade_signed ox = 0; ox < ( static_cast< proshade_signed > ( xDimS ) - 1 ); ox++ ) { if ( ( ( static_cast< proshade_single > ( xIt ) * newXSample ) >= ( static_cast< proshade_single > ( ox ) * oldXSample ) ) && ( ( static_cast< proshade_single > ( xIt ) * newXSample ) <= ( ( static_cast< proshade_single > ( ox ) + 1 ) * oldXSample ) ) ) { xBottom = ox; break; } }
-                for ( proshade_signed oy = 0; oy < ( static_cast< proshade_signed > ( yDimS ) - 1 ); oy++ ) { if ( ( ( static_cast< proshade_single > ( yIt ) * newYSample ) >= ( static_cast< proshade_single > ( oy ) * oldYSample ) ) && ( ( static_cast< proshade_single > ( yIt ) * newYSample ) <= ( ( static_cast< proshade_single > ( oy ) + 1 ) * oldYSample ) ) ) { yBottom = oy; break; } }
-                for ( proshade_signed oz = 0; oz < ( static_cast< proshade_signed > ( zDimS ) - 1 ); oz++ ) { if ( ( ( static_cast< proshade_single > ( zIt ) * newZSample ) >= ( static_cast< proshade_single > ( oz ) * oldZSample ) ) && ( ( static_cast< proshade_single > ( zIt ) * newZSample ) <= ( ( static_cast< proshade_single > ( oz ) + 1 ) * oldZSample ) ) ) { zBottom = oz; break; } }
-                xTop                                  = xBottom + 1;
-                yTop                                  = yBottom + 1;
-                zTop                                  = zBottom + 1;
-
-                //==================================== Find the surrounding point's values from the original map
-                oldMapIndex                           = zBottom + static_cast< proshade_signed > ( zDimS ) * ( yBottom + static_cast< proshade_signed > ( yDimS ) * xBottom );
-                c000.at(0)                            = static_cast<proshade_double> ( xBottom ) * static_cast<proshade_double> ( oldXSample );
-                c000.at(1)                            = static_cast<proshade_double> ( yBottom ) * static_cast<proshade_double> ( oldYSample );
-                c000.at(2)                            = static_cast<proshade_double> ( zBottom ) * static_cast<proshade_double> ( oldZSample );
-                c000.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                oldMapIndex                           = zTop    + static_cast< proshade_signed > ( zDimS ) * ( yBottom + static_cast< proshade_signed > ( yDimS ) * xBottom );
-                c001.at(0)                            = static_cast<proshade_double> ( xBottom ) * static_cast<proshade_double> ( oldXSample );
-                c001.at(1)                            = static_cast<proshade_double> ( yBottom ) * static_cast<proshade_double> ( oldYSample );
-                c001.at(2)                            = static_cast<proshade_double> ( zTop    ) * static_cast<proshade_double> ( oldZSample );
-                c001.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                oldMapIndex                           = zBottom + static_cast< proshade_signed > ( zDimS ) * ( yTop    + static_cast< proshade_signed > ( yDimS ) * xBottom );
-                c010.at(0)                            = static_cast<proshade_double> ( xBottom ) * static_cast<proshade_double> ( oldXSample );
-                c010.at(1)                            = static_cast<proshade_double> ( yTop    ) * static_cast<proshade_double> ( oldYSample );
-                c010.at(2)                            = static_cast<proshade_double> ( zBottom ) * static_cast<proshade_double> ( oldZSample );
-                c010.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                oldMapIndex                           = zTop    + static_cast< proshade_signed > ( zDimS ) * ( yTop    + static_cast< proshade_signed > ( yDimS ) * xBottom );
-                c011.at(0)                            = static_cast<proshade_double> ( xBottom ) * static_cast<proshade_double> ( oldXSample );
-                c011.at(1)                            = static_cast<proshade_double> ( yTop    ) * static_cast<proshade_double> ( oldYSample );
-                c011.at(2)                            = static_cast<proshade_double> ( zTop    ) * static_cast<proshade_double> ( oldZSample );
-                c011.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                oldMapIndex                           = zBottom + static_cast< proshade_signed > ( zDimS ) * ( yBottom + static_cast< proshade_signed > ( yDimS ) * xTop    );
-                c100.at(0)                            = static_cast<proshade_double> ( xTop    ) * static_cast<proshade_double> ( oldXSample );
-                c100.at(1)                            = static_cast<proshade_double> ( yBottom ) * static_cast<proshade_double> ( oldYSample );
-                c100.at(2)                            = static_cast<proshade_double> ( zBottom ) * static_cast<proshade_double> ( oldZSample );
-                c100.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                oldMapIndex                           = zTop    + static_cast< proshade_signed > ( zDimS ) * ( yBottom + static_cast< proshade_signed > ( yDimS ) * xTop    );
-                c101.at(0)                            = static_cast<proshade_double> ( xTop    ) * static_cast<proshade_double> ( oldXSample );
-                c101.at(1)                            = static_cast<proshade_double> ( yBottom ) * static_cast<proshade_double> ( oldYSample );
-                c101.at(2)                            = static_cast<proshade_double> ( zTop    ) * static_cast<proshade_double> ( oldZSample );
-                c101.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                oldMapIndex                           = zBottom + static_cast< proshade_signed > ( zDimS ) * ( yTop    + static_cast< proshade_signed > ( yDimS ) * xTop    );
-                c110.at(0)                            = static_cast<proshade_double> ( xTop    ) * static_cast<proshade_double> ( oldXSample );
-                c110.at(1)                            = static_cast<proshade_double> ( yTop    ) * static_cast<proshade_double> ( oldYSample );
-                c110.at(2)                            = static_cast<proshade_double> ( zBottom ) * static_cast<proshade_double> ( oldZSample );
-                c110.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                oldMapIndex                           = zTop    + static_cast< proshade_signed > ( zDimS ) * ( yTop    + static_cast< proshade_signed > ( yDimS ) * xTop    );
-                c111.at(0)                            = static_cast<proshade_double> ( xTop    ) * static_cast<proshade_double> ( oldXSample );
-                c111.at(1)                            = static_cast<proshade_double> ( yTop    ) * static_cast<proshade_double> ( oldYSample );
-                c111.at(2)                            = static_cast<proshade_double> ( zTop    ) * static_cast<proshade_double> ( oldZSample );
-                c111.at(3)                            = static_cast<proshade_double> ( map[oldMapIndex] );
-                
-                //==================================== Interpolate to the new grid along X
-                xRelative                             = ( ( static_cast<proshade_double> ( xIt ) * static_cast<proshade_double> ( newXSample ) ) - ( static_cast<proshade_double> ( xBottom ) * static_cast<proshade_double> ( oldXSample ) ) ) / ( ( static_cast<proshade_double> ( xTop ) * static_cast<proshade_double> ( oldXSample ) ) - ( static_cast<proshade_double> ( xBottom ) * static_cast<proshade_double> ( oldXSample ) ) );
-                
-                //==================================== Interpolate for the less less point
-                c00.at(0)                             = ( static_cast< proshade_double > ( newXSample ) * xRelative ) + c000.at(0);
-                c00.at(1)                             = c000.at(1);
-                c00.at(2)                             = c000.at(2);
-                c00.at(3)                             = ( c000.at(3) * ( 1.0 - xRelative ) ) + ( c100.at(3) * xRelative );
-                
-                //==================================== Interpolate for the less more point
-                c01.at(0)                             = ( static_cast< proshade_double > ( newXSample ) * xRelative ) + c001.at(0);
-                c01.at(1)                             = c001.at(1);
-                c01.at(2)                             = c001.at(2);
-                c01.at(3)                             = ( c001.at(3) * ( 1.0 - xRelative ) ) + ( c101.at(3) * xRelative );
-                
-                //==================================== Interpolate for the more less point
-                c10.at(0)                             = ( static_cast< proshade_double > ( newXSample ) * xRelative ) + c010.at(0);
-                c10.at(1)                             = c010.at(1);
-                c10.at(2)                             = c010.at(2);
-                c10.at(3)                             = ( c010.at(3) * ( 1.0 - xRelative ) ) + ( c110.at(3) * xRelative );
-                
-                //==================================== Interpolate for the more more point
-                c11.at(0)                             = ( static_cast< proshade_double > ( newXSample ) * xRelative ) + c011.at(0);
-                c11.at(1)                             = c011.at(1);
-                c11.at(2)                             = c011.at(2);
-                c11.at(3)                             = ( c011.at(3) * ( 1.0 - xRelative ) ) + ( c111.at(3) * xRelative );
-                
-                //==================================== Interpolate to the new grid along Y
-                yRelative                             =  ( ( static_cast<proshade_double> ( yIt ) * static_cast<proshade_double> ( newYSample ) ) - ( static_cast<proshade_double> ( yBottom ) * static_cast<proshade_double> ( oldYSample ) ) ) / ( ( static_cast<proshade_double> ( yTop ) * static_cast<proshade_double> ( oldYSample ) ) - ( static_cast<proshade_double> ( yBottom ) * static_cast<proshade_double> ( oldYSample ) ) );
-                
-                //==================================== Interpolate for the less point
-                c0.at(0)                              = c00.at(0);
-                c0.at(1)                              = ( static_cast< proshade_double > ( newYSample ) * yRelative ) + c00.at(1);
-                c0.at(2)                              = c00.at(2);
-                c0.at(3)                              = ( c00.at(3) * ( 1.0 - yRelative ) ) + ( c10.at(3) * yRelative );
-                
-                //==================================== Interpolate for the more point
-                c1.at(0)                              = c01.at(0);
-                c1.at(1)                              = ( static_cast< proshade_double > ( newYSample ) * yRelative ) + c01.at(1);
-                c1.at(2)                              = c01.at(2);
-                c1.at(3)                              = ( c01.at(3) * ( 1.0 - yRelative ) ) + ( c11.at(3) * yRelative );
-                
-                //==================================== Interpolate to the new grid along Z
-                zRelative                             = ( ( static_cast<proshade_double> ( zIt ) * static_cast< proshade_double > ( newZSample ) ) - ( static_cast<proshade_double> ( zBottom ) * static_cast<proshade_double> ( oldZSample ) ) ) / static_cast< proshade_double > ( ( static_cast<proshade_double> ( zTop ) * static_cast<proshade_double> ( oldZSample ) ) - ( static_cast<proshade_double> ( zBottom ) * static_cast<proshade_double> ( oldZSample ) ) );
-                newMap[newMapIndex]                   = ( c0.at(3) * ( 1.0 - zRelative ) ) + ( c1.at(3) * zRelative );
+                newRow[zIt]                           = ( xyRow[zBottom[zIt]] * zRelativeC[zIt] ) + ( xyRow[zTop[zIt]] * zRelative[zIt] );
             }
         }
-    }
+    } );
     
-    //================================================ Delete old map and allocate new memory
+    //================================================ Replace the old map with the new one
     delete[] map;
-    map                                               = new proshade_double [newXDim * newYDim * newZDim];
-    
-    //================================================ Copy map
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( newXDim * newYDim * newZDim ); iter++ )
-    {
-        map[iter]                                     = newMap[iter];
-    }
-    
-    //================================================ Release memory
-    delete[] newMap;
+    map                                               = newMap;
     
     //================================================ Define change in indices and return it
     corrs[0]                                          = static_cast< proshade_single > ( newXDim - xDim );
@@ -1415,7 +1311,8 @@ void ProSHADE_internal_mapManip::reSampleMapToResolutionTrilinear ( proshade_dou
 /*! \brief This function re-samples a map to conform to given resolution using Fourier.
  
     This function re-samples the internal map to a given resolutution by removing or zero-padding the Fourier (reciprocal space) coefficients and computing the inverse
-    Fourier transform. This is the default option for map re-sampling, should it be required by the user.
+    Fourier transform. This is the default option for map re-sampling, should it be required by the user. Both transforms work on the half-spectrum (real to complex
+    and complex to real), the missing coefficients being obtained from Friedel's law.
  
     \param[in] map A Reference Pointer to the map for which the bounds are to be found.
     \param[in] resolution The required resolution value.
@@ -1453,73 +1350,70 @@ void ProSHADE_internal_mapManip::reSampleMapToResolutionFourier ( proshade_doubl
     if ( newYDim % 2 != 0 ) { newYDim += 1; }
     if ( newZDim % 2 != 0 ) { newZDim += 1; }
  
-    proshade_signed preXChange, preYChange, preZChange;
-    preXChange                                        = static_cast< proshade_signed  > ( std::floor ( ( static_cast<proshade_single> ( xDimS ) - static_cast<proshade_single> ( newXDim ) ) / 2.0f ) );
-    preYChange                                        = static_cast< proshade_signed  > ( std::floor ( ( static_cast<proshade_single> ( yDimS ) - static_cast<proshade_single> ( newYDim ) ) / 2.0f ) );
-    preZChange                                        = static_cast< proshade_signed  > ( std::floor ( ( static_cast<proshade_single> ( zDimS ) - static_cast<proshade_single> ( newZDim ) ) / 2.0f ) );
-    
-    proshade_signed postXChange                       = static_cast<proshade_signed> ( xDimS ) - ( preXChange + static_cast<proshade_signed> ( newXDim ) );
-    proshade_signed postYChange                       = static_cast<proshade_signed> ( yDimS ) - ( preYChange + static_cast<proshade_signed> ( newYDim ) );
-    proshade_signed postZChange                       = static_cast<proshade_signed> ( zDimS ) - ( preZChange + static_cast<proshade_signed> ( newZDim ) );
-    
-    proshade_unsign origSizeArr = 0, newSizeArr = 0;
+    proshade_signed xDimO                             = static_cast< proshade_signed > ( xDimS );
+    proshade_signed yDimO                             = static_cast< proshade_signed > ( yDimS );
+    proshade_signed zDimO                             = static_cast< proshade_signed > ( zDimS );
+    proshade_signed xDimN                             = static_cast< proshade_signed > ( newXDim );
+    proshade_signed yDimN                             = static_cast< proshade_signed > ( newYDim );
+    proshade_signed zDimN                             = static_cast< proshade_signed > ( newZDim );
+    proshade_signed zHalfN                            = ( zDimN / 2 ) + 1;
     proshade_double normFactor                        = static_cast<proshade_double> ( xDimS * yDimS * zDimS );
 
     //================================================ Manage memory
-    fftw_complex *origMap, *fCoeffs, *newFCoeffs, *newMap;
+    fftw_complex *fCoeffs, *newFCoeffs;
+    proshade_double *newMap;
     fftw_plan planForwardFourier, planBackwardRescaledFourier;
-    allocateResolutionFourierMemory                   ( origMap, fCoeffs, newFCoeffs, newMap, planForwardFourier, planBackwardRescaledFourier,
+    allocateResolutionFourierMemory                   ( map, fCoeffs, newFCoeffs, newMap, planForwardFourier, planBackwardRescaledFourier,
                                                         xDimS, yDimS, zDimS, newXDim, newYDim, newZDim );
 
-    //================================================ Fill maps with data and zeroes
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( normFactor ); iter++ ) { origMap[iter][0] = map[iter]; origMap[iter][1] = 0.0; }
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( newXDim * newYDim * newZDim ); iter++ ) { newFCoeffs[iter][0] = 0.0; newFCoeffs[iter][1] = 0.0; }
-
-    //================================================ Get the Fourier coeffs
-    fftw_execute                                      ( planForwardFourier );
+    //================================================ Get the half-spectrum of the map
+    fftw_execute_dft_r2c                              ( planForwardFourier, map, fCoeffs );
     
-    //================================================ Change the order of Fourier coefficients
-    changeFourierOrder                                ( fCoeffs, static_cast< proshade_signed > ( xDimS ), static_cast< proshade_signed > ( yDimS ), static_cast< proshade_signed > ( zDimS ), true );
+    //================================================ Define the re-sampled coefficient for each frequency: copy the original coefficient if it exists, otherwise zero (removing high frequencies or adding these with 0 values)
+    auto reSampledCoeff                               = [&] ( proshade_signed h, proshade_signed k, proshade_signed l )
+    {
+        if ( ( h < -( xDimO / 2 ) ) || ( h > ( ( xDimO - 1 ) / 2 ) ) ||
+             ( k < -( yDimO / 2 ) ) || ( k > ( ( yDimO - 1 ) / 2 ) ) ||
+             ( l < -( zDimO / 2 ) ) || ( l > ( ( zDimO - 1 ) / 2 ) ) ) { return ( std::complex< proshade_double > ( 0.0, 0.0 ) ); }
+        
+        return                                        ( ProSHADE_internal_maths::getHalfSpectrumCoeff ( fCoeffs, xDimO, yDimO, zDimO, ( h + xDimO ) % xDimO, ( k + yDimO ) % yDimO, ( l + zDimO ) % zDimO ) / normFactor );
+    };
     
-    //================================================ Re-sample the coefficients by removing high frequencies or adding these with 0 values
-    for ( proshade_unsign xIt = 0; xIt < newXDim; xIt++ )
+    //================================================ Fill the re-sampled half-spectrum, averaging each coefficient with the conjugate of its Friedel mate (so that the inverse gives the real part of the complex inverse)
+    for ( proshade_signed xIt = 0; xIt < xDimN; xIt++ )
     {
-        for ( proshade_unsign yIt = 0; yIt < newYDim; yIt++ )
+        for ( proshade_signed yIt = 0; yIt < yDimN; yIt++ )
         {
-            for ( proshade_unsign zIt = 0; zIt < newZDim; zIt++ )
+            for ( proshade_signed zIt = 0; zIt < zHalfN; zIt++ )
             {
-                //==================================== Find the array positions
-                origSizeArr                           = ( ( zIt + static_cast< proshade_unsign > ( preZChange ) ) + zDimS   *
-                                                        ( ( yIt + static_cast< proshade_unsign > ( preYChange ) ) + yDimS   *
-                                                          ( xIt + static_cast< proshade_unsign > ( preXChange ) ) ) );
-                newSizeArr                            = zIt                + newZDim * ( yIt                + newYDim * xIt                );
+                //==================================== Convert to the frequencies of the re-sampled map (the new dimensions are even)
+                proshade_signed h                     = ( xIt < ( xDimN / 2 ) ) ? xIt : ( xIt - xDimN );
+                proshade_signed k                     = ( yIt < ( yDimN / 2 ) ) ? yIt : ( yIt - yDimN );
+                proshade_signed l                     = ( zIt < ( zDimN / 2 ) ) ? zIt : ( zIt - zDimN );
                 
-                //==================================== If original coefficient for this new coefficient position exists, copy
-                if ( ( ( -1  < static_cast< proshade_signed > ( xIt )   + preXChange ) && ( -1  < static_cast<proshade_signed> ( yIt )   + preYChange ) && ( -1  < static_cast<proshade_signed> ( zIt )   + preZChange ) ) &&
-                     ( ( xIt < newXDim + static_cast<proshade_unsign> ( postXChange ) ) && ( yIt < newYDim + static_cast<proshade_unsign> ( postYChange ) ) && ( zIt < newZDim + static_cast<proshade_unsign> ( postZChange ) ) ) )
-                {
-                    //================================ Copy the Fourier coeff
-                    newFCoeffs[newSizeArr][0]         = fCoeffs[origSizeArr][0] / normFactor;
-                    newFCoeffs[newSizeArr][1]         = fCoeffs[origSizeArr][1] / normFactor;
-                }
+                //==================================== Find the Friedel mate frequencies (the highest negative frequency is its own mate)
+                proshade_signed hMate                 = ( -h == ( xDimN / 2 ) ) ? h : -h;
+                proshade_signed kMate                 = ( -k == ( yDimN / 2 ) ) ? k : -k;
+                proshade_signed lMate                 = ( -l == ( zDimN / 2 ) ) ? l : -l;
+                
+                //==================================== Save the coefficient
+                std::complex< proshade_double > coeff = ( reSampledCoeff ( h, k, l ) + std::conj ( reSampledCoeff ( hMate, kMate, lMate ) ) ) / 2.0;
+                size_t newSizeArr                     = static_cast< size_t > ( zIt + zHalfN * ( yIt + yDimN * xIt ) );
+                newFCoeffs[newSizeArr][0]             = coeff.real();
+                newFCoeffs[newSizeArr][1]             = coeff.imag();
             }
         }
     }
     
-    //================================================ Change the order of the re-sampled Fourier coefficients
-    changeFourierOrder                                ( newFCoeffs, static_cast< proshade_signed > ( newXDim ), static_cast< proshade_signed > ( newYDim ), static_cast< proshade_signed > ( newZDim ), false );
-
     //================================================ Get the new map from the re-sized Fourier coefficients
-    fftw_execute                                      ( planBackwardRescaledFourier );
+    fftw_execute_dft_c2r                              ( planBackwardRescaledFourier, newFCoeffs, newMap );
 
-    //================================================ Delete the old map and create a new, re-sized one. Then copy the new map values into this new map memory.
-    delete map;
-    map                                               = new proshade_double [newXDim * newYDim * newZDim];
-    ProSHADE_internal_misc::checkMemoryAllocation     ( map, __FILE__, __LINE__, __func__ );
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( newXDim * newYDim * newZDim ); iter++ ) { map[iter] = newMap[iter][0]; }
+    //================================================ Replace the old map with the new, re-sized one
+    delete[] map;
+    map                                               = newMap;
     
     //================================================ Release memory
-    releaseResolutionFourierMemory                    ( origMap, fCoeffs, newFCoeffs, newMap, planForwardFourier, planBackwardRescaledFourier );
+    releaseResolutionFourierMemory                    ( fCoeffs, newFCoeffs, planForwardFourier, planBackwardRescaledFourier );
     
     //================================================ Define change in indices and return it
     corrs[0]                                          = static_cast< proshade_single > ( newXDim ) - static_cast< proshade_single > ( xDimS );
@@ -1536,13 +1430,15 @@ void ProSHADE_internal_mapManip::reSampleMapToResolutionFourier ( proshade_doubl
 
 /*! \brief This function allocates and checks the allocatio of the memory required by the Fourier resampling.
  
-    This function allocates the memory required for the Fourier space re-sampling of density maps. It allocates the original map and original map coefficients arrays (these need to be of the fftw_complex type) as well as the
-    re-sampled map and re-sampled map coefficients. It then also proceeds to check the memory allocation and creating the FFTW transform plans for both, the forward and re-sampled backward operations.
+    This function allocates the memory required for the Fourier space re-sampling of density maps. It allocates the original map half-spectrum
+    coefficients array, the re-sampled map half-spectrum coefficients array and the re-sampled map. It then also proceeds to check the memory
+    allocation and obtains the real to complex forward and the complex to real re-sampled backward FFTW transform plans from the plans cache.
+    The plans must therefore be executed using fftw_execute_dft_r2c() and fftw_execute_dft_c2r() on these arrays.
  
-    \param[in] origMap A Reference pointer to an array where the original map data will be stored.
-    \param[in] fCoeffs A Reference pointer to an array where the original map Fourier coefficients data will be stored.
-    \param[in] newFCoeffs A Reference pointer to an array where the re-sampled map Fourier coefficients data will be stored.
-    \param[in] newMap A Reference pointer to an array where the re-sampled map data will be stored.
+    \param[in] origMap The original map, which will be the input of the forward transform.
+    \param[in] fCoeffs A Reference pointer to an array where the original map half-spectrum will be stored.
+    \param[in] newFCoeffs A Reference pointer to an array where the re-sampled map half-spectrum will be stored.
+    \param[in] newMap A Reference pointer to an array where the re-sampled map data will be stored. This array is allocated using new[] and is to be owned by the caller.
     \param[in] planForwardFourier FFTW_plan which will compute the original map to Fourier coefficients transform.
     \param[in] planBackwardRescaledFourier FFTW_plan which will compute the re-sampled Fourier coefficients to re-sampled map transform.
     \param[in] xDimOld The number of indices along the x-axis of the original map.
@@ -1552,23 +1448,21 @@ void ProSHADE_internal_mapManip::reSampleMapToResolutionFourier ( proshade_doubl
     \param[in] yDimNew The number of indices along the y-axis of the re-sampled map.
     \param[in] zDimNew The number of indices along the z-axis of the re-sampled map.
  */
-void ProSHADE_internal_mapManip::allocateResolutionFourierMemory ( fftw_complex*& origMap, fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, fftw_complex*& newMap, fftw_plan& planForwardFourier, fftw_plan& planBackwardRescaledFourier, proshade_unsign xDimOld, proshade_unsign yDimOld, proshade_unsign zDimOld, proshade_unsign xDimNew, proshade_unsign yDimNew, proshade_unsign zDimNew )
+void ProSHADE_internal_mapManip::allocateResolutionFourierMemory ( proshade_double* origMap, fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, proshade_double*& newMap, fftw_plan& planForwardFourier, fftw_plan& planBackwardRescaledFourier, proshade_unsign xDimOld, proshade_unsign yDimOld, proshade_unsign zDimOld, proshade_unsign xDimNew, proshade_unsign yDimNew, proshade_unsign zDimNew )
 {
     //================================================ Initialise memory
-    origMap                                           = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * xDimOld * yDimOld * zDimOld ) );
-    fCoeffs                                           = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * xDimOld * yDimOld * zDimOld ) );
-    newFCoeffs                                        = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * xDimNew * yDimNew * zDimNew ) );
-    newMap                                            = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * xDimNew * yDimNew * zDimNew ) );
+    fCoeffs                                           = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * xDimOld * yDimOld * ( ( zDimOld / 2 ) + 1 ) ) );
+    newFCoeffs                                        = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * xDimNew * yDimNew * ( ( zDimNew / 2 ) + 1 ) ) );
+    newMap                                            = new proshade_double [xDimNew * yDimNew * zDimNew];
     
     //================================================ Check memory allocation
-    ProSHADE_internal_misc::checkMemoryAllocation     ( origMap,          __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( fCoeffs,          __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( newFCoeffs,       __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( newMap,           __FILE__, __LINE__, __func__ );
     
-    //================================================ Create plans
-    planForwardFourier                                = fftw_plan_dft_3d ( static_cast< int > ( xDimOld ), static_cast< int > ( yDimOld ), static_cast< int > ( zDimOld ), origMap,    fCoeffs, FFTW_FORWARD,  FFTW_ESTIMATE );
-    planBackwardRescaledFourier                       = fftw_plan_dft_3d ( static_cast< int > ( xDimNew ), static_cast< int > ( yDimNew ), static_cast< int > ( zDimNew ), newFCoeffs, newMap,  FFTW_BACKWARD, FFTW_ESTIMATE );
+    //================================================ Get plans from the plans cache
+    planForwardFourier                                = ProSHADE_internal_fftw::getR2C3DPlan ( static_cast< int > ( xDimOld ), static_cast< int > ( yDimOld ), static_cast< int > ( zDimOld ), origMap,    fCoeffs );
+    planBackwardRescaledFourier                       = ProSHADE_internal_fftw::getC2R3DPlan ( static_cast< int > ( xDimNew ), static_cast< int > ( yDimNew ), static_cast< int > ( zDimNew ), newFCoeffs, newMap  );
     
     //================================================ Done
     return ;
@@ -1577,26 +1471,22 @@ void ProSHADE_internal_mapManip::allocateResolutionFourierMemory ( fftw_complex*
 
 /*! \brief This function releases the memory required by the Fourier resampling.
  
-    This function simply deletes all the memory allocated by the allocateResolutionFourierMemory() function.
+    This function simply deletes the coefficient arrays allocated by the allocateResolutionFourierMemory() function; the re-sampled map is owned by the caller.
  
-    \param[in] origMap A Reference pointer to an array where the original map data were stored.
-    \param[in] fCoeffs A Reference pointer to an array where the original map Fourier coefficients data were stored.
-    \param[in] newFCoeffs A Reference pointer to an array where the re-sampled map Fourier coefficients data were stored.
-    \param[in] newMap A Reference pointer to an array where the re-sampled map data were stored.
+    \param[in] fCoeffs A Reference pointer to an array where the original map half-spectrum was stored.
+    \param[in] newFCoeffs A Reference pointer to an array where the re-sampled map half-spectrum was stored.
     \param[in] planForwardFourier FFTW_plan which computed the original map to Fourier coefficients transform.
     \param[in] planBackwardRescaledFourier FFTW_plan which computed the re-sampled Fourier coefficients to re-sampled map transform.
  */
-void ProSHADE_internal_mapManip::releaseResolutionFourierMemory ( fftw_complex*& origMap, fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, fftw_complex*& newMap, fftw_plan& planForwardFourier, fftw_plan& planBackwardRescaledFourier )
+void ProSHADE_internal_mapManip::releaseResolutionFourierMemory ( fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, fftw_plan& planForwardFourier, fftw_plan& planBackwardRescaledFourier )
 {
-    //================================================ Delete the FFTW plans
-    fftw_destroy_plan                                 ( planForwardFourier );
-    fftw_destroy_plan                                 ( planBackwardRescaledFourier );
+    //================================================ The FFTW plans are owned by the plans cache, just forget them
+    planForwardFourier                                = nullptr;
+    planBackwardRescaledFourier                       = nullptr;
     
     //================================================ Delete the complex arrays
-    fftw_free                                         ( origMap );
     fftw_free                                         ( fCoeffs );
     fftw_free                                         ( newFCoeffs );
-    fftw_free                                         ( newMap );
     
     //================================================ Done
     return ;
@@ -1681,12 +1571,13 @@ void ProSHADE_internal_mapManip::changeFourierOrder ( fftw_complex*& fCoeffs, pr
  
     This function takes an already FFTW-ed map and its dimensions as the input and proceeds to remove the phase
     from the map. It writes over the map and does not release any memory - it is the role of the calling function
-    to deal with both these features.
+    to deal with both these features. The coefficients are expected in the half-spectrum layout of the real to
+    complex Fourier transform, i.e. with the dimensions xDim x yDim x ( zDim / 2 + 1 ).
  
-    \param[in] mapCoeffs A Reference Pointer to the frequency map, from which phase is to be removed.
-    \param[in] xDim The number of indices along the x-axis of the input map.
-    \param[in] yDim The number of indices along the y-axis of the input map.
-    \param[in] zDim The number of indices along the z-axis of the input map.
+    \param[in] mapCoeffs A Reference Pointer to the half-spectrum frequency map, from which phase is to be removed.
+    \param[in] xDim The number of indices along the x-axis of the real space map.
+    \param[in] yDim The number of indices along the y-axis of the real space map.
+    \param[in] zDim The number of indices along the z-axis of the real space map.
  */
 void ProSHADE_internal_mapManip::removeMapPhase ( fftw_complex*& mapCoeffs, proshade_unsign xDim, proshade_unsign yDim, proshade_unsign zDim )
 {
@@ -1694,16 +1585,17 @@ void ProSHADE_internal_mapManip::removeMapPhase ( fftw_complex*& mapCoeffs, pros
     proshade_double real, imag, mag, phase;
     proshade_unsign arrayPos                          = 0;
     proshade_double normFactor                        = static_cast<proshade_double> ( xDim * yDim * zDim );
+    proshade_unsign zHalf                             = ( zDim / 2 ) + 1;
     
-    //================================================ Iterate through the map
+    //================================================ Iterate through the half-spectrum
     for ( proshade_unsign uIt = 0; uIt < xDim; uIt++ )
     {
         for ( proshade_unsign vIt = 0; vIt < yDim; vIt++ )
         {
-            for ( proshade_unsign wIt = 0; wIt < zDim; wIt++ )
+            for ( proshade_unsign wIt = 0; wIt < zHalf; wIt++ )
             {
                 //==================================== Var init
-                arrayPos                              = wIt + zDim * ( vIt + yDim * uIt );
+                arrayPos                              = wIt + zHalf * ( vIt + yDim * uIt );
                 real                                  = mapCoeffs[arrayPos][0];
                 imag                                  = mapCoeffs[arrayPos][1];
 
@@ -1723,12 +1615,83 @@ void ProSHADE_internal_mapManip::removeMapPhase ( fftw_complex*& mapCoeffs, pros
     
 }
 
+/*! \brief This function computes the periodic box (neighbourhood) sums of a map.
+ 
+    This function computes, for each map point, the sum of all map values within the cube of ( 2 * kernel + 1 ) points along
+    each dimension centred on this point, assuming map periodicity. As the box sum is separable, it is computed as three
+    successive one-dimensional periodic box sums, each using the prefix (running) sums along the map lines. This makes the cost
+    linear in the map size and independent of the kernel size. The lines are processed in parallel.
+ 
+    \param[in] map The map whose box sums are to be computed.
+    \param[in] boxSums Array of the same size as the map, where the box sums will be saved.
+    \param[in] xDim The number of indices along the x axis of the map.
+    \param[in] yDim The number of indices along the y axis of the map.
+    \param[in] zDim The number of indices along the z axis of the map.
+    \param[in] kernel The number of neighbours in any direction to be included in the box.
+    \param[in] noThreads The number of threads to be used.
+ */
+void ProSHADE_internal_mapManip::getPeriodicBoxSums ( proshade_double* map, proshade_double* boxSums, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_signed kernel, proshade_unsign noThreads )
+{
+    //================================================ Set local variables
+    size_t xDimS                                      = static_cast< size_t > ( xDim );
+    size_t yDimS                                      = static_cast< size_t > ( yDim );
+    size_t zDimS                                      = static_cast< size_t > ( zDim );
+    size_t boxLen                                     = static_cast< size_t > ( 2 * kernel + 1 );
+    
+    //================================================ One dimensional periodic box sum of a line (can be done in place)
+    auto lineBoxSum = [&] ( const proshade_double* in, proshade_double* out, size_t lineLen, size_t stride, std::vector< proshade_double >& prefix )
+    {
+        //============================================ Prefix sums
+        prefix[0]                                     = 0.0;
+        for ( size_t iter = 0; iter < lineLen; iter++ ) { prefix[iter+1] = prefix[iter] + in[iter * stride]; }
+        
+        //============================================ Whole periods and the remaining partial window
+        size_t fullWraps                              = boxLen / lineLen;
+        size_t remLen                                 = boxLen % lineLen;
+        size_t shift                                  = static_cast< size_t > ( kernel ) % lineLen;
+        for ( size_t iter = 0; iter < lineLen; iter++ )
+        {
+            size_t start                              = ( iter + lineLen - shift ) % lineLen;
+            proshade_double winSum                    = static_cast< proshade_double > ( fullWraps ) * prefix[lineLen];
+            if ( ( start + remLen ) <= lineLen )      { winSum += prefix[start + remLen] - prefix[start]; }
+            else                                      { winSum += ( prefix[lineLen] - prefix[start] ) + prefix[start + remLen - lineLen]; }
+            out[iter * stride]                        = winSum;
+        }
+    };
+    
+    //================================================ Sum along z (the first pass reads the map, the others work in place)
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( xDimS ), noThreads, [&] ( proshade_unsign uIt, proshade_unsign )
+    {
+        std::vector< proshade_double > prefix         ( zDimS + 1 );
+        for ( size_t vIt = 0; vIt < yDimS; vIt++ ) { size_t base = zDimS * ( vIt + yDimS * uIt ); lineBoxSum ( map + base, boxSums + base, zDimS, 1, prefix ); }
+    } );
+    
+    //================================================ Sum along y
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( xDimS ), noThreads, [&] ( proshade_unsign uIt, proshade_unsign )
+    {
+        std::vector< proshade_double > prefix         ( yDimS + 1 );
+        for ( size_t wIt = 0; wIt < zDimS; wIt++ ) { size_t base = wIt + zDimS * yDimS * uIt; lineBoxSum ( boxSums + base, boxSums + base, yDimS, zDimS, prefix ); }
+    } );
+    
+    //================================================ Sum along x
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( yDimS ), noThreads, [&] ( proshade_unsign vIt, proshade_unsign )
+    {
+        std::vector< proshade_double > prefix         ( xDimS + 1 );
+        for ( size_t wIt = 0; wIt < zDimS; wIt++ ) { size_t base = wIt + zDimS * vIt; lineBoxSum ( boxSums + base, boxSums + base, xDimS, zDimS * yDimS, prefix ); }
+    } );
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief Function for creating "fake" half-maps.
  
     This function takes the internal map and an empty map array and proceeds to find all neighbours within the kernel distance to each
     map points. It then computes the average of these neighbours and saves this average as the value of the "fake" half-map. These are
     then useul for map masking, as the correlation between the "fake" half-maps and the original maps give nice masks according to Rangana
-    - see him about how well these work.
+    - see him about how well these work. The neighbour sums are obtained from the periodic box sums, so that the cost does not depend
+    on the kernel size.
  
     \param[in] map A Reference Pointer to the map which should be blurred/sharpened.
     \param[in] blurredMap A Reference Pointer to the variable which will store the modified map.
@@ -1736,54 +1699,19 @@ void ProSHADE_internal_mapManip::removeMapPhase ( fftw_complex*& mapCoeffs, pros
     \param[in] yDimS The number of indices along the y axis of the map.
     \param[in] zDimS The number of indices along the z axis of the map.
     \param[in] fakeMapKernel The amount of neighbours in any direction whose average is to be used to get the current point.
+    \param[in] noThreads The number of threads to be used.
  */
-void ProSHADE_internal_mapManip::getFakeHalfMap ( proshade_double*& map, proshade_double*& fakeHalfMap, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_signed fakeMapKernel )
+void ProSHADE_internal_mapManip::getFakeHalfMap ( proshade_double*& map, proshade_double*& fakeHalfMap, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_signed fakeMapKernel, proshade_unsign noThreads )
 {
     //================================================ Set local variables
-    proshade_signed xDim                              = static_cast< proshade_signed > ( xDimS );
-    proshade_signed yDim                              = static_cast< proshade_signed > ( yDimS );
-    proshade_signed zDim                              = static_cast< proshade_signed > ( zDimS );
-    proshade_signed currentPos, neighArrPos, neighXPos, neighYPos, neighZPos;
-    proshade_double neighSum;
+    size_t noPoints                                   = static_cast< size_t > ( xDimS ) * static_cast< size_t > ( yDimS ) * static_cast< size_t > ( zDimS );
     proshade_double neighCount                        = pow ( ( ( fakeMapKernel * 2 ) + 1 ), 3.0 ) - 1.0;
-
-    //================================================ Blur the coeffs
-    for ( proshade_signed uIt = 0; uIt < xDim; uIt++ )
-    {
-        for ( proshade_signed vIt = 0; vIt < yDim; vIt++ )
-        {
-            for ( proshade_signed wIt = 0; wIt < zDim; wIt++ )
-            {
-                //==================================== Var init
-                currentPos                            = wIt + zDim * ( vIt + yDim * uIt );
-                neighSum                              = 0.0;
-                
-                //==================================== Average neighbours
-                for ( proshade_signed xCh = -fakeMapKernel; xCh <= +fakeMapKernel; xCh++ )
-                {
-                    for ( proshade_signed yCh = -fakeMapKernel; yCh <= +fakeMapKernel; yCh++ )
-                    {
-                        for ( proshade_signed zCh = -fakeMapKernel; zCh <= +fakeMapKernel; zCh++ )
-                        {
-                            if ( ( xCh == 0 ) && ( yCh == 0 ) && ( zCh == 0 ) ) { continue; }
-                            
-                            //======================== Find the nieghbour peak indices (with periodicity)
-                            neighXPos                 = uIt + xCh; if ( neighXPos >= xDim ) { neighXPos -= xDim; }; if ( neighXPos < 0 ) { neighXPos += xDim; }
-                            neighYPos                 = vIt + yCh; if ( neighYPos >= yDim ) { neighYPos -= yDim; }; if ( neighYPos < 0 ) { neighYPos += yDim; }
-                            neighZPos                 = wIt + zCh; if ( neighZPos >= zDim ) { neighZPos -= zDim; }; if ( neighZPos < 0 ) { neighZPos += zDim; }
-                            neighArrPos               = neighZPos + zDim * ( neighYPos + yDim * neighXPos );
-                            
-                            //======================== Add to average
-                            neighSum                 += map[neighArrPos];
-                        }
-                    }
-                }
-                
-                //==================================== Save the average to "fake" half-map
-                fakeHalfMap[currentPos]               = neighSum / neighCount;
-            }
-        }
-    }
+    
+    //================================================ Get the neighbourhood sums (including the point itself)
+    getPeriodicBoxSums                                ( map, fakeHalfMap, static_cast< proshade_signed > ( xDimS ), static_cast< proshade_signed > ( yDimS ), static_cast< proshade_signed > ( zDimS ), fakeMapKernel, noThreads );
+    
+    //================================================ Save the average of the neighbours to "fake" half-map
+    for ( size_t iter = 0; iter < noPoints; iter++ ) { fakeHalfMap[iter] = ( fakeHalfMap[iter] - map[iter] ) / neighCount; }
     
     //================================================ Done
     return ;
@@ -1793,6 +1721,9 @@ void ProSHADE_internal_mapManip::getFakeHalfMap ( proshade_double*& map, proshad
 /*! \brief Function for creating the correlation mask.
  
     This function is currently not used and should probably be deleted. The proper implementation of this masking approach should be available in the EMDA software.
+    The local Pearson's correlation coefficients are computed from the periodic box sums of both maps, their squares and their product, so
+    that the cost does not depend on the kernel size. Both maps are centred on their means before the sums are taken, so that the
+    variances are not obtained as the difference of two large numbers when the maps have a large offset.
  
     \param[in] map A Reference Pointer to the map which should be blurred/sharpened.
     \param[in] blurredMap A Reference Pointer to the variable which stores the fake half-map.
@@ -1801,58 +1732,69 @@ void ProSHADE_internal_mapManip::getFakeHalfMap ( proshade_double*& map, proshad
     \param[in] yDimS The number of indices along the y axis of the map.
     \param[in] zDimS The number of indices along the z axis of the map.
     \param[in] corrMaskKernel The amount of neighbours in any direction whose correlation is to be used to get the current points correlation.
+    \param[in] noThreads The number of threads to be used.
  */
-void ProSHADE_internal_mapManip::getCorrelationMapMask ( proshade_double*& map, proshade_double*& fakeHalfMap, proshade_double*& correlationMask, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_signed corrMaskKernel )
+void ProSHADE_internal_mapManip::getCorrelationMapMask ( proshade_double*& map, proshade_double*& fakeHalfMap, proshade_double*& correlationMask, proshade_unsign xDimS, proshade_unsign yDimS, proshade_unsign zDimS, proshade_signed corrMaskKernel, proshade_unsign noThreads )
 {
     //================================================ Set local variables
-    proshade_signed xDim = static_cast< proshade_signed > ( xDimS ), yDim = static_cast< proshade_signed > ( yDimS ), zDim = static_cast< proshade_signed > ( zDimS ), currentPos, neighArrPos, neighXPos, neighYPos, neighZPos, corrIter;
-    proshade_unsign noCorrVals                        = static_cast<proshade_unsign> ( pow ( ( ( corrMaskKernel * 2 ) + 1 ), 3 ) );
+    proshade_signed xDim = static_cast< proshade_signed > ( xDimS ), yDim = static_cast< proshade_signed > ( yDimS ), zDim = static_cast< proshade_signed > ( zDimS );
+    size_t noPoints                                   = static_cast< size_t > ( xDimS ) * static_cast< size_t > ( yDimS ) * static_cast< size_t > ( zDimS );
+    proshade_double noCorrVals                        = pow ( ( ( corrMaskKernel * 2 ) + 1 ), 3.0 );
     
     //================================================ Alocate memory
-    proshade_double *origMap                          = new proshade_double [noCorrVals];
-    proshade_double *fakeHM                           = new proshade_double [noCorrVals];
+    proshade_double *sumX                             = new proshade_double [noPoints];
+    proshade_double *sumY                             = new proshade_double [noPoints];
+    proshade_double *sumXX                            = new proshade_double [noPoints];
+    proshade_double *sumYY                            = new proshade_double [noPoints];
+    proshade_double *sumXY                            = new proshade_double [noPoints];
     
     //================================================ Check memory allocation
-    ProSHADE_internal_misc::checkMemoryAllocation ( origMap, __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation ( fakeHM,  __FILE__, __LINE__, __func__ );
-    
-    //================================================ Blur the coeffs
-    for ( proshade_signed uIt = 0; uIt < xDim; uIt++ )
+    ProSHADE_internal_misc::checkMemoryAllocation ( sumX,  __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation ( sumY,  __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation ( sumXX, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation ( sumYY, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation ( sumXY, __FILE__, __LINE__, __func__ );
+    
+    //================================================ Centre both maps on their means (the correlation does not depend on the offset)
+    proshade_double xMean                             = 0.0;
+    proshade_double yMean                             = 0.0;
+    for ( size_t iter = 0; iter < noPoints; iter++ ) { xMean += map[iter]; yMean += fakeHalfMap[iter]; }
+    xMean                                            /= static_cast< proshade_double > ( noPoints );
+    yMean                                            /= static_cast< proshade_double > ( noPoints );
+    for ( size_t iter = 0; iter < noPoints; iter++ ) { sumX[iter] = map[iter] - xMean; sumY[iter] = fakeHalfMap[iter] - yMean; }
+    
+    //================================================ Get the box sums of the centred values, their squares and their products
+    for ( size_t iter = 0; iter < noPoints; iter++ ) { sumXX[iter] = sumX[iter] * sumX[iter]; sumYY[iter] = sumY[iter] * sumY[iter]; sumXY[iter] = sumX[iter] * sumY[iter]; }
+    getPeriodicBoxSums                                ( sumX,        sumX,  xDim, yDim, zDim, corrMaskKernel, noThreads );
+    getPeriodicBoxSums                                ( sumY,        sumY,  xDim, yDim, zDim, corrMaskKernel, noThreads );
+    getPeriodicBoxSums                                ( sumXX,       sumXX, xDim, yDim, zDim, corrMaskKernel, noThreads );
+    getPeriodicBoxSums                                ( sumYY,       sumYY, xDim, yDim, zDim, corrMaskKernel, noThreads );
+    getPeriodicBoxSums                                ( sumXY,       sumXY, xDim, yDim, zDim, corrMaskKernel, noThreads );
+    
+    //================================================ Compute the local correlations
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( xDimS ), noThreads, [&] ( proshade_unsign uIt, proshade_unsign )
     {
-        for ( proshade_signed vIt = 0; vIt < yDim; vIt++ )
+        for ( size_t iter = static_cast< size_t > ( uIt ) * yDimS * zDimS; iter < ( static_cast< size_t > ( uIt ) + 1 ) * yDimS * zDimS; iter++ )
         {
-            for ( proshade_signed wIt = 0; wIt < zDim; wIt++ )
-            {
-                //==================================== Var init
-                currentPos                            = wIt + zDim * ( vIt + yDim * uIt );
-                corrIter                              = 0;
-                
-                //==================================== Average neighbours
-                for ( proshade_signed xCh = -corrMaskKernel; xCh <= +corrMaskKernel; xCh++ )
-                {
-                    for ( proshade_signed yCh = -corrMaskKernel; yCh <= +corrMaskKernel; yCh++ )
-                    {
-                        for ( proshade_signed zCh = -corrMaskKernel; zCh <= +corrMaskKernel; zCh++ )
-                        {
-                            //======================== Find the nieghbour peak indices (with periodicity)
-                            neighXPos                 = uIt + xCh; if ( neighXPos >= xDim ) { neighXPos -= xDim; }; if ( neighXPos < 0 ) { neighXPos += xDim; }
-                            neighYPos                 = vIt + yCh; if ( neighYPos >= yDim ) { neighYPos -= yDim; }; if ( neighYPos < 0 ) { neighYPos += yDim; }
-                            neighZPos                 = wIt + zCh; if ( neighZPos >= zDim ) { neighZPos -= zDim; }; if ( neighZPos < 0 ) { neighZPos += zDim; }
-                            neighArrPos               = neighZPos + zDim * ( neighYPos + yDim * neighXPos );
-                            
-                            //======================== Add to correct arrays
-                            origMap[corrIter]         = map[neighArrPos];
-                            fakeHM[corrIter]          = fakeHalfMap[neighArrPos];
-                            corrIter                 += 1;
-                        }
-                    }
-                }
-                
-                //==================================== Save the correlation comparison result
-                correlationMask[currentPos]           = ProSHADE_internal_maths::pearsonCorrCoeff ( origMap, fakeHM, noCorrVals );
-            }
+            //======================================== Co-variance and variances (times the number of values)
+            proshade_double xmmymm                    = sumXY[iter] - ( ( sumX[iter] * sumY[iter] ) / noCorrVals );
+            proshade_double xmmsq                     = sumXX[iter] - ( ( sumX[iter] * sumX[iter] ) / noCorrVals );
+            proshade_double ymmsq                     = sumYY[iter] - ( ( sumY[iter] * sumY[iter] ) / noCorrVals );
+            
+            //======================================== Constant neighbourhoods have no correlation (pearsonCorrCoeff() returns 0 for these)
+            if ( ( xmmsq <= ( sumXX[iter] * 1E-12 ) ) || ( ymmsq <= ( sumYY[iter] * 1E-12 ) ) ) { correlationMask[iter] = 0.0; continue; }
+            
+            //======================================== Save the correlation comparison result
+            correlationMask[iter]                     = xmmymm / ( sqrt ( xmmsq ) * sqrt ( ymmsq ) );
         }
-    }
+    } );
+    
+    //================================================ Release memory
+    delete[] sumX;
+    delete[] sumY;
+    delete[] sumXX;
+    delete[] sumYY;
+    delete[] sumXY;
     
     //================================================ Done
     return ;
@@ -1885,8 +1827,111 @@ proshade_single ProSHADE_internal_mapManip::getIndicesFromAngstroms ( proshade_u
     
 }
 
+/*! \brief This function computes the exact squared Euclidean distance transform of a map.
+ 
+    This function takes a map where the feature (e.g. mask) points have the value 0 and all other points have a non-finite (infinite)
+    value and replaces each value with the squared Euclidean distance (in Angstroms squared) to the nearest feature point. The
+    transform is separable, so it is computed as three successive one-dimensional transforms (along z, y and x), each using the
+    lower envelope of parabolas algorithm of Felzenszwalb and Huttenlocher, which is linear in the line length. Voxel sizes may
+    differ between the axes. The map is not considered periodic. The lines of each pass are processed in parallel.
+ 
+    \param[in] sqDist The map to be transformed in place (0 for feature points, infinity otherwise).
+    \param[in] xDim The number of map indices along the x-axis.
+    \param[in] yDim The number of map indices along the y-axis.
+    \param[in] zDim The number of map indices along the z-axis.
+    \param[in] xVox The voxel size in Angstroms along the x-axis.
+    \param[in] yVox The voxel size in Angstroms along the y-axis.
+    \param[in] zVox The voxel size in Angstroms along the z-axis.
+    \param[in] noThreads The number of threads to be used.
+ */
+void ProSHADE_internal_mapManip::getSquaredDistanceTransform ( proshade_double* sqDist, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_double xVox, proshade_double yVox, proshade_double zVox, proshade_unsign noThreads )
+{
+    //================================================ Set local variables
+    size_t xDimS                                      = static_cast< size_t > ( xDim );
+    size_t yDimS                                      = static_cast< size_t > ( yDim );
+    size_t zDimS                                      = static_cast< size_t > ( zDim );
+    
+    //================================================ One dimensional transform of a line: min over q of ( vox * ( p - q ) )^2 + f(q)
+    auto lineTransform = [&] ( proshade_double* line, size_t lineLen, size_t stride, proshade_double voxSq, std::vector< proshade_double >& fVals, std::vector< size_t >& parabs, std::vector< proshade_double >& bounds )
+    {
+        //============================================ Copy the line and build the lower envelope of the parabolas rooted at finite values
+        size_t noParabs                               = 0;
+        for ( size_t iter = 0; iter < lineLen; iter++ )
+        {
+            fVals[iter]                               = line[iter * stride];
+            if ( !std::isfinite ( fVals[iter] ) )     { continue; }
+            
+            //======================================== Remove the parabolas hidden by the new one
+            proshade_double qVal                      = static_cast< proshade_double > ( iter );
+            proshade_double inters                    = 0.0;
+            while ( noParabs > 0 )
+            {
+                proshade_double vVal                  = static_cast< proshade_double > ( parabs[noParabs-1] );
+                inters                                = ( ( fVals[iter] + voxSq * qVal * qVal ) - ( fVals[parabs[noParabs-1]] + voxSq * vVal * vVal ) ) / ( 2.0 * voxSq * ( qVal - vVal ) );
+                if ( ( noParabs > 1 ) && ( inters <= bounds[noParabs-1] ) ) { noParabs -= 1; continue; }
+                break;
+            }
+            
+            //======================================== Add the new parabola
+            parabs[noParabs]                          = iter;
+            bounds[noParabs]                          = ( noParabs == 0 ) ? -std::numeric_limits< proshade_double >::infinity() : inters;
+            noParabs                                 += 1;
+        }
+        
+        //============================================ No feature in this line, leave it infinite
+        if ( noParabs == 0 ) { return ; }
+        
+        //============================================ Read the envelope
+        size_t envIt                                  = 0;
+        for ( size_t iter = 0; iter < lineLen; iter++ )
+        {
+            proshade_double pVal                      = static_cast< proshade_double > ( iter );
+            while ( ( ( envIt + 1 ) < noParabs ) && ( bounds[envIt+1] < pVal ) ) { envIt += 1; }
+            proshade_double diff                      = pVal - static_cast< proshade_double > ( parabs[envIt] );
+            line[iter * stride]                       = voxSq * diff * diff + fVals[parabs[envIt]];
+        }
+    };
+    
+    //================================================ Transform along z
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( xDimS ), noThreads, [&] ( proshade_unsign uIt, proshade_unsign )
+    {
+        std::vector< proshade_double > fVals ( zDimS ), bounds ( zDimS );
+        std::vector< size_t > parabs                  ( zDimS );
+        for ( size_t vIt = 0; vIt < yDimS; vIt++ ) { lineTransform ( sqDist + zDimS * ( vIt + yDimS * uIt ), zDimS, 1, zVox * zVox, fVals, parabs, bounds ); }
+    } );
+    
+    //================================================ Transform along y
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( xDimS ), noThreads, [&] ( proshade_unsign uIt, proshade_unsign )
+    {
+        std::vector< proshade_double > fVals ( yDimS ), bounds ( yDimS );
+        std::vector< size_t > parabs                  ( yDimS );
+        for ( size_t wIt = 0; wIt < zDimS; wIt++ ) { lineTransform ( sqDist + wIt + zDimS * yDimS * uIt, yDimS, zDimS, yVox * yVox, fVals, parabs, bounds ); }
+    } );
+    
+    //================================================ Transform along x
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( yDimS ), noThreads, [&] ( proshade_unsign vIt, proshade_unsign )
+    {
+        std::vector< proshade_double > fVals ( xDimS ), bounds ( xDimS );
+        std::vector< size_t > parabs                  ( xDimS );
+        for ( size_t wIt = 0; wIt < zDimS; wIt++ ) { lineTransform ( sqDist + wIt + zDimS * vIt, xDimS, zDimS * yDimS, xVox * xVox, fVals, parabs, bounds ); }
+    } );
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief This function connects blobs in mask.
  
+    This function dilates the mask by adding all points within the connection distance of any mask point to the mask, thus connecting
+    the mask blobs closer to each other than twice this distance. The connection distance is the same number of the (smallest) voxel
+    sizes as the number of one-point dilation steps used previously, but the points are now selected using the exact Euclidean distance
+    (allowing for different voxel sizes along the axes) computed by the linear time distance transform instead of iterated neighbour
+    searches.
+ 
+    \warning This function is not called by the masking path (ProSHADE_data::maskMap() and getMaskFromBlurr()); it is only available
+    to the library users who want to post-process a mask themselves.
+ 
     \param[in] mask A pointer reference to mask map in which blobs should be connected.
     \param[in] xDim The number of map indices along the x-axis.
     \param[in] yDim The number of map indices along the y-axis.
@@ -1895,66 +1940,34 @@ proshade_single ProSHADE_internal_mapManip::getIndicesFromAngstroms ( proshade_u
     \param[in] yAngs The map size in Angstroms along the y-axis.
     \param[in] zAngs The map size in Angstroms along the z-axis.
     \param[in] maskThres The threshold which will be used for applying mask.
+    \param[in] noThreads The number of threads to be used.
  */
-void ProSHADE_internal_mapManip::connectMaskBlobs ( proshade_double*& mask, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single maskThres )
+void ProSHADE_internal_mapManip::connectMaskBlobs ( proshade_double*& mask, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single maskThres, proshade_unsign noThreads )
 {
     //================================================ Initialise variables
-    proshade_double* hlpMap                           = new proshade_double[xDim * yDim * zDim];
+    size_t noPoints                                   = static_cast< size_t > ( xDim * yDim * zDim );
+    proshade_double xVox                              = static_cast< proshade_double > ( xAngs ) / static_cast< proshade_double > ( xDim );
+    proshade_double yVox                              = static_cast< proshade_double > ( yAngs ) / static_cast< proshade_double > ( yDim );
+    proshade_double zVox                              = static_cast< proshade_double > ( zAngs ) / static_cast< proshade_double > ( zDim );
     proshade_signed addSurroundingPoints              = static_cast< proshade_signed > ( std::max ( 3L, static_cast<proshade_signed> ( std::ceil ( getIndicesFromAngstroms( static_cast< proshade_unsign > ( xDim ), static_cast< proshade_unsign > ( yDim ), static_cast< proshade_unsign > ( zDim ), xAngs, yAngs, zAngs, static_cast< proshade_single > ( std::max( xAngs, std::max( yAngs, zAngs ) ) * 0.1f ) ) ) ) ) );
-    proshade_signed currPos, neighXPos, neighYPos, neighZPos, neighArrPos;
+    proshade_double connectDist                       = static_cast< proshade_double > ( addSurroundingPoints ) * std::min ( xVox, std::min ( yVox, zVox ) );
+    proshade_double* sqDist                           = new proshade_double[noPoints];
     
     //================================================ Check memory allocation
-    ProSHADE_internal_misc::checkMemoryAllocation     ( hlpMap, __FILE__, __LINE__, __func__ );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( sqDist, __FILE__, __LINE__, __func__ );
     
-    //================================================ Copy the mask map
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( xDim * yDim * zDim ); iter++ ) { hlpMap[iter] = mask[iter]; }
+    //================================================ Initialise the distance transform with the mask points
+    for ( size_t iter = 0; iter < noPoints; iter++ ) { sqDist[iter] = ( mask[iter] < static_cast< proshade_double > ( maskThres ) ) ? std::numeric_limits< proshade_double >::infinity() : 0.0; }
     
-    //================================================ Repeat as many times as needed
-    for ( proshade_signed it = 0; it < addSurroundingPoints; it++ )
-    {
-        //============================================ For each x, y and z
-        for ( proshade_signed xIt = 0; xIt < xDim; xIt++ )
-        {
-            for ( proshade_signed yIt = 0; yIt < yDim; yIt++ )
-            {
-                for ( proshade_signed zIt = 0; zIt < zDim; zIt++ )
-                {
-                    //================================ Current position
-                    currPos                           = zIt + zDim * ( yIt + yDim * xIt );
-                    
-                    //================================ If zero, ignore
-                    if ( hlpMap[currPos] < static_cast< proshade_double > ( maskThres ) ) { continue; }
-                    
-                    //================================ Check neighbours
-                    for ( proshade_signed xCh = -1; xCh <= +1; xCh++ )
-                    {
-                        for ( proshade_signed yCh = -1; yCh <= +1; yCh++ )
-                        {
-                            for ( proshade_signed zCh = -1; zCh <= +1; zCh++ )
-                            {
-                                if ( ( xCh == 0 ) && ( yCh == 0 ) && ( zCh == 0 ) ) { continue; }
-                                
-                                //==================== Find the nieghbour indices (without periodicity)
-                                neighXPos             = xIt + xCh; if ( neighXPos < 0 ) { continue; } if ( neighXPos >= xDim ) { continue; }
-                                neighYPos             = yIt + yCh; if ( neighYPos < 0 ) { continue; } if ( neighYPos >= yDim ) { continue; }
-                                neighZPos             = zIt + zCh; if ( neighZPos < 0 ) { continue; } if ( neighZPos >= zDim ) { continue; }
-                                neighArrPos           = neighZPos + zDim * ( neighYPos + yDim * neighXPos );
-                                
-                                //==================== Add to mask if this point is below it (as it is a neighbour to a point which is part of the mask)
-                                if ( hlpMap[neighArrPos] < static_cast< proshade_double > ( maskThres ) ) { mask[neighArrPos] = static_cast< proshade_double > ( maskThres ); }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
-        //============================================ Now copy the updated mask to the temporary helper, unless last iteration
-        for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( xDim * yDim * zDim ); iter++ ) { hlpMap[iter] = mask[iter]; }
-    }
+    //================================================ Find the distances to the closest mask points
+    getSquaredDistanceTransform                       ( sqDist, xDim, yDim, zDim, xVox, yVox, zVox, noThreads );
+    
+    //================================================ Add all points close enough to the mask (with a small tolerance for the rounding errors)
+    proshade_double maxSqDist                         = connectDist * connectDist * ( 1.0 + 1E-9 );
+    for ( size_t iter = 0; iter < noPoints; iter++ ) { if ( ( mask[iter] < static_cast< proshade_double > ( maskThres ) ) && ( sqDist[iter] <= maxSqDist ) ) { mask[iter] = static_cast< proshade_double > ( maskThres ); } }
     
     //================================================ Release memory
-    delete[] hlpMap;
+    delete[] sqDist;
     
     //================================================ Done
     return ;
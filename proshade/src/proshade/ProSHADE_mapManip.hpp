@@ -58,41 +58,51 @@ namespace ProSHADE_internal_mapManip
                                                         proshade_single zAngs, proshade_signed* xFrom, proshade_signed* xTo, proshade_signed* yFrom, proshade_signed* yTo,
                                                         proshade_signed* zFrom, proshade_signed* zTo, proshade_signed* xOrigin, proshade_signed* yOrigin,
                                                         proshade_signed* zOrigin );
+    std::complex< proshade_double > getTranslationPhaseShift ( proshade_signed uIt, proshade_signed vIt, proshade_signed wIt, proshade_single xMov, proshade_single yMov,
+                                                        proshade_single zMov, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_signed xDim,
+                                                        proshade_signed yDim, proshade_signed zDim );
     void moveMapByFourier                             ( proshade_double*& map, proshade_single xMov, proshade_single yMov, proshade_single zMov, proshade_single xAngs,
-                                                        proshade_single yAngs, proshade_single zAngs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim );
+                                                        proshade_single yAngs, proshade_single zAngs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim,
+                                                        fftw_complex* coeffsScratch = nullptr );
     void moveMapByFourierInReci                       ( proshade_complex*& coeffs, proshade_double*& weights, proshade_single xMov, proshade_single yMov, proshade_single zMov, proshade_single xAngs,
                                                         proshade_single yAngs, proshade_single zAngs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim );
     void blurSharpenMap                               ( proshade_double*& map, proshade_double*& maskedMap, proshade_unsign xDimS, proshade_unsign yDimS,
-                                                        proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single blurringFactor );
+                                                        proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs, proshade_single zAngs, proshade_single blurringFactor,
+                                                        fftw_complex* coeffsScratch = nullptr );
     void getMaskFromBlurr                             ( proshade_double*& blurMap, proshade_double*& outMap, proshade_unsign xDimS, proshade_unsign yDimS,
-                                                        proshade_unsign zDimS, proshade_single noIQRs );
+                                                        proshade_unsign zDimS, proshade_single noIQRs, proshade_unsign noThreads = 1, proshade_unsign* noPasses = nullptr );
     void getNonZeroBounds                             ( proshade_double* map, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_signed*& ret );
     void addExtraBoundSpace                           ( proshade_unsign xDim, proshade_unsign yDim, proshade_unsign zDim, proshade_single xAngs, proshade_single yAngs,
                                                         proshade_single zAngs, proshade_signed*& bounds, proshade_single extraSpace );
+    void getTrilinearAxisTable                        ( proshade_signed newDim, proshade_signed oldDim, proshade_single newSample, proshade_single oldSample,
+                                                        std::vector< proshade_signed >* bottoms, std::vector< proshade_signed >* tops, std::vector< proshade_double >* weights );
     void reSampleMapToResolutionTrilinear             ( proshade_double*& map, proshade_single resolution, proshade_unsign xDimS, proshade_unsign yDimS,
                                                         proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs,  proshade_single zAngs,
-                                                        proshade_single*& corrs );
+                                                        proshade_single*& corrs, proshade_unsign noThreads = 1 );
     void reSampleMapToResolutionFourier               ( proshade_double*& map, proshade_single resolution, proshade_unsign xDimS, proshade_unsign yDimS,
                                                         proshade_unsign zDimS, proshade_single xAngs, proshade_single yAngs,  proshade_single zAngs,
                                                         proshade_single*& corrs );
-    void allocateResolutionFourierMemory              ( fftw_complex*& origMap, fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, fftw_complex*& newMap, fftw_plan& planForwardFourier,
+    void allocateResolutionFourierMemory              ( proshade_double* origMap, fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, proshade_double*& newMap, fftw_plan& planForwardFourier,
                                                         fftw_plan& planBackwardRescaledFourier, proshade_unsign xDimOld, proshade_unsign yDimOld, proshade_unsign zDimOld,
                                                         proshade_unsign xDimNew, proshade_unsign yDimNew, proshade_unsign zDimNew );
-    void releaseResolutionFourierMemory               ( fftw_complex*& origMap, fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, fftw_complex*& newMap, fftw_plan& planForwardFourier,
-                                                        fftw_plan& planBackwardRescaledFourier );
+    void releaseResolutionFourierMemory               ( fftw_complex*& fCoeffs, fftw_complex*& newFCoeffs, fftw_plan& planForwardFourier, fftw_plan& planBackwardRescaledFourier );
     void changeFourierOrder                           ( fftw_complex*& fCoeffs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, bool negativeFirst );
     void removeMapPhase                               ( fftw_complex*& mapCoeffs, proshade_unsign xDim, proshade_unsign yDim, proshade_unsign zDim );
+    void getPeriodicBoxSums                           ( proshade_double* map, proshade_double* boxSums, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim,
+                                                        proshade_signed kernel, proshade_unsign noThreads );
     void getFakeHalfMap                               ( proshade_double*& map, proshade_double*& fakeHalfMap, proshade_unsign xDimS, proshade_unsign yDimS,
-                                                       proshade_unsign zDimS, proshade_signed fakeMapKernel );
+                                                       proshade_unsign zDimS, proshade_signed fakeMapKernel, proshade_unsign noThreads );
     void getCorrelationMapMask                        ( proshade_double*& map, proshade_double*& fakeHalfMap, proshade_double*& correlationMask,
                                                         proshade_unsign xDimS, proshade_unsign yDimS,
-                                                       proshade_unsign zDimS, proshade_signed corrMaskKernel );
+                                                       proshade_unsign zDimS, proshade_signed corrMaskKernel, proshade_unsign noThreads );
     proshade_single getIndicesFromAngstroms           ( proshade_unsign xDim, proshade_unsign yDim, proshade_unsign zDim,
                                                         proshade_single xAngs, proshade_single yAngs, proshade_single zAngs,
                                                         proshade_single dist );
+    void getSquaredDistanceTransform                  ( proshade_double* sqDist, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_double xVox,
+                                                        proshade_double yVox, proshade_double zVox, proshade_unsign noThreads = 1 );
     void connectMaskBlobs                             ( proshade_double*& mask, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim,
                                                         proshade_single xAngs, proshade_single yAngs,
-                                                        proshade_single zAngs, proshade_single maskThres );
+                                                        proshade_single zAngs, proshade_single maskThres, proshade_unsign noThreads = 1 );
     void beautifyBoundaries                           ( proshade_signed*& bounds, proshade_unsign xDim, proshade_unsign yDim, proshade_unsign zDim, proshade_signed boundsDiffThres );
     proshade_signed betterClosePrimeFactors           ( proshade_signed fromRange, proshade_signed toRange );
     void distributeSpaceToBoundaries                  ( proshade_signed& minBound, proshade_signed& maxBound, proshade_signed oldBoundRange, proshade_signed newBoundRange );
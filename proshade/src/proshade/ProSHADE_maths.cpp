@@ -23,6 +23,13 @@
 //==================================================== ProSHADE
 #include "ProSHADE_maths.hpp"
 
+//==================================================== Local variables
+namespace ProSHADE_internal_maths
+{
+    static std::mutex legendreTableMutex;             //!< Mutex guarding the Gauss-Legendre abscissas and weights table.
+    static std::map< std::pair< proshade_unsign, proshade_unsign >, std::vector< proshade_double > > legendreTable; //!< The already computed abscissas (first half) and weights (second half) keyed by the order and the number of approximation steps.
+}
+
 /*! \brief Function to multiply two complex numbers.
  
     This function takes pointers to the real and imaginary parts of two complex numbers and
@@ -138,6 +145,41 @@ void ProSHADE_internal_maths::vectorMeanAndSD ( std::vector<proshade_double>* ve
     
 }
 
+/*! \brief Function to get array mean and standard deviation.
+ 
+    This function returns the same mean and standard deviation as the vectorMeanAndSD() function, but reads the values directly
+    from an array in a single pass, so that the values do not need to be copied into a vector first.
+ 
+    \param[in] vals Pointer to an array of proshade_double's for which mean and sd should be obtained.
+    \param[in] valsSize The length of the array.
+    \param[in] ret Pointer to array of 2 proshade_double's, which will be the return values - first mean and second sd.
+ */
+void ProSHADE_internal_maths::arrayMeanAndSD ( const proshade_double* vals, size_t valsSize, proshade_double*& ret )
+{
+    //================================================ Get the sum and the sum of squares
+    proshade_double sum                               = 0.0;
+    proshade_double squaredSum                        = 0.0;
+    for ( size_t iter = 0; iter < valsSize; iter++ )
+    {
+        sum                                          += vals[iter];
+        squaredSum                                   += vals[iter] * vals[iter];
+    }
+    
+    //================================================ Get mean and standard deviation
+    ret[0]                                            = sum / static_cast<proshade_double> ( valsSize );
+    ret[1]                                            = std::sqrt ( ( squaredSum / static_cast<proshade_double> ( valsSize ) ) - std::pow ( ret[0], 2.0 ) );
+    
+    //================================================ Check for NaN's
+    const FloatingPoint< proshade_double > lhs1 ( ret[0] );
+    const FloatingPoint< proshade_double > lhs2 ( ret[1] );
+    if ( !lhs1.AlmostEquals ( lhs1 ) ) { ret[0] = 0.0; }
+    if ( !lhs2.AlmostEquals ( lhs2 ) ) { ret[1] = 0.0; }
+    
+    //================================================ Return
+    return ;
+    
+}
+
 /*! \brief Function to get vector median and inter-quartile range.
  
     This function takes a pointer to a vector of proshade_double's and returns the median and the inter-quartile range of
@@ -188,6 +230,27 @@ void ProSHADE_internal_maths::vectorMedianAndIQR ( std::vector<proshade_double>*
     
 }
 
+/*! \brief Function to get vector median and inter-quartile range by selection.
+ 
+    This function returns the same median and inter-quartile range as the vectorMedianAndIQR() function, but instead of sorting the
+    whole vector, it only selects the required order statistics (in linear time), leaving the vector partially re-ordered.
+ 
+    \param[in] vec Pointer to a vector of proshade_double's for which median and IQR should be obtained.
+    \param[in] ret Pointer to array of 2 proshade_double's, which will be the return values - first median and second IQR.
+ */
+void ProSHADE_internal_maths::vectorMedianAndIQRSelection ( std::vector<proshade_double>* vec, proshade_double*& ret )
+{
+    //================================================ Sanity check
+    if ( vec->size() < 3 ) { ret[0] = 0.0; ret[1] = 0.0; return; }
+    
+    //================================================ Select in place
+    arrayMedianAndIQRSelection                        ( vec->data(), vec->size(), ret );
+    
+    //================================================ Return
+    return ;
+    
+}
+
 /*! \brief Function to get array median and inter-quartile range.
  
     This function takes a pointer to a array of proshade_double's and returns the median and the inter-quartile range of
@@ -233,6 +296,333 @@ void ProSHADE_internal_maths::arrayMedianAndIQR ( proshade_double* vec, proshade
     
 }
 
+/*! \brief Function to get array median and inter-quartile range by selection.
+ 
+    This function returns the same median and inter-quartile range as the vectorMedianAndIQR() function, but instead of sorting the
+    array, it only selects the required order statistics (in linear time) in place. The array is left partially re-ordered, so that
+    the caller can re-use a single scratch buffer for repeated calls.
+ 
+    \param[in] vec Pointer to an array of proshade_double's for which median and IQR should be obtained.
+    \param[in] vecSize The length of the array.
+    \param[in] ret Pointer to array of 2 proshade_double's, which will be the return values - first median and second IQR.
+ */
+void ProSHADE_internal_maths::arrayMedianAndIQRSelection ( proshade_double* vec, size_t vecSize, proshade_double*& ret )
+{
+    //================================================ Sanity check (very short arrays have no quartiles, as in arrayMedianAndIQR)
+    if ( vecSize == 0 ) { ret[0] = 0.0; ret[1] = 0.0; return; }
+    if ( vecSize < 3 )  { ret[0] = ( vec[0] + vec[vecSize - 1] ) / 2.0; ret[1] = 0.0; return; }
+    
+    //================================================ Find the order statistics positions (as used by vectorMedianAndIQR)
+    std::vector< size_t > positions;
+    getMedianAndIQRPositions                          ( vecSize, &positions );
+    
+    //================================================ Select the order statistics in increasing order, each time searching only above the previous one
+    size_t searchStart                                = 0;
+    for ( size_t posIt = 0; posIt < positions.size(); posIt++ )
+    {
+        if ( positions.at(posIt) < searchStart ) { continue; }
+        std::nth_element                              ( vec + searchStart, vec + positions.at(posIt), vec + vecSize );
+        searchStart                                   = positions.at(posIt) + 1;
+    }
+    
+    //================================================ Get median and quartiles
+    std::vector< proshade_double > orderStats         ( positions.size(), 0.0 );
+    for ( size_t posIt = 0; posIt < positions.size(); posIt++ ) { orderStats.at(posIt) = vec[positions.at(posIt)]; }
+    medianAndIQRFromOrderStatistics                   ( &orderStats, ret );
+    
+    //================================================ Return
+    return ;
+    
+}
+
+/*! \brief Function to get array median and inter-quartile range using histogram refinement.
+ 
+    This function returns exactly the same median and inter-quartile range as the vectorMedianAndIQR() function, but it does not
+    copy, sort or modify the input array. Instead, the required order statistics are found by the arrayOrderStatistics() function,
+    which only reads the array a few times using a fixed amount of memory. This makes it suitable for whole maps.
+ 
+    \param[in] vec Pointer to an array of proshade_double's for which median and IQR should be obtained.
+    \param[in] vecSize The length of the array.
+    \param[in] ret Pointer to array of 2 proshade_double's, which will be the return values - first median and second IQR.
+    \param[in] noThreads The number of threads to be used for reading the array.
+    \param[in] noPasses Optional pointer to a counter, to which the number of passes over the array will be added.
+ */
+void ProSHADE_internal_maths::arrayMedianAndIQRHistogram ( const proshade_double* vec, size_t vecSize, proshade_double*& ret, proshade_unsign noThreads, proshade_unsign* noPasses )
+{
+    //================================================ Sanity check
+    if ( vecSize < 3 ) { ret[0] = 0.0; ret[1] = 0.0; return; }
+    
+    //================================================ Find the order statistics positions (as used by vectorMedianAndIQR)
+    std::vector< size_t > positions;
+    getMedianAndIQRPositions                          ( vecSize, &positions );
+    
+    //================================================ Get the order statistics
+    std::vector< proshade_double > orderStats;
+    arrayOrderStatistics                              ( vec, vecSize, &positions, &orderStats, noThreads, noPasses );
+    
+    //================================================ Get median and quartiles
+    medianAndIQRFromOrderStatistics                   ( &orderStats, ret );
+    
+    //================================================ Return
+    return ;
+    
+}
+
+/*! \brief Function finding the sorted positions of the order statistics needed for the median and inter-quartile range.
+ 
+    \param[in] vecSize The number of values (must be at least 3).
+    \param[in] positions Pointer to vector to which the positions will be saved - 3 positions for odd sizes (Q1, median, Q3) and
+    6 positions for even sizes (the pairs averaged for Q1, median and Q3), in increasing order.
+ */
+void ProSHADE_internal_maths::getMedianAndIQRPositions ( size_t vecSize, std::vector< size_t >* positions )
+{
+    //================================================ Find the positions
+    size_t q1Pos                                      = vecSize / 4;
+    size_t medPos                                     = vecSize / 2;
+    size_t q3Pos                                      = ( vecSize / 4 ) * 3;
+    
+    //================================================ Save them in increasing order
+    if ( ( vecSize % 2 ) == 0 ) { *positions = { q1Pos - 1, q1Pos, medPos - 1, medPos, q3Pos - 1, q3Pos }; }
+    else                        { *positions = { q1Pos, medPos, q3Pos }; }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Function combining the order statistics from getMedianAndIQRPositions() into the median and inter-quartile range.
+ 
+    \param[in] orderStats Pointer to vector of values at the positions given by the getMedianAndIQRPositions() function.
+    \param[in] ret Pointer to array of 2 proshade_double's, which will be the return values - first median and second IQR.
+ */
+void ProSHADE_internal_maths::medianAndIQRFromOrderStatistics ( std::vector< proshade_double >* orderStats, proshade_double*& ret )
+{
+    //================================================ Get median and quartiles
+    proshade_double Q1, Q3;
+    if ( orderStats->size() == 6 )
+    {
+        Q1                                            = ( orderStats->at(0) + orderStats->at(1) ) / 2.0;
+        ret[0]                                        = ( orderStats->at(2) + orderStats->at(3) ) / 2.0;
+        Q3                                            = ( orderStats->at(4) + orderStats->at(5) ) / 2.0;
+    }
+    else
+    {
+        Q1                                            = orderStats->at(0);
+        ret[0]                                        = orderStats->at(1);
+        Q3                                            = orderStats->at(2);
+    }
+    
+    //================================================ And now save the IQR
+    ret[1]                                            = Q3 -  Q1;
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Function for finding exact order statistics of a large array without copying it.
+ 
+    This function finds the values which would be at the given positions if the array was sorted in increasing order. It does
+    so by first finding the range of the values and then building a fixed size histogram over that range (in parallel, each
+    worker having its own histogram). The bin containing each required position then becomes the new range, so that the next
+    pass only considers the values in this bin. Once a bin contains few enough values (or only a single distinct value), these
+    values are gathered and the exact order statistic is selected from them. As the bins also record the minimum and maximum of
+    their values, the result is exact - typically after one histogram and one gathering pass. The array must not contain NaN's.
+ 
+    \param[in] vals Pointer to the array of values.
+    \param[in] valsSize The length of the array.
+    \param[in] positions Pointer to vector of the sorted order positions to be found (each must be lower than valsSize).
+    \param[in] ret Pointer to vector to which the values at the requested positions will be saved.
+    \param[in] noThreads The number of threads to be used for reading the array.
+    \param[in] noPasses Optional pointer to a counter, to which the number of passes over the array will be added.
+ */
+void ProSHADE_internal_maths::arrayOrderStatistics ( const proshade_double* vals, size_t valsSize, std::vector< size_t >* positions, std::vector< proshade_double >* ret, proshade_unsign noThreads, proshade_unsign* noPasses )
+{
+    //================================================ Initialise variables
+    const size_t noBins                               = 4096;
+    const size_t gatherLimit                          = 65536;
+    size_t noPos                                      = positions->size();
+    ret->assign                                       ( noPos, 0.0 );
+    if ( ( noPos == 0 ) || ( valsSize == 0 ) ) { return; }
+    
+    //================================================ Split the array into blocks, one task each
+    size_t maxWorkers                                 = static_cast< size_t > ( ProSHADE_internal_misc::getNumberOfThreads ( noThreads, std::numeric_limits< proshade_unsign >::max ( ) ) );
+    proshade_unsign noBlocks                          = static_cast< proshade_unsign > ( std::min ( maxWorkers * 8, ( valsSize / 8192 ) + 1 ) );
+    size_t blockSize                                  = ( valsSize + noBlocks - 1 ) / noBlocks;
+    proshade_unsign noWorkers                         = ProSHADE_internal_misc::getNumberOfThreads ( noThreads, noBlocks );
+    
+    //================================================ Find the range of the values
+    std::vector< proshade_double > workerMin          ( noWorkers, std::numeric_limits< proshade_double >::infinity ( ) );
+    std::vector< proshade_double > workerMax          ( noWorkers, -std::numeric_limits< proshade_double >::infinity ( ) );
+    ProSHADE_internal_misc::parallelFor               ( noBlocks, noThreads, [&] ( proshade_unsign blockIt, proshade_unsign workerIt )
+    {
+        size_t blockEnd                               = std::min ( valsSize, ( static_cast< size_t > ( blockIt ) + 1 ) * blockSize );
+        for ( size_t iter = static_cast< size_t > ( blockIt ) * blockSize; iter < blockEnd; iter++ )
+        {
+            workerMin.at(workerIt)                    = std::min ( workerMin.at(workerIt), vals[iter] );
+            workerMax.at(workerIt)                    = std::max ( workerMax.at(workerIt), vals[iter] );
+        }
+    } );
+    if ( noPasses != nullptr ) { *noPasses += 1; }
+    
+    //================================================ Each position starts with the whole range (lo and hi are inclusive; below counts the values lower than lo)
+    std::vector< proshade_double > posLo              ( noPos, *std::min_element ( workerMin.begin(), workerMin.end() ) );
+    std::vector< proshade_double > posHi              ( noPos, *std::max_element ( workerMax.begin(), workerMax.end() ) );
+    std::vector< size_t > posBelow                    ( noPos, 0 );
+    std::vector< size_t > posInRange                  ( noPos, valsSize );
+    std::vector< bool > posDone                       ( noPos, false );
+    
+    //================================================ Refine until all positions are resolved
+    while ( true )
+    {
+        //============================================ Resolve positions whose range holds a single distinct value and group the rest by range
+        std::vector< size_t > histRanges, gatherRanges;
+        std::vector< std::vector< size_t > > rangePositions;
+        for ( size_t posIt = 0; posIt < noPos; posIt++ )
+        {
+            if ( posDone.at(posIt) ) { continue; }
+            if ( posLo.at(posIt) >= posHi.at(posIt) ) { ret->at(posIt) = posLo.at(posIt); posDone.at(posIt) = true; continue; }
+            
+            bool found                                = false;
+            for ( size_t rIt = 0; rIt < rangePositions.size(); rIt++ )
+            {
+                size_t firstPos                       = rangePositions.at(rIt).at(0);
+                if ( ( posLo.at(firstPos) == posLo.at(posIt) ) && ( posHi.at(firstPos) == posHi.at(posIt) ) ) { rangePositions.at(rIt).emplace_back ( posIt ); found = true; break; }
+            }
+            if ( found ) { continue; }
+            
+            rangePositions.emplace_back               ( std::vector< size_t > ( 1, posIt ) );
+            proshade_double binScale                  = static_cast< proshade_double > ( noBins ) / ( posHi.at(posIt) - posLo.at(posIt) );
+            if ( ( posInRange.at(posIt) <= gatherLimit ) || !std::isfinite ( binScale ) || ( binScale <= 0.0 ) ) { gatherRanges.emplace_back ( rangePositions.size() - 1 ); }
+            else                                                                                                  { histRanges.emplace_back   ( rangePositions.size() - 1 ); }
+        }
+        if ( rangePositions.size() == 0 ) { break; }
+        
+        //============================================ Histogram pass - find the bin containing each position
+        if ( histRanges.size() > 0 )
+        {
+            size_t noHist                             = histRanges.size();
+            std::vector< proshade_double > histLo     ( noHist ), histHi ( noHist ), histScale ( noHist );
+            for ( size_t hIt = 0; hIt < noHist; hIt++ )
+            {
+                size_t firstPos                       = rangePositions.at(histRanges.at(hIt)).at(0);
+                histLo.at(hIt)                        = posLo.at(firstPos);
+                histHi.at(hIt)                        = posHi.at(firstPos);
+                histScale.at(hIt)                     = static_cast< proshade_double > ( noBins ) / ( histHi.at(hIt) - histLo.at(hIt) );
+            }
+            
+            std::vector< std::vector< size_t > > workerCounts ( noWorkers, std::vector< size_t > ( noHist * noBins, 0 ) );
+            std::vector< std::vector< proshade_double > > workerBinMin ( noWorkers, std::vector< proshade_double > ( noHist * noBins, std::numeric_limits< proshade_double >::infinity ( ) ) );
+            std::vector< std::vector< proshade_double > > workerBinMax ( noWorkers, std::vector< proshade_double > ( noHist * noBins, -std::numeric_limits< proshade_double >::infinity ( ) ) );
+            ProSHADE_internal_misc::parallelFor       ( noBlocks, noThreads, [&] ( proshade_unsign blockIt, proshade_unsign workerIt )
+            {
+                size_t* counts                        = &workerCounts.at(workerIt)[0];
+                proshade_double* binMin               = &workerBinMin.at(workerIt)[0];
+                proshade_double* binMax               = &workerBinMax.at(workerIt)[0];
+                size_t blockEnd                       = std::min ( valsSize, ( static_cast< size_t > ( blockIt ) + 1 ) * blockSize );
+                for ( size_t iter = static_cast< size_t > ( blockIt ) * blockSize; iter < blockEnd; iter++ )
+                {
+                    for ( size_t hIt = 0; hIt < noHist; hIt++ )
+                    {
+                        if ( ( vals[iter] < histLo[hIt] ) || ( vals[iter] > histHi[hIt] ) ) { continue; }
+                        size_t binIndex               = hIt * noBins + std::min ( noBins - 1, static_cast< size_t > ( ( vals[iter] - histLo[hIt] ) * histScale[hIt] ) );
+                        counts[binIndex]             += 1;
+                        binMin[binIndex]              = std::min ( binMin[binIndex], vals[iter] );
+                        binMax[binIndex]              = std::max ( binMax[binIndex], vals[iter] );
+                    }
+                }
+            } );
+            if ( noPasses != nullptr ) { *noPasses += 1; }
+            
+            //======================================== Combine the worker histograms
+            for ( size_t wIt = 1; wIt < noWorkers; wIt++ )
+            {
+                for ( size_t binIt = 0; binIt < noHist * noBins; binIt++ )
+                {
+                    workerCounts.at(0).at(binIt)     += workerCounts.at(wIt).at(binIt);
+                    workerBinMin.at(0).at(binIt)      = std::min ( workerBinMin.at(0).at(binIt), workerBinMin.at(wIt).at(binIt) );
+                    workerBinMax.at(0).at(binIt)      = std::max ( workerBinMax.at(0).at(binIt), workerBinMax.at(wIt).at(binIt) );
+                }
+            }
+            
+            //======================================== Narrow the range of each position to its bin (values are monotonically binned, so each bin holds all values between its minimum and maximum)
+            for ( size_t hIt = 0; hIt < noHist; hIt++ )
+            {
+                for ( size_t rPosIt = 0; rPosIt < rangePositions.at(histRanges.at(hIt)).size(); rPosIt++ )
+                {
+                    size_t posIt                      = rangePositions.at(histRanges.at(hIt)).at(rPosIt);
+                    size_t cumulative                 = posBelow.at(posIt);
+                    size_t lastNonEmpty               = noBins;
+                    size_t chosenBin                  = noBins;
+                    for ( size_t binIt = 0; binIt < noBins; binIt++ )
+                    {
+                        size_t binCount               = workerCounts.at(0).at(hIt * noBins + binIt);
+                        if ( binCount == 0 ) { continue; }
+                        lastNonEmpty                  = binIt;
+                        if ( cumulative + binCount > positions->at(posIt) ) { chosenBin = binIt; break; }
+                        cumulative                   += binCount;
+                    }
+                    if ( chosenBin == noBins ) { chosenBin = lastNonEmpty; cumulative -= workerCounts.at(0).at(hIt * noBins + chosenBin); }
+                    
+                    //================================ If the histogram did not split the values (e.g. infinite range), gather them instead
+                    size_t chosenCount                = workerCounts.at(0).at(hIt * noBins + chosenBin);
+                    if ( chosenCount == posInRange.at(posIt) ) { posInRange.at(posIt) = 0; continue; }
+                    
+                    posBelow.at(posIt)                = cumulative;
+                    posLo.at(posIt)                   = workerBinMin.at(0).at(hIt * noBins + chosenBin);
+                    posHi.at(posIt)                   = workerBinMax.at(0).at(hIt * noBins + chosenBin);
+                    posInRange.at(posIt)              = chosenCount;
+                }
+            }
+            
+            continue;
+        }
+        
+        //============================================ Gathering pass - collect the values in each range and select the order statistics exactly
+        size_t noGather                               = gatherRanges.size();
+        std::vector< std::vector< std::vector< proshade_double > > > workerVals ( noWorkers, std::vector< std::vector< proshade_double > > ( noGather ) );
+        ProSHADE_internal_misc::parallelFor           ( noBlocks, noThreads, [&] ( proshade_unsign blockIt, proshade_unsign workerIt )
+        {
+            size_t blockEnd                           = std::min ( valsSize, ( static_cast< size_t > ( blockIt ) + 1 ) * blockSize );
+            for ( size_t iter = static_cast< size_t > ( blockIt ) * blockSize; iter < blockEnd; iter++ )
+            {
+                for ( size_t gIt = 0; gIt < noGather; gIt++ )
+                {
+                    size_t firstPos                   = rangePositions.at(gatherRanges.at(gIt)).at(0);
+                    if ( ( vals[iter] >= posLo.at(firstPos) ) && ( vals[iter] <= posHi.at(firstPos) ) ) { workerVals.at(workerIt).at(gIt).emplace_back ( vals[iter] ); }
+                }
+            }
+        } );
+        if ( noPasses != nullptr ) { *noPasses += 1; }
+        
+        for ( size_t gIt = 0; gIt < noGather; gIt++ )
+        {
+            //======================================== Combine the worker values
+            std::vector< proshade_double > rangeVals;
+            for ( size_t wIt = 0; wIt < noWorkers; wIt++ ) { rangeVals.insert ( rangeVals.end(), workerVals.at(wIt).at(gIt).begin(), workerVals.at(wIt).at(gIt).end() ); }
+            
+            //======================================== Select the positions in increasing order, each time searching only above the previous one
+            size_t searchStart                        = 0;
+            for ( size_t rPosIt = 0; rPosIt < rangePositions.at(gatherRanges.at(gIt)).size(); rPosIt++ )
+            {
+                size_t posIt                          = rangePositions.at(gatherRanges.at(gIt)).at(rPosIt);
+                size_t localPos                       = std::min ( positions->at(posIt) - posBelow.at(posIt), rangeVals.size() - 1 );
+                if ( localPos >= searchStart )
+                {
+                    std::nth_element                  ( rangeVals.begin() + static_cast< std::ptrdiff_t > ( searchStart ), rangeVals.begin() + static_cast< std::ptrdiff_t > ( localPos ), rangeVals.end() );
+                    searchStart                       = localPos + 1;
+                }
+                ret->at(posIt)                        = rangeVals.at(localPos);
+                posDone.at(posIt)                     = true;
+            }
+        }
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief Function for computing the Pearson's correlation coefficient.
  
     This function takes two numerical arrays of same length and proceeds to compute the Pearson's
@@ -276,10 +666,12 @@ proshade_double ProSHADE_internal_maths::pearsonCorrCoeff ( proshade_double* val
     
 }
 
-/*! \brief Function to prepare abscissas and weights for Gauss-Legendre integration using the Glaser-Liu-Rokhlin method.
+/*! \brief Function to obtain abscissas and weights for Gauss-Legendre integration.
  
     This function fills in the Gauss-Legendre interpolation points positions (abscissas) and their weights vectors, which will then be used for computing the
-    Gauss-Legendre interpolation.
+    Gauss-Legendre interpolation. As the same orders are required for every band of every structure pair, the values are computed by the
+    computeLegendreAbscAndWeights() function only the first time a given order and number of steps are requested and then copied from
+    a process-wide table, which can be used by multiple threads at the same time.
  
     \param[in] order The order to which the abscissas and weights should be prepared.
     \param[in] abscissas The array holding the abscissa values.
@@ -294,6 +686,42 @@ void ProSHADE_internal_maths::getLegendreAbscAndWeights ( proshade_unsign order,
         throw ProSHADE_exception ( "The integration order is too low.", "EI00019", __FILE__, __LINE__, __func__, "The Gauss-Legendre integration order is less than 2. This\n                    : seems very low; if you have a very small structure or very\n                    : low resolution, please manually increase the integration\n                    : order. Otherwise, please report this as a bug." );
     }
     
+    //================================================ Lock the table
+    std::lock_guard< std::mutex > lock                ( legendreTableMutex );
+    
+    //================================================ Compute the values, if not already done
+    std::pair< proshade_unsign, proshade_unsign > key ( order, noSteps );
+    std::map< std::pair< proshade_unsign, proshade_unsign >, std::vector< proshade_double > >::iterator tableIt = legendreTable.find ( key );
+    if ( tableIt == legendreTable.end ( ) )
+    {
+        std::vector< proshade_double > vals           ( order * 2, 0.0 );
+        computeLegendreAbscAndWeights                 ( order, &vals[0], &vals[order], noSteps );
+        tableIt                                       = legendreTable.insert ( std::make_pair ( key, vals ) ).first;
+    }
+    
+    //================================================ Copy the values
+    for ( proshade_unsign iter = 0; iter < order; iter++ )
+    {
+        abscissas[iter]                               = tableIt->second[iter];
+        weights[iter]                                 = tableIt->second[order + iter];
+    }
+    
+    //================================================ Done
+    return ;
+}
+
+/*! \brief Function to compute abscissas and weights for Gauss-Legendre integration using the Glaser-Liu-Rokhlin method.
+ 
+    This function computes the Gauss-Legendre interpolation points positions (abscissas) and their weights vectors. It should not be called
+    directly, as the getLegendreAbscAndWeights() function keeps the already computed values and checks that the order is at least 2.
+ 
+    \param[in] order The order to which the abscissas and weights should be prepared.
+    \param[in] abscissas The array holding the abscissa values.
+    \param[in] weights The array holding the weight values.
+    \param[in] noSteps The number of steps to be used in approximations.
+ */
+void ProSHADE_internal_maths::computeLegendreAbscAndWeights ( proshade_unsign order, proshade_double* abscissas, proshade_double* weights, proshade_unsign noSteps )
+{
     //================================================ Initialise
     proshade_double polyValue                         = 0.0;
     proshade_double deriValue                         = 0.0;
@@ -792,6 +1220,137 @@ void ProSHADE_internal_maths::gaussLegendreIntegration ( proshade_complex* vals,
     
 }
 
+/*! \brief Function to compute the per-value weights equivalent to the Gauss-Legendre integration over the shell values.
+ 
+    As the Gauss-Legendre integration done by the gaussLegendreIntegration() function is a linear combination of the shell values, where the
+    coefficients only depend on the number of values, the abscissas and weights and the integration range, this function computes these
+    coefficients so that the same integration can be applied to many sets of shell values at once (e.g. as a matrix product). The
+    abscissas are placed and linearly interpolated between the shells in the same way as in the gaussLegendreIntegration() function.
+ 
+    \param[in] valsSize The number of shell values to be integrated over.
+    \param[in] order The integration order value.
+    \param[in] abscissas The allocated array for holding the abscissa values.
+    \param[in] weights The allocated array for holding the weight values.
+    \param[in] integralOverRange The range of the intgral. If progressive shell mapping is used, this will not be max shell radius.
+    \param[in] maxSphereDists Distance between two shells.
+    \param[in] shellWeights Allocated array of valsSize length to which the per-value integration weights will be saved.
+ */
+void ProSHADE_internal_maths::getGaussLegendreShellWeights ( proshade_unsign valsSize, proshade_unsign order, proshade_double* abscissas, proshade_double* weights, proshade_double integralOverRange, proshade_double maxSphereDists, proshade_double* shellWeights )
+{
+    //================================================ Initialise local variables
+    proshade_double absPos                            = 0.0;
+    proshade_unsign lesserPos                         = 0;
+    proshade_unsign upperPos                          = 0;
+    proshade_double lesserWeight                      = 0.0;
+    proshade_double upperWeight                       = 0.0;
+    for ( proshade_unsign valIt = 0; valIt < valsSize; valIt++ ) { shellWeights[valIt] = 0.0; }
+    
+    //================================================ For each abscissa
+    for ( proshade_unsign absIter = 0; absIter < order; absIter++ )
+    {
+        //============================================ Find real position of abscissas
+        absPos                                        = ( ( abscissas[absIter] + 1.0 ) / 2.0 ) * integralOverRange;
+        
+        //============================================ Find lesser and upper bounds
+        for ( proshade_unsign valIt = 0; valIt < valsSize; valIt++ )
+        {
+            if ( ( ( static_cast< proshade_double > ( valIt ) * maxSphereDists ) <=  absPos ) && ( ( ( static_cast< proshade_double > ( valIt ) + 1.0 ) * maxSphereDists ) > absPos ) )
+            {
+                lesserPos                             = static_cast<proshade_unsign> ( valIt );
+                upperPos                              = static_cast<proshade_unsign> ( valIt + 1 );
+                break;
+            }
+        }
+        
+        //============================================ Distribute the abscissa weight between the two shells (the values below the first shell are assumed to be 0)
+        if ( lesserPos != 0 )
+        {
+            lesserWeight                              = static_cast< proshade_double > ( upperPos ) - ( absPos / maxSphereDists );
+            upperWeight                               = 1.0 - lesserWeight;
+            
+            shellWeights[lesserPos-1]                += weights[absIter] * lesserWeight;
+            shellWeights[upperPos-1]                 += weights[absIter] * upperWeight;
+        }
+        else if ( upperPos != 0 )
+        {
+            upperWeight                               = 1.0 - ( static_cast< proshade_double > ( upperPos ) - ( absPos / maxSphereDists ) );
+            
+            shellWeights[upperPos-1]                 += weights[absIter] * upperWeight;
+        }
+    }
+    
+    //================================================ Normalise
+    for ( proshade_unsign valIt = 0; valIt < valsSize; valIt++ ) { shellWeights[valIt] *= ( integralOverRange / 2.0 ); }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Function to multiply a complex matrix by the conjugate transpose of another complex matrix using BLAS.
+ 
+    This function computes C = A * B^H for column-major complex matrices A (rows x inner) and B (cols x inner), saving the result into
+    the column-major complex matrix C (rows x cols). The computation is done by the BLAS ZGEMM function, which is linked together with LAPACK.
+ 
+    \param[in] rows The number of rows of matrices A and C.
+    \param[in] cols The number of rows of matrix B and the number of columns of matrix C.
+    \param[in] inner The number of columns of matrices A and B.
+    \param[in] A Pointer to the column-major matrix A.
+    \param[in] B Pointer to the column-major matrix B.
+    \param[in] C Pointer to the column-major matrix C, to which the result will be saved.
+ */
+void ProSHADE_internal_maths::complexMatrixMultiplyConjugTranspose ( int rows, int cols, int inner, std::complex<proshade_double>* A, std::complex<proshade_double>* B, std::complex<proshade_double>* C )
+{
+    //================================================ Empty product
+    if ( inner < 1 ) { for ( int iter = 0; iter < ( rows * cols ); iter++ ) { C[iter] = std::complex<proshade_double> ( 0.0, 0.0 ); } return ; }
+    
+    //================================================ Initialise BLAS variables
+    char transA                                       = 'N';
+    char transB                                       = 'C';
+    std::complex<proshade_double> alpha               ( 1.0, 0.0 );
+    std::complex<proshade_double> beta                ( 0.0, 0.0 );
+    
+    //================================================ Run BLAS ZGEMM
+    zgemm_                                            ( &transA, &transB, &rows, &cols, &inner, &alpha, A, &rows, B, &cols, &beta, C, &rows );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Function to compute all the dot products between a set of real vectors using BLAS.
+ 
+    This function computes the Gram matrix C = A * A^T, where A holds noVectors vectors of length vecLength stored
+    one after another. Only the upper triangle of the column-major matrix C (noVectors x noVectors) is filled, i.e.
+    C[i + j * noVectors] for i <= j is the dot product of vectors i and j. The computation is done by the BLAS DSYRK function.
+ 
+    \param[in] noVectors The number of vectors in A and the dimension of C.
+    \param[in] vecLength The length of each vector.
+    \param[in] A Pointer to the vectors, each stored contiguously.
+    \param[in] C Pointer to the noVectors * noVectors array, to which the upper triangle of the result will be saved.
+ */
+void ProSHADE_internal_maths::realGramMatrixUpper ( int noVectors, int vecLength, proshade_double* A, proshade_double* C )
+{
+    //================================================ Nothing to do
+    if ( noVectors < 1 ) { return ; }
+    
+    //================================================ Empty vectors
+    if ( vecLength < 1 ) { for ( int iter = 0; iter < ( noVectors * noVectors ); iter++ ) { C[iter] = 0.0; } return ; }
+    
+    //================================================ Initialise BLAS variables
+    char uplo                                         = 'U';
+    char trans                                        = 'T';
+    proshade_double alpha                             = 1.0;
+    proshade_double beta                              = 0.0;
+    
+    //================================================ Run BLAS DSYRK (the vectors are the columns of the column-major vecLength x noVectors matrix)
+    dsyrk_                                            ( &uplo, &trans, &noVectors, &vecLength, &alpha, A, &vecLength, &beta, C, &noVectors );
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief Function to compute the complete complex matrix SVD and return only the sigmas.
  
     This function converts the input proshade_complex matrix of dimensions dim onto the LAPACK compatible
@@ -3694,7 +4253,6 @@ proshade_double ProSHADE_internal_maths::computeFSC ( fftw_complex *fCoeffs1, ff
     //================================================ Initialise local variables
     proshade_double realOrig, realRot, imagOrig, imagRot, fsc = 0.0;;
     proshade_signed indx, arrPos;
-    std::vector< proshade_double > covarByBin         ( static_cast< size_t > ( noBins ), 0.0 );
     
     //================================================ Clean FSC computation memory
     for ( size_t binIt = 0; binIt < static_cast< size_t > ( noBins ); binIt++ ) { for ( size_t valIt = 0; valIt < 12; valIt++ ) { binData[binIt][valIt] = 0.0; } }
@@ -3737,6 +4295,32 @@ proshade_double ProSHADE_internal_maths::computeFSC ( fftw_complex *fCoeffs1, ff
         }
     }
     
+    //================================================ Compute the FSC from the bin sums
+    fsc                                               = computeFSCFromBinSums ( noBins, binData, binCounts, fscByBin, averageByBinSize );
+    
+    //================================================ Done
+    return                                            ( fsc );
+    
+}
+
+/*! \brief This function computes the FSC from the already summed bin values.
+ 
+    This function takes the bin sums (the first 10 values of each bin data array) and bin counts, as computed by the computeFSC() or
+    computeRotatedFSC() functions, and computes the FSC for each bin and their (weighted) average.
+ 
+    \param[in] noBin Number of bins.
+    \param[in] binData Array of arrays of dimensions noBins x 12 with the first 10 values already summed. The remaining values are filled by this function.
+    \param[in] binCounts Array of counts for each bin.
+    \param[in] fscByBin This array will hold FSC values for each bin.
+    \param[in] weightByBinSize Boolean value determining if averaging bins should take into account  the bin sizes or not.
+    \param[out] fsc The Fourier Shell Correlation average over all bins.
+ */
+proshade_double ProSHADE_internal_maths::computeFSCFromBinSums ( proshade_signed noBins, proshade_double**& binData, proshade_signed*& binCounts, proshade_double*& fscByBin, bool averageByBinSize )
+{
+    //================================================ Initialise local variables
+    proshade_double fsc                               = 0.0;
+    std::vector< proshade_double > covarByBin         ( static_cast< size_t > ( noBins ), 0.0 );
+    
     //================================================ Compute covariance by bin
     for ( size_t binIt = 0; binIt < static_cast< size_t > ( noBins ); binIt++ )
     {
@@ -3781,6 +4365,253 @@ proshade_double ProSHADE_internal_maths::computeFSC ( fftw_complex *fCoeffs1, ff
     
 }
 
+/*! \brief This function interpolates the Fourier coefficients at the rotated position of a single reciprocal space index.
+ 
+    This function rotates the hkl index by the supplied matrix and tri-linearly interpolates the coefficients at the resulting position exactly
+    as the ProSHADE_data::rotateFourierCoeffs() function does for each of its indices, but without any memory allocation.
+ 
+    \param[in] coeffs The coefficients to be rotated.
+    \param[in] rotMat The (transposed) rotation matrix.
+    \param[in] mins The minimal reciprocal space index along each axis.
+    \param[in] maxs The maximal reciprocal space index along each axis.
+    \param[in] xDim The number of indices along the x-axis.
+    \param[in] yDim The number of indices along the y-axis.
+    \param[in] zDim The number of indices along the z-axis.
+    \param[in] h The x-axis reciprocal space index.
+    \param[in] k The y-axis reciprocal space index.
+    \param[in] l The z-axis reciprocal space index.
+    \param[in] re Pointer to where the real part of the interpolated value will be saved.
+    \param[in] im Pointer to where the imaginary part of the interpolated value will be saved.
+    \param[out] X False if the rotated position is outside of the coefficients, true otherwise.
+ */
+bool ProSHADE_internal_maths::interpolateRotatedFourierCoeff ( fftw_complex* coeffs, proshade_double* rotMat, proshade_signed* mins, proshade_signed* maxs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_signed h, proshade_signed k, proshade_signed l, proshade_double* re, proshade_double* im )
+{
+    //================================================ Initialise local variables
+    size_t dimMax                                     = static_cast< size_t > ( xDim * yDim * zDim );
+    proshade_signed interpMins[3], interpMaxs[3];
+    proshade_double interpDiff[3], rotVec[3];
+    
+    //================================================ Compute new point position
+    rotVec[0]                                         = ( static_cast< proshade_double > ( h ) * rotMat[0] ) + ( static_cast< proshade_double > ( k ) * rotMat[1] ) + ( static_cast< proshade_double > ( l ) * rotMat[2] );
+    rotVec[1]                                         = ( static_cast< proshade_double > ( h ) * rotMat[3] ) + ( static_cast< proshade_double > ( k ) * rotMat[4] ) + ( static_cast< proshade_double > ( l ) * rotMat[5] );
+    rotVec[2]                                         = ( static_cast< proshade_double > ( h ) * rotMat[6] ) + ( static_cast< proshade_double > ( k ) * rotMat[7] ) + ( static_cast< proshade_double > ( l ) * rotMat[8] );
+    
+    //================================================ Find surrounding grid points indices and check for boundaries
+    for ( size_t posIt = 0; posIt < 3; posIt++ )
+    {
+        interpMins[posIt]                             = static_cast< proshade_signed > ( std::round ( rotVec[posIt] ) );
+        if ( static_cast< proshade_double > ( interpMins[posIt] ) > rotVec[posIt] ) { interpMaxs[posIt] = interpMins[posIt]; interpMins[posIt]--; }
+        else                                                                       { interpMaxs[posIt] = interpMins[posIt] + 1; }
+        
+        if ( ( maxs[posIt] < interpMins[posIt] ) || ( interpMins[posIt] < mins[posIt] ) || ( maxs[posIt] < interpMaxs[posIt] ) || ( interpMaxs[posIt] < mins[posIt] ) ) { return ( false ); }
+        
+        interpDiff[posIt]                             = rotVec[posIt] - static_cast< proshade_double > ( interpMins[posIt] );
+    }
+    
+    //================================================ Find the surrounding points values (the first rotated axis is the fastest in the coefficients array)
+    std::complex< proshade_double > corners[8];
+    for ( size_t cIt = 0; cIt < 8; cIt++ )
+    {
+        proshade_signed i0                            = ( cIt & 4 ) ? interpMaxs[0] : interpMins[0];
+        proshade_signed i1                            = ( cIt & 2 ) ? interpMaxs[1] : interpMins[1];
+        proshade_signed i2                            = ( cIt & 1 ) ? interpMaxs[2] : interpMins[2];
+        size_t arrPos                                 = static_cast< size_t > ( ( i0 - mins[0] ) + zDim * ( ( i1 - mins[1] ) + yDim * ( i2 - mins[2] ) ) );
+        if ( arrPos >= dimMax ) { return ( false ); }
+        corners[cIt]                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
+    }
+    
+    //================================================ Interpolate along x, y and z
+    std::complex< proshade_double > c00               = ( corners[0] * ( 1.0 - interpDiff[0] ) ) + ( corners[4] * interpDiff[0] );
+    std::complex< proshade_double > c01               = ( corners[1] * ( 1.0 - interpDiff[0] ) ) + ( corners[5] * interpDiff[0] );
+    std::complex< proshade_double > c10               = ( corners[2] * ( 1.0 - interpDiff[0] ) ) + ( corners[6] * interpDiff[0] );
+    std::complex< proshade_double > c11               = ( corners[3] * ( 1.0 - interpDiff[0] ) ) + ( corners[7] * interpDiff[0] );
+    std::complex< proshade_double > c0                = ( c00 * ( 1.0 - interpDiff[1] ) ) + ( c10 * interpDiff[1] );
+    std::complex< proshade_double > c1                = ( c01 * ( 1.0 - interpDiff[1] ) ) + ( c11 * interpDiff[1] );
+    std::complex< proshade_double > res               = ( c0  * ( 1.0 - interpDiff[2] ) ) + ( c1  * interpDiff[2] );
+    
+    //================================================ Save
+   *re                                                = res.real();
+   *im                                                = res.imag();
+    
+    //================================================ Done
+    return                                            ( true );
+    
+}
+
+/*! \brief This function finds the rotated Fourier coefficient value at a single position of the rotated coefficients array.
+ 
+    This function returns the value which the ProSHADE_data::rotateFourierCoeffs() function would save at the given position (before switching
+    the x and z axes). That function interpolates the indices with l <= 0 and fills the l > 0 half using Friedel's law (except for the
+    indices on the minimal boundary). As the reciprocal space index range is one longer than odd dimensions, several indices may write into
+    the same position; in such a case, the value written last is returned. Values which are not a number are replaced by zero.
+ 
+    \param[in] coeffs The coefficients to be rotated.
+    \param[in] rotMat The (transposed) rotation matrix.
+    \param[in] mins The minimal reciprocal space index along each axis.
+    \param[in] maxs The maximal reciprocal space index along each axis.
+    \param[in] xDim The number of indices along the x-axis.
+    \param[in] yDim The number of indices along the y-axis.
+    \param[in] zDim The number of indices along the z-axis.
+    \param[in] arrPos The position in the rotated coefficients array (z being the fastest index).
+    \param[in] re Pointer to where the real part of the rotated value will be saved.
+    \param[in] im Pointer to where the imaginary part of the rotated value will be saved.
+ */
+void ProSHADE_internal_maths::getRotatedFourierCoeff ( fftw_complex* coeffs, proshade_double* rotMat, proshade_signed* mins, proshade_signed* maxs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_signed arrPos, proshade_double* re, proshade_double* im )
+{
+    //================================================ Initialise local variables
+    proshade_signed lastWrite[4]                      = { 0, 0, 0, -1 };
+    proshade_double valRe, valIm, lastRe = 0.0, lastIm = 0.0;
+    proshade_signed dimMax                            = xDim * yDim * zDim;
+    
+    //================================================ Find all hkl indices which map onto this position
+    for ( proshade_signed zOver = 0; zOver < 2; zOver++ )
+    {
+        proshade_signed zPos                          = ( arrPos % zDim ) + ( zOver * zDim );
+        if ( ( zPos > ( maxs[2] - mins[2] ) ) || ( zPos > arrPos ) ) { continue; }
+        
+        for ( proshade_signed yOver = 0; yOver < 2; yOver++ )
+        {
+            proshade_signed xyPos                     = ( arrPos - zPos ) / zDim;
+            proshade_signed yPos                      = ( xyPos % yDim ) + ( yOver * yDim );
+            if ( ( yPos > ( maxs[1] - mins[1] ) ) || ( yPos > xyPos ) ) { continue; }
+            
+            proshade_signed xPos                      = ( xyPos - yPos ) / yDim;
+            if ( xPos > ( maxs[0] - mins[0] ) ) { continue; }
+            
+            proshade_signed h                         = xPos + mins[0];
+            proshade_signed k                         = yPos + mins[1];
+            proshade_signed l                         = zPos + mins[2];
+            
+            //======================================== Direct write from the hkl iteration (only the l <= 0 half is iterated over)
+            if ( ( l <= 0 ) && interpolateRotatedFourierCoeff ( coeffs, rotMat, mins, maxs, xDim, yDim, zDim, h, k, l, &valRe, &valIm ) )
+            {
+                proshade_signed order[4]              = { h, k, l, 0 };
+                if ( std::lexicographical_compare ( lastWrite, lastWrite + 4, order, order + 4 ) || ( lastWrite[3] < 0 ) )
+                {
+                    for ( size_t oIt = 0; oIt < 4; oIt++ ) { lastWrite[oIt] = order[oIt]; }
+                    lastRe                            = valRe;
+                    lastIm                            = valIm;
+                }
+            }
+            
+            //======================================== Friedel mate write from the -h-k-l iteration (source must be iterated over, not be on the minimal boundary and have its own direct write)
+            if ( ( -h <= mins[0] ) || ( -h > maxs[0] ) || ( -k <= mins[1] ) || ( -k > maxs[1] ) || ( -l <= mins[2] ) || ( -l > 0 ) ) { continue; }
+            if ( ( ( -l - mins[2] ) + zDim * ( ( -k - mins[1] ) + yDim * ( -h - mins[0] ) ) ) >= dimMax ) { continue; }
+            if ( interpolateRotatedFourierCoeff ( coeffs, rotMat, mins, maxs, xDim, yDim, zDim, -h, -k, -l, &valRe, &valIm ) )
+            {
+                proshade_signed order[4]              = { -h, -k, -l, 1 };
+                if ( std::lexicographical_compare ( lastWrite, lastWrite + 4, order, order + 4 ) || ( lastWrite[3] < 0 ) )
+                {
+                    for ( size_t oIt = 0; oIt < 4; oIt++ ) { lastWrite[oIt] = order[oIt]; }
+                    lastRe                            = valRe;
+                    lastIm                            = -valIm;
+                }
+            }
+        }
+    }
+    
+    //================================================ Save, not a number is zero
+   *re                                                = lastRe;
+   *im                                                = lastIm;
+    if ( std::isnan ( *re ) || std::isnan ( *im ) ) { *re = 0.0; *im = 0.0; }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function computes the FSC between Fourier coefficients and their rotated version without computing the rotated coefficients array.
+ 
+    This function computes the same value as the ProSHADE_data::rotateFourierCoeffs() followed by the computeFSC() functions, but instead of
+    allocating and filling the rotated coefficients array, it finds the rotated value of each binned reflection on the fly (see
+    getRotatedFourierCoeff()) and adds it directly to the bin sums. The x-axis slabs are processed in parallel, each worker having its own
+    bin sums, which are added together at the end.
+ 
+    \param[in] fCoeffs The Fourier coefficients of the map.
+    \param[in] rotMat The (transposed) rotation matrix by which the coefficients are to be rotated.
+    \param[in] xInds The number of indices along the x-axis.
+    \param[in] yInds The number of indices along the y-axis.
+    \param[in] zInds The number of indices along the z-axis.
+    \param[in] noBin Number of bins.
+    \param[in] binIndexing The map of bin belonging for each reflection.
+    \param[in] binData Array of arrays for holding temporary results of the FSC computation. It needs to have been already allocated and have dimensions of noBins x 12.
+    \param[in] binCounts Array of counts for each bin. It needs to be pre-allocated and have dimension of noBins.
+    \param[in] fscByBin This array will hold FSC values for each bin.
+    \param[in] noThreads The number of threads to be used; 0 means all available.
+    \param[in] weightByBinSize Boolean value determining if averaging bins should take into account  the bin sizes or not.
+    \param[out] fsc The Fourier Shell Correlation between the supplied and the rotated Fourier coefficients.
+ */
+proshade_double ProSHADE_internal_maths::computeRotatedFSC ( fftw_complex* fCoeffs, proshade_double* rotMat, proshade_signed xInds, proshade_signed yInds, proshade_signed zInds, proshade_signed noBins, proshade_signed* binIndexing, proshade_double**& binData, proshade_signed*& binCounts, proshade_double*& fscByBin, proshade_unsign noThreads, bool averageByBinSize )
+{
+    //================================================ Determine reciprocal space indexing
+    proshade_signed mins[3], maxs[3];
+    mins[0]                                           = static_cast< proshade_signed > ( std::floor ( static_cast< proshade_single > ( xInds ) / -2.0f ) );
+    mins[1]                                           = static_cast< proshade_signed > ( std::floor ( static_cast< proshade_single > ( yInds ) / -2.0f ) );
+    mins[2]                                           = static_cast< proshade_signed > ( std::floor ( static_cast< proshade_single > ( zInds ) / -2.0f ) );
+    for ( size_t dIt = 0; dIt < 3; dIt++ ) { maxs[dIt] = -( mins[dIt] + 1 ); }
+    
+    //================================================ Allocate per worker bin sums (10 sums and the count for each bin)
+    size_t noBinsS                                    = static_cast< size_t > ( noBins );
+    proshade_unsign noWorkers                         = ProSHADE_internal_misc::getNumberOfThreads ( noThreads, static_cast< proshade_unsign > ( xInds ) );
+    std::vector< std::vector< proshade_double > > workerSums ( noWorkers, std::vector< proshade_double > ( noBinsS * 11, 0.0 ) );
+    
+    //================================================ Compute bin sums for each x-axis slab
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( xInds ), noThreads, [&] ( proshade_unsign xIt, proshade_unsign workerIt )
+    {
+        proshade_double* sums                         = &workerSums.at(workerIt)[0];
+        proshade_double realOrig, imagOrig, realRot, imagRot;
+        proshade_signed arrPos, indx, rotX, rotY, rotZ;
+        for ( proshade_signed yIt = 0; yIt < yInds; yIt++ )
+        {
+            for ( proshade_signed zIt = 0; zIt < ( zInds / 2 ); zIt++ )
+            {
+                //==================================== If no bin is associated, skip this reflection
+                arrPos                                = zIt + zInds * ( yIt + yInds * static_cast< proshade_signed > ( xIt ) );
+                indx                                  = binIndexing[ static_cast< size_t > ( arrPos ) ];
+                if ( ( indx < 0 ) || ( indx >= noBins ) ) { continue; }
+                
+                //==================================== The rotated coefficients have x and z switched, so find the position this one was taken from
+                rotX                                  = arrPos % xInds;
+                rotY                                  = ( arrPos / xInds ) % yInds;
+                rotZ                                  = arrPos / ( xInds * yInds );
+                getRotatedFourierCoeff                ( fCoeffs, rotMat, mins, maxs, xInds, yInds, zInds, rotZ + zInds * ( rotY + yInds * rotX ), &realRot, &imagRot );
+                
+                //==================================== Calculate the sums
+                realOrig                              = fCoeffs[arrPos][0];
+                imagOrig                              = fCoeffs[arrPos][1];
+                proshade_double* binSums              = sums + ( static_cast< size_t > ( indx ) * 11 );
+                binSums[0]                           += realOrig;
+                binSums[1]                           += imagOrig;
+                binSums[2]                           += realRot;
+                binSums[3]                           += imagRot;
+                binSums[4]                           += realOrig * realRot;
+                binSums[5]                           += imagOrig * imagRot;
+                binSums[6]                           += realOrig * realOrig;
+                binSums[7]                           += imagOrig * imagOrig;
+                binSums[8]                           += realRot  * realRot;
+                binSums[9]                           += imagRot  * imagRot;
+                binSums[10]                          += 1.0;
+            }
+        }
+    } );
+    
+    //================================================ Add the worker sums together
+    for ( size_t binIt = 0; binIt < noBinsS; binIt++ )
+    {
+        for ( size_t valIt = 0; valIt < 12; valIt++ ) { binData[binIt][valIt] = 0.0; }
+        binCounts[binIt]                              = 0;
+        for ( size_t wIt = 0; wIt < workerSums.size(); wIt++ )
+        {
+            for ( size_t valIt = 0; valIt < 10; valIt++ ) { binData[binIt][valIt] += workerSums.at(wIt)[( binIt * 11 ) + valIt]; }
+            binCounts[binIt]                         += static_cast< proshade_signed > ( workerSums.at(wIt)[( binIt * 11 ) + 10] );
+        }
+    }
+    
+    //================================================ Done
+    return                                            ( computeFSCFromBinSums ( noBins, binData, binCounts, fscByBin, averageByBinSize ) );
+    
+}
+
 /*! \brief This function computes the weights for each reflection using its bin belonging.
  
     This function computes the weights for tralsation optimisation - the bin FSC for each reflection according to its bin belonging for weights1 and
@@ -4229,6 +5060,145 @@ proshade_double ProSHADE_internal_maths::findTopGroupSmooth ( std::vector< std::
     
 }
 
+/*! \brief This function applies a reciprocal space filter to a real map using the real to complex Fourier transforms.
+ 
+    This function computes the half-spectrum (real to complex) Fourier transform of the input map, multiplies each coefficient by
+    the filter value and computes the complex to real inverse Fourier transform, saving the result to the output map. The filter is
+    given for the full Fourier coefficients array index (z being the fastest index) and is expected to include any normalisation.
+    As only the half-spectrum is held, the filter is made Hermitian by averaging each value with the complex conjugate of the value
+    of its Friedel mate; the result is therefore identical to taking the real part of the inverse complex Fourier transform of the
+    fully filtered complex Fourier transform of the map, while needing half the Fourier transform time and memory. The transforms
+    read and write the maps directly (the out-of-place real to complex transform does not modify its input), so the only scratch
+    memory needed is the half-spectrum, which can be supplied by the caller for re-use over multiple calls.
+ 
+    \param[in] inMap The real map to be filtered.
+    \param[in] outMap Array of the same size as the input map where the filtered map will be saved. It can be the input map.
+    \param[in] xDim The number of indices along the x-axis of the map.
+    \param[in] yDim The number of indices along the y-axis of the map.
+    \param[in] zDim The number of indices along the z-axis of the map.
+    \param[in] filter Function returning the complex multiplier for the given full Fourier coefficients array index.
+    \param[in] coeffsScratch Optional array of at least xDim * yDim * ( zDim / 2 + 1 ) coefficients to be used for the half-spectrum. If nullptr, it is allocated.
+ */
+void ProSHADE_internal_maths::applyFourierFilterToRealMap ( proshade_double* inMap, proshade_double* outMap, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, std::function< std::complex< proshade_double > ( size_t ) > filter, fftw_complex* coeffsScratch )
+{
+    //================================================ Initialise local variables
+    size_t xDimS                                      = static_cast< size_t > ( xDim );
+    size_t yDimS                                      = static_cast< size_t > ( yDim );
+    size_t zDimS                                      = static_cast< size_t > ( zDim );
+    size_t zHalf                                      = ( zDimS / 2 ) + 1;
+    
+    //================================================ Allocate memory, unless supplied
+    fftw_complex* halfCoeffs                          = coeffsScratch;
+    if ( coeffsScratch == nullptr )
+    {
+        halfCoeffs                                    = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * xDimS * yDimS * zHalf ) );
+        ProSHADE_internal_misc::checkMemoryAllocation ( halfCoeffs, __FILE__, __LINE__, __func__ );
+    }
+    
+    //================================================ Get plans from the plans cache
+    fftw_plan forward                                 = ProSHADE_internal_fftw::getR2C3DPlan ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), inMap, halfCoeffs );
+    fftw_plan inverse                                 = ProSHADE_internal_fftw::getC2R3DPlan ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), halfCoeffs, outMap );
+    
+    //================================================ Compute forward Fourier
+    fftw_execute_dft_r2c                              ( forward, inMap, halfCoeffs );
+    
+    //================================================ Apply the Hermitian part of the filter
+    for ( size_t uIt = 0; uIt < xDimS; uIt++ )
+    {
+        for ( size_t vIt = 0; vIt < yDimS; vIt++ )
+        {
+            for ( size_t wIt = 0; wIt < zHalf; wIt++ )
+            {
+                //==================================== Find the full array position of the coefficient and of its Friedel mate
+                size_t fullPos                        = wIt + zDimS * ( vIt + yDimS * uIt );
+                size_t matePos                        = ( ( zDimS - wIt ) % zDimS ) + zDimS * ( ( ( yDimS - vIt ) % yDimS ) + yDimS * ( ( xDimS - uIt ) % xDimS ) );
+                std::complex< proshade_double > mult  = ( filter ( fullPos ) + std::conj ( filter ( matePos ) ) ) / 2.0;
+                
+                //==================================== Apply
+                size_t halfPos                        = wIt + zHalf * ( vIt + yDimS * uIt );
+                std::complex< proshade_double > coeff = std::complex< proshade_double > ( halfCoeffs[halfPos][0], halfCoeffs[halfPos][1] ) * mult;
+                halfCoeffs[halfPos][0]                = coeff.real();
+                halfCoeffs[halfPos][1]                = coeff.imag();
+            }
+        }
+    }
+    
+    //================================================ Compute inverse Fourier directly into the output map
+    fftw_execute_dft_c2r                              ( inverse, halfCoeffs, outMap );
+    
+    //================================================ Release memory, unless supplied (the plans are owned by the plans cache)
+    if ( coeffsScratch == nullptr ) { fftw_free ( halfCoeffs ); }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function returns any coefficient of the full Fourier transform of a real map from its half-spectrum.
+ 
+    The real to complex Fourier transform only holds the coefficients with the z-axis index up to zDim / 2. The remaining coefficients
+    are obtained from Friedel's law, i.e. as the complex conjugate of the coefficient with the negated (periodic) indices.
+ 
+    \param[in] halfCoeffs The half-spectrum with the dimensions xDim x yDim x ( zDim / 2 + 1 ).
+    \param[in] xDim The number of indices along the x-axis of the real map.
+    \param[in] yDim The number of indices along the y-axis of the real map.
+    \param[in] zDim The number of indices along the z-axis of the real map.
+    \param[in] uIt The x-axis index of the requested coefficient in the full coefficients array (0 to xDim - 1).
+    \param[in] vIt The y-axis index of the requested coefficient in the full coefficients array (0 to yDim - 1).
+    \param[in] wIt The z-axis index of the requested coefficient in the full coefficients array (0 to zDim - 1).
+    \param[out] X The requested Fourier coefficient.
+ */
+std::complex< proshade_double > ProSHADE_internal_maths::getHalfSpectrumCoeff ( fftw_complex* halfCoeffs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_signed uIt, proshade_signed vIt, proshade_signed wIt )
+{
+    //================================================ Initialise local variables
+    proshade_signed zHalf                             = ( zDim / 2 ) + 1;
+    
+    //================================================ Held coefficient
+    if ( wIt < zHalf )
+    {
+        size_t halfPos                                = static_cast< size_t > ( wIt + zHalf * ( vIt + yDim * uIt ) );
+        return                                        ( std::complex< proshade_double > ( halfCoeffs[halfPos][0], halfCoeffs[halfPos][1] ) );
+    }
+    
+    //================================================ Use Friedel's law
+    size_t matePos                                    = static_cast< size_t > ( ( zDim - wIt ) + zHalf * ( ( ( yDim - vIt ) % yDim ) + yDim * ( ( xDim - uIt ) % xDim ) ) );
+    
+    //================================================ Done
+    return                                            ( std::complex< proshade_double > ( halfCoeffs[matePos][0], -halfCoeffs[matePos][1] ) );
+    
+}
+
+/*! \brief This function expands the half-spectrum of a real map Fourier transform into the full Fourier coefficients array.
+ 
+    \param[in] halfCoeffs The half-spectrum with the dimensions xDim x yDim x ( zDim / 2 + 1 ).
+    \param[in] fullCoeffs Pre-allocated array of xDim * yDim * zDim coefficients, to which the full Fourier transform will be saved.
+    \param[in] xDim The number of indices along the x-axis of the real map.
+    \param[in] yDim The number of indices along the y-axis of the real map.
+    \param[in] zDim The number of indices along the z-axis of the real map.
+ */
+void ProSHADE_internal_maths::expandHalfSpectrum ( fftw_complex* halfCoeffs, fftw_complex* fullCoeffs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim )
+{
+    //================================================ For each full array coefficient
+    for ( proshade_signed uIt = 0; uIt < xDim; uIt++ )
+    {
+        for ( proshade_signed vIt = 0; vIt < yDim; vIt++ )
+        {
+            for ( proshade_signed wIt = 0; wIt < zDim; wIt++ )
+            {
+                //==================================== Copy or conjugate the mate
+                size_t fullPos                        = static_cast< size_t > ( wIt + zDim * ( vIt + yDim * uIt ) );
+                std::complex< proshade_double > coeff = getHalfSpectrumCoeff ( halfCoeffs, xDim, yDim, zDim, uIt, vIt, wIt );
+                fullCoeffs[fullPos][0]                = coeff.real();
+                fullCoeffs[fullPos][1]                = coeff.imag();
+            }
+        }
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
 /*! \brief This function combines Fourier coefficients of two structures in a way, so that inverse Fourier of the combination will be the translation function.
  
     \param[in] tmpOut1 Array holding the static structure Fourier outputs.
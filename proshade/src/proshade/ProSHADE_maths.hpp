@@ -21,7 +21,7 @@
  */
 
 //==================================================== ProSHADE
-#include "ProSHADE_misc.hpp"
+#include "ProSHADE_fftw.hpp"
 
 //==================================================== almostEqual for comparing floating point numbers (BSD License, works on Windows as well as linux)
 #include <almostEqual.hpp>
@@ -39,6 +39,10 @@ extern "C"
     extern void zgesdd_ ( char* jobz, int* m, int* n, std::complex<double>* a, int* lda, double* s, std::complex<double>* u, int* ldu, std::complex<double>* vt, int* ldvt, std::complex<double>* work, int* lwork, double* rwork, int* iwork, int* info );
     // ... The eigenvalue/eigenvector solver
     extern void dgeev_ ( char* jobvl, char* jobvr, int* n, double* a, int* lda, double* wr, double* wi, double* vl, int* ldvl, double* vr, int* ldvr, double* work, int* lwork, int* info );
+    // ... The complex matrix-matrix multiplication function from BLAS
+    extern void zgemm_ ( char* transa, char* transb, int* m, int* n, int* k, std::complex<double>* alpha, std::complex<double>* a, int* lda, std::complex<double>* b, int* ldb, std::complex<double>* beta, std::complex<double>* c, int* ldc );
+    // ... The real symmetric rank-k update function from BLAS
+    extern void dsyrk_ ( char* uplo, char* trans, int* n, int* k, double* alpha, double* a, int* lda, double* beta, double* c, int* ldc );
 }
 
 //==================================================== ProSHADE_internal_spheres Namespace
@@ -47,6 +51,30 @@ extern "C"
 // ... organisation a bit messier.
 namespace ProSHADE_internal_spheres
 {
+/*! \class ProSHADE_rotFun_sphereGeometry
+    \brief This class holds the rotation function map positions of the angle-axis sphere sampling points.
+ 
+    The positions depend only on the angular dim, the rotation function dim and the represented angle, so that they are shared by all the
+    spheres with the same geometry. The cache is owned by the structure (ProSHADE_data) whose rotation function is being converted and it is
+    released together with it; it is also capped at a fixed number of values, above which the positions are not cached.
+ */
+    class ProSHADE_rotFun_sphereGeometry
+    {
+    private:
+        std::mutex geometryMutex;
+        std::map< std::pair< std::pair< proshade_unsign, proshade_unsign >, proshade_double >, std::vector< proshade_double > > positions;
+        size_t noValues;
+        
+    public:
+        ProSHADE_rotFun_sphereGeometry                ( void );
+       ~ProSHADE_rotFun_sphereGeometry                ( void );
+        
+    public:
+        const proshade_double* findPositions          ( proshade_unsign angDim, proshade_unsign rfDim, proshade_double repAng );
+        const proshade_double* storePositions         ( proshade_unsign angDim, proshade_unsign rfDim, proshade_double repAng, std::vector< proshade_double >& newPositions,
+                                                        std::vector< proshade_double >* localPositions );
+    };
+    
 /*! \class ProSHADE_rotFun_sphere
     \brief This class contains all inputed data for the rotation function angle-axis converted spheres.
  
@@ -67,6 +95,9 @@ namespace ProSHADE_internal_spheres
         
         proshade_double* axesValues;
         std::vector< std::pair< proshade_unsign,proshade_unsign > > peaks;
+        
+    private:
+        const proshade_double* getSamplingPositions   ( ProSHADE_rotFun_sphereGeometry* geometry, std::vector< proshade_double >* localPositions );
     public:
         ProSHADE_rotFun_sphere                        ( proshade_double rad, proshade_double radRange, proshade_unsign dim, proshade_unsign rfDim, proshade_double repAng, proshade_unsign sphNo );
        ~ProSHADE_rotFun_sphere                        ( void );
@@ -86,7 +117,8 @@ namespace ProSHADE_internal_spheres
         
         
     public:
-        void interpolateSphereValues                  ( proshade_complex* rotFun );
+        void interpolateSphereValues                  ( proshade_complex* rotFun, ProSHADE_rotFun_sphereGeometry* geometry );
+        void interpolateSphereValues                  ( proshade_double* rotFunMagnitudes, ProSHADE_rotFun_sphereGeometry* geometry );
         void findAllPeaks                             ( proshade_signed noSmNeighbours, std::vector< proshade_double >* allHeights );
         void removeSmallPeaks                         ( proshade_double peakThres );
     };
@@ -307,11 +339,22 @@ namespace ProSHADE_internal_maths
     proshade_double complexMultiplicationRealOnly     ( proshade_double* r1, proshade_double* i1, proshade_double* r2, proshade_double* i2 );
     proshade_double complexMultiplicationConjugRealOnly ( proshade_double* r1, proshade_double* i1, proshade_double* r2, proshade_double* i2 );
     void vectorMeanAndSD                              ( std::vector<proshade_double>* vec, proshade_double*& ret );
+    void arrayMeanAndSD                               ( const proshade_double* vals, size_t valsSize, proshade_double*& ret );
     void vectorMedianAndIQR                           ( std::vector<proshade_double>* vec, proshade_double*& ret );
+    void vectorMedianAndIQRSelection                  ( std::vector<proshade_double>* vec, proshade_double*& ret );
     void arrayMedianAndIQR                            ( proshade_double* vec, proshade_unsign vecSize, proshade_double*& ret );
+    void arrayMedianAndIQRSelection                   ( proshade_double* vec, size_t vecSize, proshade_double*& ret );
+    void arrayMedianAndIQRHistogram                   ( const proshade_double* vec, size_t vecSize, proshade_double*& ret, proshade_unsign noThreads = 1,
+                                                        proshade_unsign* noPasses = nullptr );
+    void getMedianAndIQRPositions                     ( size_t vecSize, std::vector< size_t >* positions );
+    void medianAndIQRFromOrderStatistics              ( std::vector< proshade_double >* orderStats, proshade_double*& ret );
+    void arrayOrderStatistics                         ( const proshade_double* vals, size_t valsSize, std::vector< size_t >* positions,
+                                                        std::vector< proshade_double >* ret, proshade_unsign noThreads = 1, proshade_unsign* noPasses = nullptr );
     proshade_double pearsonCorrCoeff                  ( proshade_double* valSet1, proshade_double* valSet2, proshade_unsign length );
     void getLegendreAbscAndWeights                    ( proshade_unsign order, proshade_double* abscissas, proshade_double* weights,
                                                         proshade_unsign noSteps );
+    void computeLegendreAbscAndWeights                ( proshade_unsign order, proshade_double* abscissas, proshade_double* weights,
+                                                        proshade_unsign noSteps );
     void getGLPolyAtZero                              ( proshade_unsign order, proshade_double *polyValue, proshade_double *deriValue );
     void getGLFirstRealRoot                           ( proshade_double polyAtZero, proshade_unsign order, proshade_double *abscAtZero,
                                                         proshade_double *weighAtZero, proshade_unsign taylorSeriesCap );
@@ -325,6 +368,11 @@ namespace ProSHADE_internal_maths
     void gaussLegendreIntegration                     ( proshade_complex* vals, proshade_unsign valsSize, proshade_unsign order,
                                                         proshade_double* abscissas, proshade_double* weights, proshade_double integralOverRange,
                                                         proshade_double maxSphereDists, proshade_double* retReal, proshade_double* retImag );
+    void getGaussLegendreShellWeights                 ( proshade_unsign valsSize, proshade_unsign order, proshade_double* abscissas, proshade_double* weights,
+                                                        proshade_double integralOverRange, proshade_double maxSphereDists, proshade_double* shellWeights );
+    void complexMatrixMultiplyConjugTranspose         ( int rows, int cols, int inner, std::complex<proshade_double>* A, std::complex<proshade_double>* B,
+                                                        std::complex<proshade_double>* C );
+    void realGramMatrixUpper                          ( int noVectors, int vecLength, proshade_double* A, proshade_double* C );
     void complexMatrixSVDSigmasOnly                   ( proshade_complex** mat, int dim, double*& singularValues );
     void realMatrixSVDUandVOnly                       ( proshade_double* mat, int dim, proshade_double* uAndV, bool fail = true );
     void getEulerZYZFromSOFTPosition                  ( proshade_signed band, proshade_signed x, proshade_signed y, proshade_signed z, proshade_double* eulerAlpha,
@@ -404,6 +452,16 @@ namespace ProSHADE_internal_maths
     proshade_double computeFSC                        ( fftw_complex *fCoeffs1, fftw_complex *fCoeffs2, proshade_signed xInds, proshade_signed yInds, proshade_signed zInds,
                                                         proshade_signed noBins, proshade_signed* binIndexing, proshade_double**& binData, proshade_signed*& binCounts, proshade_double*& fscByBin,
                                                         bool averageByBinSize = false );
+    proshade_double computeFSCFromBinSums             ( proshade_signed noBins, proshade_double**& binData, proshade_signed*& binCounts, proshade_double*& fscByBin,
+                                                        bool averageByBinSize = false );
+    bool interpolateRotatedFourierCoeff               ( fftw_complex* coeffs, proshade_double* rotMat, proshade_signed* mins, proshade_signed* maxs, proshade_signed xDim,
+                                                        proshade_signed yDim, proshade_signed zDim, proshade_signed h, proshade_signed k, proshade_signed l,
+                                                        proshade_double* re, proshade_double* im );
+    void getRotatedFourierCoeff                       ( fftw_complex* coeffs, proshade_double* rotMat, proshade_signed* mins, proshade_signed* maxs, proshade_signed xDim,
+                                                        proshade_signed yDim, proshade_signed zDim, proshade_signed arrPos, proshade_double* re, proshade_double* im );
+    proshade_double computeRotatedFSC                 ( fftw_complex* fCoeffs, proshade_double* rotMat, proshade_signed xInds, proshade_signed yInds, proshade_signed zInds,
+                                                        proshade_signed noBins, proshade_signed* binIndexing, proshade_double**& binData, proshade_signed*& binCounts,
+                                                        proshade_double*& fscByBin, proshade_unsign noThreads, bool averageByBinSize = false );
     void computeFSCWeightByBin                        ( proshade_double*& weights1, proshade_double*& weights2, proshade_signed* binIndexing, proshade_double* fscByBin, proshade_signed noBins,
                                                         proshade_signed xDim, proshade_signed yDim, proshade_signed zDim );
     proshade_double computeTheFValue                  ( proshade_complex* fCoeffs, proshade_double* weights, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim );
@@ -414,6 +472,11 @@ namespace ProSHADE_internal_maths
     proshade_double findTopGroupSmooth                ( std::vector< proshade_double* >* CSym, size_t peakPos, proshade_double step, proshade_double sigma, proshade_signed windowSize, proshade_double maxLim = 1.0 );
     proshade_double findTopGroupSmooth                ( std::vector< std::vector< proshade_double > >* CSym, size_t peakPos, proshade_double step, proshade_double sigma, proshade_signed windowSize,
                                                         proshade_double maxLim = 1.0 );
+    void applyFourierFilterToRealMap                  ( proshade_double* inMap, proshade_double* outMap, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim,
+                                                        std::function< std::complex< proshade_double > ( size_t ) > filter, fftw_complex* coeffsScratch = nullptr );
+    std::complex< proshade_double > getHalfSpectrumCoeff ( fftw_complex* halfCoeffs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim, proshade_signed uIt,
+                                                        proshade_signed vIt, proshade_signed wIt );
+    void expandHalfSpectrum                           ( fftw_complex* halfCoeffs, fftw_complex* fullCoeffs, proshade_signed xDim, proshade_signed yDim, proshade_signed zDim );
     void combineFourierForTranslation                 ( fftw_complex* tmpOut1, fftw_complex* tmpOut2, fftw_complex*& resOut, proshade_unsign xD, proshade_unsign yD, proshade_unsign zD );
     void findHighestValueInMap                        ( fftw_complex* resIn, proshade_unsign xD, proshade_unsign yD, proshade_unsign zD, proshade_double* trsX,
                                                         proshade_double* trsY, proshade_double* trsZ, proshade_double* mapPeak );
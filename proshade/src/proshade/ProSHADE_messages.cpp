@@ -72,17 +72,20 @@ void ProSHADE_internal_messages::printProgressMessage ( proshade_signed verbose,
 {
     if ( verbose >= messageLevel )
     {
+        //============================================ Build the whole line first, so that lines from parallel workers do not interleave
+        std::stringstream hlpSS;
         if ( messageLevel > 0 )
         {
-            std::cout << " ";
+            hlpSS << " ";
         }
         
         for ( proshade_signed iter = 0; iter < ( messageLevel + messageShift ); iter++ )
         {
-            std::cout << "... ";
+            hlpSS << "... ";
         }
         
-        std::cout << message << std::endl << std::flush;
+        hlpSS << message << std::endl;
+        std::cout << hlpSS.str() << std::flush;
     }
     
     //================================================ Done
@@ -176,6 +179,25 @@ void ProSHADE_internal_messages::printHelp [[noreturn]] ( void )
     std::cout << "            The verbosity of the run. Accepted values are from 0 to 4 with      " << std::endl;
     std::cout << "            increasing amount of lines being printed.                           " << std::endl;
     std::cout << "                                                                                " << std::endl;
+    std::cout << "    -T or --threads                                 [DEFAULT:            1]     " << std::endl;
+    std::cout << "            The number of threads to be used by the parallelised computations,  " << std::endl;
+    std::cout << "            i.e. the sphere mapping, the spherical harmonics decomposition and  " << std::endl;
+    std::cout << "            the distances computation. Use 0 for all available hardware threads." << std::endl;
+    std::cout << "                                                                                " << std::endl;
+    std::cout << "    -Q or --fftwRigour                              [DEFAULT:            0]     " << std::endl;
+    std::cout << "            The FFTW planning rigour: 0 for ESTIMATE, 1 for MEASURE and 2 for   " << std::endl;
+    std::cout << "            PATIENT. Higher rigour makes planning slower, but transforms faster." << std::endl;
+    std::cout << "                                                                                " << std::endl;
+    std::cout << "    -W or --fftwWisdom                              [DEFAULT:         NONE]     " << std::endl;
+    std::cout << "            File name (including path) from which the FFTW wisdom is loaded     " << std::endl;
+    std::cout << "            and to which it is saved, so that planning is done only once.       " << std::endl;
+    std::cout << "                                                                                " << std::endl;
+    std::cout << "    -U or --invSOFT                                 [DEFAULT:            0]     " << std::endl;
+    std::cout << "            The inverse SO(3) Fourier transform implementation: 0 for the SOFT  " << std::endl;
+    std::cout << "            library naive transform, 1 for the parallel transform (uses the     " << std::endl;
+    std::cout << "            --threads value). The parallel transform is not available on        " << std::endl;
+    std::cout << "            Windows, where the naive transform is always used.                  " << std::endl;
+    std::cout << "                                                                                " << std::endl;
     std::cout << "    -f or --file                                    [DEFAULT:         NONE]     " << std::endl;
     std::cout << "            File name (including path) of the input coordinate or map file.     " << std::endl;
     std::cout << "            For multiple files, use the option multiple times.                  " << std::endl;
@@ -237,6 +259,19 @@ void ProSHADE_internal_messages::printHelp [[noreturn]] ( void )
     std::cout << "            to be detected between structures that appear identical. By         " << std::endl;
     std::cout << "            default negative density is removed, this option keeps it in.       " << std::endl;
     std::cout << "                                                                                " << std::endl;
+    std::cout << "    -X or --mapMemBudget                            [DEFAULT:            0]     " << std::endl;
+    std::cout << "            The maximum size (in MB) of a map read from a map file. Larger      " << std::endl;
+    std::cout << "            maps (after cropping, if --cropOnRead is used) are not read and     " << std::endl;
+    std::cout << "            an error is reported. The map is never cropped because of this      " << std::endl;
+    std::cout << "            limit. This only applies to the input map of uncompressed mode 2    " << std::endl;
+    std::cout << "            map files. Use 0 for no limit.                                      " << std::endl;
+    std::cout << "                                                                                " << std::endl;
+    std::cout << "    -Y or --cropOnRead                              [DEFAULT:        FALSE]     " << std::endl;
+    std::cout << "            Read only the box containing the map density (cell averages above   " << std::endl;
+    std::cout << "            \"maskThreshold\" IQRs from the median) from uncompressed mode 2 map  " << std::endl;
+    std::cout << "            files, without holding the full map in memory. Note that this       " << std::endl;
+    std::cout << "            changes the map box and origin and therefore all the results.       " << std::endl;
+    std::cout << "                                                                                " << std::endl;
     std::cout << "    -K or --oversamplRate                           [DEFAULT:         0.50]     " << std::endl;
     std::cout << "            The rate at which the map resolution will be over-sampled compared  " << std::endl;
     std::cout << "            to the standard sampling of resolution / 2 indices per Angstrom.    " << std::endl;
@@ -402,6 +437,20 @@ void ProSHADE_internal_messages::printHelp [[noreturn]] ( void )
     std::cout << "    --noFRF or -n                                   [DEFAULT:         TRUE]     " << std::endl;
     std::cout << "            Is the computation of the full rotation function descriptor         " << std::endl;
     std::cout << "            required?                                                           " << std::endl;
+    std::cout << "                                                                                " << std::endl;
+    std::cout << "    --FRFCoarse or -V                               [DEFAULT:        FALSE]     " << std::endl;
+    std::cout << "            Should the full rotation function descriptor peak be found on a     " << std::endl;
+    std::cout << "            quarter bandwidth rotation function and refined at full bandwidth?  " << std::endl;
+    std::cout << "            This saves time and memory for large pairwise screens.              " << std::endl;
+    std::cout << "                                                                                " << std::endl;
+    std::cout << "    --allVsAll or -L                                [DEFAULT:        FALSE]     " << std::endl;
+    std::cout << "            Should the distances be computed between all pairs of structures    " << std::endl;
+    std::cout << "            (full distance matrix) instead of the first against all others?     " << std::endl;
+    std::cout << "                                                                                " << std::endl;
+    std::cout << "    --maxInFlight or -N                             [DEFAULT:            0]     " << std::endl;
+    std::cout << "            The maximum number of structures processed (and held in memory)     " << std::endl;
+    std::cout << "            at the same time by the parallel distances computation. Use 0 for   " << std::endl;
+    std::cout << "            the same value as the number of threads.                            " << std::endl;
     std::cout << "                                                    [DEFAUlT:        FALSE]     " << std::endl;
     std::cout << "    -I or --symCentre                                                           " << std::endl;
     std::cout << "            Should symmetry centre be sought using phaseless map symmetry       " << std::endl;
@@ -22,6 +22,12 @@
 //==================================================== ProSHADE
 #include "ProSHADE_misc.hpp"
 
+//==================================================== Local variables
+namespace ProSHADE_internal_misc
+{
+    static thread_local bool insideParallelLoop       = false; //!< Is the current thread a worker of a parallelFor() loop?
+}
+
 /*! \brief Adds the element to the vector.
  
     This function takes a pointer to a vector of strings and a single string element and adds this element to the end of
@@ -491,3 +497,118 @@ void ProSHADE_internal_misc::deepCopyBoundsSigPtrVector ( std::vector < proshade
     return ;
     
 }
+
+/*! \brief This function checks whether the calling thread is a worker of a parallelFor() loop.
+ 
+    This is useful for the computations which are parallelised by other means (e.g. the threaded FFTW), so that these do not
+    over-subscribe the threads when called from within a parallel loop.
+ 
+    \param[out] X True if the calling thread is processing a parallelFor() task, false otherwise.
+ */
+bool ProSHADE_internal_misc::isInsideParallelLoop ( void )
+{
+    //================================================ Done
+    return                                            ( insideParallelLoop );
+    
+}
+
+/*! \brief This function resolves the number of worker threads to be used for a given number of tasks.
+ 
+    \param[in] requested The number of threads requested by the user; 0 means all available hardware threads.
+    \param[in] noTasks The number of independent tasks to be processed.
+    \param[out] X The number of threads to be used, which is at least 1 and at most noTasks.
+ */
+proshade_unsign ProSHADE_internal_misc::getNumberOfThreads ( proshade_unsign requested, proshade_unsign noTasks )
+{
+    //================================================ Resolve automatic value
+    proshade_unsign ret                               = requested;
+    if ( ret == 0 ) { ret = static_cast< proshade_unsign > ( std::thread::hardware_concurrency ( ) ); }
+    
+    //================================================ Clamp
+    if ( ret > noTasks ) { ret = noTasks; }
+    if ( ret < 1 )       { ret = 1; }
+    
+    //================================================ Done
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function runs a set of independent tasks over a pool of worker threads.
+ 
+    This function processes the tasks 0 to noTasks-1 by calling the supplied function with the task index and the index of
+    the worker thread processing it (so that the caller can keep per-worker data). The workers take the next unprocessed task
+    from a shared counter, so that faster workers take over the remaining tasks instead of waiting for slower ones. If any
+    task throws an exception, the remaining tasks are skipped and the first exception is re-thrown in the calling thread once
+    all workers have finished. If only a single thread is to be used, or if this function is called from within a task of another
+    parallel loop, the tasks are processed in order in the calling thread.
+ 
+    \param[in] noTasks The number of tasks to be processed.
+    \param[in] noThreads The requested number of threads; 0 means all available hardware threads.
+    \param[in] taskFn The function processing a single task, taking the task index and the worker index.
+ */
+void ProSHADE_internal_misc::parallelFor ( proshade_unsign noTasks, proshade_unsign noThreads, std::function< void ( proshade_unsign, proshade_unsign ) > taskFn )
+{
+    //================================================ Sanity check
+    if ( noTasks == 0 ) { return ; }
+    
+    //================================================ Resolve the number of workers (nested parallel loops run serially, so that the threads are not over-subscribed)
+    proshade_unsign noWorkers                         = ProSHADE_internal_misc::getNumberOfThreads ( noThreads, noTasks );
+    if ( insideParallelLoop ) { noWorkers = 1; }
+    
+    //================================================ Serial processing
+    if ( noWorkers == 1 )
+    {
+        for ( proshade_unsign iter = 0; iter < noTasks; iter++ ) { taskFn ( iter, 0 ); }
+        return ;
+    }
+    
+    //================================================ FFTW planner needs to be made thread safe before any parallel plan creation
+    static std::once_flag fftwThreadSafeFlag;
+    std::call_once                                    ( fftwThreadSafeFlag, [] ( ) { fftw_make_planner_thread_safe ( ); } );
+    
+    //================================================ Initialise shared state
+    std::atomic< proshade_unsign > nextTask           ( 0 );
+    std::atomic< bool > failed                        ( false );
+    std::exception_ptr firstError                     = nullptr;
+    std::mutex errorMutex;
+    
+    //================================================ Worker definition
+    auto worker = [&] ( proshade_unsign workerIndex )
+    {
+        insideParallelLoop                            = true;
+        while ( !failed.load ( ) )
+        {
+            //======================================== Get next task
+            proshade_unsign taskIndex                 = nextTask.fetch_add ( 1 );
+            if ( taskIndex >= noTasks ) { break; }
+            
+            //======================================== Process it
+            try
+            {
+                taskFn                                ( taskIndex, workerIndex );
+            }
+            catch ( ... )
+            {
+                std::lock_guard< std::mutex > lock    ( errorMutex );
+                if ( firstError == nullptr ) { firstError = std::current_exception ( ); }
+                failed.store                          ( true );
+            }
+        }
+    };
+    
+    //================================================ Start the workers (the calling thread is worker 0)
+    std::vector< std::thread > workers;
+    for ( proshade_unsign wIt = 1; wIt < noWorkers; wIt++ ) { workers.emplace_back ( worker, wIt ); }
+    worker                                            ( 0 );
+    insideParallelLoop                                = false;
+    
+    //================================================ Wait for all workers
+    for ( size_t wIt = 0; wIt < workers.size(); wIt++ ) { workers.at(wIt).join ( ); }
+    
+    //================================================ Re-throw the first failure, if any
+    if ( firstError != nullptr ) { std::rethrow_exception ( firstError ); }
+    
+    //================================================ Done
+    return ;
+    
+}
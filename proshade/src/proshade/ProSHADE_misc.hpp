@@ -63,6 +63,10 @@ namespace ProSHADE_internal_misc
     void deepCopyBoundsSigPtrVector                   ( std::vector < proshade_signed* >* sigPtrVec, proshade_signed* xFrom, proshade_signed* xTo, proshade_signed* yFrom,
                                                         proshade_signed* yTo, proshade_signed* zFrom, proshade_signed* zTo );
     
+    proshade_unsign getNumberOfThreads                ( proshade_unsign requested, proshade_unsign noTasks );
+    bool isInsideParallelLoop                         ( void );
+    void parallelFor                                  ( proshade_unsign noTasks, proshade_unsign noThreads, std::function< void ( proshade_unsign, proshade_unsign ) > taskFn );
+    
 /*! \brief Checks if memory was allocated properly.
 
     This function checks if the memory allocation has suceeded for a given pointer, printing error message if not.
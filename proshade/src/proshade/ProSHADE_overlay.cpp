@@ -334,12 +334,12 @@ void ProSHADE_internal_data::ProSHADE_data::computeTranslationMap ( ProSHADE_int
     for ( proshade_unsign iter = 0; iter < dimMult; iter++ ) { tmpIn2[iter][0] = this->getMapValue            ( iter ); tmpIn2[iter][1] = 0.0; }
     
     //================================================ Calculate Fourier
-    fftw_execute                                      ( forwardFourierObj1 );
-    fftw_execute                                      ( forwardFourierObj2 );
+    fftw_execute_dft                                  ( forwardFourierObj1, tmpIn1, tmpOut1 );
+    fftw_execute_dft                                  ( forwardFourierObj2, tmpIn2, tmpOut2 );
     
     //================================================ Combine Fourier coeffs and invert
     ProSHADE_internal_maths::combineFourierForTranslation ( tmpOut1, tmpOut2, resOut, staticStructure->getXDim(), staticStructure->getYDim(), staticStructure->getZDim() );
-    fftw_execute                                      ( inverseFourierCombo );
+    fftw_execute_dft                                  ( inverseFourierCombo, resOut, this->translationMap );
     
     //================================================ Free memory
     ProSHADE_internal_overlay::freeTranslationFunctionMemory ( tmpIn1, tmpOut1, tmpIn2, tmpOut2, resOut, forwardFourierObj1, forwardFourierObj2, inverseFourierCombo );
@@ -382,10 +382,10 @@ void ProSHADE_internal_overlay::allocateTranslationFunctionMemory ( fftw_complex
     ProSHADE_internal_misc::checkMemoryAllocation     ( resIn,   __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( resOut,  __FILE__, __LINE__, __func__ );
     
-    //================================================ Get Fourier transforms of the maps
-    forwardFourierObj1                                = fftw_plan_dft_3d ( static_cast< int > ( xD ), static_cast< int > ( yD ), static_cast< int > ( zD ), tmpIn1, tmpOut1, FFTW_FORWARD , FFTW_ESTIMATE );
-    forwardFourierObj2                                = fftw_plan_dft_3d ( static_cast< int > ( xD ), static_cast< int > ( yD ), static_cast< int > ( zD ), tmpIn2, tmpOut2, FFTW_FORWARD , FFTW_ESTIMATE );
-    inverseFourierCombo                               = fftw_plan_dft_3d ( static_cast< int > ( xD ), static_cast< int > ( yD ), static_cast< int > ( zD ), resOut, resIn  , FFTW_BACKWARD, FFTW_ESTIMATE );
+    //================================================ Get Fourier transforms plans of the maps from the plans cache
+    forwardFourierObj1                                = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xD ), static_cast< int > ( yD ), static_cast< int > ( zD ), tmpIn1, tmpOut1, FFTW_FORWARD  );
+    forwardFourierObj2                                = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xD ), static_cast< int > ( yD ), static_cast< int > ( zD ), tmpIn2, tmpOut2, FFTW_FORWARD  );
+    inverseFourierCombo                               = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xD ), static_cast< int > ( yD ), static_cast< int > ( zD ), resOut, resIn,   FFTW_BACKWARD );
     
     //================================================ Done
     return ;
@@ -405,10 +405,10 @@ void ProSHADE_internal_overlay::allocateTranslationFunctionMemory ( fftw_complex
  */
 void ProSHADE_internal_overlay::freeTranslationFunctionMemory ( fftw_complex*& tmpIn1, fftw_complex*& tmpOut1, fftw_complex*& tmpIn2, fftw_complex*& tmpOut2, fftw_complex*& resOut, fftw_plan& forwardFourierObj1, fftw_plan& forwardFourierObj2, fftw_plan& inverseFourierCombo )
 {
-    //================================================ Release memory
-    fftw_destroy_plan                                 ( forwardFourierObj1 );
-    fftw_destroy_plan                                 ( forwardFourierObj2 );
-    fftw_destroy_plan                                 ( inverseFourierCombo );
+    //================================================ Release memory (the plans are owned by the plans cache)
+    forwardFourierObj1                                = nullptr;
+    forwardFourierObj2                                = nullptr;
+    inverseFourierCombo                               = nullptr;
     fftw_free                                         ( tmpIn1 );
     fftw_free                                         ( tmpIn2 );
     fftw_free                                         ( tmpOut1 );
@@ -884,27 +884,15 @@ void ProSHADE_internal_data::ProSHADE_data::rotateFourierCoeffs ( proshade_doubl
 {
     //================================================ Initialise local variables
     size_t dimMax                                     = static_cast< size_t > ( xDim * yDim * zDim );
-    proshade_double *rotMat                           = new proshade_double[9];
-    proshade_signed *mins                             = new proshade_signed[3];
-    proshade_signed *maxs                             = new proshade_signed[3];
-    proshade_signed *interpMins                       = new proshade_signed[3];
-    proshade_signed *interpMaxs                       = new proshade_signed[3];
-    proshade_double *interpDiff                       = new proshade_double[3];
+    proshade_double rotMat[9];
+    proshade_signed mins[3], maxs[3];
     rotCoeffs                                         = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * dimMax ) );
     fftw_complex *rotCoeffsHlp                        = reinterpret_cast< fftw_complex* > ( fftw_malloc ( sizeof ( fftw_complex ) * dimMax ) );
-    proshade_double *rotVec;
-    std::complex< proshade_double > c000, c001, c010, c011, c100, c101, c110, c111, c00, c01, c10, c11, c0, c1;
+    proshade_double interpRe, interpIm;
     size_t arrPos                                     = 0;
     size_t arrPos2                                    = 0;
-    bool withinBounds                                 = false;
     
     //================================================ Check memory allocation
-    ProSHADE_internal_misc::checkMemoryAllocation     ( rotMat,        __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( mins,          __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( maxs,          __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( interpMins,    __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( interpMaxs,    __FILE__, __LINE__, __func__ );
-    ProSHADE_internal_misc::checkMemoryAllocation     ( interpDiff,    __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( rotCoeffs,     __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( rotCoeffsHlp,  __FILE__, __LINE__, __func__ );
     
@@ -931,90 +919,14 @@ void ProSHADE_internal_data::ProSHADE_data::rotateFourierCoeffs ( proshade_doubl
         {
             for ( proshade_signed zIt = mins[2]; zIt <= 0; zIt++ )
             {
-                //==================================== Compute new point position
-                rotVec                                = ProSHADE_internal_maths::compute3x3MatrixVectorMultiplication ( rotMat,
-                                                                                                                        static_cast< proshade_double > ( xIt ),
-                                                                                                                        static_cast< proshade_double > ( yIt ),
-                                                                                                                        static_cast< proshade_double > ( zIt ) );
-                
-                //==================================== Find surrounding grid points indices and check for boundaries
-                withinBounds                          = true;
-                for ( size_t posIt = 0; posIt < 3; posIt++ )
-                {
-                    //================================ Determine surrounding points indices in this dimension
-                    interpMins[posIt]                 = static_cast< proshade_signed > ( std::round ( rotVec[posIt] ) );
-                    if ( interpMins[posIt] > rotVec[posIt] ) { interpMaxs[posIt] = interpMins[posIt]; interpMins[posIt]--; }
-                    else                                     { interpMaxs[posIt] = interpMins[posIt] + 1; }
-                    
-                    //================================ Check for boundaries
-                    if ( ( maxs[posIt] < interpMins[posIt] ) || ( interpMins[posIt] < mins[posIt] ) || ( maxs[posIt] < interpMaxs[posIt] ) || ( interpMaxs[posIt] < mins[posIt] ) )
-                    {
-                        withinBounds                  = false;
-                        break;
-                    }
-                    
-                    //================================ Compute the difference from position to min index along this axis
-                    interpDiff[posIt]                 = rotVec[posIt] - static_cast< proshade_double > ( interpMins[posIt] );
-                }
-                if ( !withinBounds ) { continue; }
-                
-                //==================================== Make sure interpolation max's are within bounds
-                for ( size_t posIt = 0; posIt < 3; posIt++ )
-                {
-                    interpMaxs[posIt]                 = std::min ( maxs[posIt], std::max ( mins[posIt], interpMaxs[posIt] ) );
-                }
-                
-                //==================================== Release memory
-                delete[] rotVec;
-                
-                //==================================== Find the surrounding points values from their indices for real and imaginary separately
-                arrPos                                = static_cast< size_t > ( ( interpMins[0] - mins[0] ) + zDim * ( ( interpMins[1] - mins[1] ) + yDim * ( interpMins[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c000                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
-
-                arrPos                                = static_cast< size_t > ( ( interpMins[0] - mins[0] ) + zDim * ( ( interpMins[1] - mins[1] ) + yDim * ( interpMaxs[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c001                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
+                //==================================== Interpolate the coefficients at the rotated position
+                if ( !ProSHADE_internal_maths::interpolateRotatedFourierCoeff ( coeffs, rotMat, mins, maxs, xDim, yDim, zDim, xIt, yIt, zIt, &interpRe, &interpIm ) ) { continue; }
                 
-                arrPos                                = static_cast< size_t > ( ( interpMins[0] - mins[0] ) + zDim * ( ( interpMaxs[1] - mins[1] ) + yDim * ( interpMins[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c010                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
-                
-                arrPos                                = static_cast< size_t > ( ( interpMins[0] - mins[0] ) + zDim * ( ( interpMaxs[1] - mins[1] ) + yDim * ( interpMaxs[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c011                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
-                
-                arrPos                                = static_cast< size_t > ( ( interpMaxs[0] - mins[0] ) + zDim * ( ( interpMins[1] - mins[1] ) + yDim * ( interpMins[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c100                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
-                
-                arrPos                                = static_cast< size_t > ( ( interpMaxs[0] - mins[0] ) + zDim * ( ( interpMins[1] - mins[1] ) + yDim * ( interpMaxs[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c101                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
-                
-                arrPos                                = static_cast< size_t > ( ( interpMaxs[0] - mins[0] ) + zDim * ( ( interpMaxs[1] - mins[1] ) + yDim * ( interpMins[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c110                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
-                
-                arrPos                                = static_cast< size_t > ( ( interpMaxs[0] - mins[0] ) + zDim * ( ( interpMaxs[1] - mins[1] ) + yDim * ( interpMaxs[2] - mins[2] ) ) );
-                if ( arrPos >= dimMax ) { continue; }
-                c111                                  = std::complex< proshade_double > ( coeffs[arrPos][0], coeffs[arrPos][1] );
-                
-                //==================================== Interpolate along x-axis
-                c00                                   = ( c000 * ( 1.0 - static_cast< proshade_double > ( interpDiff[0] ) ) ) + ( c100 * static_cast< proshade_double > ( interpDiff[0] ) );
-                c01                                   = ( c001 * ( 1.0 - static_cast< proshade_double > ( interpDiff[0] ) ) ) + ( c101 * static_cast< proshade_double > ( interpDiff[0] ) );
-                c10                                   = ( c010 * ( 1.0 - static_cast< proshade_double > ( interpDiff[0] ) ) ) + ( c110 * static_cast< proshade_double > ( interpDiff[0] ) );
-                c11                                   = ( c011 * ( 1.0 - static_cast< proshade_double > ( interpDiff[0] ) ) ) + ( c111 * static_cast< proshade_double > ( interpDiff[0] ) );
-                
-                //==================================== Interpolate along y-axis
-                c0                                    = ( c00  * ( 1.0 - static_cast< proshade_double > ( interpDiff[1] ) ) ) + ( c10  * static_cast< proshade_double > ( interpDiff[1] ) );
-                c1                                    = ( c01  * ( 1.0 - static_cast< proshade_double > ( interpDiff[1] ) ) ) + ( c11  * static_cast< proshade_double > ( interpDiff[1] ) );
-                
-                //==================================== Interpolate along z-axis
+                //==================================== Save the interpolated value
                 arrPos                                = static_cast< size_t > ( ( zIt - mins[2] ) + zDim * ( ( yIt - mins[1] ) + yDim * ( xIt - mins[0] ) ) );
                 if ( arrPos >= dimMax ) { continue; }
-                rotCoeffs[arrPos][0]                  = ( ( c0   * ( 1.0 - static_cast< proshade_double > ( interpDiff[2] ) ) ) + ( c1   * static_cast< proshade_double > ( interpDiff[2] ) ) ).real();
-                rotCoeffs[arrPos][1]                  = ( ( c0   * ( 1.0 - static_cast< proshade_double > ( interpDiff[2] ) ) ) + ( c1   * static_cast< proshade_double > ( interpDiff[2] ) ) ).imag();
+                rotCoeffs[arrPos][0]                  = interpRe;
+                rotCoeffs[arrPos][1]                  = interpIm;
                 
                 //==================================== Use Friedel's Law to save time
                 if ( ( mins[0] == xIt ) || ( mins[1] == yIt ) || ( mins[2] == zIt ) ) { continue; }
@@ -1048,12 +960,6 @@ void ProSHADE_internal_data::ProSHADE_data::rotateFourierCoeffs ( proshade_doubl
     for ( size_t iter = 0; iter < static_cast< size_t > ( xDim * yDim * zDim ); iter++ ) { rotCoeffs[iter][0] = rotCoeffsHlp[iter][0]; rotCoeffs[iter][1] = rotCoeffsHlp[iter][1]; }
     
     //================================================ Release memory
-    delete[] rotMat;
-    delete[] mins;
-    delete[] maxs;
-    delete[] interpMaxs;
-    delete[] interpMins;
-    delete[] interpDiff;
     fftw_free                                         ( rotCoeffsHlp );
     
     //================================================ Done
@@ -1175,8 +1081,8 @@ void ProSHADE_internal_data::ProSHADE_data::computeRotatedSH ( )
     \param[in] icoeffs Pointer to be initialised for the imaginary coefficient values.
     \param[in] weights Pointer to be initialised for the transform weight values.
     \param[in] workspace Pointer to be initialised for the computation screatch space.
-    \param[in] idctPlan Pointer reference to the cosine/sine transform plan to be created.
-    \param[in] ifftPlan Pointer reference to the discrete 3D Fourier transform plan to be created.
+    \param[in] idctPlan Pointer reference to the cosine/sine transform plan to be obtained from the plans cache.
+    \param[in] ifftPlan Pointer reference to the discrete 3D Fourier transform plan to be obtained from the plans cache.
  */
 void ProSHADE_internal_overlay::initialiseInverseSHComputation ( proshade_unsign shBand, double*& sigR, double*& sigI, double*& rcoeffs, double*& icoeffs, double*& weights, double*& workspace, fftw_plan& idctPlan, fftw_plan& ifftPlan )
 {
@@ -1197,24 +1103,12 @@ void ProSHADE_internal_overlay::initialiseInverseSHComputation ( proshade_unsign
     ProSHADE_internal_misc::checkMemoryAllocation     ( weights,   __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( workspace, __FILE__, __LINE__, __func__ );
     
-    //================================================ Create the cosine/sine transform plan
-    idctPlan                                          = fftw_plan_r2r_1d ( static_cast< int > ( oneDim ), weights, workspace, FFTW_REDFT01, FFTW_ESTIMATE );
-    
-    //================================================ Set up the discrete Fourier transform
-    int rank, howmany_rank;
-    fftw_iodim dims[1], howmany_dims[1];
+    //================================================ Get the cosine/sine transform plan from the plans cache
+    idctPlan                                          = ProSHADE_internal_fftw::getR2R1DPlan ( static_cast< int > ( oneDim ), weights, workspace, FFTW_REDFT01 );
     
-    rank                                              = 1;
-    dims[0].n                                         = 2 * static_cast< int > ( shBand );
-    dims[0].is                                        = 2 * static_cast< int > ( shBand );
-    dims[0].os                                        = 1;
-    howmany_rank                                      = 1;
-    howmany_dims[0].n                                 = 2 * static_cast< int > ( shBand );
-    howmany_dims[0].is                                = 1;
-    howmany_dims[0].os                                = 2 * static_cast< int > ( shBand );
-    
-    //================================================ Create the discrete Fourier transform
-    ifftPlan                                          = fftw_plan_guru_split_dft ( rank, dims, howmany_rank, howmany_dims, sigR, sigI, rcoeffs, icoeffs, FFTW_ESTIMATE );
+    //================================================ Get the discrete Fourier transform plan from the plans cache
+    ifftPlan                                          = ProSHADE_internal_fftw::getSplitDFTPlan ( static_cast< int > ( oneDim ), static_cast< int > ( oneDim ), static_cast< int > ( oneDim ), 1, 1, static_cast< int > ( oneDim ),
+                                                                                                  sigR, sigI, rcoeffs, icoeffs );
     
     //================================================ Done
     return ;
@@ -1272,10 +1166,6 @@ void ProSHADE_internal_data::ProSHADE_data::invertSHCoefficients ( )
              this->spheres[shell]->setRotatedMappedData ( iter, sigR[iter] );
          }
          
-         //=========================================== Release the plans
-         fftw_destroy_plan ( idctPlan );
-         fftw_destroy_plan ( ifftPlan );
-         
          //=========================================== Release the memory
          delete[] sigR;
          delete[] rcoeffs;
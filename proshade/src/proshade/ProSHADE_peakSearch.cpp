@@ -23,129 +23,271 @@
 //==================================================== ProSHADE
 #include "ProSHADE_peakSearch.hpp"
 
-/*! \brief This function finds all indices with higher value then all neighbours.
+/*! \brief This function computes the running maximum over a window of a single line of values in place.
  
-    This function finds all map indices with higher height than all their neighbours (the size of neighbours in terms of surrounding points can be changed)
-    and saves these as well as the neighbours into the output vector of double*. It also keeps track of the non-peak values and saves their median height
-    and its IQR, so that the output vector could be cleared from these small (background) values.
+    This function computes, for each position i of the line, the maximum of the values at positions i - halfWindow to i + halfWindow
+    (truncated to the line) using the van Herk / Gil-Werman algorithm. The line is padded by halfWindow lowest values on both sides,
+    split into blocks of the window size and the prefix and suffix maxima within the blocks are computed; the maximum over any window
+    is then the larger of the suffix maximum at its start and the prefix maximum at its end. Thus, the cost is independent of the window size.
+    Only the suffix maxima are stored; the prefix maximum is kept running ahead of the output position, so that it only reads values which
+    were not yet over-written and the line can be filtered where it is (including strided lines of a 3D map).
  
-    \param[in] map Pointer to 1D array holding the 3D map value in which the peaks are to be found. Map must be cube!
-    \param[in] dim The size of one dimension of the map (assuming cube map).
-    \param[in] peakSize The number of neighbouring points in single direction which should be considered as neighbours.
-    \param[in] medianIQR Pointer to double[2] array where median and IQR of non-peak values will be saved.
-    \param[out] X Vector of pointers to double numbers, first is the 'peak' (x,y,z and height) and then all neighbours follow in sets of 4 numbers.
+    \param[in] line Pointer to the first line value; the values will be over-written by the running maxima.
+    \param[in] stride The distance between two consecutive line values in the array.
+    \param[in] length The number of values in the line.
+    \param[in] halfWindow The number of neighbouring values in each direction which are in the window.
+    \param[in] suffixMax Workspace of at least length + 2 * halfWindow values.
  */
-std::vector< proshade_double* > ProSHADE_internal_peakSearch::findAllPointsAboveNeighbours ( proshade_complex* map, proshade_unsign dim, proshade_signed peakSize, proshade_double* medianIQR )
+void ProSHADE_internal_peakSearch::runningMaxFilter1D ( proshade_double* line, size_t stride, proshade_signed length, proshade_signed halfWindow, proshade_double* suffixMax )
 {
+    //================================================ Nothing to do
+    if ( ( halfWindow < 1 ) || ( length < 2 ) ) { return ; }
+    
     //================================================ Initialise local variables
-    std::vector< proshade_double* > ret;
-    std::vector< proshade_double > nonPeakVals;
-    proshade_double* retHlp                           = nullptr;
-    proshade_double pointHeight                       = 0.0;
-    proshade_signed x, y, z, peakX, peakY, peakZ, newIter, ptrIter;
-    proshade_signed xDim                              = static_cast< proshade_signed > ( std::pow ( dim, 2 ) );
-    proshade_signed yDim                              = static_cast< proshade_signed > ( dim );
-    bool breakPeak;
+    proshade_signed window                            = ( 2 * halfWindow ) + 1;
+    proshade_signed padLength                         = length + ( 2 * halfWindow );
+    proshade_double lowest                            = -std::numeric_limits< proshade_double >::infinity ( );
+    proshade_double prefixMax                         = lowest;
+    proshade_signed linePos;
+    proshade_double val;
+    
+    //================================================ Block suffix maxima (right to left)
+    for ( proshade_signed iter = padLength - 1; iter >= 0; iter-- )
+    {
+        linePos                                       = iter - halfWindow;
+        val                                           = ( ( linePos >= 0 ) && ( linePos < length ) ) ? line[static_cast< size_t > ( linePos ) * stride] : lowest;
+        if ( ( iter == ( padLength - 1 ) ) || ( ( ( iter + 1 ) % window ) == 0 ) ) { suffixMax[iter] = val; }
+        else                                                                       { suffixMax[iter] = std::max ( suffixMax[iter+1], val ); }
+    }
     
-    //================================================ Check all points
-    for ( proshade_signed iter = 0; iter < static_cast< proshade_signed > ( pow( static_cast<proshade_unsign> ( dim ), 3 ) ); iter++ )
+    //================================================ Block prefix maxima (left to right) up to the end of the first window
+    for ( proshade_signed iter = 0; iter < ( window - 1 ); iter++ )
     {
-        //============================================ Find point height
-        pointHeight                                   = pow( map[iter][0], 2.0 ) + pow( map[iter][1], 2.0 );
-        
-        //============================================ Find the x, y and z
-        x                                             = static_cast< proshade_signed > ( std::floor ( iter / xDim ) );
-        y                                             = static_cast< proshade_signed > ( std::floor ( ( iter - x * xDim ) / yDim ) );
-        z                                             = static_cast< proshade_signed > ( iter - x * xDim - y * yDim );
-        
-        //==================================== Initialise the output pointer
-        if ( retHlp == nullptr )
-        {
-            retHlp                                    = new proshade_double[static_cast<proshade_unsign>( pow( ((peakSize*2)+1), 3) * 4 )];
-            ProSHADE_internal_misc::checkMemoryAllocation ( retHlp, __FILE__, __LINE__, __func__ );
-        }
+        linePos                                       = iter - halfWindow;
+        val                                           = ( ( linePos >= 0 ) && ( linePos < length ) ) ? line[static_cast< size_t > ( linePos ) * stride] : lowest;
+        prefixMax                                     = ( ( iter % window ) == 0 ) ? val : std::max ( prefixMax, val );
+    }
+    
+    //================================================ Window [i - halfWindow, i + halfWindow] is [i, i + window - 1] in the padded line; its end reads line position i + halfWindow, which was not over-written yet
+    for ( proshade_signed iter = 0; iter < length; iter++ )
+    {
+        linePos                                       = iter + halfWindow;
+        val                                           = ( linePos < length ) ? line[static_cast< size_t > ( linePos ) * stride] : lowest;
+        prefixMax                                     = ( ( ( iter + window - 1 ) % window ) == 0 ) ? val : std::max ( prefixMax, val );
+        line[static_cast< size_t > ( iter ) * stride] = std::max ( suffixMax[iter], prefixMax );
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function computes the maximum over the neighbourhood of each point of a cube map.
+ 
+    This function computes for each map point the maximum value over the box of ( 2 * peakSize + 1 )^3 points centred on it (truncated
+    at the map boundaries) by three separable running maximum passes along the z, y and x dimensions. Each pass filters the lines of the
+    output map in place, processing the map in slabs in parallel, so that each worker only needs a single line of workspace.
+ 
+    \param[in] heights Pointer to the cube map values.
+    \param[in] dim The size of one dimension of the map.
+    \param[in] peakSize The number of neighbouring points in single direction which should be considered as neighbours.
+    \param[in] noThreads The number of threads to be used; 0 means all available.
+    \param[in] neighMax Pointer to dim^3 values to which the neighbourhood maxima will be saved.
+ */
+void ProSHADE_internal_peakSearch::computeNeighbourhoodMaxima ( proshade_double* heights, proshade_unsign dim, proshade_signed peakSize, proshade_unsign noThreads, proshade_double* neighMax )
+{
+    //================================================ Initialise local variables
+    size_t dimS                                       = static_cast< size_t > ( dim );
+    proshade_signed halfWindow                        = std::min ( peakSize, static_cast< proshade_signed > ( dim ) );
+    size_t padLength                                  = dimS + ( 2 * static_cast< size_t > ( std::max ( halfWindow, static_cast< proshade_signed > ( 0 ) ) ) );
+    proshade_unsign noWorkers                         = ProSHADE_internal_misc::getNumberOfThreads ( noThreads, dim );
+    std::vector< std::vector< proshade_double > > workspaces ( noWorkers, std::vector< proshade_double > ( padLength ) );
+    
+    //================================================ Copy the values
+    std::copy                                         ( heights, heights + ( dimS * dimS * dimS ), neighMax );
+    
+    //================================================ Filter along z, y and x (the line, slab and in-slab line strides for each pass)
+    const size_t lineStrides[3]                       = { 1,           dimS,        dimS * dimS };
+    const size_t outerStrides[3]                      = { dimS * dimS, dimS * dimS, dimS        };
+    const size_t innerStrides[3]                      = { dimS,        1,           1           };
+    for ( size_t pass = 0; pass < 3; pass++ )
+    {
+        size_t lineStride                             = lineStrides[pass];
+        size_t outerStride                            = outerStrides[pass];
+        size_t innerStride                            = innerStrides[pass];
         
-        //============================================ Get the X surrounding values and check for all being lower than point in question
-        breakPeak                                     = false;
-        ptrIter                                       = 4;
-        for ( proshade_signed xCh = -peakSize; xCh <= +peakSize; xCh++ )
+        ProSHADE_internal_misc::parallelFor           ( dim, noThreads, [&] ( proshade_unsign outerIt, proshade_unsign workerIt )
         {
-            if ( breakPeak ) { break; }
-            for ( proshade_signed yCh = -peakSize; yCh <= +peakSize; yCh++ )
+            proshade_double* suffixMax                = &workspaces.at(workerIt)[0];
+            for ( size_t innerIt = 0; innerIt < dimS; innerIt++ )
             {
-                if ( breakPeak ) { break; }
-                for ( proshade_signed zCh = -peakSize; zCh <= +peakSize; zCh++ )
-                {
-                    if ( breakPeak ) { break; }
-                    if ( ( xCh == 0 ) && ( yCh == 0 ) && ( zCh == 0 ) ) { continue; }
-                    
-                    //================================ Find the nieghbout peak indices (with periodicity)
-                    peakX                             = x + xCh; if ( peakX >= yDim ) { peakX = yDim - 1; }; if ( peakX < 0 ) { peakX = 0; }
-                    peakY                             = y + yCh; if ( peakY >= yDim ) { peakY = yDim - 1; }; if ( peakY < 0 ) { peakY = 0; }
-                    peakZ                             = z + zCh; if ( peakZ >= yDim ) { peakZ = yDim - 1; }; if ( peakZ < 0 ) { peakZ = 0; }
-                    newIter                           = peakX * xDim + peakY * yDim + peakZ;
-                    
-                    //================================ If neighbour has higher value than index in question, break out
-                    if ( ( pow ( map[newIter][0], 2.0 ) + pow( map[newIter][1], 2.0 ) ) > pointHeight ) { breakPeak = true; break; }
-                    
-                    //================================ Save neighbour values for optimisation of peaks later
-                    retHlp[ptrIter]                   = static_cast<proshade_double> ( peakX );
-                    retHlp[ptrIter+1]                 = static_cast<proshade_double> ( peakY );
-                    retHlp[ptrIter+2]                 = static_cast<proshade_double> ( peakZ );
-                    retHlp[ptrIter+3]                 = pow ( map[newIter][0], 2.0 ) + pow( map[newIter][1], 2.0 );
-                    ptrIter                          += 4;
-                }
+                runningMaxFilter1D                    ( neighMax + ( outerIt * outerStride ) + ( innerIt * innerStride ), lineStride, static_cast< proshade_signed > ( dim ), halfWindow, suffixMax );
             }
-        }
-        if ( breakPeak ) { ProSHADE_internal_misc::addToDoubleVector ( &nonPeakVals, pointHeight ); continue; }
+        } );
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function finds all map points with value higher than or equal to all their neighbours.
+ 
+    This function computes the squared magnitudes of the map values and their neighbourhood maxima (see computeNeighbourhoodMaxima()),
+    so that a point is a local maximum if its value is equal to the maximum of its neighbourhood. All the remaining (non-peak) values
+    are used to compute the median and IQR of the background by selection; these are collected in the neighbourhood maxima array, so
+    that only the heights and this one array of map size are held.
+ 
+    \param[in] map Pointer to 1D array holding the 3D map value in which the peaks are to be found. Map must be cube!
+    \param[in] dim The size of one dimension of the map (assuming cube map).
+    \param[in] peakSize The number of neighbouring points in single direction which should be considered as neighbours.
+    \param[in] noThreads The number of threads to be used; 0 means all available.
+    \param[in] heights Pointer to a vector which will be filled with the squared magnitudes of the map values.
+    \param[in] medianIQR Pointer to double[2] array where median and IQR of non-peak values will be saved.
+    \param[out] X Vector of all the local maxima map indices and heights.
+ */
+std::vector< ProSHADE_internal_peakSearch::ProSHADE_mapPeak > ProSHADE_internal_peakSearch::findAllLocalMaxima ( proshade_complex* map, proshade_unsign dim, proshade_signed peakSize, proshade_unsign noThreads, std::vector< proshade_double >* heights, proshade_double* medianIQR )
+{
+    //================================================ Initialise local variables
+    std::vector< ProSHADE_mapPeak > ret;
+    size_t dimS                                       = static_cast< size_t > ( dim );
+    size_t mapSize                                    = dimS * dimS * dimS;
+    
+    //================================================ Compute the point heights
+    heights->resize                                   ( mapSize );
+    for ( size_t iter = 0; iter < mapSize; iter++ ) { heights->at(iter) = ( map[iter][0] * map[iter][0] ) + ( map[iter][1] * map[iter][1] ); }
+    
+    //================================================ Compute the neighbourhood maxima
+    std::vector< proshade_double > neighMax           ( mapSize );
+    computeNeighbourhoodMaxima                        ( heights->data(), dim, peakSize, noThreads, neighMax.data() );
+    
+    //================================================ Split into peaks and background (the background values are packed into the front of the neighbourhood maxima, which are not needed behind the current point any more)
+    size_t noNonPeakVals                              = 0;
+    for ( size_t iter = 0; iter < mapSize; iter++ )
+    {
+        if ( heights->at(iter) < neighMax[iter] ) { neighMax[noNonPeakVals] = heights->at(iter); noNonPeakVals++; continue; }
         
-        //============================================ If passing, save for returning
-        retHlp[0]                                     = static_cast< proshade_double > ( x );
-        retHlp[1]                                     = static_cast< proshade_double > ( y );
-        retHlp[2]                                     = static_cast< proshade_double > ( z );
-        retHlp[3]                                     = pointHeight;
-        ProSHADE_internal_misc::addToDblPtrVector ( &ret, retHlp );
-        retHlp                                        = nullptr;
+        ProSHADE_mapPeak peak;
+        peak.x                                        = static_cast< proshade_signed > ( iter / ( dimS * dimS ) );
+        peak.y                                        = static_cast< proshade_signed > ( ( iter / dimS ) % dimS );
+        peak.z                                        = static_cast< proshade_signed > ( iter % dimS );
+        peak.height                                   = heights->at(iter);
+        ret.emplace_back                              ( peak );
     }
     
     //================================================ Save non-peak median and IQR
-    ProSHADE_internal_maths::vectorMedianAndIQR       ( &nonPeakVals, medianIQR );
-    
-    //================================================ Release memory if need be
-    if ( retHlp != nullptr ) { delete[] retHlp; }
+    neighMax.resize                                   ( noNonPeakVals );
+    ProSHADE_internal_maths::vectorMedianAndIQRSelection ( &neighMax, medianIQR );
     
     //================================================ Done
     return                                            ( ret );
     
 }
 
-/*! \brief This function clears the 'higher than neighbour' vector from background values.
+/*! \brief This function removes the background local maxima.
  
-    This function simply takes all the 'higher than all neighbours' indices vector and a threshold defining values and proceeds to
-    compute the threshold for calling the indice a peak. Then, it applies this threshold to the vector, keeping only the indices
-    which have higher value than the threshold.
+    This function computes the threshold for calling a local maximum a peak from the background median and IQR and removes all
+    local maxima with lower height.
  
-    \param[in] pointVec Vector of double pointers as returned by findAllPointsAboveNeighbours().
+    \param[in] peaks Pointer to the vector of local maxima as returned by findAllLocalMaxima().
     \param[in] medianIQR Array of two numbers, the median and IQR for which should be used to remove 'background' points in the vector.
     \param[in] noIQRs The number of IQRs from median to be used to create the cut-off threshold.
  */
-void ProSHADE_internal_peakSearch::pointsAboveNeighboursRemoveSmallHeight ( std::vector< proshade_double* >* pointVec, proshade_double* medianIQR, proshade_double noIQRs )
+void ProSHADE_internal_peakSearch::removeSmallLocalMaxima ( std::vector< ProSHADE_mapPeak >* peaks, proshade_double* medianIQR, proshade_double noIQRs )
 {
     //================================================ Determine the threshold
     proshade_double backgroundThreshold               = std::min ( std::max ( medianIQR[0] + ( medianIQR[1] * noIQRs ), 0.05 ), 0.5 );
     
-    //================================================ Check for passing the threshold
-    for ( proshade_signed iter = static_cast<proshade_signed> ( pointVec->size()-1 ); iter >= 0  ; iter-- )
+    //================================================ Keep only the passing peaks
+    peaks->erase                                      ( std::remove_if ( peaks->begin(), peaks->end(), [backgroundThreshold] ( const ProSHADE_mapPeak& peak ) { return ( peak.height <= backgroundThreshold ); } ), peaks->end() );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function optimises the local maxima positions using the values of their neighbours.
+ 
+    This function does the same optimisation as optimisePeakPositions(), i.e. it computes the neighbour values weighted average rotation
+    matrix, subjects it to SVD and converts the U * V^T product to Euler angles, but reads the neighbour values directly from the map
+    heights instead of from the per-peak arrays. The peaks are processed in parallel.
+ 
+    \param[in] heights Pointer to the squared magnitudes of the map values.
+    \param[in] dim The size of one dimension of the map.
+    \param[in] peaks The local maxima to be optimised.
+    \param[in] peakSize The number of neighbouring points in single direction which should be considered as neighbours.
+    \param[in] noThreads The number of threads to be used; 0 means all available.
+    \param[out] X Vector of the optimised peak Euler angles and heights.
+ */
+std::vector< ProSHADE_internal_peakSearch::ProSHADE_rotationPeak > ProSHADE_internal_peakSearch::optimiseLocalMaximaPositions ( proshade_double* heights, proshade_unsign dim, std::vector< ProSHADE_mapPeak >* peaks, proshade_signed peakSize, proshade_unsign noThreads )
+{
+    //================================================ Initialise local variables
+    std::vector< ProSHADE_rotationPeak > ret          ( peaks->size() );
+    proshade_signed dimS                              = static_cast< proshade_signed > ( dim );
+    proshade_signed band                              = dimS / 2;
+    
+    //================================================ For each peak
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( peaks->size() ), noThreads, [&] ( proshade_unsign pkIt, proshade_unsign )
     {
-        if ( pointVec->at( static_cast< size_t > ( iter ) )[3] <= backgroundThreshold )
+        //============================================ Initialise local variables
+        const ProSHADE_mapPeak& peak                  = peaks->at(pkIt);
+        proshade_double avgMat[9], hlpMat[9], uAndV[18];
+        proshade_double eulA, eulB, eulG, pointHeight;
+        proshade_double matWeight                     = 0.0;
+        proshade_signed peakX, peakY, peakZ;
+        for ( proshade_unsign i = 0; i < 9; i++ ) { avgMat[i] = 0.0; }
+        
+        //============================================ For the point itself and each neighbour (with the same boundary handling as the neighbourhood maxima)
+        for ( proshade_signed ptIt = -1; ptIt < static_cast< proshade_signed > ( std::pow ( ( peakSize * 2 ) + 1, 3 ) ); ptIt++ )
         {
-            delete[] pointVec->at( static_cast< size_t > ( iter ) );
-            pointVec->erase                           ( pointVec->begin() + iter );
+            if ( ptIt < 0 ) { peakX = peak.x; peakY = peak.y; peakZ = peak.z; }
+            else
+            {
+                proshade_signed xCh                   = ( ptIt / ( ( ( peakSize * 2 ) + 1 ) * ( ( peakSize * 2 ) + 1 ) ) ) - peakSize;
+                proshade_signed yCh                   = ( ( ptIt / ( ( peakSize * 2 ) + 1 ) ) % ( ( peakSize * 2 ) + 1 ) ) - peakSize;
+                proshade_signed zCh                   = ( ptIt % ( ( peakSize * 2 ) + 1 ) ) - peakSize;
+                if ( ( xCh == 0 ) && ( yCh == 0 ) && ( zCh == 0 ) ) { continue; }
+                peakX                                 = std::min ( std::max ( peak.x + xCh, static_cast< proshade_signed > ( 0 ) ), dimS - 1 );
+                peakY                                 = std::min ( std::max ( peak.y + yCh, static_cast< proshade_signed > ( 0 ) ), dimS - 1 );
+                peakZ                                 = std::min ( std::max ( peak.z + zCh, static_cast< proshade_signed > ( 0 ) ), dimS - 1 );
+            }
+            pointHeight                               = heights[peakZ + dimS * ( peakY + dimS * peakX )];
+            
+            //======================================== Add the weighted rotation matrix to the sum
+            ProSHADE_internal_maths::getEulerZYZFromSOFTPosition ( band, peakX, peakY, peakZ, &eulA, &eulB, &eulG );
+            ProSHADE_internal_maths::getRotationMatrixFromEulerZYZAngles ( eulA, eulB, eulG, hlpMat );
+            for ( proshade_unsign i = 0; i < 9; i++ ) { avgMat[i] += hlpMat[i] * pointHeight; }
+            matWeight                                += pointHeight;
         }
-    }
+        
+        //============================================ Normalise weighted sum matrix by sum of weights
+        for ( proshade_unsign i = 0; i < 9; i++ ) { avgMat[i] /= matWeight; }
+        
+        //============================================ Decompose the average matrix using SVD
+        ProSHADE_internal_maths::realMatrixSVDUandVOnly ( avgMat, 3, uAndV, false );
+        const FloatingPoint< proshade_double > lhs ( uAndV[0] ), rhs ( -777.7 );
+        if ( lhs.AlmostEquals ( rhs ) )
+        {
+            //======================================== SVD Failed. Just use the central value
+            ProSHADE_internal_maths::getEulerZYZFromSOFTPosition ( band, peak.x, peak.y, peak.z, &eulA, &eulB, &eulG );
+        }
+        else
+        {
+            //======================================== SVD Succeeded. Compute U * V^T and convert to Euler
+            for ( proshade_unsign i = 0; i < 9; i++ ) { avgMat[i] = 0.0; }
+            ProSHADE_internal_maths::multiplyTwoSquareMatrices ( uAndV, uAndV+9, avgMat, 3 );
+            ProSHADE_internal_maths::getEulerZYZFromRotMatrix ( avgMat, &eulA, &eulB, &eulG );
+        }
+        
+        //============================================ Save
+        ret.at(pkIt).eulA                             = eulA;
+        ret.at(pkIt).eulB                             = eulB;
+        ret.at(pkIt).eulG                             = eulG;
+        ret.at(pkIt).height                           = peak.height;
+    } );
     
     //================================================ Done
-    return ;
+    return                                            ( ret );
     
 }
 
@@ -304,34 +446,32 @@ void ProSHADE_internal_peakSearch::optimisePeakPositions ( std::vector< proshade
     it firstly locates all map points which have higher value than all their neighbours in all directions. It also computes the median
     and IQR of all non-higher points and it then uses the median + x * IQR threshold (x is the noIQRs parameter) to remove all map points
     with value under this thereshold. Finally, it optimises all the remaining values using the weighted average of all the neighbour
-    points. The final output then is a vector with a single entry for each passing peak; this array has 4 values, the alpha, beta and gamma
-    Euler angle values and the maximum peak heigh.
+    points. The final output then is a vector with a single entry for each passing peak, holding the alpha, beta and gamma Euler angle
+    values and the maximum peak heigh.
  
     \param[in] map Pointer to 1D array holding the 3D map value in which the peaks are to be found. Map must be cube!
     \param[in] dim The size of one dimension of the map (assuming cube map).
     \param[in] peakSize The number of neighbouring points in single direction which should be considered as neighbours.
     \param[in] noIQRs The number of IQRs from the median to determine minimal peak height.
-    \param[out] X Vector of located peaks with pointers to arrays of 4 values: alpha, beta, gamma and peak heighht.
+    \param[in] noThreads The number of threads to be used; 0 means all available.
+    \param[out] X Vector of located peaks with their Euler angles and heights.
  */
-std::vector< proshade_double* > ProSHADE_internal_peakSearch::getAllPeaksNaive ( proshade_complex* map, proshade_unsign dim, proshade_signed peakSize, proshade_double noIQRs )
+std::vector< ProSHADE_internal_peakSearch::ProSHADE_rotationPeak > ProSHADE_internal_peakSearch::getAllPeaksNaive ( proshade_complex* map, proshade_unsign dim, proshade_signed peakSize, proshade_double noIQRs, proshade_unsign noThreads )
 {
     //================================================ Find all indices with higher value than all neighbours
-    std::vector< proshade_double* > allHigherIndices;
-    proshade_double* nonPeakMedianIQR                 = new  proshade_double[2];
-    ProSHADE_internal_misc::checkMemoryAllocation     ( nonPeakMedianIQR, __FILE__, __LINE__, __func__ );
-    allHigherIndices                                  = findAllPointsAboveNeighbours ( map, dim, peakSize, nonPeakMedianIQR );
+    std::vector< proshade_double > heights;
+    proshade_double nonPeakMedianIQR[2];
+    proshade_double* medianIQRPtr                     = nonPeakMedianIQR;
+    std::vector< ProSHADE_mapPeak > localMaxima       = findAllLocalMaxima ( map, dim, peakSize, noThreads, &heights, medianIQRPtr );
     
     //================================================ Remove all indices with too small height
-    pointsAboveNeighboursRemoveSmallHeight            ( &allHigherIndices, nonPeakMedianIQR, noIQRs );
+    removeSmallLocalMaxima                            ( &localMaxima, medianIQRPtr, noIQRs );
     
     //================================================ Optimise the peaks using the neighbour values
-    optimisePeakPositions                             ( &allHigherIndices, peakSize, dim/2 );
-    
-    //================================================ Release memory
-    delete[]  nonPeakMedianIQR;
+    std::vector< ProSHADE_rotationPeak > ret          = optimiseLocalMaximaPositions ( heights.data(), dim, &localMaxima, peakSize, noThreads );
     
     //================================================ Done
-    return                                            ( allHigherIndices );
+    return                                            ( ret );
     
 }
 
@@ -355,7 +495,7 @@ void ProSHADE_internal_peakSearch::getBestPeakEulerAngsNaive ( proshade_complex*
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Looking for Euler angles of highest peak.", settings->messageShift );
     
     //================================================ Get all peaks
-    std::vector< proshade_double* > allPeaks          = getAllPeaksNaive ( map, dim, static_cast< proshade_signed > ( settings->peakNeighbours ), settings->noIQRsFromMedianNaivePeak );
+    std::vector< ProSHADE_rotationPeak > allPeaks     = getAllPeaksNaive ( map, dim, static_cast< proshade_signed > ( settings->peakNeighbours ), settings->noIQRsFromMedianNaivePeak, settings->noThreads );
     
     //================================================ Report progress
     std::stringstream hlpSSP;
@@ -376,19 +516,13 @@ void ProSHADE_internal_peakSearch::getBestPeakEulerAngsNaive ( proshade_complex*
     proshade_unsign highestPeakIndex                  = 0;
     for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign>( allPeaks.size() ); iter++ )
     {
-        if ( allPeaks.at(iter)[3] > highestPeak ) { highestPeak = allPeaks.at(iter)[3]; highestPeakIndex = iter; }
+        if ( allPeaks.at(iter).height > highestPeak ) { highestPeak = allPeaks.at(iter).height; highestPeakIndex = iter; }
     }
 
     //================================================ Get Euler ZYZ for the highest peak
-   *eulA                                              = allPeaks.at(highestPeakIndex)[0];
-   *eulB                                              = allPeaks.at(highestPeakIndex)[1];
-   *eulG                                              = allPeaks.at(highestPeakIndex)[2];
-    
-    //================================================ Release memory
-    for ( proshade_unsign iter = 0; iter < static_cast<proshade_unsign> ( allPeaks.size() ); iter++ )
-    {
-        delete[] allPeaks.at(iter);
-    }
+   *eulA                                              = allPeaks.at(highestPeakIndex).eulA;
+   *eulB                                              = allPeaks.at(highestPeakIndex).eulB;
+   *eulG                                              = allPeaks.at(highestPeakIndex).eulG;
     
     //================================================ Report progress
     std::stringstream hlpSS;
@@ -503,7 +637,7 @@ void ProSHADE_internal_peakSearch::getSmoothedZScore1D ( proshade_unsign dim, pr
     //================================================ Re-set the run
     for ( proshade_unsign i = 0; i < dim; i++ ) { signals[i] = 0; avgFilter[i] = 0.0; stdFilter[i] = 0.0; filteredY[i] = 0.0; }
     for ( proshade_unsign i = 0; i < smoothingLag; i++ ) { subVec[i] = scoreOverVals[i-smoothingLag+dim]; }
-    ProSHADE_internal_maths::arrayMedianAndIQR ( subVec, smoothingLag, medianIQR );
+    ProSHADE_internal_maths::arrayMedianAndIQRSelection ( subVec, smoothingLag, medianIQR );
     avgFilter[0]                                      = medianIQR[0];
     stdFilter[0]                                      = medianIQR[1];
     
@@ -544,7 +678,7 @@ void ProSHADE_internal_peakSearch::getSmoothedZScore1D ( proshade_unsign dim, pr
                 subVec[subIt]                         = filteredY[( i + static_cast< proshade_unsign > ( subIt ) - smoothingLag + 1 )];
             }
         }
-        ProSHADE_internal_maths::arrayMedianAndIQR    ( subVec, smoothingLag, medianIQR );
+        ProSHADE_internal_maths::arrayMedianAndIQRSelection ( subVec, smoothingLag, medianIQR );
         avgFilter[i+1]                                = medianIQR[0];
         stdFilter[i+1]                                = medianIQR[1];
     }
@@ -35,16 +35,44 @@
  */
 namespace ProSHADE_internal_peakSearch
 {
-    std::vector< proshade_double* > findAllPointsAboveNeighbours ( proshade_complex* map, proshade_unsign dim,
-                                                                   proshade_signed peakSize, proshade_double* medianIQR );
-    void pointsAboveNeighboursRemoveSmallHeight       ( std::vector< proshade_double* >* pointVec, proshade_double* medianIQR,
-                                                        proshade_double noIQRs );
+/*! \struct ProSHADE_mapPeak
+    \brief The compact record of a local maximum of a cube map.
+ */
+    struct ProSHADE_mapPeak
+    {
+        proshade_signed x;                            //!< The x-axis index of the local maximum.
+        proshade_signed y;                            //!< The y-axis index of the local maximum.
+        proshade_signed z;                            //!< The z-axis index of the local maximum.
+        proshade_double height;                       //!< The map value squared magnitude at the local maximum.
+    };
+    
+/*! \struct ProSHADE_rotationPeak
+    \brief The compact record of an optimised rotation function peak.
+ */
+    struct ProSHADE_rotationPeak
+    {
+        proshade_double eulA;                         //!< The Euler ZYZ convention alpha angle of the peak.
+        proshade_double eulB;                         //!< The Euler ZYZ convention beta angle of the peak.
+        proshade_double eulG;                         //!< The Euler ZYZ convention gamma angle of the peak.
+        proshade_double height;                       //!< The peak height.
+    };
+    
+    void runningMaxFilter1D                           ( proshade_double* line, size_t stride, proshade_signed length, proshade_signed halfWindow,
+                                                        proshade_double* suffixMax );
+    void computeNeighbourhoodMaxima                   ( proshade_double* heights, proshade_unsign dim, proshade_signed peakSize, proshade_unsign noThreads,
+                                                        proshade_double* neighMax );
+    std::vector< ProSHADE_mapPeak > findAllLocalMaxima ( proshade_complex* map, proshade_unsign dim, proshade_signed peakSize, proshade_unsign noThreads,
+                                                        std::vector< proshade_double >* heights, proshade_double* medianIQR );
+    void removeSmallLocalMaxima                       ( std::vector< ProSHADE_mapPeak >* peaks, proshade_double* medianIQR, proshade_double noIQRs );
+    std::vector< ProSHADE_rotationPeak > optimiseLocalMaximaPositions ( proshade_double* heights, proshade_unsign dim, std::vector< ProSHADE_mapPeak >* peaks,
+                                                        proshade_signed peakSize, proshade_unsign noThreads );
     void allocatePeakOptimisationMemory               ( proshade_double*& avgMat, proshade_double*& hlpMap, proshade_double*& eA,
                                                         proshade_double*& eB, proshade_double*& eG, proshade_double*& uAV );
     void releasePeakOptimisationMemory                ( proshade_double*& avgMat, proshade_double*& hlpMap, proshade_double*& eA,
                                                        proshade_double*& eB, proshade_double*& eG, proshade_double*& uAV );
     void optimisePeakPositions                        ( std::vector< proshade_double* >* pointVec, proshade_signed peakSize, proshade_signed band );
-    std::vector< proshade_double* > getAllPeaksNaive  ( proshade_complex* map, proshade_unsign dim, proshade_signed peakSize, proshade_double noIQRs );
+    std::vector< ProSHADE_rotationPeak > getAllPeaksNaive ( proshade_complex* map, proshade_unsign dim, proshade_signed peakSize, proshade_double noIQRs,
+                                                        proshade_unsign noThreads );
     void getBestPeakEulerAngsNaive                    ( proshade_complex* map, proshade_unsign dim, proshade_double* eulA, proshade_double* eulB,
                                                         proshade_double* eulG, ProSHADE_settings* settings );
     void allocateSmoothingZScoreMemory                ( proshade_unsign dim, proshade_double*& scoreOverVals, proshade_signed*& signals,
@@ -45,6 +45,8 @@ public:
     bool removeWaters;                                //!< Should all waters be removed from input PDB files?
     bool firstModelOnly;                              //!< Shoud only the first PDB model be used, or should all models be used?
     bool removeNegativeDensity;                       //!< Should the negative density be removed from input files?
+    proshade_unsign mapMemoryBudget;                  //!< The maximum size (in MB) of the internal map read from a map file; larger maps are rejected. Set to 0 for no limit.
+    bool cropMapOnRead;                               //!< Should uncompressed mode 2 maps be cropped to their density box (see maskingThresholdIQRs) while being read? This changes the map box and origin.
     
     //================================================ Settings regarding the resolution of calculations
     proshade_single requestedResolution;              //!< The resolution to which the calculations are to be done.
@@ -118,6 +120,9 @@ public:
     proshade_double enLevMatrixPowerWeight;           //!< If RRP matrices shell position is to be weighted by putting the position as an exponent, this variable sets the exponent. Set to 0 for no weighting.
     bool computeTraceSigmaDesc;                       //!< If true, the trace sigma descriptor will be computed, otherwise all its computations will be omitted.
     bool computeRotationFuncDesc;                     //!< If true, the rotation function descriptor will be computed, otherwise all its computations will be omitted.
+    bool rotFunDescCoarseToFine;                      //!< If true, the rotation function descriptor peak is located on a reduced bandwidth rotation function and refined at full bandwidth, instead of computing the full bandwidth rotation function.
+    bool computeAllDistances;                         //!< If true, distances between all pairs of structures (the full N x N matrix) will be computed instead of only the first structure against all others.
+    proshade_unsign maxInFlightStructures;            //!< The maximum number of structures which can be processed (and held in memory) concurrently by the parallel distances computation. Set to 0 to use the number of threads.
     
     //================================================ Settings regarding peak searching
     proshade_unsign peakNeighbours;                   //!< Number of points in any direction that have to be lower than the considered index in order to consider this index a peak.
@@ -152,6 +157,16 @@ public:
     proshade_signed verbose;                          //!< Should the software report on the progress, or just be quiet? Value between -1 (nothing) and 4 (loud)
     proshade_signed messageShift;                     //!< This value allows shifting the messages to create more readable log for sub-processes.
     
+    //================================================ Settings regarding parallel computation
+    proshade_unsign noThreads;                        //!< The number of threads to be used by the parallelised computations. Set to 0 to use all available hardware threads.
+    
+    //================================================ Settings regarding FFTW planning
+    proshade_unsign fftwPlanningRigour;               //!< The FFTW planning rigour; 0 for FFTW_ESTIMATE, 1 for FFTW_MEASURE and 2 for FFTW_PATIENT.
+    std::string fftwWisdomFile;                       //!< The file from which the FFTW wisdom is loaded at the start and to which it is saved at the end of the run. Empty string means no wisdom file.
+    
+    //================================================ Settings regarding the inverse SO(3) Fourier transform
+    proshade_unsign invSOFTBackend;                   //!< The inverse SO(3) Fourier transform implementation; 0 for the SOFT library naive transform, 1 for the parallel transform.
+    
 public: // maybe make this protected?
     //================================================ Variable modifying functions
     void determineBandwidthFromAngle                  ( proshade_double uncertainty );
@@ -215,6 +230,13 @@ public:
     void __declspec(dllexport) setEnergyLevelsComputation                     ( bool enLevDesc );
     void __declspec(dllexport) setTraceSigmaComputation                       ( bool trSigVal );
     void __declspec(dllexport) setRotationFunctionComputation                 ( bool rotfVal );
+    void __declspec(dllexport) setRotationFunctionCoarseToFine                ( bool coarseVal );
+    void __declspec(dllexport) setAllVsAllDistances                           ( bool allDist );
+    void __declspec(dllexport) setMaxInFlightStructures                       ( proshade_unsign maxInFl );
+    void __declspec(dllexport) setNumberOfThreads                             ( proshade_unsign noThr );
+    void __declspec(dllexport) setFFTWPlanningRigour                          ( proshade_unsign rigour );
+    void __declspec(dllexport) setFFTWWisdomFile                              ( std::string wisdomFile );
+    void __declspec(dllexport) setInverseSOFTBackend                          ( proshade_unsign backend );
     void __declspec(dllexport) setPeakNeighboursNumber                        ( proshade_unsign pkS );
     void __declspec(dllexport) setPeakNaiveNoIQR                              ( proshade_double noIQRs );
     void __declspec(dllexport) setPhaseUsage                                  ( bool phaseUsage );
@@ -234,6 +256,8 @@ public:
     void __declspec(dllexport) setFSCThreshold                                ( proshade_double fscThr );
     void __declspec(dllexport) setPeakThreshold                               ( proshade_double peakThr );
     void __declspec(dllexport) setNegativeDensity                             ( bool nDens );
+    void __declspec(dllexport) setMapMemoryBudget                             ( proshade_unsign memBudget );
+    void __declspec(dllexport) setCropMapOnRead                               ( bool cropOnRead );
 #else
     void addStructure                                 ( std::string structure );
     void setResolution                                ( proshade_single resolution );
@@ -272,6 +296,13 @@ public:
     void setEnergyLevelsComputation                   ( bool enLevDesc );
     void setTraceSigmaComputation                     ( bool trSigVal );
     void setRotationFunctionComputation               ( bool rotfVal );
+    void setRotationFunctionCoarseToFine              ( bool coarseVal );
+    void setAllVsAllDistances                         ( bool allDist );
+    void setMaxInFlightStructures                     ( proshade_unsign maxInFl );
+    void setNumberOfThreads                           ( proshade_unsign noThr );
+    void setFFTWPlanningRigour                        ( proshade_unsign rigour );
+    void setFFTWWisdomFile                            ( std::string wisdomFile );
+    void setInverseSOFTBackend                        ( proshade_unsign backend );
     void setPeakNeighboursNumber                      ( proshade_unsign pkS );
     void setPeakNaiveNoIQR                            ( proshade_double noIQRs );
     void setPhaseUsage                                ( bool phaseUsage );
@@ -291,6 +322,8 @@ public:
     void setFSCThreshold                              ( proshade_double fscThr );
     void setPeakThreshold                             ( proshade_double peakThr );
     void setNegativeDensity                           ( bool nDens );
+    void setMapMemoryBudget                           ( proshade_unsign memBudget );
+    void setCropMapOnRead                             ( bool cropOnRead );
 #endif
     
     //================================================ Command line options parsing
@@ -171,6 +171,10 @@ proshade_unsign ProSHADE_internal_spheres::ProSHADE_sphere::getMaxCircumference
     the appropriate map data onto a spherical grid a given by the sphere object calling it. It uses the tri-linear interpolation in the
     order XYZ and saves all results internally.
  
+    The sines and cosines of the grid angles are computed only once per shell and the eight surrounding map values are read directly into
+    local variables, so that the inner loop does not allocate, does not do any bounds-checked accesses and writes the results contiguously.
+    The tri-linear interpolation arithmetic is done in the same order as with the per-point interpolation vectors, so that the results are identical.
+ 
     \param[in] map The density map pointer - the map which should be mapped to the data.
     \param[in] xDimMax The internal map maximum index in the x dimension.
     \param[in] yDimMax The internal map maximum index in the y dimension.
@@ -179,61 +183,70 @@ proshade_unsign ProSHADE_internal_spheres::ProSHADE_sphere::getMaxCircumference
 void ProSHADE_internal_spheres::ProSHADE_sphere::mapData ( proshade_double* map, proshade_unsign xDimMax, proshade_unsign yDimMax, proshade_unsign zDimMax )
 {
     //================================================ Initialise local variavles
-    proshade_double x, y, z, xRelative, yRelative, zRelative;
-    proshade_signed xBottom, yBottom, zBottom, xTop, yTop, zTop;
-    std::vector<proshade_double> lonCO                ( this->localAngRes + 1 );
-    std::vector<proshade_double> latCO                ( this->localAngRes + 1 );
-    std::vector<proshade_double> c000                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c001                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c010                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c011                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c100                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c101                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c110                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c111                 = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c00                  = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c01                  = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c10                  = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c11                  = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c0                   = std::vector<proshade_double> ( 4 );
-    std::vector<proshade_double> c1                   = std::vector<proshade_double> ( 4 );
-    
-    //================================================ Find pixelisation cutOffs
-    this->getLongitudeCutoffs                         ( &lonCO );
-    this->getLattitudeCutoffs                         ( &latCO );
+    std::vector<proshade_double> cosLon               ( this->localAngRes );
+    std::vector<proshade_double> sinLon               ( this->localAngRes );
+    std::vector<proshade_double> cosLat               ( this->localAngRes );
+    std::vector<proshade_double> sinLat               ( this->localAngRes );
+    const proshade_double xSampling                   = static_cast< proshade_double > ( this->xDimSampling );
+    const proshade_double ySampling                   = static_cast< proshade_double > ( this->yDimSampling );
+    const proshade_double zSampling                   = static_cast< proshade_double > ( this->zDimSampling );
+    const proshade_double xHalfDim                    = static_cast< proshade_double > ( xDimMax ) / 2.0;
+    const proshade_double yHalfDim                    = static_cast< proshade_double > ( yDimMax ) / 2.0;
+    const proshade_double zHalfDim                    = static_cast< proshade_double > ( zDimMax ) / 2.0;
+    const proshade_signed xHalfInd                    = static_cast< proshade_signed > ( xDimMax / 2 );
+    const proshade_signed yHalfInd                    = static_cast< proshade_signed > ( yDimMax / 2 );
+    const proshade_signed zHalfInd                    = static_cast< proshade_signed > ( zDimMax / 2 );
+    const proshade_signed xDim                        = static_cast< proshade_signed > ( xDimMax );
+    const proshade_signed yDim                        = static_cast< proshade_signed > ( yDimMax );
+    const proshade_signed zDim                        = static_cast< proshade_signed > ( zDimMax );
+    const proshade_signed xStep                       = yDim * zDim;
+    proshade_double x, y, z, xRelative, yRelative, zRelative, c00, c01, c10, c11, c0, c1;
+    proshade_signed xBottom, yBottom, zBottom, mapIndex;
+    proshade_double* resPtr                           = nullptr;
+    
+    //================================================ Find the grid angles sines and cosines
+    this->getSamplingAngles                           ( &cosLon, &sinLon, &cosLat, &sinLat );
     
     //================================================ Interpolate the map onto this shell
-    for ( unsigned int thIt = 0; thIt < this->localAngRes; thIt++ )
+    for ( proshade_unsign phIt = 0; phIt < this->localAngRes; phIt++ )
     {
-        for ( unsigned int phIt = 0; phIt < this->localAngRes; phIt++ )
+        //============================================ The z position and its indices only depend on the lattitude
+        z                                             = this->sphereRadius * sinLat[phIt];
+        zBottom                                       = static_cast< proshade_signed > ( std::floor ( ( z / zSampling ) ) + zHalfDim );
+        zRelative                                     = ( z - ( static_cast< proshade_double > ( zBottom - zHalfInd ) * zSampling ) ) / zSampling;
+        resPtr                                        = this->mappedData + ( phIt * this->localAngRes );
+        
+        //============================================ If the whole lattitude ring is out of bounds, just zero it
+        if ( ( zBottom < 0 ) || ( ( zBottom + 1 ) >= zDim ) ) { for ( proshade_unsign thIt = 0; thIt < this->localAngRes; thIt++ ) { resPtr[thIt] = 0.0; } continue; }
+        
+        for ( proshade_unsign thIt = 0; thIt < this->localAngRes; thIt++ )
         {
-            //======================================== Get grid point x, y and z
-            this->getInterpolationXYZ                 ( &x, &y, &z, thIt, &lonCO, phIt, &latCO );
+            //======================================== Get grid point x and y
+            x                                         = this->sphereRadius * cosLon[thIt] * cosLat[phIt];
+            y                                         = this->sphereRadius * sinLon[thIt] * cosLat[phIt];
+            
+            //======================================== Find the lower corner of the 8 closest points
+            xBottom                                   = static_cast< proshade_signed > ( std::floor ( ( x / xSampling ) ) + xHalfDim );
+            yBottom                                   = static_cast< proshade_signed > ( std::floor ( ( y / ySampling ) ) + yHalfDim );
+            
+            //======================================== If any of the 8 closest points is out of bounds, the value is 0
+            if ( ( xBottom < 0 ) || ( ( xBottom + 1 ) >= xDim ) || ( yBottom < 0 ) || ( ( yBottom + 1 ) >= yDim ) ) { resPtr[thIt] = 0.0; continue; }
             
-            //======================================== Find 8 closest point around the grid point in indices
-            this->getXYZTopBottoms                    ( xDimMax, yDimMax, zDimMax, x, y, z, &xBottom, &yBottom, &zBottom, &xTop, &yTop, &zTop );
-
-            //======================================== Get the 8 closest points interpolation vectors (or set to 0 if out-of-bounds)
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xBottom, yBottom, zBottom, &c000 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xBottom, yBottom, zTop   , &c001 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xBottom, yTop   , zBottom, &c010 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xBottom, yTop   , zTop   , &c011 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xTop   , yBottom, zBottom, &c100 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xTop   , yBottom, zTop   , &c101 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xTop   , yTop   , zBottom, &c110 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-            if ( !getMapPoint ( map, xDimMax, yDimMax, zDimMax, xTop   , yTop   , zTop   , &c111 ) ) { this->mappedData[phIt * this->localAngRes + thIt] = 0.0; continue; }
-
             //======================================== Interpolate along X axis
-            xRelative                                 = ( x - ( static_cast< proshade_double > ( xBottom - static_cast<proshade_signed> ( ( ( xDimMax ) / 2 ) ) ) * static_cast< proshade_double > ( this->xDimSampling ) ) ) / static_cast< proshade_double > ( this->xDimSampling );
-            this->interpolateAlongFirst               ( c000, c001, c010, c011, c100, c101, c110, c111, &c00, &c01, &c10, &c11, xRelative );
+            mapIndex                                  = zBottom + zDim * ( yBottom + yDim * xBottom );
+            xRelative                                 = ( x - ( static_cast< proshade_double > ( xBottom - xHalfInd ) * xSampling ) ) / xSampling;
+            c00                                       = ( map[mapIndex]                    * ( 1.0 - xRelative ) ) + ( map[mapIndex + xStep]                    * xRelative );
+            c01                                       = ( map[mapIndex + 1]                * ( 1.0 - xRelative ) ) + ( map[mapIndex + xStep + 1]                * xRelative );
+            c10                                       = ( map[mapIndex + zDim]             * ( 1.0 - xRelative ) ) + ( map[mapIndex + xStep + zDim]             * xRelative );
+            c11                                       = ( map[mapIndex + zDim + 1]         * ( 1.0 - xRelative ) ) + ( map[mapIndex + xStep + zDim + 1]         * xRelative );
             
             //======================================== Interpolate along Y axis
-            yRelative                                 = ( y - ( static_cast< proshade_double > ( yBottom - static_cast<proshade_signed> ( ( ( yDimMax ) / 2 ) ) ) * static_cast< proshade_double > ( this->yDimSampling ) ) ) / static_cast< proshade_double > ( this->yDimSampling );
-            this->interpolateAlongSecond              ( c00, c01, c10, c11, &c0, &c1, yRelative );
-
-            //======================================== Save the resulting value
-            zRelative                                 = ( z - ( static_cast< proshade_double > ( zBottom - static_cast<proshade_signed> ( ( ( zDimMax ) / 2 ) ) ) * static_cast< proshade_double > ( this->zDimSampling ) ) ) / static_cast< proshade_double > ( this->zDimSampling );
-            this->mappedData[phIt * this->localAngRes + thIt] = ( c0.at(3) * ( 1.0 - zRelative ) ) + ( c1.at(3) * zRelative );
+            yRelative                                 = ( y - ( static_cast< proshade_double > ( yBottom - yHalfInd ) * ySampling ) ) / ySampling;
+            c0                                        = ( c00 * ( 1.0 - yRelative ) ) + ( c10 * yRelative );
+            c1                                        = ( c01 * ( 1.0 - yRelative ) ) + ( c11 * yRelative );
+            
+            //======================================== Interpolate along Z axis and save the resulting value
+            resPtr[thIt]                              = ( c0 * ( 1.0 - zRelative ) ) + ( c1 * zRelative );
         }
     }
     
@@ -241,44 +254,6 @@ void ProSHADE_internal_spheres::ProSHADE_sphere::mapData ( proshade_double* map,
     return ;
     
 }
-
-/*! \brief This function fills in the interpolation vector for a single map point.
- 
-    This function takes the index positions of a map point and a pointer to a vector of 4 proshade_double's and fills in the
-    vector so that interpolation can easily be done using its values. It also returns boolean value, true if the point is
-    in bounds and everything had succeeded and false if the point was out of bounds and therefore the interpolation is not
-    required as the mapped value should just be 0.
- 
-    \param[in] map The density map pointer - the map which should be mapped to the data.
-    \param[in] xDimMax The internal map maximum index in the x dimension.
-    \param[in] yDimMax The internal map maximum index in the y dimension.
-    \param[in] zDimMax The internal map maximum index in the z dimension.
-    \param[in] xPos The x axis index position of the point of which interpolation vector is to be obtained.
-    \param[in] yPos The y axis index position of the point of which interpolation vector is to be obtained.
-    \param[in] zPos The z axis index position of the point of which interpolation vector is to be obtained.
-    \param[in] interpVec The variable to which the interpolation values are to be saved (vector of proshade_double's initialised to length 4).
- */
-bool ProSHADE_internal_spheres::ProSHADE_sphere::getMapPoint ( proshade_double* map, proshade_unsign xDimMax, proshade_unsign yDimMax, proshade_unsign zDimMax, proshade_signed xPos, proshade_signed yPos, proshade_signed zPos, std::vector<proshade_double>* interpVec )
-{
-    //================================================ Initialise local variables
-    proshade_signed posIter                           = zPos + static_cast<proshade_signed> ( zDimMax ) * ( yPos  + static_cast<proshade_signed> ( yDimMax ) * xPos );
-    
-    //================================================ Check of out-of-bounds shells
-    if ( ( xPos < 0 ) || ( xPos >= static_cast<proshade_signed> ( xDimMax ) ) ) { return ( false ); }
-    if ( ( yPos < 0 ) || ( yPos >= static_cast<proshade_signed> ( yDimMax ) ) ) { return ( false ); }
-    if ( ( zPos < 0 ) || ( zPos >= static_cast<proshade_signed> ( zDimMax ) ) ) { return ( false ); }
-    
-    //================================================ Get the interpolation values
-    interpVec->at(0)                                  = static_cast<proshade_double> ( xPos ) * static_cast<proshade_double> ( this->xDimSampling );
-    interpVec->at(1)                                  = static_cast<proshade_double> ( yPos ) * static_cast<proshade_double> ( this->yDimSampling );
-    interpVec->at(2)                                  = static_cast<proshade_double> ( zPos ) * static_cast<proshade_double> ( this->zDimSampling );
-    interpVec->at(3)                                  = map[posIter];
-    
-    //================================================ Done
-    return                                            ( true );
-    
-}
-
 /*! \brief This function fills in the vector of longitudal bin boarder values.
  
     This is a simple abstraction function which finds the boarders of the angular grid binds along the longitudal angle.
@@ -321,60 +296,34 @@ void ProSHADE_internal_spheres::ProSHADE_sphere::getLattitudeCutoffs ( std::vect
     
 }
 
-/*! \brief This function finds the x, y and z positions of supplied shell point.
- 
-    This function converts the angular grid longitude and lattitude position (defined as in between the cutt-offs of the given index and its
-    neighbour) to the X, Y and Z axis positions, which it saves in the supplied variables.
- 
-    \param[in] x A pointer to variable where the x position is to be saved.
-    \param[in] y A pointer to variable where the y position is to be saved.
-    \param[in] z A pointer to variable where the z position is to be saved.
-    \param[in] thetaIt The longitude cut-off index of the grid point of which the XYZ are to be computed.
-    \param[in] lonCO A pointer for vector of proshade_double's where the longitude cutt-off values are saved
-    \param[in] phiIt The lattitude cut-off index of the grid point of which the XYZ are to be computed.
-    \param[in] lonCO A pointer for vector of proshade_double's where the lattitude cutt-off values are saved
- */
-void ProSHADE_internal_spheres::ProSHADE_sphere::getInterpolationXYZ ( proshade_double* x, proshade_double* y, proshade_double* z, proshade_double thetaIt, std::vector<proshade_double>* lonCO, proshade_unsign phiIt, std::vector<proshade_double>* latCO )
-{
-    //================================================ Compute and save XYZ interpolation positions
-   *x                                                 = this->sphereRadius * std::cos ( ( lonCO->at( static_cast<proshade_unsign> ( thetaIt ) ) + lonCO->at( static_cast<proshade_unsign> ( thetaIt+1 ) ) ) / 2.0 ) *
-                                                                             std::cos ( ( latCO->at( static_cast<proshade_unsign> ( phiIt ) )   + latCO->at( static_cast<proshade_unsign> ( phiIt+1 ) )   ) / 2.0 );
-   *y                                                 = this->sphereRadius * std::sin ( ( lonCO->at( static_cast<proshade_unsign> ( thetaIt ) ) + lonCO->at( static_cast<proshade_unsign> ( thetaIt+1 ) ) ) / 2.0 ) *
-                                                                             std::cos ( ( latCO->at( static_cast<proshade_unsign> ( phiIt ) )   + latCO->at( static_cast<proshade_unsign> ( phiIt+1 ) )   ) / 2.0 );
-   *z                                                 = this->sphereRadius * std::sin ( ( latCO->at( static_cast<proshade_unsign> ( phiIt ) )   + latCO->at( static_cast<proshade_unsign> ( phiIt+1 ) )   ) / 2.0 );
-    
-    //================================================ Done
-    return ;
-    
-}
-
-/*! \brief This function fills in the interpolation vector for a single map point.
+/*! \brief This function computes the sines and cosines of the angular grid positions of this shell.
  
-    This function takes the XYZ position of a point and finds the top and bottom map points which surround the XYZ position.
+    This function finds the longitude and lattitude of the centre of each angular grid bin (as the mean of the bin cut-offs) and
+    saves their sines and cosines, so that these do not need to be re-computed for every grid point.
  
-    \param[in] xDimMax The internal map maximum index in the x dimension.
-    \param[in] yDimMax The internal map maximum index in the y dimension.
-    \param[in] zDimMax The internal map maximum index in the z dimension.
-    \param[in] x The x position of the point for which the surrounding indices are to be found.
-    \param[in] y The y position of the point for which the surrounding indices are to be found.
-    \param[in] z The z position of the point for which the surrounding indices are to be found.
-    \param[in] xBottom A pointer to the variable which should now hold the x position of the lower surrounding point.
-    \param[in] yBottom A pointer to the variable which should now hold the y position of the lower surrounding point.
-    \param[in] zBottom A pointer to the variable which should now hold the z position of the lower surrounding point.
-    \param[in] xTop A pointer to the variable which should now hold the x position of the upper surrounding point.
-    \param[in] yTop A pointer to the variable which should now hold the y position of the upper surrounding point.
-    \param[in] zTop A pointer to the variable which should now hold the z position of the upper surrounding point.
+    \param[in] cosLon A pointer for vector of proshade_double's to which the longitude cosines are to be saved. The vector needs to be initialised for this->localAngRes size.
+    \param[in] sinLon A pointer for vector of proshade_double's to which the longitude sines are to be saved. The vector needs to be initialised for this->localAngRes size.
+    \param[in] cosLat A pointer for vector of proshade_double's to which the lattitude cosines are to be saved. The vector needs to be initialised for this->localAngRes size.
+    \param[in] sinLat A pointer for vector of proshade_double's to which the lattitude sines are to be saved. The vector needs to be initialised for this->localAngRes size.
  */
-void ProSHADE_internal_spheres::ProSHADE_sphere::getXYZTopBottoms ( proshade_unsign xDimMax, proshade_unsign yDimMax, proshade_unsign zDimMax, proshade_double x, proshade_double y, proshade_double z, proshade_signed* xBottom, proshade_signed* yBottom, proshade_signed* zBottom, proshade_signed* xTop, proshade_signed* yTop, proshade_signed* zTop )
+void ProSHADE_internal_spheres::ProSHADE_sphere::getSamplingAngles ( std::vector<proshade_double>* cosLon, std::vector<proshade_double>* sinLon, std::vector<proshade_double>* cosLat, std::vector<proshade_double>* sinLat )
 {
-    //================================================ Get the values
-   *xBottom                                           = static_cast< proshade_signed > ( std::floor ( ( x / static_cast< proshade_double > ( this->xDimSampling ) ) ) + ( static_cast< proshade_double > ( xDimMax ) / 2.0 ) );
-   *yBottom                                           = static_cast< proshade_signed > ( std::floor ( ( y / static_cast< proshade_double > ( this->yDimSampling ) ) ) + ( static_cast< proshade_double > ( yDimMax ) / 2.0 ) );
-   *zBottom                                           = static_cast< proshade_signed > ( std::floor ( ( z / static_cast< proshade_double > ( this->zDimSampling ) ) ) + ( static_cast< proshade_double > ( zDimMax ) / 2.0 ) );
-            
-   *xTop                                              = *xBottom + 1;
-   *yTop                                              = *yBottom + 1;
-   *zTop                                              = *zBottom + 1;
+    //================================================ Initialise local variables
+    std::vector<proshade_double> lonCO                ( this->localAngRes + 1 );
+    std::vector<proshade_double> latCO                ( this->localAngRes + 1 );
+    
+    //================================================ Find pixelisation cutOffs
+    this->getLongitudeCutoffs                         ( &lonCO );
+    this->getLattitudeCutoffs                         ( &latCO );
+    
+    //================================================ Compute the sines and cosines of the bin centres
+    for ( proshade_unsign iter = 0; iter < this->localAngRes; iter++ )
+    {
+        cosLon->at(iter)                              = std::cos ( ( lonCO.at(iter) + lonCO.at(iter+1) ) / 2.0 );
+        sinLon->at(iter)                              = std::sin ( ( lonCO.at(iter) + lonCO.at(iter+1) ) / 2.0 );
+        cosLat->at(iter)                              = std::cos ( ( latCO.at(iter) + latCO.at(iter+1) ) / 2.0 );
+        sinLat->at(iter)                              = std::sin ( ( latCO.at(iter) + latCO.at(iter+1) ) / 2.0 );
+    }
     
     //================================================ Done
     return ;
@@ -420,91 +369,6 @@ proshade_double* ProSHADE_internal_spheres::ProSHADE_sphere::getMappedData ( voi
     return                                            ( this->mappedData );
 }
 
-/*! \brief This function interpolates along the first (X) dimension.
- 
-    This function takes the 8 interpolation vectors for the neighbouring map points and proceeds to interpolate out the X axis
-    from all of them, thus resulting in 4 new interpolation vectors which contain the Y and Z dimension values. This is the first
-    step of the tri-linear interpolation procedure.
- 
-    \param[in] c000 The interpolation vector for map point less less less (than the point of interest).
-    \param[in] c001 The interpolation vector for map point less less more (than the point of interest).
-    \param[in] c010 The interpolation vector for map point less more less (than the point of interest).
-    \param[in] c011 The interpolation vector for map point less more more (than the point of interest).
-    \param[in] c100 The interpolation vector for map point more less less (than the point of interest).
-    \param[in] c101 The interpolation vector for map point more less more (than the point of interest).
-    \param[in] c110 The interpolation vector for map point more more less (than the point of interest).
-    \param[in] c111 The interpolation vector for map point more more more (than the point of interest).
-    \param[in] c00 Pointer to the variable where the less less second interporetation vector will be saved.
-    \param[in] c01 Pointer to the variable where the less more second interporetation vector will be saved.
-    \param[in] c10 Pointer to the variable where the more less second interporetation vector will be saved.
-    \param[in] c11 Pointer to the variable where the more more second interporetation vector will be saved.
-    \param[in] xd The relative distance of the point of interest to the lower map point along the x axis.
- */
-void ProSHADE_internal_spheres::ProSHADE_sphere::interpolateAlongFirst ( std::vector<proshade_double> c000, std::vector<proshade_double> c001, std::vector<proshade_double> c010, std::vector<proshade_double> c011, std::vector<proshade_double> c100, std::vector<proshade_double> c101, std::vector<proshade_double> c110, std::vector<proshade_double> c111, std::vector<proshade_double>* c00, std::vector<proshade_double>* c01, std::vector<proshade_double>* c10, std::vector<proshade_double>* c11, proshade_double xd )
-{
-    //================================================ Interpolate for the less less point
-    c00->at(0)                                        = ( static_cast< proshade_double > ( this->xDimSampling ) * xd ) + c000.at(0);
-    c00->at(1)                                        = c000.at(1);
-    c00->at(2)                                        = c000.at(2);
-    c00->at(3)                                        = ( c000.at(3) * ( 1.0 - xd ) ) + ( c100.at(3) * xd );
-    
-    //================================================ Interpolate for the less more point
-    c01->at(0)                                        = ( static_cast< proshade_double > ( this->xDimSampling ) * xd ) + c001.at(0);
-    c01->at(1)                                        = c001.at(1);
-    c01->at(2)                                        = c001.at(2);
-    c01->at(3)                                        = ( c001.at(3) * ( 1.0 - xd ) ) + ( c101.at(3) * xd );
-    
-    //================================================ Interpolate for the more less point
-    c10->at(0)                                        = ( static_cast< proshade_double > ( this->xDimSampling ) * xd ) + c010.at(0);
-    c10->at(1)                                        = c010.at(1);
-    c10->at(2)                                        = c010.at(2);
-    c10->at(3)                                        = ( c010.at(3) * ( 1.0 - xd ) ) + ( c110.at(3) * xd );
-    
-    //================================================ Interpolate for the more more point
-    c11->at(0)                                        = ( static_cast< proshade_double > ( this->xDimSampling ) * xd ) + c011.at(0);
-    c11->at(1)                                        = c011.at(1);
-    c11->at(2)                                        = c011.at(2);
-    c11->at(3)                                        = ( c011.at(3) * ( 1.0 - xd ) ) + ( c111.at(3) * xd );
-    
-    //================================================ Done
-    return ;
-    
-}
-
-/*! \brief This function interpolates along the second (Y) dimension.
- 
-    This function takes the 4 interpolation vectors for the neighbouring map points with the X axis already interpolate (that is, as
-    outputted from the interpolateAlongFirst() function) and proceeds to interpolate out the Y axis from all of them, thus resulting
-    in 2 new interpolation vectors which contain the Z dimension values only. This is the second step of the tri-linear interpolation
-    procedure.
- 
-    \param[in] c00 The interpolation vector for map point less less (than the point of interest) as returned from interpolateAlongFirst().
-    \param[in] c01 The interpolation vector for map point less more (than the point of interest) as returned from interpolateAlongFirst().
-    \param[in] c10 The interpolation vector for map point more less (than the point of interest) as returned from interpolateAlongFirst().
-    \param[in] c11 The interpolation vector for map point more more (than the point of interest) as returned from interpolateAlongFirst().
-    \param[in] c0 Pointer to the variable where the less third interporetation vector will be saved.
-    \param[in] c1 Pointer to the variable where the more third interporetation vector will be saved.
-    \param[in] yd The relative distance of the point of interest to the lower map point along the y axis.
- */
-void ProSHADE_internal_spheres::ProSHADE_sphere::interpolateAlongSecond ( std::vector<proshade_double> c00, std::vector<proshade_double> c01, std::vector<proshade_double> c10, std::vector<proshade_double> c11, std::vector<proshade_double>* c0, std::vector<proshade_double>* c1, proshade_double yd )
-{
-    //================================================ Interpolate for the less point
-    c0->at(0)                                         = c00.at(0);
-    c0->at(1)                                         = ( static_cast< proshade_double > ( this->yDimSampling ) * yd ) + c00.at(1);
-    c0->at(2)                                         = c00.at(2);
-    c0->at(3)                                         = ( c00.at(3) * ( 1.0 - yd ) ) + ( c10.at(3) * yd );
-    
-    //================================================ Interpolate for the more point
-    c1->at(0)                                         = c01.at(0);
-    c1->at(1)                                         = ( static_cast< proshade_double > ( this->yDimSampling ) * yd ) + c01.at(1);
-    c1->at(2)                                         = c01.at(2);
-    c1->at(3)                                         = ( c01.at(3) * ( 1.0 - yd ) ) + ( c11.at(3) * yd );
-    
-    //================================================ Done
-    return ;
-    
-}
-
 /*! \brief This function determines the bandwidth for the spherical harmonics computation.
  
     This function is here to automstically determine the bandwidth to which the spherical harmonics computations should be done.
@@ -767,28 +631,114 @@ std::vector<std::pair<proshade_unsign,proshade_unsign>> ProSHADE_internal_sphere
     
 }
 
-/*! \brief Function for interpolating the sphere grid values from angle-axis converted rotation function.
+//==================================================== Local variables
+namespace ProSHADE_internal_spheres
+{
+    static const size_t rotFunSphereGeometryMaxValues = static_cast< size_t > ( 1 ) << 24; //!< The maximum number of values (128MB) to be held by a single sampling positions cache.
+}
+
+/*! \brief This is the constructor for the angle-axis sphere sampling positions cache.
+ */
+ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry::ProSHADE_rotFun_sphereGeometry ( void )
+{
+    //================================================ Nothing is cached yet
+    this->noValues                                    = 0;
+    
+}
+
+/*! \brief This is the destructor for the angle-axis sphere sampling positions cache.
+ */
+ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry::~ProSHADE_rotFun_sphereGeometry ( void )
+{
+    //================================================ The positions are released with the map
+    
+}
+
+/*! \brief This function returns the cached sampling positions for the given geometry, if there are any.
+ 
+    \param[in] angDim The dimension size of the angular sampling grid.
+    \param[in] rfDim The dimension size of the rotation function sampling grid.
+    \param[in] repAng The angle represented by the sphere.
+    \param[out] X Pointer to the cached positions or nullptr if these were not cached yet.
+ */
+const proshade_double* ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry::findPositions ( proshade_unsign angDim, proshade_unsign rfDim, proshade_double repAng )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( this->geometryMutex );
+    
+    //================================================ Find the positions
+    std::map< std::pair< std::pair< proshade_unsign, proshade_unsign >, proshade_double >, std::vector< proshade_double > >::iterator found = this->positions.find ( std::make_pair ( std::make_pair ( angDim, rfDim ), repAng ) );
+    if ( found == this->positions.end() ) { return ( nullptr ); }
+    
+    //================================================ Done
+    return                                            ( found->second.data() );
+    
+}
+
+/*! \brief This function saves newly computed sampling positions into the cache, unless these were saved by another thread already or the cache is full.
+ 
+    \param[in] angDim The dimension size of the angular sampling grid.
+    \param[in] rfDim The dimension size of the rotation function sampling grid.
+    \param[in] repAng The angle represented by the sphere.
+    \param[in] newPositions The computed positions; these are moved out of the vector.
+    \param[in] localPositions Pointer to a vector which will hold the positions if these cannot be cached.
+    \param[out] X Pointer to the positions to be used.
+ */
+const proshade_double* ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry::storePositions ( proshade_unsign angDim, proshade_unsign rfDim, proshade_double repAng, std::vector< proshade_double >& newPositions, std::vector< proshade_double >* localPositions )
+{
+    //================================================ Lock the cache
+    std::lock_guard< std::mutex > lock                ( this->geometryMutex );
+    
+    //================================================ Use the already cached positions, if another thread was faster
+    std::pair< std::pair< proshade_unsign, proshade_unsign >, proshade_double > geomKey = std::make_pair ( std::make_pair ( angDim, rfDim ), repAng );
+    std::map< std::pair< std::pair< proshade_unsign, proshade_unsign >, proshade_double >, std::vector< proshade_double > >::iterator found = this->positions.find ( geomKey );
+    if ( found != this->positions.end() ) { return ( found->second.data() ); }
+    
+    //================================================ If the cache is full, keep the positions local
+    if ( ( this->noValues + newPositions.size() ) > rotFunSphereGeometryMaxValues )
+    {
+       *localPositions                                = std::move ( newPositions );
+        return                                        ( localPositions->data() );
+    }
+    
+    //================================================ Cache the positions
+    this->noValues                                   += newPositions.size();
+    std::vector< proshade_double >& cached            = this->positions[geomKey];
+    cached                                            = std::move ( newPositions );
+    
+    //================================================ Done
+    return                                            ( cached.data() );
+    
+}
+
+/*! \brief This function returns the rotation function map positions of all the sphere sampling grid points.
  
-    This function starts by converting each of the sphere sampling points lattitude and longitude to the XYZ position and by adding the represented
-    rotation angle, obtains the angle-axis representation for the given point. It then proceeds to locate such points exact position in the indices space
-    of the supplied rotation map. From there, it interpolates the exact correlation value for the given point, thus effectivelly re-sampling the rotation
-    function space onto the sphere.
+    This function converts each of the sphere sampling points lattitude and longitude to the XYZ position and by adding the represented
+    rotation angle, obtains the angle-axis representation for the given point. It then proceeds to locate such points exact position in the
+    indices space of the rotation map. As these positions depend only on the grid dimensions and the represented angle, they are kept in the
+    supplied cache and shared by all spheres with the same geometry. If the cache is full, the positions are computed into the supplied vector.
  
-    \param[in] rotFun proshade_complex pointer to the rotation function values.
+    \param[in] geometry Pointer to the sampling positions cache of the structure whose rotation function is being converted.
+    \param[in] localPositions Pointer to a vector which will hold the positions if these cannot be cached.
+    \param[out] X Pointer to the map x, y and z positions (in this order) for each sampling point, indexed as the axesValues array.
  */
-void ProSHADE_internal_spheres::ProSHADE_rotFun_sphere::interpolateSphereValues ( proshade_complex* rotFun )
+const proshade_double* ProSHADE_internal_spheres::ProSHADE_rotFun_sphere::getSamplingPositions ( ProSHADE_rotFun_sphereGeometry* geometry, std::vector< proshade_double >* localPositions )
 {
+    //================================================ Return cached positions if available
+    const proshade_double* cachedPositions            = geometry->findPositions ( this->angularDim, this->rotFunDim, this->representedAngle );
+    if ( cachedPositions != nullptr ) { return ( cachedPositions ); }
+    
     //================================================ Initialise variables
     proshade_double lonSampling                       = ( M_PI       ) / static_cast< proshade_double > ( this->angularDim );
     proshade_double latSampling                       = ( M_PI * 2.0 ) / static_cast< proshade_double > ( this->angularDim );
-    
-    proshade_double lat, lon, cX, cY, cZ, c000, c001, c010, c011, c100, c101, c110, c111, c00, c01, c10, c11, c0, c1, xRelative, yRelative, zRelative, eulerAlpha, eulerBeta, eulerGamma, mapX, mapY, mapZ;
-    proshade_signed xBottom, xTop, yBottom, yTop, zBottom, zTop, mapIndex;
+    proshade_double lat, lon, cX, cY, cZ, eulerAlpha, eulerBeta, eulerGamma;
+    size_t mapIndex;
+    std::vector< proshade_double > positions          ( static_cast< size_t > ( this->angularDim ) * static_cast< size_t > ( this->angularDim ) * 3 );
     
     //================================================ For each sphere grid position
-    for ( proshade_signed lonIt = 0; lonIt < static_cast<proshade_signed> ( this->angularDim ); lonIt++ )
+    for ( proshade_unsign lonIt = 0; lonIt < this->angularDim; lonIt++ )
     {
-        for ( proshade_signed latIt = 0; latIt < static_cast<proshade_signed> ( this->angularDim ); latIt++ )
+        for ( proshade_unsign latIt = 0; latIt < this->angularDim; latIt++ )
         {
             //======================================== Convert to XYZ position on unit sphere. The radius here is not important, as it does not change the direction of the vector.
             lon                                       = static_cast<proshade_double> ( lonIt ) * lonSampling;
@@ -801,68 +751,110 @@ void ProSHADE_internal_spheres::ProSHADE_rotFun_sphere::interpolateSphereValues
             ProSHADE_internal_maths::getEulerZYZFromAngleAxis ( cX, cY, cZ, this->representedAngle, &eulerAlpha, &eulerBeta, &eulerGamma );
             
             //======================================== Convert to SOFT map position (decimal, not indices)
-            ProSHADE_internal_maths::getSOFTPositionFromEulerZYZ ( this->rotFunDim / 2, eulerAlpha, eulerBeta, eulerGamma, &mapX, &mapY, &mapZ );
-            
-            //======================================== Find lower and higher points and deal with boundaries
-            xBottom = static_cast< proshade_signed > ( std::floor ( mapX ) ); if ( xBottom < 0 ) { xBottom = 0; } if ( xBottom >= static_cast< proshade_signed > ( this->rotFunDim ) ) { xBottom = static_cast<proshade_signed> ( this->rotFunDim - 2 ); }
-            yBottom = static_cast< proshade_signed > ( std::floor ( mapY ) ); if ( yBottom < 0 ) { yBottom = 0; } if ( yBottom >= static_cast< proshade_signed > ( this->rotFunDim ) ) { yBottom = static_cast<proshade_signed> ( this->rotFunDim - 2 ); }
-            zBottom = static_cast< proshade_signed > ( std::floor ( mapZ ) ); if ( zBottom < 0 ) { zBottom = 0; } if ( zBottom >= static_cast< proshade_signed > ( this->rotFunDim ) ) { zBottom = static_cast<proshade_signed> ( this->rotFunDim - 2 ); }
-            xTop = static_cast< proshade_signed > ( std::ceil ( mapX ) );     if ( xTop    < 1 ) { xTop = 1;    } if ( xTop    >= static_cast< proshade_signed > ( this->rotFunDim ) ) { xTop    = static_cast<proshade_signed> ( this->rotFunDim - 1 ); }
-            yTop = static_cast< proshade_signed > ( std::ceil ( mapY ) );     if ( yTop    < 1 ) { yTop = 1;    } if ( yTop    >= static_cast< proshade_signed > ( this->rotFunDim ) ) { yTop    = static_cast<proshade_signed> ( this->rotFunDim - 1 ); }
-            zTop = static_cast< proshade_signed > ( std::ceil ( mapZ ) );     if ( zTop    < 1 ) { zTop = 1;    } if ( zTop    >= static_cast< proshade_signed > ( this->rotFunDim ) ) { zTop    = static_cast<proshade_signed> ( this->rotFunDim - 1 ); }
-            
-            //======================================== Start X interpolation - bottom, bottom, bottom
-            mapIndex                                  = zBottom + static_cast< proshade_signed > ( this->rotFunDim ) * ( yBottom + static_cast< proshade_signed > ( this->rotFunDim ) * xBottom );
-            c000                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== X interpolation - bottom, bottom, top
-            mapIndex                                  = zTop    + static_cast< proshade_signed > ( this->rotFunDim ) * ( yBottom + static_cast< proshade_signed > ( this->rotFunDim ) * xBottom );
-            c001                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== X interpolation - bottom, top, bottom
-            mapIndex                                  = zBottom + static_cast< proshade_signed > ( this->rotFunDim ) * ( yTop    + static_cast< proshade_signed > ( this->rotFunDim ) * xBottom );
-            c010                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== X interpolation - bottom, top, top
-            mapIndex                                  = zTop    + static_cast< proshade_signed > ( this->rotFunDim ) * ( yTop    + static_cast< proshade_signed > ( this->rotFunDim ) * xBottom );
-            c011                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== X interpolation - top, bottom, bottom
-            mapIndex                                  = zBottom + static_cast< proshade_signed > ( this->rotFunDim ) * ( yBottom + static_cast< proshade_signed > ( this->rotFunDim ) * xTop    );
-            c100                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== X interpolation - top, bottom, top
-            mapIndex                                  = zTop    + static_cast< proshade_signed > ( this->rotFunDim ) * ( yBottom + static_cast< proshade_signed > ( this->rotFunDim ) * xTop    );
-            c101                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== X interpolation - top, top, bottom
-            mapIndex                                  = zBottom + static_cast< proshade_signed > ( this->rotFunDim ) * ( yTop    + static_cast< proshade_signed > ( this->rotFunDim ) * xTop    );
-            c110                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== X interpolation - top, top, top
-            mapIndex                                  = zTop    + static_cast< proshade_signed > ( this->rotFunDim ) * ( yTop    + static_cast< proshade_signed > ( this->rotFunDim ) * xTop    );
-            c111                                      = pow( rotFun[mapIndex][0], 2.0 ) + pow( rotFun[mapIndex][1], 2.0 );
-            
-            //======================================== Solve for X
-            xRelative                                 = mapX - std::floor( mapX );
-            c00                                       = ( c000 * ( 1.0 - xRelative ) ) + ( c100 * xRelative );
-            c01                                       = ( c001 * ( 1.0 - xRelative ) ) + ( c101 * xRelative );
-            c10                                       = ( c010 * ( 1.0 - xRelative ) ) + ( c110 * xRelative );
-            c11                                       = ( c011 * ( 1.0 - xRelative ) ) + ( c111 * xRelative );
-            
-            //======================================== Solve for Y
-            yRelative                                 = mapY - std::floor( mapY );
-            c0                                        = ( c00 * ( 1.0 - yRelative ) ) + ( c10 * yRelative );
-            c1                                        = ( c01 * ( 1.0 - yRelative ) ) + ( c11 * yRelative );
-            
-            //======================================== Solve for Z
-            zRelative                                 = mapZ - std::floor( mapZ );
-            
-            //======================================== Save result
-            mapIndex                                  = lonIt + ( latIt * static_cast< proshade_signed > ( this->angularDim ) );
-            this->axesValues[mapIndex]                = ( c0 * ( 1.0 - zRelative ) ) + ( c1 * zRelative );
+            mapIndex                                  = ( lonIt + ( latIt * this->angularDim ) ) * 3;
+            ProSHADE_internal_maths::getSOFTPositionFromEulerZYZ ( this->rotFunDim / 2, eulerAlpha, eulerBeta, eulerGamma, &positions[mapIndex], &positions[mapIndex+1], &positions[mapIndex+2] );
         }
     }
+    
+    //================================================ Cache the positions, unless another thread did so already or the cache is full
+    return                                            ( geometry->storePositions ( this->angularDim, this->rotFunDim, this->representedAngle, positions, localPositions ) );
+    
+}
+
+/*! \brief This function tri-linearly interpolates the rotation function magnitudes onto the sphere sampling grid.
+ 
+    \param[in] positions The rotation function map positions of all sampling points as returned by getSamplingPositions().
+    \param[in] angularDim The dimension size of the angular sampling grid.
+    \param[in] rotFunDim The dimension size of the rotation function sampling grid.
+    \param[in] magnitude A function returning the rotation function magnitude for a map index.
+    \param[in] axesValues The sphere values array to which the results are saved.
+ */
+template < typename MagnitudeFn >
+static void interpolateRotFunMagnitudes ( const proshade_double* positions, proshade_unsign angularDim, proshade_unsign rotFunDim, MagnitudeFn magnitude, proshade_double* axesValues )
+{
+    //================================================ Initialise variables
+    proshade_signed dim                               = static_cast< proshade_signed > ( rotFunDim );
+    proshade_double mapX, mapY, mapZ, c00, c01, c10, c11, c0, c1, xRelative, yRelative, zRelative;
+    proshade_signed xBottom, xTop, yBottom, yTop, zBottom, zTop;
+    size_t noPoints                                   = static_cast< size_t > ( angularDim ) * static_cast< size_t > ( angularDim );
+    
+    //================================================ For each sphere grid position
+    for ( size_t ptIt = 0; ptIt < noPoints; ptIt++ )
+    {
+        //============================================ Get the map position
+        mapX                                          = positions[( ptIt * 3 ) + 0];
+        mapY                                          = positions[( ptIt * 3 ) + 1];
+        mapZ                                          = positions[( ptIt * 3 ) + 2];
+        
+        //============================================ Find lower and higher points and deal with boundaries
+        xBottom = static_cast< proshade_signed > ( std::floor ( mapX ) ); if ( xBottom < 0 ) { xBottom = 0; } if ( xBottom >= dim ) { xBottom = dim - 2; }
+        yBottom = static_cast< proshade_signed > ( std::floor ( mapY ) ); if ( yBottom < 0 ) { yBottom = 0; } if ( yBottom >= dim ) { yBottom = dim - 2; }
+        zBottom = static_cast< proshade_signed > ( std::floor ( mapZ ) ); if ( zBottom < 0 ) { zBottom = 0; } if ( zBottom >= dim ) { zBottom = dim - 2; }
+        xTop    = static_cast< proshade_signed > ( std::ceil  ( mapX ) ); if ( xTop    < 1 ) { xTop    = 1; } if ( xTop    >= dim ) { xTop    = dim - 1; }
+        yTop    = static_cast< proshade_signed > ( std::ceil  ( mapY ) ); if ( yTop    < 1 ) { yTop    = 1; } if ( yTop    >= dim ) { yTop    = dim - 1; }
+        zTop    = static_cast< proshade_signed > ( std::ceil  ( mapZ ) ); if ( zTop    < 1 ) { zTop    = 1; } if ( zTop    >= dim ) { zTop    = dim - 1; }
+        
+        //============================================ Solve for X
+        xRelative                                     = mapX - std::floor( mapX );
+        c00                                           = ( magnitude ( zBottom + dim * ( yBottom + dim * xBottom ) ) * ( 1.0 - xRelative ) ) + ( magnitude ( zBottom + dim * ( yBottom + dim * xTop ) ) * xRelative );
+        c01                                           = ( magnitude ( zTop    + dim * ( yBottom + dim * xBottom ) ) * ( 1.0 - xRelative ) ) + ( magnitude ( zTop    + dim * ( yBottom + dim * xTop ) ) * xRelative );
+        c10                                           = ( magnitude ( zBottom + dim * ( yTop    + dim * xBottom ) ) * ( 1.0 - xRelative ) ) + ( magnitude ( zBottom + dim * ( yTop    + dim * xTop ) ) * xRelative );
+        c11                                           = ( magnitude ( zTop    + dim * ( yTop    + dim * xBottom ) ) * ( 1.0 - xRelative ) ) + ( magnitude ( zTop    + dim * ( yTop    + dim * xTop ) ) * xRelative );
+        
+        //============================================ Solve for Y
+        yRelative                                     = mapY - std::floor( mapY );
+        c0                                            = ( c00 * ( 1.0 - yRelative ) ) + ( c10 * yRelative );
+        c1                                            = ( c01 * ( 1.0 - yRelative ) ) + ( c11 * yRelative );
+        
+        //============================================ Solve for Z and save result
+        zRelative                                     = mapZ - std::floor( mapZ );
+        axesValues[ptIt]                              = ( c0 * ( 1.0 - zRelative ) ) + ( c1 * zRelative );
+    }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Function for interpolating the sphere grid values from angle-axis converted rotation function.
+ 
+    This function obtains the (shared) rotation function map positions of all the sphere sampling points and then interpolates the
+    squared magnitude of the rotation function for each of them, thus effectivelly re-sampling the rotation function space onto the sphere.
+ 
+    \param[in] rotFun proshade_complex pointer to the rotation function values.
+    \param[in] geometry Pointer to the sampling positions cache of the structure whose rotation function is being converted.
+ */
+void ProSHADE_internal_spheres::ProSHADE_rotFun_sphere::interpolateSphereValues ( proshade_complex* rotFun, ProSHADE_rotFun_sphereGeometry* geometry )
+{
+    //================================================ Get the sampling positions
+    std::vector< proshade_double > localPositions;
+    const proshade_double* positions                  = this->getSamplingPositions ( geometry, &localPositions );
+    
+    //================================================ Interpolate the squared magnitudes
+    interpolateRotFunMagnitudes                       ( positions, this->angularDim, this->rotFunDim, [rotFun] ( proshade_signed mapIndex ) { return ( ( rotFun[mapIndex][0] * rotFun[mapIndex][0] ) + ( rotFun[mapIndex][1] * rotFun[mapIndex][1] ) ); }, this->axesValues );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief Function for interpolating the sphere grid values from pre-computed rotation function squared magnitudes.
+ 
+    This function does the same as the rotation function version, but reads the already computed squared magnitudes of the rotation function,
+    which is faster when many spheres are interpolated from the same rotation function.
+ 
+    \param[in] rotFunMagnitudes Pointer to the squared magnitudes of the rotation function values.
+    \param[in] geometry Pointer to the sampling positions cache of the structure whose rotation function is being converted.
+ */
+void ProSHADE_internal_spheres::ProSHADE_rotFun_sphere::interpolateSphereValues ( proshade_double* rotFunMagnitudes, ProSHADE_rotFun_sphereGeometry* geometry )
+{
+    //================================================ Get the sampling positions
+    std::vector< proshade_double > localPositions;
+    const proshade_double* positions                  = this->getSamplingPositions ( geometry, &localPositions );
+    
+    //================================================ Interpolate the squared magnitudes
+    interpolateRotFunMagnitudes                       ( positions, this->angularDim, this->rotFunDim, [rotFunMagnitudes] ( proshade_signed mapIndex ) { return ( rotFunMagnitudes[mapIndex] ); }, this->axesValues );
+    
     //================================================ Done
     return ;
     
@@ -69,28 +69,10 @@ namespace ProSHADE_internal_spheres
         
     protected:
         proshade_unsign getMaxCircumference           ( proshade_unsign xDimMax, proshade_unsign yDimMax, proshade_unsign zDimMax, proshade_single maxRange );
-        bool getMapPoint                              ( proshade_double* map, proshade_unsign xDimMax, proshade_unsign yDimMax,
-                                                        proshade_unsign zDimMax, proshade_signed xPos,
-                                                        proshade_signed yPos, proshade_signed zPos, std::vector<proshade_double>* interpVec );
         void getLongitudeCutoffs                      ( std::vector<proshade_double>* lonCO );
         void getLattitudeCutoffs                      ( std::vector<proshade_double>* latCO );
-        void getInterpolationXYZ                      ( proshade_double* x, proshade_double* y, proshade_double* z,
-                                                        proshade_double thetaIt, std::vector<proshade_double>* lonCO,
-                                                        proshade_unsign phiIt, std::vector<proshade_double>* latCO );
-        void getXYZTopBottoms                         ( proshade_unsign xDimMax, proshade_unsign yDimMax, proshade_unsign zDimMax,
-                                                        proshade_double x, proshade_double y, proshade_double z,
-                                                        proshade_signed* xBottom, proshade_signed* yBottom, proshade_signed* zBottom,
-                                                        proshade_signed* xTop,
-                                                        proshade_signed* yTop, proshade_signed* zTop );
-        void interpolateAlongFirst                    ( std::vector<proshade_double> c000, std::vector<proshade_double> c001, std::vector<proshade_double> c010,
-                                                        std::vector<proshade_double> c011, std::vector<proshade_double> c100, std::vector<proshade_double> c101,
-                                                        std::vector<proshade_double> c110, std::vector<proshade_double> c111,
-                                                        std::vector<proshade_double>* c00, std::vector<proshade_double>* c01,
-                                                        std::vector<proshade_double>* c10, std::vector<proshade_double>* c11,
-                                                        proshade_double xd );
-        void interpolateAlongSecond                   ( std::vector<proshade_double> c00, std::vector<proshade_double> c01,
-                                                        std::vector<proshade_double> c10, std::vector<proshade_double> c11,
-                                                        std::vector<proshade_double>* c0, std::vector<proshade_double>* c1, proshade_double yd );
+        void getSamplingAngles                        ( std::vector<proshade_double>* cosLon, std::vector<proshade_double>* sinLon,
+                                                        std::vector<proshade_double>* cosLat, std::vector<proshade_double>* sinLat );
         void mapData                                  ( proshade_double* map, proshade_unsign xDimMax, proshade_unsign yDimMax, proshade_unsign zDimMax );
         
     public:
@@ -22,6 +22,12 @@
 //==================================================== ProSHADE
 #include "ProSHADE_sphericalHarmonics.hpp"
 
+//==================================================== Local variables
+namespace ProSHADE_internal_sphericalHarmonics
+{
+    static const size_t maxPooledWorkspaces           = 8; //!< The maximum number of different bandwidth workspaces kept for a single worker.
+}
+
 /*! \brief This function determines the integration order for the between spheres integration.
  
     This function simply takes all pointer variables required for the spherical harmonics computation and allocates the required
@@ -41,9 +47,9 @@ void ProSHADE_internal_sphericalHarmonics::allocateComputationMemory ( proshade_
     //================================================ Initialise local variables
     proshade_unsign oneDimmension                     = 2 * band;
     
-    //================================================ Allocate Input Memory
-    inputReal                                         = new proshade_double [oneDimmension * oneDimmension];
-    inputImag                                         = new proshade_double [oneDimmension * oneDimmension];
+    //================================================ Allocate Input Memory (single block, so that the real/imaginary separation is the same for the cached FFTW plan)
+    inputReal                                         = new proshade_double [oneDimmension * oneDimmension * 2];
+    inputImag                                         = inputReal + ( oneDimmension * oneDimmension );
     
     //================================================ Allocate Output Memory
     outputReal                                        = new proshade_double [oneDimmension * oneDimmension];
@@ -124,9 +130,6 @@ void ProSHADE_internal_sphericalHarmonics::initialiseFFTWPlans ( proshade_unsign
     //================================================ Initialize fft plan along phi angles
     fftw_iodim dims[1];
     fftw_iodim howmany_dims[1];
-    
-    int rank                                          = 1;
-    int howmany_rank                                  = 1;
             
     dims[0].n                                         = static_cast<int> ( band * 2 );
     dims[0].is                                        = 1;
@@ -136,23 +139,23 @@ void ProSHADE_internal_sphericalHarmonics::initialiseFFTWPlans ( proshade_unsign
     howmany_dims[0].is                                = static_cast<int> ( band * 2 );
     howmany_dims[0].os                                = 1;
     
-    //================================================ Plan fft transform
-    fftPlan                                           = fftw_plan_guru_split_dft ( rank,
-                                                                                   dims,
-                                                                                   howmany_rank,
-                                                                                   howmany_dims,
-                                                                                   inputReal,
-                                                                                   inputImag,
-                                                                                   rres,
-                                                                                   ires,
-                                                                                   FFTW_ESTIMATE  );
-    
-    //================================================ Initialize dct plan for SHT
-    dctPlan                                           = fftw_plan_r2r_1d ( static_cast<int> ( band * 2 ),
-                                                                           scratchpad,
-                                                                           scratchpad + static_cast<int> ( band * 2 ),
-                                                                           FFTW_REDFT10,
-                                                                           FFTW_ESTIMATE ) ;
+    //================================================ Get the fft transform plan from the cache
+    fftPlan                                           = ProSHADE_internal_fftw::getSplitDFTPlan ( dims[0].n,
+                                                                                                  howmany_dims[0].n,
+                                                                                                  dims[0].is,
+                                                                                                  howmany_dims[0].is,
+                                                                                                  dims[0].os,
+                                                                                                  howmany_dims[0].os,
+                                                                                                  inputReal,
+                                                                                                  inputImag,
+                                                                                                  rres,
+                                                                                                  ires );
+    
+    //================================================ Get the dct plan for SHT from the cache
+    dctPlan                                           = ProSHADE_internal_fftw::getR2R1DPlan ( static_cast<int> ( band * 2 ),
+                                                                                               scratchpad,
+                                                                                               scratchpad + static_cast<int> ( band * 2 ),
+                                                                                               FFTW_REDFT10 );
     
     //================================================ Done
     return ;
@@ -178,24 +181,26 @@ void ProSHADE_internal_sphericalHarmonics::initialiseFFTWPlans ( proshade_unsign
  */
 void ProSHADE_internal_sphericalHarmonics::releaseSphericalMemory ( proshade_double*& inputReal, proshade_double*& inputImag, proshade_double*& outputReal, proshade_double*& outputImag, double*& tableSpaceHelper, double**& tableSpace, double*& shWeights, fftw_complex*& workspace, fftw_plan& fftPlan, fftw_plan& dctPlan )
 {
-    //================================================ Release all memory related to SH
+    //================================================ Release all memory related to SH (the imaginary input is within the real input block)
     delete[] inputReal;
-    delete[] inputImag;
     delete[] outputReal;
     delete[] outputImag;
     delete[] tableSpaceHelper;
     delete[] shWeights;
+    free                                              ( tableSpace );
     fftw_free                                         ( workspace );
             
     //================================================ Set pointers to NULL
+    inputReal                                         = nullptr;
+    inputImag                                         = nullptr;
     tableSpaceHelper                                  = nullptr;
     tableSpace                                        = nullptr;
     shWeights                                         = nullptr;
     workspace                                         = nullptr;
           
-    //================================================ Delete fftw plans
-    fftw_destroy_plan                                 ( dctPlan );
-    fftw_destroy_plan                                 ( fftPlan );
+    //================================================ The fftw plans are owned by the plans cache, just forget them
+    dctPlan                                           = nullptr;
+    fftPlan                                           = nullptr;
     
     //================================================ Done
     return ;
@@ -391,24 +396,21 @@ void ProSHADE_internal_sphericalHarmonics::applyCondonShortleyPhase ( proshade_u
 
 /*! \brief This function computes the spherical harmonics of a aingle shell, saving them in supplied pointer.
  
-    This function does all the spherical harmonics computations for a single shell, including the memory allocation and
-    releasing and the FFTW transforms. Because the shells can have different resolutions, the memory management is left
-    until here, but possible speed-up could be gained from having the same resolution on all shells as in the older ProSHADE
-    versions.
+    This function does all the spherical harmonics computations for a single shell, including the FFTW transforms. The memory, the
+    Legendre polynomials table, the weights and the plans are taken from the supplied workspace for the given bandwidth (see
+    ProSHADE_SH_workspacePool::getWorkspace()), so that they are only computed once for all the shells with the same bandwidth.
  
     \param[in] band The bandwidth to which the computation will be done.
     \param[in] sphereMappedData An array of doubles containing the mapped data onto a sphere for the sphere to be decomposed.
     \param[in] shArray An array of complex numbers to which the results of the spherical harmonics decomposition are to be saved.
+    \param[in] shWsp The workspace for the bandwidth, which must not be used by any other thread at the same time.
  */
-void ProSHADE_internal_sphericalHarmonics::computeSphericalHarmonics ( proshade_unsign band, proshade_double* sphereMappedData, proshade_complex*& shArray )
+void ProSHADE_internal_sphericalHarmonics::computeSphericalHarmonics ( proshade_unsign band, proshade_double* sphereMappedData, proshade_complex*& shArray, ProSHADE_SH_workspace* shWsp )
 {
     //================================================ Initialise local variables
-    proshade_double *inputReal = nullptr, *inputImag = nullptr, *outputReal = nullptr, *outputImag = nullptr;
-    double *shWeights = nullptr, *tableSpaceHelper = nullptr;
-    double** tablePml                                 = nullptr;
-    fftw_complex* workspace                           = nullptr;
     proshade_unsign oneDim                            = static_cast<proshade_unsign> ( band * 2 );
     proshade_double normCoeff                         = ( 1.0 / ( static_cast<proshade_double> ( band * 2 ) ) ) * sqrt( 2.0 * M_PI );
+    proshade_double *rdataptr = nullptr, *idataptr = nullptr;
     
     //================================================ Set output to zeroes (so that all unfilled data are not random)
     for ( proshade_unsign i = 0; i < ( 2 * band * 2 * band); i++ )
@@ -417,28 +419,165 @@ void ProSHADE_internal_sphericalHarmonics::computeSphericalHarmonics ( proshade_
         shArray[i][1]                                 = 0.0;
     }
     
-    //================================================ Within workspace pointers
-    proshade_double *rres = nullptr, *ires = nullptr, *fltres = nullptr, *scratchpad = nullptr, *rdataptr = nullptr, *idataptr = nullptr;
-    
-    //================================================ FFTW Plans
-    fftw_plan fftPlan                                 = nullptr;
-    fftw_plan dctPlan                                 = nullptr;
-    
-    //================================================ Initialise all memory
-    initialiseAllMemory                               ( band, inputReal, inputImag, outputReal, outputImag, shWeights, tablePml, tableSpaceHelper, workspace,
-                                                        rres, ires, fltres, scratchpad, fftPlan, dctPlan );
-    
     //================================================ Do the initial discrete split transform
-    initialSplitDiscreteTransform                     ( oneDim, inputReal, inputImag, rres, ires, sphereMappedData, fftPlan, normCoeff );
+    initialSplitDiscreteTransform                     ( oneDim, shWsp->inputReal, shWsp->inputImag, shWsp->rres, shWsp->ires, sphereMappedData, shWsp->fftPlan, normCoeff );
     
     //================================================ Complete the spherical harmonics transform
-    computeSphericalTransformCoeffs                   ( band, rdataptr, idataptr, outputReal, outputImag, rres, ires, fltres, scratchpad, tablePml, shWeights, dctPlan );
+    computeSphericalTransformCoeffs                   ( band, rdataptr, idataptr, shWsp->outputReal, shWsp->outputImag, shWsp->rres, shWsp->ires, shWsp->fltres, shWsp->scratchpad, shWsp->tablePml, shWsp->shWeights, shWsp->dctPlan );
     
     //================================================ Apply the Condon-Shortley phase and save result to the final array
-    applyCondonShortleyPhase                          ( band, outputReal, outputImag, shArray );
+    applyCondonShortleyPhase                          ( band, shWsp->outputReal, shWsp->outputImag, shArray );
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This is the constructor for the spherical harmonics workspace.
+ 
+    This constructor allocates all the memory required for the spherical harmonics computation of the given bandwidth, pre-computes the
+    Legendre polynomials table and the weights and obtains the FFTW plans.
+ 
+    \param[in] bandwidth The bandwidth for which the workspace is to be prepared.
+ */
+ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspace::ProSHADE_SH_workspace ( proshade_unsign bandwidth )
+{
+    //================================================ Initialise variables
+    this->band                                        = bandwidth;
+    this->inputReal                                   = nullptr;
+    this->inputImag                                   = nullptr;
+    this->outputReal                                  = nullptr;
+    this->outputImag                                  = nullptr;
+    this->shWeights                                   = nullptr;
+    this->tablePml                                    = nullptr;
+    this->tableSpaceHelper                            = nullptr;
+    this->workspace                                   = nullptr;
+    this->rres                                        = nullptr;
+    this->ires                                        = nullptr;
+    this->fltres                                      = nullptr;
+    this->scratchpad                                  = nullptr;
+    this->fftPlan                                     = nullptr;
+    this->dctPlan                                     = nullptr;
+    this->lastUsed                                    = 0;
+    
+    //================================================ Allocate memory, compute the tables and weights and get plans
+    initialiseAllMemory                               ( this->band, this->inputReal, this->inputImag, this->outputReal, this->outputImag, this->shWeights, this->tablePml,
+                                                        this->tableSpaceHelper, this->workspace, this->rres, this->ires, this->fltres, this->scratchpad, this->fftPlan, this->dctPlan );
+    
+}
+
+/*! \brief This is the destructor for the spherical harmonics workspace.
+ 
+    This destructor releases all the memory held by the workspace. The FFTW plans are owned by the plans cache and are not destroyed.
+ */
+ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspace::~ProSHADE_SH_workspace ( void )
+{
+    //================================================ Release all memory
+    releaseSphericalMemory                            ( this->inputReal, this->inputImag, this->outputReal, this->outputImag, this->tableSpaceHelper, this->tablePml,
+                                                        this->shWeights, this->workspace, this->fftPlan, this->dctPlan );
+    
+}
+
+/*! \brief This is the constructor for the spherical harmonics workspaces pool.
+ */
+ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspacePool::ProSHADE_SH_workspacePool ( void )
+{
+    //================================================ Nothing to do, workspaces are created on request
+    
+}
+
+/*! \brief This is the destructor for the spherical harmonics workspaces pool, releasing all the workspaces.
+ */
+ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspacePool::~ProSHADE_SH_workspacePool ( void )
+{
+    //================================================ Release all workspaces
+    this->releaseWorkspaces                           ( );
+    
+}
+
+/*! \brief This function returns the spherical harmonics workspace of the given worker for the given bandwidth.
+ 
+    This function looks up the workspace for the required bandwidth in the set of the given worker and creates it if it does not
+    exist yet. As each worker has its own set, the returned workspace can be used without any locking, as long as no two threads
+    use the same worker index at the same time (which parallelFor() guarantees). If the set already contains the maximum number
+    of workspaces, the least recently used one is released first, so that the progressive mapping (where many different bandwidths
+    are used) does not accumulate the tables for all of them.
+ 
+    \param[in] band The bandwidth for which the workspace is required.
+    \param[in] workerIt The index of the worker requesting the workspace.
+    \param[out] X Pointer to the workspace, which is owned by the pool and must not be deleted by the caller.
+ */
+ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspace* ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspacePool::getWorkspace ( proshade_unsign band, proshade_unsign workerIt )
+{
+    //================================================ Sanity check (the workers sets must exist before the parallel loop starts)
+    if ( static_cast< size_t > ( workerIt ) >= this->workspaces.size ( ) )
+    {
+        throw ProSHADE_exception ( "Spherical harmonics workspace requested for unknown worker.", "ED00082", __FILE__, __LINE__, __func__, "The spherical harmonics workspaces pool was asked for the\n                    : workspace of a worker it has not been sized for. The pool\n                    : needs to be sized using reserveWorkers() before the\n                    : parallel loop starts." );
+    }
+    std::map< proshade_unsign, ProSHADE_SH_workspace* >& workerSet = this->workspaces.at ( workerIt );
+    
+    //================================================ Find the workspace, if it exists
+    this->useCounters.at ( workerIt )                += 1;
+    std::map< proshade_unsign, ProSHADE_SH_workspace* >::iterator wspIt = workerSet.find ( band );
+    if ( wspIt != workerSet.end ( ) )
+    {
+        wspIt->second->lastUsed                       = this->useCounters.at ( workerIt );
+        return                                        ( wspIt->second );
+    }
+    
+    //================================================ If the set is full, release the least recently used workspace
+    if ( workerSet.size ( ) >= maxPooledWorkspaces )
+    {
+        std::map< proshade_unsign, ProSHADE_SH_workspace* >::iterator oldest = workerSet.begin ( );
+        for ( wspIt = workerSet.begin ( ); wspIt != workerSet.end ( ); wspIt++ ) { if ( wspIt->second->lastUsed < oldest->second->lastUsed ) { oldest = wspIt; } }
+        delete oldest->second;
+        workerSet.erase                               ( oldest );
+    }
+    
+    //================================================ Create the new workspace
+    ProSHADE_SH_workspace* newWsp                     = new ProSHADE_SH_workspace ( band );
+    ProSHADE_internal_misc::checkMemoryAllocation     ( newWsp, __FILE__, __LINE__, __func__ );
+    newWsp->lastUsed                                  = this->useCounters.at ( workerIt );
+    workerSet[band]                                   = newWsp;
+    
+    //================================================ Done
+    return                                            ( newWsp );
+    
+}
+
+/*! \brief This function makes sure the pool holds a workspaces set for each of the given number of workers.
+ 
+    This function must be called before the parallel loop using the pool starts, as the sets cannot be added safely from within the loop.
+ 
+    \param[in] noWorkers The number of workers which will request workspaces.
+ */
+void ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspacePool::reserveWorkers ( proshade_unsign noWorkers )
+{
+    //================================================ Add the missing sets
+    if ( this->workspaces.size ( ) < static_cast< size_t > ( noWorkers ) )
+    {
+        this->workspaces.resize                       ( static_cast< size_t > ( noWorkers ) );
+        this->useCounters.resize                      ( static_cast< size_t > ( noWorkers ), 0 );
+    }
+    
+    //================================================ Done
+    return ;
     
-    //================================================ Free memory
-    releaseSphericalMemory                            ( inputReal, inputImag, outputReal, outputImag, tableSpaceHelper, tablePml, shWeights, workspace, fftPlan, dctPlan );
+}
+
+/*! \brief This function releases all the spherical harmonics workspaces held by the pool.
+ */
+void ProSHADE_internal_sphericalHarmonics::ProSHADE_SH_workspacePool::releaseWorkspaces ( void )
+{
+    //================================================ Delete all workspaces of all workers
+    for ( size_t wIt = 0; wIt < this->workspaces.size ( ); wIt++ )
+    {
+        for ( std::map< proshade_unsign, ProSHADE_SH_workspace* >::iterator wspIt = this->workspaces.at(wIt).begin ( ); wspIt != this->workspaces.at(wIt).end ( ); wspIt++ )
+        {
+            delete wspIt->second;
+        }
+        this->workspaces.at(wIt).clear                ( );
+    }
     
     //================================================ Done
     return ;
@@ -36,6 +36,63 @@
  */
 namespace ProSHADE_internal_sphericalHarmonics
 {
+/*! \class ProSHADE_SH_workspace
+    \brief This class holds all the memory, the Legendre polynomials table, the weights and the FFTW plans required for the spherical harmonics computation of a single bandwidth.
+ 
+    Because all shells of the same bandwidth (and all shells of all structures, if the bandwidth does not change) require the same
+    Legendre polynomials table and weights, the workspace is computed only once for each bandwidth and then re-used for all the shells.
+    The workspaces are kept in a ProSHADE_SH_workspacePool, which holds a separate set for each worker, so that the shells can be
+    decomposed concurrently.
+ */
+    class ProSHADE_SH_workspace
+    {
+    public:
+        proshade_unsign band;
+        proshade_double* inputReal;
+        proshade_double* inputImag;
+        proshade_double* outputReal;
+        proshade_double* outputImag;
+        double* shWeights;
+        double** tablePml;
+        double* tableSpaceHelper;
+        fftw_complex* workspace;
+        proshade_double* rres;
+        proshade_double* ires;
+        proshade_double* fltres;
+        proshade_double* scratchpad;
+        fftw_plan fftPlan;
+        fftw_plan dctPlan;
+        proshade_unsign lastUsed;
+        
+    public:
+        ProSHADE_SH_workspace                         ( proshade_unsign bandwidth );
+       ~ProSHADE_SH_workspace                         ( void );
+    };
+    
+/*! \class ProSHADE_SH_workspacePool
+    \brief This class owns the spherical harmonics workspaces of all the workers decomposing the shells of a structure.
+ 
+    Each worker (as numbered by ProSHADE_internal_misc::parallelFor()) has its own set of workspaces keyed by the bandwidth, so that
+    the returned workspace can be used without any locking. The pool is owned by the structure (ProSHADE_data) and so the workspaces
+    survive between the parallel loops and the repeated decompositions of the structure; they are all released when the pool is
+    deleted or when releaseWorkspaces() is called.
+ */
+    class ProSHADE_SH_workspacePool
+    {
+    private:
+        std::vector< std::map< proshade_unsign, ProSHADE_SH_workspace* > > workspaces;
+        std::vector< proshade_unsign > useCounters;
+        
+    public:
+        ProSHADE_SH_workspacePool                     ( void );
+       ~ProSHADE_SH_workspacePool                     ( void );
+        
+    public:
+        ProSHADE_SH_workspace* getWorkspace           ( proshade_unsign band, proshade_unsign workerIt );
+        void reserveWorkers                           ( proshade_unsign noWorkers );
+        void releaseWorkspaces                        ( void );
+    };
+    
     void allocateComputationMemory                    ( proshade_unsign band, proshade_double*& inputReal, proshade_double*& inputImag, proshade_double*& outputReal,
                                                         proshade_double*& outputImag, double*& shWeights, double*& tableSpaceHelper, fftw_complex*& workspace );
     void placeWithinWorkspacePointers                 ( fftw_complex*& workspace, proshade_unsign oDim, proshade_double*& rres, proshade_double*& ires,
@@ -60,7 +117,8 @@ namespace ProSHADE_internal_sphericalHarmonics
                                                         proshade_double*& scratchpad, double**& tablePml, double*& shWeights, fftw_plan& dctPlan );
     void applyCondonShortleyPhase                     ( proshade_unsign band, proshade_double* outputReal, proshade_double* outputImag,
                                                         proshade_complex*& shArray );
-    void computeSphericalHarmonics                    ( proshade_unsign band, proshade_double* sphereMappedData, proshade_complex*& shArray );
+    void computeSphericalHarmonics                    ( proshade_unsign band, proshade_double* sphereMappedData, proshade_complex*& shArray,
+                                                        ProSHADE_SH_workspace* shWsp );
 }
 
 #endif 
@@ -98,13 +98,15 @@ proshade_double determinePeakThreshold ( std::vector < proshade_double > inArr,
         
         //============================================ Get the threshold
         ret                                           = std::min ( mean + ( noIQRsFromMedian * rmsd ), startMinVal );
-        for ( size_t iter = 0; iter < inArr.size(); iter++ ) { if ( inArr.at(iter) > ret ) { noVals += 1; } }
-        while ( noVals > 1000)
+        
+        //============================================ More than 1000 values are above the threshold exactly when it is below the 1001st largest value, so select that value once instead of re-counting for each step
+        if ( vecSize > 1000 )
         {
-            noVals                                    = 0;
-            ret                                      += 0.01;
-            for ( size_t iter = 0; iter < inArr.size(); iter++ ) { if ( inArr.at(iter) > ret ) { noVals += 1; } }
+            std::nth_element                          ( inArr.begin(), inArr.begin() + static_cast< std::ptrdiff_t > ( vecSize - 1001 ), inArr.end() );
+            proshade_double limitVal                  = inArr.at( vecSize - 1001 );
+            while ( ret < limitVal ) { ret += 0.01; }
         }
+        noVals                                        = static_cast< proshade_unsign > ( std::count_if ( inArr.begin(), inArr.end(), [&] ( proshade_double val ) { return ( val > ret ); } ) );
         if ( noVals == 0 ) { ret -= 0.01; }
     }
     
@@ -152,17 +154,23 @@ void ProSHADE_internal_data::ProSHADE_data::convertRotationFunction ( ProSHADE_s
                                                                                                                spIt - 1 ) );
     }
 
-    //================================================ Interpolate the rotation function onto the spheres
-    for ( proshade_unsign shIt = 0; shIt < static_cast<proshade_unsign> ( sphereMappedRotFun.size() ); shIt++ )
+    //================================================ Compute the rotation function squared magnitudes once for all spheres
+    size_t rotFunSize                                 = static_cast< size_t > ( this->getEMatDim ( ) * 2 ) * static_cast< size_t > ( this->getEMatDim ( ) * 2 ) * static_cast< size_t > ( this->getEMatDim ( ) * 2 );
+    std::vector< proshade_double > rotFunMagnitudes   ( rotFunSize );
+    proshade_complex* rotFun                          = this->getInvSO3Coeffs ( );
+    for ( size_t iter = 0; iter < rotFunSize; iter++ ) { rotFunMagnitudes[iter] = ( rotFun[iter][0] * rotFun[iter][0] ) + ( rotFun[iter][1] * rotFun[iter][1] ); }
+    
+    //================================================ Report progress
+    std::stringstream hlpSSI;
+    hlpSSI << "Interpolating " << this->sphereMappedRotFun.size() << " spheres.";
+    ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 3, hlpSSI.str(), settings->messageShift );
+    
+    //================================================ Interpolate the rotation function onto the spheres in parallel
+    ProSHADE_internal_spheres::ProSHADE_rotFun_sphereGeometry* geometry = this->getRotFunSphereGeometry ( );
+    ProSHADE_internal_misc::parallelFor               ( static_cast< proshade_unsign > ( this->sphereMappedRotFun.size() ), settings->noThreads, [&] ( proshade_unsign shIt, proshade_unsign )
     {
-        //============================================ Report progress
-        std::stringstream hlpSS;
-        hlpSS << "Interpolating sphere " << shIt << " ( radius: " << this->sphereMappedRotFun.at(shIt)->getRadius() << " ).";
-        ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 3, hlpSS.str(), settings->messageShift );
-        
-        //============================================ Interpolate onto spheres
-        this->sphereMappedRotFun.at(shIt)->interpolateSphereValues ( this->getInvSO3Coeffs ( ) );
-    }
+        this->sphereMappedRotFun.at(shIt)->interpolateSphereValues ( &rotFunMagnitudes[0], geometry );
+    } );
     
     //================================================ Report completion
     ProSHADE_internal_messages::printProgressMessage  ( settings->verbose, 2, "Self-rotation function converted to spherical angle-axis space.", settings->messageShift );
@@ -1676,11 +1684,26 @@ std::vector< proshade_double* > ProSHADE_internal_data::ProSHADE_data::decidePol
         fscVal                                        = 0.0;
         fscValAvg                                     = 0.0;
         
+        //============================================ Unless the fast search is to stop at the first low FSC, match all axes and compute their FSCs concurrently
+        std::vector< proshade_signed > matchedAxes;
+        if ( !settings->fastISearch )
+        {
+            std::vector< proshade_double* > fscAxes;
+            for ( size_t aIt = 0; aIt < polyList->at(gIt).size(); aIt++ )
+            {
+                matchedPos                            = ProSHADE_internal_symmetry::addAxisUnlessSame ( static_cast< proshade_unsign > ( polyList->at(gIt).at(aIt)[0] ), polyList->at(gIt).at(aIt)[1], polyList->at(gIt).at(aIt)[2], polyList->at(gIt).at(aIt)[3], polyList->at(gIt).at(aIt)[5], polyList->at(gIt).at(aIt)[6], CSyms, tolerance );
+                matchedAxes.push_back                 ( matchedPos );
+                fscAxes.push_back                     ( CSyms->at( static_cast< size_t > ( matchedPos ) ) );
+            }
+            this->computeFSCBatch                     ( settings, &fscAxes, cutIndices, fCoeffsCut, noBins, xDim, yDim, zDim );
+        }
+        
         //============================================ For each axis
         for ( size_t aIt = 0; aIt < polyList->at(gIt).size(); aIt++ )
         {
             //======================================== Match to CSyms
-            matchedPos                                = ProSHADE_internal_symmetry::addAxisUnlessSame ( static_cast< proshade_unsign > ( polyList->at(gIt).at(aIt)[0] ), polyList->at(gIt).at(aIt)[1], polyList->at(gIt).at(aIt)[2], polyList->at(gIt).at(aIt)[3], polyList->at(gIt).at(aIt)[5], polyList->at(gIt).at(aIt)[6], CSyms, tolerance );
+            if ( settings->fastISearch ) { matchedPos = ProSHADE_internal_symmetry::addAxisUnlessSame ( static_cast< proshade_unsign > ( polyList->at(gIt).at(aIt)[0] ), polyList->at(gIt).at(aIt)[1], polyList->at(gIt).at(aIt)[2], polyList->at(gIt).at(aIt)[3], polyList->at(gIt).at(aIt)[5], polyList->at(gIt).at(aIt)[6], CSyms, tolerance ); }
+            else                         { matchedPos = matchedAxes.at(aIt); }
             
             //======================================== Compute FSC
             fscVal                                    = this->computeFSC ( settings, CSyms, static_cast< size_t > ( matchedPos ), cutIndices, fCoeffsCut, noBins, bindata, binCounts, fscByBin, xDim, yDim, zDim );
@@ -2973,7 +2996,7 @@ std::vector < proshade_double* > ProSHADE_internal_data::ProSHADE_data::findRequ
                                                                                                                 static_cast < proshade_unsign > ( angIt - 1.0 ) ) );
         
         //=========================================== Interpolate rotation function onto the sphere
-        this->sphereMappedRotFun.at(static_cast < size_t > ( angIt - 1.0 ))->interpolateSphereValues ( this->getInvSO3Coeffs ( ) );
+        this->sphereMappedRotFun.at(static_cast < size_t > ( angIt - 1.0 ))->interpolateSphereValues ( this->getInvSO3Coeffs ( ), this->getRotFunSphereGeometry ( ) );
         
         //============================================ Find all peaks for this sphere
         this->sphereMappedRotFun.at(static_cast < size_t > ( angIt - 1.0 ))->findAllPeaks ( static_cast< proshade_signed > ( settings->peakNeighbours ), &allPeakHeights );
@@ -3106,7 +3129,7 @@ void ProSHADE_internal_symmetry::findPredictedAxesHeights ( std::vector< proshad
                                                                                                                 static_cast<proshade_unsign> ( angIt ) ) );
 
         //=========================================== Interpolate rotation function onto the sphere
-        dataObj->sphereMappedRotFun.at( static_cast < proshade_unsign > ( angIt ))->interpolateSphereValues ( dataObj->getInvSO3Coeffs ( ) );
+        dataObj->sphereMappedRotFun.at( static_cast < proshade_unsign > ( angIt ))->interpolateSphereValues ( dataObj->getInvSO3Coeffs ( ), dataObj->getRotFunSphereGeometry ( ) );
     }
     
     //================================================ Check for improved sum
@@ -3429,7 +3452,7 @@ proshade_double ProSHADE_internal_symmetry::findPredictedSingleAxisHeight ( pros
                                                                                                                 static_cast<proshade_unsign> ( angIt - 1.0 ) ) );
         
         //============================================ Interpolate rotation function onto the sphere
-        dataObj->sphereMappedRotFun.at( static_cast < proshade_unsign > ( angIt - 1.0 ))->interpolateSphereValues ( dataObj->getInvSO3Coeffs ( ) );
+        dataObj->sphereMappedRotFun.at( static_cast < proshade_unsign > ( angIt - 1.0 ))->interpolateSphereValues ( dataObj->getInvSO3Coeffs ( ), dataObj->getRotFunSphereGeometry ( ) );
     }
     
     //================================================ Convert XYZ to lat and lon INDICES
@@ -3856,10 +3879,10 @@ void ProSHADE_internal_symmetry::allocateCentreOfMapFourierTransforms ( proshade
     ProSHADE_internal_misc::checkMemoryAllocation     ( trFunc,        __FILE__, __LINE__, __func__ );
     ProSHADE_internal_misc::checkMemoryAllocation     ( trFuncCoeffs,  __FILE__, __LINE__, __func__ );
     
-    //================================================
-   *planForwardFourier                                = fftw_plan_dft_3d ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), origMap,       origCoeffs, FFTW_FORWARD,   FFTW_ESTIMATE );
-   *planForwardFourierRot                             = fftw_plan_dft_3d ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), rotMapComplex, rotCoeffs,  FFTW_FORWARD,   FFTW_ESTIMATE );
-   *planReverseFourierComb                            = fftw_plan_dft_3d ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), trFuncCoeffs,  trFunc,     FFTW_BACKWARD,  FFTW_ESTIMATE );
+    //================================================ Get the plans from the plans cache
+   *planForwardFourier                                = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), origMap,       origCoeffs, FFTW_FORWARD   );
+   *planForwardFourierRot                             = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), rotMapComplex, rotCoeffs,  FFTW_FORWARD   );
+   *planReverseFourierComb                            = ProSHADE_internal_fftw::getDFT3DPlan ( static_cast< int > ( xDim ), static_cast< int > ( yDim ), static_cast< int > ( zDim ), trFuncCoeffs,  trFunc,     FFTW_BACKWARD  );
     
     //================================================ Done
     return ;
@@ -3874,22 +3897,12 @@ void ProSHADE_internal_symmetry::allocateCentreOfMapFourierTransforms ( proshade
     \param[in] rotCoeffs Array to which the result of the Fourier transform of the rotated map will be saved into.
     \param[in] trFunc Array to which the results of inverse Fourier transform of the conbined coefficients will be saved.
     \param[in] trFuncCoeffs Array to which the two maps coefficients will be combined into before inverse Fourier transform computation.
-    \param[in] planForwardFourier FFTW3 plan for the original map Fourier transform.
-    \param[in] planForwardFourierRot FFTW3 plat for the rotated map Fourier transform.
-    \param[in] planReverseFourierComb FFTW3 plan for the inverse Fourier transform from the combined coefficients to translation function.
+ 
+    Note that the FFTW3 plans obtained by the allocateCentreOfMapFourierTransforms() function are owned by the plans cache and are
+    therefore not released here.
  */
-void ProSHADE_internal_symmetry::releaseCentreOfMapFourierTransforms ( fftw_complex *origMap, fftw_complex *origCoeffs, fftw_complex *rotMapComplex, fftw_complex *rotCoeffs, fftw_complex *trFunc, fftw_complex *trFuncCoeffs, fftw_plan planForwardFourier, fftw_plan planForwardFourierRot, fftw_plan planReverseFourierComb )
+void ProSHADE_internal_symmetry::releaseCentreOfMapFourierTransforms ( fftw_complex *origMap, fftw_complex *origCoeffs, fftw_complex *rotMapComplex, fftw_complex *rotCoeffs, fftw_complex *trFunc, fftw_complex *trFuncCoeffs )
 {
-    //================================================ Destroy the FFTW3 plans
-    fftw_destroy_plan                                 ( planReverseFourierComb );
-    fftw_destroy_plan                                 ( planForwardFourier );
-    fftw_destroy_plan                                 ( planForwardFourierRot );
-    
-    //================================================ Set pointers to NULL
-    planReverseFourierComb                            = nullptr;
-    planForwardFourier                                = nullptr;
-    planForwardFourierRot                             = nullptr;
-    
     //================================================ Release the memory
     fftw_free                                         ( origMap );
     fftw_free                                         ( origCoeffs );
@@ -3929,13 +3942,13 @@ std::vector< proshade_double > ProSHADE_internal_symmetry::findTranslationBetwee
     
     //================================================ Convert rotated map to Fourier space
     for ( size_t it = 0; it < static_cast< size_t > ( symStr->getXDim() * symStr->getYDim() * symStr->getZDim() ); it++ ) { rotMapComplex[it][0] = rotMap[it]; rotMapComplex[it][1] = 0.0; }
-    fftw_execute                                      ( planForwardFourierRot );
+    fftw_execute_dft                                  ( planForwardFourierRot, rotMapComplex, rotCoeffs );
     
     //================================================ Combine coeffs for translation function
     ProSHADE_internal_maths::combineFourierForTranslation ( origCoeffs, rotCoeffs, trFuncCoeffs, symStr->getXDim(), symStr->getYDim(), symStr->getZDim() );
     
     //================================================ Compute translation function
-    fftw_execute                                      ( planReverseFourierComb );
+    fftw_execute_dft                                  ( planReverseFourierComb, trFuncCoeffs, trFunc );
     
     //================================================ Find peak
     mapPeak                                           = 0.0;
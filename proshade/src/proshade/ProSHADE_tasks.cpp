@@ -137,7 +137,11 @@ void ProSHADE_internal_tasks::checkMapManipulationSettings ( ProSHADE_settings*
 /*! \brief The distances computation task driver function.
  
     This function is called to proceed with the distances computation task according to the information placed in
-    the settings object passed as the first argument.
+    the settings object passed as the first argument. The structure to which all others are compared is prepared first,
+    the remaining structures are then each read, processed and compared by a pool of worker threads. Each worker holds at
+    most a single structure at any time, so that the number of workers (limited by both the number of threads and the
+    maximum number of in-flight structures) bounds the memory requirements. The results are reported in the input order
+    and are the same irrespective of the number of threads used.
  
     \param[in] settings ProSHADE_settings object specifying the details of how distances computation should be done.
     \param[in] enLevs Pointer to vector where all energy levels distances are to be saved into.
@@ -164,52 +168,307 @@ void ProSHADE_internal_tasks::DistancesComputationTask ( ProSHADE_settings* sett
     //================================================ Get spherical harmonics
     compareAgainst->computeSphericalHarmonics         ( settings );
     
+    //================================================ Pre-compute the RRP matrices, so that this structure is only read from by the workers
+    if ( settings->computeEnergyLevelsDesc ) { compareAgainst->computeRRPMatrices ( settings ); }
+    
+    //================================================ Initialise local variables
+    proshade_unsign noComparisons                     = static_cast< proshade_unsign > ( settings->inputFiles.size() ) - 1;
+    proshade_unsign noWorkers                         = getNumberOfDistancesWorkers ( settings, noComparisons );
+    std::vector< proshade_double > enLevRes           ( noComparisons, 0.0 );
+    std::vector< proshade_double > trSigmRes          ( noComparisons, 0.0 );
+    std::vector< proshade_double > rotFunRes          ( noComparisons, 0.0 );
+    std::vector< ProSHADE_settings* > workerSettings  = createWorkerSettings ( settings, noWorkers );
+    
     //================================================ Now, for each other structure
-    for ( proshade_unsign iter = 1; iter < static_cast<proshade_unsign> ( settings->inputFiles.size() ); iter++ )
+    try
     {
-        //============================================ Create a data object
-        ProSHADE_internal_data::ProSHADE_data* compareChanging = new ProSHADE_internal_data::ProSHADE_data ( );
-
-        //============================================ Read in the compared structure
-        compareChanging->readInStructure              ( settings->inputFiles.at(iter), iter, settings );
+        ProSHADE_internal_misc::parallelFor           ( noComparisons, noWorkers, [&] ( proshade_unsign taskIt, proshade_unsign workerIt )
+        {
+            //======================================== Initialise local variables
+            proshade_unsign iter                      = taskIt + 1;
+            ProSHADE_settings* locSettings            = workerSettings.at(workerIt);
+            
+            //======================================== Create a data object
+            ProSHADE_internal_data::ProSHADE_data* compareChanging = new ProSHADE_internal_data::ProSHADE_data ( );
+            
+            try
+            {
+                //==================================== Read in the compared structure
+                compareChanging->readInStructure      ( locSettings->inputFiles.at(iter), iter, locSettings );
+                
+                //==================================== Internal data processing  (COM, norm, mask, extra space)
+                compareChanging->processInternalMap   ( locSettings );
+                
+                //==================================== Map to sphere
+                compareChanging->mapToSpheres         ( locSettings );
+                
+                //==================================== Get spherical harmonics
+                compareChanging->computeSphericalHarmonics ( locSettings );
+                
+                //==================================== Get distances
+                computeDistancesForPair               ( compareAgainst, compareChanging, locSettings, &enLevRes.at(taskIt), &trSigmRes.at(taskIt), &rotFunRes.at(taskIt) );
+                
+                //==================================== Report results straight away when running serially
+                if ( noWorkers == 1 ) { ReportDistancesResults ( settings, settings->inputFiles.at(0), settings->inputFiles.at(iter), enLevRes.at(taskIt), trSigmRes.at(taskIt), rotFunRes.at(taskIt) ); }
+            }
+            catch ( ... )
+            {
+                delete compareChanging;
+                throw;
+            }
+            
+            //======================================== Release the memory
+            delete compareChanging;
+        } );
+    }
+    catch ( ... )
+    {
+        releaseWorkerSettings                         ( &workerSettings );
+        delete compareAgainst;
+        throw;
+    }
+    
+    //================================================ Save results to the run object and report them in the input order
+    for ( proshade_unsign iter = 0; iter < noComparisons; iter++ )
+    {
+        ProSHADE_internal_misc::addToDoubleVector     ( enLevs, enLevRes.at(iter)  );
+        ProSHADE_internal_misc::addToDoubleVector     ( trSigm, trSigmRes.at(iter) );
+        ProSHADE_internal_misc::addToDoubleVector     ( rotFun, rotFunRes.at(iter) );
+        
+        if ( noWorkers > 1 ) { ReportDistancesResults ( settings, settings->inputFiles.at(0), settings->inputFiles.at(iter+1), enLevRes.at(iter), trSigmRes.at(iter), rotFunRes.at(iter) ); }
+    }
 
-        //============================================ Internal data processing  (COM, norm, mask, extra space)
-        compareChanging->processInternalMap           ( settings );
+    //================================================ Release memory
+    releaseWorkerSettings                             ( &workerSettings );
+    delete compareAgainst;
+    
+    //================================================ Done
+    return ;
+    
+}
 
-        //============================================ Map to sphere
-        compareChanging->mapToSpheres                 ( settings );
-        
-        //============================================ Get spherical harmonics
-        compareChanging->computeSphericalHarmonics    ( settings );
-        
-        //============================================ Get distances
-        proshade_double enLevDist                     = 0.0;
-        if ( settings->computeEnergyLevelsDesc ) { enLevDist  = ProSHADE_internal_distances::computeEnergyLevelsDescriptor ( compareAgainst, compareChanging, settings ); }
-        else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Energy levels distance computation not required.", settings->messageShift ); }
-        
-        proshade_double trSigmDist                    = 0.0;
-        if ( settings->computeTraceSigmaDesc   ) { trSigmDist = ProSHADE_internal_distances::computeTraceSigmaDescriptor ( compareAgainst, compareChanging, settings ); }
-        else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Trace sigma distance computation not required.", settings->messageShift ); }
-        
-        proshade_double rotFunDist                    = 0.0;
-        if ( settings->computeRotationFuncDesc ) { rotFunDist = ProSHADE_internal_distances::computeRotationFunctionDescriptor ( compareAgainst, compareChanging, settings ); }
-        else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Rotation function distance computation not required.", settings->messageShift ); }
-        
-        //============================================ Save results to the run object
-        ProSHADE_internal_misc::addToDoubleVector     ( enLevs, enLevDist  );
-        ProSHADE_internal_misc::addToDoubleVector     ( trSigm, trSigmDist );
-        ProSHADE_internal_misc::addToDoubleVector     ( rotFun, rotFunDist );
+/*! \brief The all-vs-all distances computation task driver function.
+ 
+    This function is called to proceed with the distances computation task when distances between all pairs of the input structures are
+    required. Each structure is read in, processed, mapped onto the spheres, decomposed into spherical harmonics and has its RRP matrices
+    computed exactly once; only the pairwise (E matrices, trace sigma and rotation function) computations are then done for each of the
+    structure pairs. As the descriptors are symmetric, only the upper triangle (including the diagonal) is computed and the results are
+    mirrored to give the full matrices.
+ 
+    Both the structure preparation and the pairwise computations are distributed over the worker threads. The pairwise computations are
+    grouped by the second structure of the pair (which is the only one written into by the distances computation), so that no two workers
+    ever modify the same structure; the longest groups are scheduled first. The results are reported in the same order as when running
+    serially.
+ 
+    \param[in] settings ProSHADE_settings object specifying the details of how distances computation should be done.
+    \param[in] enLevs Pointer to vector where the energy levels distances from the first to all other structures are to be saved into.
+    \param[in] trSigm Pointer to vector where the trace sigma distances from the first to all other structures are to be saved into.
+    \param[in] rotFun Pointer to vector where the rotation function distances from the first to all other structures are to be saved into.
+    \param[in] enLevsMat Pointer to vector of vectors where the full matrix of energy levels distances is to be saved into.
+    \param[in] trSigmMat Pointer to vector of vectors where the full matrix of trace sigma distances is to be saved into.
+    \param[in] rotFunMat Pointer to vector of vectors where the full matrix of rotation function distances is to be saved into.
+ */
+void ProSHADE_internal_tasks::AllDistancesComputationTask ( ProSHADE_settings* settings, std::vector< proshade_double >* enLevs, std::vector< proshade_double >* trSigm, std::vector< proshade_double >* rotFun, std::vector< std::vector< proshade_double > >* enLevsMat, std::vector< std::vector< proshade_double > >* trSigmMat, std::vector< std::vector< proshade_double > >* rotFunMat )
+{
+    //================================================ Check the settings are complete and meaningful
+    checkDistancesSettings                            ( settings );
+    
+    //================================================ Initialise local variables
+    proshade_unsign noStructures                      = static_cast< proshade_unsign > ( settings->inputFiles.size() );
+    std::vector< ProSHADE_internal_data::ProSHADE_data* > structures ( noStructures, nullptr );
+    std::vector< ProSHADE_settings* > workerSettings;
+    
+    //================================================ Allocate the results matrices
+    enLevsMat->assign                                 ( noStructures, std::vector< proshade_double > ( noStructures, 0.0 ) );
+    trSigmMat->assign                                 ( noStructures, std::vector< proshade_double > ( noStructures, 0.0 ) );
+    rotFunMat->assign                                 ( noStructures, std::vector< proshade_double > ( noStructures, 0.0 ) );
+    
+    try
+    {
+        //============================================ Prepare the first structure, this fixes all the values left on auto in the settings
+        prepareStructureForDistances                  ( &structures.at(0), 0, settings );
         
-        //============================================ Report results
-        ReportDistancesResults                        ( settings, settings->inputFiles.at(0), settings->inputFiles.at(iter), enLevDist, trSigmDist, rotFunDist );
+        //============================================ Prepare all other structures exactly once
+        proshade_unsign noWorkers                     = getNumberOfDistancesWorkers ( settings, noStructures - 1 );
+        workerSettings                                = createWorkerSettings ( settings, noWorkers );
+        ProSHADE_internal_misc::parallelFor           ( noStructures - 1, noWorkers, [&] ( proshade_unsign taskIt, proshade_unsign workerIt )
+        {
+            prepareStructureForDistances              ( &structures.at(taskIt+1), taskIt + 1, workerSettings.at(workerIt) );
+        } );
         
-        //============================================ Release the memory
-        delete compareChanging;
+        //============================================ For each unique structure pair, grouped by the second structure and longest groups first
+        ProSHADE_internal_misc::parallelFor           ( noStructures, noWorkers, [&] ( proshade_unsign taskIt, proshade_unsign workerIt )
+        {
+            proshade_unsign str2                      = noStructures - 1 - taskIt;
+            for ( proshade_unsign str1 = 0; str1 <= str2; str1++ )
+            {
+                //==================================== Get distances
+                computeDistancesForPair               ( structures.at(str1), structures.at(str2), workerSettings.at(workerIt), &enLevsMat->at(str1).at(str2), &trSigmMat->at(str1).at(str2), &rotFunMat->at(str1).at(str2) );
+                
+                //==================================== Save results into the lower triangle as well
+                enLevsMat->at(str2).at(str1)          = enLevsMat->at(str1).at(str2);
+                trSigmMat->at(str2).at(str1)          = trSigmMat->at(str1).at(str2);
+                rotFunMat->at(str2).at(str1)          = rotFunMat->at(str1).at(str2);
+            }
+        } );
+    }
+    catch ( ... )
+    {
+        releaseWorkerSettings                         ( &workerSettings );
+        for ( proshade_unsign iter = 0; iter < noStructures; iter++ ) { delete structures.at(iter); }
+        throw;
+    }
+    
+    //================================================ Report results in the serial order
+    for ( proshade_unsign str1 = 0; str1 < noStructures; str1++ )
+    {
+        for ( proshade_unsign str2 = str1; str2 < noStructures; str2++ )
+        {
+            ReportDistancesResults                    ( settings, settings->inputFiles.at(str1), settings->inputFiles.at(str2), enLevsMat->at(str1).at(str2), trSigmMat->at(str1).at(str2), rotFunMat->at(str1).at(str2) );
+        }
+    }
+    
+    //================================================ Save the first row into the vectors as well, so that the first-vs-all accessors still work
+    for ( proshade_unsign iter = 1; iter < noStructures; iter++ )
+    {
+        ProSHADE_internal_misc::addToDoubleVector     ( enLevs, enLevsMat->at(0).at(iter) );
+        ProSHADE_internal_misc::addToDoubleVector     ( trSigm, trSigmMat->at(0).at(iter) );
+        ProSHADE_internal_misc::addToDoubleVector     ( rotFun, rotFunMat->at(0).at(iter) );
     }
     
-
     //================================================ Release memory
-    delete compareAgainst;
+    releaseWorkerSettings                             ( &workerSettings );
+    for ( proshade_unsign iter = 0; iter < noStructures; iter++ ) { delete structures.at(iter); }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function prepares a single structure for the all-vs-all distances computation.
+ 
+    \param[in] str Pointer to the data object pointer, which will be allocated and filled by this function.
+    \param[in] strIndex The index of the structure in the settings input files list.
+    \param[in] settings ProSHADE_settings object specifying the details of how distances computation should be done.
+ */
+void ProSHADE_internal_tasks::prepareStructureForDistances ( ProSHADE_internal_data::ProSHADE_data** str, proshade_unsign strIndex, ProSHADE_settings* settings )
+{
+    //================================================ Create a data object
+    *str                                              = new ProSHADE_internal_data::ProSHADE_data ( );
+    
+    //================================================ Read in the structure
+    (*str)->readInStructure                           ( settings->inputFiles.at(strIndex), strIndex, settings );
+    
+    //================================================ Internal data processing  (COM, norm, mask, extra space)
+    (*str)->processInternalMap                        ( settings );
+    
+    //================================================ Map to sphere
+    (*str)->mapToSpheres                              ( settings );
+    
+    //================================================ Get spherical harmonics
+    (*str)->computeSphericalHarmonics                 ( settings );
+    
+    //================================================ Pre-compute the RRP matrices, these depend on this structure only
+    if ( settings->computeEnergyLevelsDesc ) { (*str)->computeRRPMatrices ( settings ); }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function computes all the requested distances between two prepared structures.
+ 
+    Note that the first structure is only read from, while the second structure has its E matrices, SO(3) coefficients and
+    related data overwritten.
+ 
+    \param[in] obj1 The first (read only) structure.
+    \param[in] obj2 The second structure.
+    \param[in] settings ProSHADE_settings object specifying the details of how distances computation should be done.
+    \param[in] enLevDist Pointer to variable where the energy levels distance is to be saved.
+    \param[in] trSigmDist Pointer to variable where the trace sigma distance is to be saved.
+    \param[in] rotFunDist Pointer to variable where the rotation function distance is to be saved.
+ */
+void ProSHADE_internal_tasks::computeDistancesForPair ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings, proshade_double* enLevDist, proshade_double* trSigmDist, proshade_double* rotFunDist )
+{
+    //================================================ Energy levels
+    *enLevDist                                        = 0.0;
+    if ( settings->computeEnergyLevelsDesc ) { *enLevDist  = ProSHADE_internal_distances::computeEnergyLevelsDescriptor ( obj1, obj2, settings ); }
+    else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Energy levels distance computation not required.", settings->messageShift ); }
+    
+    //================================================ Trace sigma
+    *trSigmDist                                       = 0.0;
+    if ( settings->computeTraceSigmaDesc   ) { *trSigmDist = ProSHADE_internal_distances::computeTraceSigmaDescriptor ( obj1, obj2, settings ); }
+    else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Trace sigma distance computation not required.", settings->messageShift ); }
+    
+    //================================================ Rotation function
+    *rotFunDist                                       = 0.0;
+    if ( settings->computeRotationFuncDesc ) { *rotFunDist = ProSHADE_internal_distances::computeRotationFunctionDescriptor ( obj1, obj2, settings ); }
+    else { ProSHADE_internal_messages::printProgressMessage ( settings->verbose, 1, "Rotation function distance computation not required.", settings->messageShift ); }
+    
+    //================================================ Done
+    return ;
+    
+}
+
+/*! \brief This function decides how many worker threads should the distances computation use.
+ 
+    The number of workers is limited by the number of threads requested, the number of tasks and the maximum number of
+    structures which can be processed (and therefore held in memory) at the same time.
+ 
+    \param[in] settings ProSHADE_settings object specifying the details of how distances computation should be done.
+    \param[in] noTasks The number of independent tasks to be processed.
+    \param[out] X The number of worker threads to be used.
+ */
+proshade_unsign ProSHADE_internal_tasks::getNumberOfDistancesWorkers ( ProSHADE_settings* settings, proshade_unsign noTasks )
+{
+    //================================================ Limit by threads and tasks
+    proshade_unsign ret                               = ProSHADE_internal_misc::getNumberOfThreads ( settings->noThreads, noTasks );
+    
+    //================================================ Limit by the in-flight structures
+    if ( ( settings->maxInFlightStructures > 0 ) && ( ret > settings->maxInFlightStructures ) ) { ret = settings->maxInFlightStructures; }
+    
+    //================================================ Done
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function creates a private copy of the settings object for each worker thread.
+ 
+    As the data processing functions write the values left on auto into the settings object, each worker needs its own
+    copy. The copies are made from the settings after the first structure has been processed, so that all workers use
+    the same values as the serial computation would.
+ 
+    \param[in] settings ProSHADE_settings object to be copied.
+    \param[in] noWorkers The number of worker threads.
+    \param[out] X Vector of the settings objects, the first being the original settings object.
+ */
+std::vector< ProSHADE_settings* > ProSHADE_internal_tasks::createWorkerSettings ( ProSHADE_settings* settings, proshade_unsign noWorkers )
+{
+    //================================================ Initialise variables
+    std::vector< ProSHADE_settings* > ret             ( 1, settings );
+    
+    //================================================ Copy settings for all other workers
+    for ( proshade_unsign wIt = 1; wIt < noWorkers; wIt++ )
+    {
+        ProSHADE_settings* locSettings                = new ProSHADE_settings ( settings );
+        ProSHADE_internal_misc::checkMemoryAllocation ( locSettings, __FILE__, __LINE__, __func__ );
+        ret.push_back                                 ( locSettings );
+    }
+    
+    //================================================ Done
+    return                                            ( ret );
+    
+}
+
+/*! \brief This function releases the settings copies created by the createWorkerSettings() function.
+ 
+    \param[in] workerSettings Pointer to the vector of worker settings, the first of which is the original settings object and is not released.
+ */
+void ProSHADE_internal_tasks::releaseWorkerSettings ( std::vector< ProSHADE_settings* >* workerSettings )
+{
+    //================================================ Delete the copies
+    for ( size_t wIt = 1; wIt < workerSettings->size(); wIt++ ) { delete workerSettings->at(wIt); }
+    workerSettings->clear                             ( );
     
     //================================================ Done
     return ;
@@ -454,7 +713,7 @@ void ProSHADE_internal_tasks::SymmetryCentreDetectionTask ( ProSHADE_settings* s
     
     //================================================ Compute Fourier for the original map
     for ( proshade_unsign it = 0; it < static_cast< proshade_unsign > ( symStr->getXDim() * symStr->getYDim() * symStr->getZDim() ); it++ ) { origMap[it][0] = symStr->getMapValue( it ); origMap[it][1] = 0.0; }
-    fftw_execute                                      ( planForwardFourier );
+    fftw_execute_dft                                  ( planForwardFourier, origMap, origCoeffs );
     
     //================================================ If single C was found
     if ( relSym.size() == 1 )
@@ -570,7 +829,7 @@ void ProSHADE_internal_tasks::SymmetryCentreDetectionTask ( ProSHADE_settings* s
     }
     
     //================================================ Release the Fourier transforms related memory
-    ProSHADE_internal_symmetry::releaseCentreOfMapFourierTransforms ( origMap, origCoeffs, rotMapComplex, rotCoeffs, trFunc, trFuncCoeffs, planForwardFourier, planForwardFourierRot, planReverseFourierComb );
+    ProSHADE_internal_symmetry::releaseCentreOfMapFourierTransforms ( origMap, origCoeffs, rotMapComplex, rotCoeffs, trFunc, trFuncCoeffs );
     
     //== Release optimisation memory
 //    delete[] trsOptMap;
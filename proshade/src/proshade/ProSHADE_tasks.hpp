@@ -40,6 +40,9 @@ namespace ProSHADE_internal_tasks
                                                         std::vector < proshade_signed* >* reboxedBounds, std::vector < proshade_double* >* manipulatedMaps );
     void DistancesComputationTask                     ( ProSHADE_settings* settings, std::vector< proshade_double >* enLevs, std::vector< proshade_double >* trSigm,
                                                         std::vector< proshade_double >* rotFun );
+    void AllDistancesComputationTask                  ( ProSHADE_settings* settings, std::vector< proshade_double >* enLevs, std::vector< proshade_double >* trSigm,
+                                                        std::vector< proshade_double >* rotFun, std::vector< std::vector< proshade_double > >* enLevsMat,
+                                                        std::vector< std::vector< proshade_double > >* trSigmMat, std::vector< std::vector< proshade_double > >* rotFunMat );
     void SymmetryDetectionTask                        ( ProSHADE_settings* settings, std::vector< proshade_double >* mapCOMShift, std::string* symT, proshade_unsign* symF, std::vector< proshade_double* >* symA, std::vector < std::vector< proshade_double > >* allCs );
     void MapOverlayTask                               ( ProSHADE_settings* settings, std::vector < proshade_double >* rotationCentre, std::vector < proshade_double >* eulerAngles,
                                                         std::vector < proshade_double >* finalTranslation );
@@ -47,6 +50,12 @@ namespace ProSHADE_internal_tasks
 
     void ReportDistancesResults                       ( ProSHADE_settings* settings, std::string str1, std::string str2, proshade_double enLevDist,
                                                         proshade_double trSigmDist, proshade_double rotFunDist );
+    void prepareStructureForDistances                 ( ProSHADE_internal_data::ProSHADE_data** str, proshade_unsign strIndex, ProSHADE_settings* settings );
+    void computeDistancesForPair                      ( ProSHADE_internal_data::ProSHADE_data* obj1, ProSHADE_internal_data::ProSHADE_data* obj2, ProSHADE_settings* settings,
+                                                        proshade_double* enLevDist, proshade_double* trSigmDist, proshade_double* rotFunDist );
+    proshade_unsign getNumberOfDistancesWorkers       ( ProSHADE_settings* settings, proshade_unsign noTasks );
+    std::vector< ProSHADE_settings* > createWorkerSettings ( ProSHADE_settings* settings, proshade_unsign noWorkers );
+    void releaseWorkerSettings                        ( std::vector< ProSHADE_settings* >* workerSettings );
             
     void checkMapManipulationSettings                 ( ProSHADE_settings* settings );
     void checkDistancesSettings                       ( ProSHADE_settings* settings );
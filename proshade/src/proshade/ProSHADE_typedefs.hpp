@@ -35,6 +35,12 @@
 #include <algorithm>
 #include <iomanip>
 #include <utility>
+#include <map>
+#include <sstream>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 //==================================================== Do not use the following flags for the included files - this causes a lot of warnings that have nothing to do with ProSHADE
 #if defined ( __GNUC__ )
@@ -109,6 +115,9 @@ extern "C" {
 #include <utils_so3.h>
 #include <soft_fftw.h>
 #include <rotate_so3_fftw.h>
+#include <makeWigner.h>
+#include <wignerTransforms_fftw.h>
+#include <utils_vec_cx.h>
     
 #ifdef __cplusplus
 }
@@ -23,9 +23,15 @@
 #include "ProSHADE_wignerMatrices.hpp"
 
 /*! \brief This function allocates the memory for the Wigner matrices for the calling object.
+ 
+    If the Wigner matrices are already allocated, they are re-used, as their dimensions are given by the E matrices bandwidth and
+    they are released whenever the E matrices are re-allocated.
  */
 void ProSHADE_internal_data::ProSHADE_data::allocateWignerMatricesSpace ( )
 {
+    //================================================ Already allocated?
+    if ( this->wignerMatrices != nullptr ) { return ; }
+    
     //================================================ Sanity check
     if ( this->getEMatDim ( ) == 0 )
     {
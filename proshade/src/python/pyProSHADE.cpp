@@ -41,6 +41,8 @@ void add_settingsClass ( pybind11::module& pyProSHADE )
         .def_readwrite                                ( "inputFiles",                           &ProSHADE_settings::inputFiles                          )
         .def_readwrite                                ( "forceP1",                              &ProSHADE_settings::forceP1                             )
         .def_readwrite                                ( "removeNegativeDensity",                &ProSHADE_settings::removeNegativeDensity               )
+        .def_readwrite                                ( "mapMemoryBudget",                      &ProSHADE_settings::mapMemoryBudget                     )
+        .def_readwrite                                ( "cropMapOnRead",                        &ProSHADE_settings::cropMapOnRead                       )
         .def_readwrite                                ( "removeWaters",                         &ProSHADE_settings::removeWaters                        )
         .def_readwrite                                ( "firstModelOnly",                       &ProSHADE_settings::firstModelOnly                      )
                 
@@ -97,6 +99,9 @@ void add_settingsClass ( pybind11::module& pyProSHADE )
         .def_readwrite                                ( "enLevMatrixPowerWeight",               &ProSHADE_settings::enLevMatrixPowerWeight              )
         .def_readwrite                                ( "computeTraceSigmaDesc",                &ProSHADE_settings::computeTraceSigmaDesc               )
         .def_readwrite                                ( "computeRotationFuncDesc",              &ProSHADE_settings::computeRotationFuncDesc             )
+        .def_readwrite                                ( "rotFunDescCoarseToFine",               &ProSHADE_settings::rotFunDescCoarseToFine              )
+        .def_readwrite                                ( "computeAllDistances",                  &ProSHADE_settings::computeAllDistances                 )
+        .def_readwrite                                ( "maxInFlightStructures",                &ProSHADE_settings::maxInFlightStructures               )
     
         .def_readwrite                                ( "peakNeighbours",                       &ProSHADE_settings::peakNeighbours                      )
         .def_readwrite                                ( "noIQRsFromMedianNaivePeak",            &ProSHADE_settings::noIQRsFromMedianNaivePeak           )
@@ -124,6 +129,12 @@ void add_settingsClass ( pybind11::module& pyProSHADE )
         .def_readwrite                                ( "verbose",                              &ProSHADE_settings::verbose                             )
         .def_readwrite                                ( "messageShift",                         &ProSHADE_settings::messageShift                        )
     
+        .def_readwrite                                ( "noThreads",                            &ProSHADE_settings::noThreads                           )
+    
+        .def_readwrite                                ( "fftwPlanningRigour",                   &ProSHADE_settings::fftwPlanningRigour                  )
+        .def_readwrite                                ( "fftwWisdomFile",                       &ProSHADE_settings::fftwWisdomFile                      )
+        .def_readwrite                                ( "invSOFTBackend",                       &ProSHADE_settings::invSOFTBackend                      )
+    
         //============================================ Mutators
         .def                                          ( "addStructure",                         &ProSHADE_settings::addStructure,                           "Adds a structure file name to the appropriate variable.",                                                                  pybind11::arg ( "structure"     ) )
         .def                                          ( "setResolution",                        &ProSHADE_settings::setResolution,                          "This function sets the resolution in the appropriate variable.",                                                           pybind11::arg ( "resolution"    ) )
@@ -162,6 +173,13 @@ void add_settingsClass ( pybind11::module& pyProSHADE )
         .def                                          ( "setEnergyLevelsComputation",           &ProSHADE_settings::setEnergyLevelsComputation,             "Sets whether the energy level distance descriptor should be computed.",                                                    pybind11::arg ( "enLevDesc"     ) )
         .def                                          ( "setTraceSigmaComputation",             &ProSHADE_settings::setTraceSigmaComputation,               "Sets whether the trace sigma distance descriptor should be computed.",                                                     pybind11::arg ( "trSigVal"      ) )
         .def                                          ( "setRotationFunctionComputation",       &ProSHADE_settings::setRotationFunctionComputation,         "Sets whether the rotation function distance descriptor should be computed.",                                               pybind11::arg ( "rotfVal"       ) )
+        .def                                          ( "setRotationFunctionCoarseToFine",      &ProSHADE_settings::setRotationFunctionCoarseToFine,        "Sets whether the rotation function descriptor peak is found by the coarse-to-fine search.",                               pybind11::arg ( "coarseVal"     ) )
+        .def                                          ( "setAllVsAllDistances",                 &ProSHADE_settings::setAllVsAllDistances,                   "Sets whether the distances should be computed between all pairs of structures.",                                           pybind11::arg ( "allDist"       ) )
+        .def                                          ( "setMaxInFlightStructures",             &ProSHADE_settings::setMaxInFlightStructures,               "Sets the maximum number of structures processed concurrently by the parallel distances computation.",                      pybind11::arg ( "maxInFl"       ) )
+        .def                                          ( "setNumberOfThreads",                   &ProSHADE_settings::setNumberOfThreads,                     "Sets the number of threads to be used by the parallelised computations.",                                                  pybind11::arg ( "noThr"         ) )
+        .def                                          ( "setFFTWPlanningRigour",                &ProSHADE_settings::setFFTWPlanningRigour,                  "Sets the rigour with which the FFTW plans are created (0 - estimate, 1 - measure, 2 - patient).",                          pybind11::arg ( "rigour"        ) )
+        .def                                          ( "setFFTWWisdomFile",                    &ProSHADE_settings::setFFTWWisdomFile,                      "Sets the file to and from which the FFTW wisdom is saved and loaded.",                                                     pybind11::arg ( "wisdomFile"    ) )
+        .def                                          ( "setInverseSOFTBackend",                &ProSHADE_settings::setInverseSOFTBackend,                  "Sets the inverse SO(3) transform implementation (0 - SOFT naive, 1 - parallel).",                                          pybind11::arg ( "backend"       ) )
         .def                                          ( "setPeakNeighboursNumber",              &ProSHADE_settings::setPeakNeighboursNumber,                "Sets the number of neighbour values that have to be smaller for an index to be considered a peak.",                        pybind11::arg ( "pkS"           ) )
         .def                                          ( "setPeakNaiveNoIQR",                    &ProSHADE_settings::setPeakNaiveNoIQR,                      "Sets the number of IQRs from the median for threshold height a peak needs to be considered a peak.",                       pybind11::arg ( "noIQRs"        ) )
         .def                                          ( "setPhaseUsage",                        &ProSHADE_settings::setPhaseUsage,                          "Sets whether the phase information will be used.",                                                                         pybind11::arg ( "phaseUsage"    ) )
@@ -181,6 +199,8 @@ void add_settingsClass ( pybind11::module& pyProSHADE )
         .def                                          ( "setFSCThreshold",                      &ProSHADE_settings::setFSCThreshold,                        "Sets the minimum FSC threshold for axis to be considered detected.",                                                     pybind11::arg ( "fscThr"        ) )
         .def                                          ( "setPeakThreshold",                     &ProSHADE_settings::setPeakThreshold,                       "Sets the minimum peak height threshold for axis to be considered possible.",                                          pybind11::arg ( "peakThr"       ) )
         .def                                          ( "setNegativeDensity",                   &ProSHADE_settings::setNegativeDensity,                     "Sets the internal variable deciding whether input files negative density should be removed.",                           pybind11::arg ( "nDens"         ) )
+        .def                                          ( "setMapMemoryBudget",                   &ProSHADE_settings::setMapMemoryBudget,                     "Sets the maximum size (in MB) of the internal map read from a map file; 0 for no limit.",                               pybind11::arg ( "memBudget"     ) )
+        .def                                          ( "setCropMapOnRead",                     &ProSHADE_settings::setCropMapOnRead,                       "Sets whether maps are cropped to their density box when read (changes the map box and origin).",                        pybind11::arg ( "cropOnRead"    ) )
     
         .def                                          ( "setSymmetryCentrePosition",
                                                         [] ( ProSHADE_settings &self, pybind11::array_t < proshade_double > pos )
@@ -307,6 +327,87 @@ void add_settingsClass ( pybind11::module& pyProSHADE )
                                                             return ( retArr );
                                                         }, "This function returns the full rotation function distances vector from the first to all other structures." )
     
+        .def                                          ( "getEnergyLevelsMatrix",
+                                                        [] ( ProSHADE_run &self ) -> pybind11::array_t < float >
+                                                        {
+                                                            //== Get the values
+                                                            std::vector< std::vector< proshade_double > > vals = self.getEnergyLevelsMatrix ();
+                                                            proshade_unsign noStr = static_cast< proshade_unsign > ( vals.size() );
+        
+                                                            //== Allocate memory for the numpy values
+                                                            float* npVals = new float[static_cast<unsigned int> ( noStr * noStr )];
+                                                            ProSHADE_internal_misc::checkMemoryAllocation ( npVals, __FILE__, __LINE__, __func__ );
+        
+                                                            //== Copy values
+                                                            for ( proshade_unsign iter = 0; iter < noStr; iter++ ) { for ( proshade_unsign it = 0; it < noStr; it++ ) { npVals[(iter*noStr)+it] = static_cast< float > ( vals.at(iter).at(it) ); } }
+        
+                                                            //== Create capsules to make sure memory is released properly from the allocating language (C++ in this case)
+                                                            pybind11::capsule pyCapsuleEnLevsMat ( npVals, []( void *f ) { float* foo = reinterpret_cast< float* > ( f ); delete[] foo; } );
+        
+                                                            //== Copy the value
+                                                            pybind11::array_t < float > retArr = pybind11::array_t<float> ( { static_cast<int> ( noStr ), static_cast<int> ( noStr ) },     // Shape
+                                                                                                                            { noStr * sizeof(float), sizeof(float) },                       // C-stype strides
+                                                                                                                            npVals,                                                         // Data
+                                                                                                                            pyCapsuleEnLevsMat );                                          // Capsule
+        
+                                                            //== Done
+                                                            return ( retArr );
+                                                        }, "This function returns the energy level distances matrix between all pairs of structures (all-vs-all mode only)." )
+    
+        .def                                          ( "getTraceSigmaMatrix",
+                                                        [] ( ProSHADE_run &self ) -> pybind11::array_t < float >
+                                                        {
+                                                            //== Get the values
+                                                            std::vector< std::vector< proshade_double > > vals = self.getTraceSigmaMatrix ();
+                                                            proshade_unsign noStr = static_cast< proshade_unsign > ( vals.size() );
+        
+                                                            //== Allocate memory for the numpy values
+                                                            float* npVals = new float[static_cast<unsigned int> ( noStr * noStr )];
+                                                            ProSHADE_internal_misc::checkMemoryAllocation ( npVals, __FILE__, __LINE__, __func__ );
+        
+                                                            //== Copy values
+                                                            for ( proshade_unsign iter = 0; iter < noStr; iter++ ) { for ( proshade_unsign it = 0; it < noStr; it++ ) { npVals[(iter*noStr)+it] = static_cast< float > ( vals.at(iter).at(it) ); } }
+        
+                                                            //== Create capsules to make sure memory is released properly from the allocating language (C++ in this case)
+                                                            pybind11::capsule pyCapsuleTrSigsMat ( npVals, []( void *f ) { float* foo = reinterpret_cast< float* > ( f ); delete[] foo; } );
+        
+                                                            //== Copy the value
+                                                            pybind11::array_t < float > retArr = pybind11::array_t<float> ( { static_cast<int> ( noStr ), static_cast<int> ( noStr ) },     // Shape
+                                                                                                                            { noStr * sizeof(float), sizeof(float) },                       // C-stype strides
+                                                                                                                            npVals,                                                         // Data
+                                                                                                                            pyCapsuleTrSigsMat );                                          // Capsule
+        
+                                                            //== Done
+                                                            return ( retArr );
+                                                        }, "This function returns the trace sigma distances matrix between all pairs of structures (all-vs-all mode only)." )
+    
+        .def                                          ( "getRotationFunctionMatrix",
+                                                        [] ( ProSHADE_run &self ) -> pybind11::array_t < float >
+                                                        {
+                                                            //== Get the values
+                                                            std::vector< std::vector< proshade_double > > vals = self.getRotationFunctionMatrix ();
+                                                            proshade_unsign noStr = static_cast< proshade_unsign > ( vals.size() );
+        
+                                                            //== Allocate memory for the numpy values
+                                                            float* npVals = new float[static_cast<unsigned int> ( noStr * noStr )];
+                                                            ProSHADE_internal_misc::checkMemoryAllocation ( npVals, __FILE__, __LINE__, __func__ );
+        
+                                                            //== Copy values
+                                                            for ( proshade_unsign iter = 0; iter < noStr; iter++ ) { for ( proshade_unsign it = 0; it < noStr; it++ ) { npVals[(iter*noStr)+it] = static_cast< float > ( vals.at(iter).at(it) ); } }
+        
+                                                            //== Create capsules to make sure memory is released properly from the allocating language (C++ in this case)
+                                                            pybind11::capsule pyCapsuleRotFunMat ( npVals, []( void *f ) { float* foo = reinterpret_cast< float* > ( f ); delete[] foo; } );
+        
+                                                            //== Copy the value
+                                                            pybind11::array_t < float > retArr = pybind11::array_t<float> ( { static_cast<int> ( noStr ), static_cast<int> ( noStr ) },     // Shape
+                                                                                                                            { noStr * sizeof(float), sizeof(float) },                       // C-stype strides
+                                                                                                                            npVals,                                                         // Data
+                                                                                                                            pyCapsuleRotFunMat );                                          // Capsule
+        
+                                                            //== Done
+                                                            return ( retArr );
+                                                        }, "This function returns the full rotation function distances matrix between all pairs of structures (all-vs-all mode only)." )
+    
         //============================================ Symmetry results accessor functions
         .def                                          ( "getSymmetryType", &ProSHADE_run::getSymmetryType, "This is the main accessor function for the user to get to know what symmetry type ProSHADE has detected and recommends." )
         .def                                          ( "getSymmetryFold", &ProSHADE_run::getSymmetryFold, "This is the main accessor function for the user to get to know what symmetry fold ProSHADE has detected and recommends." )
@@ -192,11 +192,11 @@ void add_dataClass ( pybind11::module& pyProSHADE )
         .def                                          ( "normaliseMap",          &ProSHADE_internal_data::ProSHADE_data::normaliseMap,          "Function for normalising the map values to mean 0 and sd 1.", pybind11::arg ( "settings" ) )
         .def                                          ( "maskMap",               &ProSHADE_internal_data::ProSHADE_data::maskMap,               "Function for computing the map mask using blurring and X IQRs from median.", pybind11::arg ( "settings" ) )
         .def                                          ( "reSampleMap",           &ProSHADE_internal_data::ProSHADE_data::reSampleMap,           "This function changes the internal map sampling to conform to particular resolution value.", pybind11::arg ( "settings" ) )
-        .def                                          ( "centreMapOnCOM",        &ProSHADE_internal_data::ProSHADE_data::centreMapOnCOM,        "This function shits the map so that its COM is in the centre of the map.", pybind11::arg ( "settings" ) )
+        .def                                          ( "centreMapOnCOM",        &ProSHADE_internal_data::ProSHADE_data::centreMapOnCOM,        "This function shits the map so that its COM is in the centre of the map.", pybind11::arg ( "settings" ), pybind11::arg ( "moveMap" ) = true )
         .def                                          ( "addExtraSpace",         &ProSHADE_internal_data::ProSHADE_data::addExtraSpace,         "This function increases the size of the map so that it can add empty space around it.", pybind11::arg ( "settings" ) )
         .def                                          ( "removePhaseInormation", &ProSHADE_internal_data::ProSHADE_data::removePhaseInormation, "This function removes phase from the map, effectively converting it to Patterson map.", pybind11::arg ( "settings" ) )
-        .def                                          ( "shiftToBoxCentre"     , &ProSHADE_internal_data::ProSHADE_data::shiftToBoxCentre,      "This function shifts the internal map so that its centre of the box is at required position.", pybind11::arg ( "settings" ) )
-        .def                                          ( "shiftToRotationCentre", &ProSHADE_internal_data::ProSHADE_data::shiftToRotationCentre, "This function shifts the internal map so that its rotation centre is at the centre of the box.", pybind11::arg ( "settings" ) )
+        .def                                          ( "shiftToBoxCentre"     , &ProSHADE_internal_data::ProSHADE_data::shiftToBoxCentre,      "This function shifts the internal map so that its centre of the box is at required position.", pybind11::arg ( "settings" ), pybind11::arg ( "addRotationCentreShift" ) = false )
+        .def                                          ( "shiftToRotationCentre", &ProSHADE_internal_data::ProSHADE_data::shiftToRotationCentre, "This function shifts the internal map so that its rotation centre is at the centre of the box.", pybind11::arg ( "settings" ), pybind11::arg ( "moveMap" ) = true )
         .def                                          ( "getReBoxBoundaries",
                                                         [] ( ProSHADE_internal_data::ProSHADE_data &self,ProSHADE_settings* settings ) -> pybind11::array_t < proshade_signed >
                                                         {
@@ -271,6 +271,7 @@ void add_dataClass ( pybind11::module& pyProSHADE )
         .def                                          ( "getXDim",     &ProSHADE_internal_data::ProSHADE_data::getXDim,     "This function allows access to the map size in indices along the X axis."   )
         .def                                          ( "getYDim",     &ProSHADE_internal_data::ProSHADE_data::getYDim,     "This function allows access to the map size in indices along the Y axis."   )
         .def                                          ( "getZDim",     &ProSHADE_internal_data::ProSHADE_data::getZDim,     "This function allows access to the map size in indices along the Z axis."   )
+        .def                                          ( "getNoMapPasses", &ProSHADE_internal_data::ProSHADE_data::getNoMapPasses, "This function allows access to the number of full map passes done by the map processing stages." )
     
         //============================================ Symmetry related functions
         .def                                          ( "computeRotationFunction", &ProSHADE_internal_data::ProSHADE_data::computeRotationFunction, "This function computes the self-rotation function for this structure and stores it internally in the ProSHADE_data object.", pybind11::arg ( "settings" ) )
@@ -948,7 +949,7 @@ void add_dataClass ( pybind11::module& pyProSHADE )
                                                                                                                                                           static_cast<proshade_unsign> ( angIt - 1.0 ) ) );
                                                                 
                                                                 //== Interpolate rotation function onto the sphere
-                                                                sphereMappedRotFun.at( static_cast < size_t > ( angIt - 1.0 ))->interpolateSphereValues ( dataObj->getInvSO3Coeffs ( ) );
+                                                                sphereMappedRotFun.at( static_cast < size_t > ( angIt - 1.0 ))->interpolateSphereValues ( dataObj->getInvSO3Coeffs ( ), dataObj->getRotFunSphereGeometry ( ) );
                                                             }
         
                                                             //== Save values to pointer
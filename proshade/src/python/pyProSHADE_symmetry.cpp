@@ -90,7 +90,7 @@ void add_symmetryNamespace ( pybind11::module& pyProSHADE )
 
         //== Compute Fourier for the original map
         for ( size_t it = 0; it < static_cast< size_t > ( dataObj->getXDim() * dataObj->getYDim() * dataObj->getZDim() ); it++ ) { origMap[it][0] = dataObj->getMapValue( it ); origMap[it][1] = 0.0; }
-        fftw_execute                                  ( planForwardFourier );
+        fftw_execute_dft                              ( planForwardFourier, origMap, origCoeffs );
         
         //== Run C++ code
         std::vector< proshade_unsign > axLst;
@@ -105,7 +105,7 @@ void add_symmetryNamespace ( pybind11::module& pyProSHADE )
                                                                                                                 planReverseFourierComb );
         
         //== Release required memory
-        ProSHADE_internal_symmetry::releaseCentreOfMapFourierTransforms ( origMap, origCoeffs, rotMapComplex, rotCoeffs, trFunc, trFuncCoeffs, planForwardFourier, planForwardFourierRot, planReverseFourierComb );
+        ProSHADE_internal_symmetry::releaseCentreOfMapFourierTransforms ( origMap, origCoeffs, rotMapComplex, rotCoeffs, trFunc, trFuncCoeffs );
         
         //== Allocate memory for the numpy values
         proshade_double* npVals                       = new proshade_double[3];